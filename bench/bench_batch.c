@@ -0,0 +1,104 @@
+/*
+ * Benchmark: batch commands
+ * Replays a looping script against a loaded world through game_command with
+ * output discarded, through a stdio sink writing to /dev/null, with output
+ * discarded while the session is recorded to /dev/null, and with the whole
+ * script chained into one line per game_command call.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "game.h"
+#include "recording.h"
+
+#define COMMANDS 2000000
+#define DEFAULT_WORLD "dark_tower"
+
+// A round trip that ends where it started, so it can repeat forever
+static const char *const script[] = {
+    "take key", "north", "take torch", "look", "east", "inventory",
+    "west", "drop torch", "south", "drop key", "undo", "redo", "examine key"
+};
+#define SCRIPT_LEN ((int)(sizeof(script) / sizeof(script[0])))
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Helper: Run the script for COMMANDS commands, returns commands per second
+static double run(Game *game, const OutputSink *sink) {
+    game_set_output(game, sink);
+    game_start(game);
+
+    double start = now_ns();
+    for (int i = 0; i < COMMANDS; i++) {
+        game_command(game, script[i % SCRIPT_LEN]);
+    }
+    return COMMANDS / ((now_ns() - start) / 1e9);
+}
+
+// Helper: Run the script chained into single lines ("take key, north, ...")
+static double run_chained(Game *game) {
+    char line[512] = "";
+    for (int i = 0; i < SCRIPT_LEN; i++) {
+        if (i > 0) strcat(line, ", ");
+        strcat(line, script[i]);
+    }
+    game_set_output(game, NULL);
+    game_start(game);
+
+    int lines = COMMANDS / SCRIPT_LEN;
+    double start = now_ns();
+    for (int i = 0; i < lines; i++) {
+        game_command(game, line);
+    }
+    return (double)lines * SCRIPT_LEN / ((now_ns() - start) / 1e9);
+}
+
+int main(int argc, char *argv[]) {
+    const char *name = argc > 1 ? argv[1] : DEFAULT_WORLD;
+
+    Game game;
+    LoadError error;
+    game_init(&game, NULL);
+    if (!game_open(&game, name, &error)) {
+        fprintf(stderr, "Error: %s\n", world_loader_get_error(&error));
+        game_free(&game);
+        return 1;
+    }
+
+    FILE *null_out = fopen("/dev/null", "w");
+    if (!null_out) {
+        fprintf(stderr, "Error: cannot open /dev/null\n");
+        game_free(&game);
+        return 1;
+    }
+    static char buffer[1 << 16];
+    setvbuf(null_out, buffer, _IOFBF, sizeof(buffer));
+    OutputSink stream = game_stream_sink(null_out);
+
+    printf("\n=== Batch Command Benchmark (%s, %d commands) ===\n\n", name, COMMANDS);
+    printf("  %-24s %14.0f commands/s\n", "output discarded", run(&game, NULL));
+    printf("  %-24s %14.0f commands/s\n", "stdio sink (/dev/null)", run(&game, &stream));
+
+    printf("  %-24s %14.0f commands/s\n", "chained, one line/script", run_chained(&game));
+
+    Recorder recorder;
+    if (recorder_open(&recorder, "/dev/null", 0)) {
+        game.recorder = &recorder;
+        printf("  %-24s %14.0f commands/s\n", "recorded (/dev/null)", run(&game, NULL));
+        game.recorder = NULL;
+        recorder_close(&recorder);
+    }
+    printf("\n");
+
+    fclose(null_out);
+    game_free(&game);
+    return 0;
+}
@@ -0,0 +1,231 @@
+/*
+ * Benchmark: Room memory layout
+ * Compares the original fat Room struct (text, item slots and conditional
+ * descriptions stored inline) against the current layout (exits in one
+ * CSR array, text in the string pool) for random-walk movement and
+ * whole-world traversal.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "world.h"
+
+#define MOVES 2000000
+#define PASSES 20
+
+// Layout of Room before the hot/cold split, kept here as the baseline
+typedef struct {
+    ConditionType type;
+    char subject[32];
+    bool negate;
+    char description[512];
+} LegacyConditionalDesc;
+
+typedef struct {
+    char id[32];
+    char name[64];
+    char description[512];
+    int exits[DIR_COUNT];
+    int items[50];
+    bool visited;
+    bool description_shown;
+    char locked_exits[DIR_COUNT][32];
+    bool exit_unlocked[DIR_COUNT];
+    LegacyConditionalDesc conditional_descs[MAX_CONDITIONAL_DESCS];
+    int conditional_desc_count;
+} LegacyRoom;
+
+typedef struct {
+    LegacyRoom *rooms;
+    int room_count;
+    int current_room;
+} LegacyWorld;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Same logic as the original world_move_ex (no keys are held in this benchmark)
+static MoveResult legacy_move(LegacyWorld *world, Direction dir) {
+    LegacyRoom *room = &world->rooms[world->current_room];
+    int next_room = room->exits[dir];
+    if (next_room == -1) return MOVE_NO_EXIT;
+    if (room->locked_exits[dir][0] != '\0' && !room->exit_unlocked[dir]) {
+        return MOVE_LOCKED;
+    }
+    world->current_room = next_room;
+    world->rooms[next_room].visited = true;
+    return MOVE_SUCCESS;
+}
+
+// Breadth-first reachability from room 0 over unlocked exits
+static int legacy_bfs(const LegacyWorld *world, int *queue, unsigned char *seen) {
+    memset(seen, 0, (size_t)world->room_count);
+    int head = 0, tail = 0;
+    queue[tail++] = 0;
+    seen[0] = 1;
+    while (head < tail) {
+        const LegacyRoom *room = &world->rooms[queue[head++]];
+        for (int d = 0; d < DIR_COUNT; d++) {
+            int next = room->exits[d];
+            if (next == -1 || seen[next]) continue;
+            if (room->locked_exits[d][0] != '\0' && !room->exit_unlocked[d]) continue;
+            seen[next] = 1;
+            queue[tail++] = next;
+        }
+    }
+    return tail;
+}
+
+static int split_bfs(const World *world, int *queue, unsigned char *seen) {
+    memset(seen, 0, (size_t)world->def->room_count);
+    int head = 0, tail = 0;
+    queue[tail++] = 0;
+    seen[0] = 1;
+    while (head < tail) {
+        int room = queue[head++];
+        const WorldDef *def = world->def;
+        for (int e = def->exit_start[room]; e < def->exit_start[room + 1]; e++) {
+            int next = def->exits[e].to;
+            if (seen[next]) continue;
+            if (def->exits[e].key && !bitset_test(world->exit_unlocked, (size_t)e)) continue;
+            seen[next] = 1;
+            queue[tail++] = next;
+        }
+    }
+    return tail;
+}
+
+// Grid world: east/west/north/south neighbours, every 16th north exit locked
+static bool build_worlds(int n, LegacyWorld *legacy, World *world) {
+    int width = 1;
+    while (width * width < n) width++;
+
+    legacy->rooms = calloc((size_t)n, sizeof(LegacyRoom));
+    if (!legacy->rooms) return false;
+    legacy->room_count = n;
+    legacy->current_room = 0;
+
+    world_init(world);
+    if (!world_reserve(world, n, 0, (size_t)n * 64)) return false;
+
+    char id[32];
+    for (int i = 0; i < n; i++) {
+        snprintf(id, sizeof(id), "room_%d", i);
+        if (world_add_room(world, id, "Room", "A generated room.") == -1) return false;
+
+        LegacyRoom *room = &legacy->rooms[i];
+        strcpy(room->id, id);
+        strcpy(room->name, "Room");
+        strcpy(room->description, "A generated room.");
+        for (int d = 0; d < DIR_COUNT; d++) room->exits[d] = -1;
+        for (int j = 0; j < 50; j++) room->items[j] = -1;
+    }
+
+    for (int i = 0; i < n; i++) {
+        int x = i % width, y = i / width;
+        int targets[DIR_COUNT] = {
+            y > 0 ? i - width : -1,
+            i + width < n ? i + width : -1,
+            x + 1 < width && i + 1 < n ? i + 1 : -1,
+            x > 0 ? i - 1 : -1,
+            -1, -1
+        };
+        for (int d = 0; d < DIR_COUNT; d++) {
+            if (targets[d] == -1) continue;
+            legacy->rooms[i].exits[d] = targets[d];
+            world_connect_rooms(world, i, (Direction)d, targets[d]);
+        }
+        if (i % 16 == 0 && targets[DIR_NORTH] != -1) {
+            strcpy(legacy->rooms[i].locked_exits[DIR_NORTH], "key");
+            world_lock_exit(world, i, DIR_NORTH, "key");
+        }
+    }
+    return true;
+}
+
+int main(void) {
+    static const int sizes[] = {1000, 10000, 50000};
+    const int size_count = (int)(sizeof(sizes) / sizeof(sizes[0]));
+
+    printf("\n=== Room Layout Benchmark ===\n\n");
+    printf("  Room before: %zu bytes, after: %zu bytes + %zu per exit\n\n",
+           sizeof(LegacyRoom), sizeof(Room) + sizeof(int32_t), sizeof(Exit));
+    printf("  %-8s %12s %12s %14s %14s\n",
+           "rooms", "move before", "move after", "BFS before", "BFS after");
+    printf("  %-8s %12s %12s %14s %14s\n", "", "ns/op", "ns/op", "us/pass", "us/pass");
+
+    volatile long sink = 0;
+
+    for (int s = 0; s < size_count; s++) {
+        int n = sizes[s];
+        LegacyWorld legacy;
+        World world;
+        if (!build_worlds(n, &legacy, &world)) {
+            fprintf(stderr, "Error: out of memory\n");
+            return 1;
+        }
+
+        // Pre-pick directions so both layouts take the same walk
+        unsigned char *dirs = malloc(MOVES);
+        int *queue = malloc((size_t)n * sizeof(int));
+        unsigned char *seen = malloc((size_t)n);
+        if (!dirs || !queue || !seen) {
+            fprintf(stderr, "Error: out of memory\n");
+            return 1;
+        }
+        unsigned int seed = 12345;
+        for (int i = 0; i < MOVES; i++) {
+            seed = seed * 1103515245u + 12345u;
+            dirs[i] = (unsigned char)((seed >> 8) % 4);
+        }
+
+        double start = now_ns();
+        for (int i = 0; i < MOVES; i++) {
+            sink += legacy_move(&legacy, (Direction)dirs[i]);
+        }
+        double legacy_move_ns = (now_ns() - start) / MOVES;
+
+        start = now_ns();
+        for (int i = 0; i < MOVES; i++) {
+            sink += world_move_ex(&world, (Direction)dirs[i], NULL, 0);
+        }
+        double split_move_ns = (now_ns() - start) / MOVES;
+
+        start = now_ns();
+        for (int p = 0; p < PASSES; p++) {
+            sink += legacy_bfs(&legacy, queue, seen);
+        }
+        double legacy_bfs_us = (now_ns() - start) / PASSES / 1000.0;
+
+        start = now_ns();
+        for (int p = 0; p < PASSES; p++) {
+            sink += split_bfs(&world, queue, seen);
+        }
+        double split_bfs_us = (now_ns() - start) / PASSES / 1000.0;
+
+        if (legacy.current_room != world.current_room) {
+            fprintf(stderr, "Error: walks diverged at %d rooms\n", n);
+            return 1;
+        }
+
+        printf("  %-8d %12.1f %12.1f %14.1f %14.1f\n",
+               n, legacy_move_ns, split_move_ns, legacy_bfs_us, split_bfs_us);
+
+        free(dirs);
+        free(queue);
+        free(seen);
+        free(legacy.rooms);
+        world_free(&world);
+    }
+
+    printf("\n");
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Benchmark: loading generated worlds
+ * Writes .world files with 1k to 400k rooms (about 50 MB) and times
+ * world_load_from_file, with its throughput over the file's bytes, then
+ * compiles each to an image (.worldc) and times world_image_load on it,
+ * and times world_cache_load when the cached image is current (hit) and
+ * when the file was touched, so its content is hashed (rehash).
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "world_cache.h"
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec / 1e6;
+}
+
+// Helper: Write a chain of rooms with one item every tenth room
+static bool write_world(const char *path, int rooms) {
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "[WORLD]\nname: Generated\nstart: room_0\n\n");
+    for (int i = 0; i < rooms; i++) {
+        fprintf(file, "[ROOM:room_%d]\n", i);
+        fprintf(file, "name: Room %d\n", i);
+        fprintf(file, "description: A generated room, number %d of %d. "
+                      "Corridors stretch away in the gloom.\n", i, rooms);
+        if (i > 0) {
+            fprintf(file, "exits: west=room_%d\n", i - 1);
+        }
+        fprintf(file, "\n");
+    }
+    for (int i = 0; i < rooms; i += 10) {
+        fprintf(file, "[ITEM:item_%d]\nname: trinket %d\n", i, i);
+        fprintf(file, "description: A small generated trinket.\n");
+        fprintf(file, "takeable: yes\nlocation: room_%d\n\n", i);
+    }
+
+    fclose(file);
+    return true;
+}
+
+int main(void) {
+    static const int sizes[] = {1000, 10000, 100000, 400000};
+    const int size_count = (int)(sizeof(sizes) / sizeof(sizes[0]));
+
+    char path[64];
+    char image_path[64];
+    char cache_dir[64];
+    char cached_path[256];
+    snprintf(path, sizeof(path), "/tmp/bench_world_%d.world", (int)getpid());
+    snprintf(image_path, sizeof(image_path), "/tmp/bench_world_%d%s", (int)getpid(),
+             WORLD_IMAGE_EXTENSION);
+    snprintf(cache_dir, sizeof(cache_dir), "/tmp/bench_cache_%d", (int)getpid());
+    world_cache_path(cache_dir, path, cached_path, sizeof(cached_path));
+
+    printf("\n=== World Load Benchmark ===\n\n");
+    printf("  %-10s %10s %10s %12s %10s %14s %12s %10s %10s\n", "rooms", "items", "file MB",
+           "load ms", "MB/s", "arena KB", "image ms", "hit ms", "rehash ms");
+
+    for (int s = 0; s < size_count; s++) {
+        if (!write_world(path, sizes[s])) {
+            fprintf(stderr, "Error: cannot write %s\n", path);
+            return 1;
+        }
+        struct stat st;
+        double mb = stat(path, &st) == 0 ? (double)st.st_size / (1024.0 * 1024.0) : 0.0;
+
+        World world;
+        LoadError error;
+        double start = now_ms();
+        bool ok = world_load_from_file(&world, path, &error);
+        double elapsed = now_ms() - start;
+
+        if (!ok) {
+            fprintf(stderr, "Error: %s\n", world_loader_get_error(&error));
+            world_free(&world);
+            unlink(path);
+            return 1;
+        }
+
+        int rooms = world.def->room_count;
+        int items = world.def->item_count;
+        size_t arena_kb = world.def->arena.total / 1024;
+        ok = world_image_write(&world, image_path, NULL, &error);
+        world_free(&world);
+
+        World image;
+        double image_ms = 0.0;
+        if (ok) {
+            start = now_ms();
+            ok = world_image_load(&image, image_path, &error);
+            image_ms = now_ms() - start;
+            world_free(&image);
+        }
+        // First load fills the cache; then a hit, then a touch forces a rehash
+        double cache_ms[2] = {0.0, 0.0};
+        WorldCacheResult expected[2] = {WORLD_CACHE_HIT, WORLD_CACHE_REVALIDATED};
+        for (int pass = -1; ok && pass < 2; pass++) {
+            if (pass == 1) {
+                struct timespec times[2] = { {0, UTIME_NOW}, {0, UTIME_NOW} };
+                utimensat(AT_FDCWD, path, times, 0);
+            }
+            WorldCacheResult result;
+            start = now_ms();
+            ok = world_cache_load(&image, path, cache_dir, &error, &result);
+            if (pass >= 0) {
+                cache_ms[pass] = now_ms() - start;
+                if (ok && result != expected[pass]) {
+                    snprintf(error.message, sizeof(error.message), "unexpected cache result %d",
+                             (int)result);
+                    ok = false;
+                }
+            }
+            world_free(&image);
+        }
+        if (!ok) {
+            fprintf(stderr, "Error: %s\n", world_loader_get_error(&error));
+            unlink(path);
+            unlink(image_path);
+            unlink(cached_path);
+            rmdir(cache_dir);
+            return 1;
+        }
+
+        printf("  %-10d %10d %10.1f %12.1f %10.0f %14zu %12.3f %10.3f %10.1f\n", rooms, items,
+               mb, elapsed, elapsed > 0 ? mb / (elapsed / 1e3) : 0.0, arena_kb, image_ms,
+               cache_ms[0], cache_ms[1]);
+    }
+
+    unlink(path);
+    unlink(image_path);
+    unlink(cached_path);
+    rmdir(cache_dir);
+    printf("\n");
+    return 0;
+}
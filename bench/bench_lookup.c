@@ -0,0 +1,119 @@
+/*
+ * Benchmark: ID lookup cost vs. entity count
+ * Compares world_find_room (open-addressed ID index) against the linear
+ * strcmp scan it replaced, from 50 to 100k rooms, and command verb lookup
+ * (perfect hash) against a scan of the built-in words.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "world.h"
+
+#define LOOKUPS 200000
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int linear_find(const World *world, const char *id) {
+    for (int i = 0; i < world->def->room_count; i++) {
+        if (strcmp(world_str(world, world->def->rooms[i].id), id) == 0) return i;
+    }
+    return -1;
+}
+
+int main(void) {
+    static const int sizes[] = {50, 500, 5000, 50000, 100000};
+    const int size_count = (int)(sizeof(sizes) / sizeof(sizes[0]));
+
+    printf("\n=== ID Lookup Benchmark ===\n\n");
+    printf("  %-10s %14s %14s\n", "rooms", "index ns/op", "linear ns/op");
+
+    unsigned int seed = 12345;
+    volatile long sink = 0;
+
+    for (int s = 0; s < size_count; s++) {
+        int n = sizes[s];
+        World world;
+        world_init(&world);
+
+        char id[32];
+        for (int i = 0; i < n; i++) {
+            snprintf(id, sizeof(id), "room_%d", i);
+            if (world_add_room(&world, id, "Room", "A generated room.") == -1) {
+                fprintf(stderr, "Error: out of memory\n");
+                return 1;
+            }
+        }
+
+        // Pre-pick lookup targets so both strategies see the same keys
+        int *targets = malloc(LOOKUPS * sizeof(int));
+        if (!targets) {
+            fprintf(stderr, "Error: out of memory\n");
+            return 1;
+        }
+        for (int i = 0; i < LOOKUPS; i++) {
+            seed = seed * 1103515245u + 12345u;
+            targets[i] = (int)((seed >> 8) % (unsigned int)n);
+        }
+
+        double start = now_ns();
+        for (int i = 0; i < LOOKUPS; i++) {
+            sink += world_find_room(&world, world_str(&world, world.def->rooms[targets[i]].id));
+        }
+        double index_ns = (now_ns() - start) / LOOKUPS;
+
+        // Linear scan is O(n); cap total work so large sizes finish quickly
+        int linear_lookups = LOOKUPS;
+        if ((long)linear_lookups * n > 200000000L) {
+            linear_lookups = (int)(200000000L / n);
+        }
+        start = now_ns();
+        for (int i = 0; i < linear_lookups; i++) {
+            sink += linear_find(&world, world_str(&world, world.def->rooms[targets[i]].id));
+        }
+        double linear_ns = (now_ns() - start) / linear_lookups;
+
+        printf("  %-10d %14.1f %14.1f\n", n, index_ns, linear_ns);
+
+        free(targets);
+        world_free(&world);
+    }
+
+    // Verb lookup: every built-in word, a synonym and words that miss
+    // (named exits and typos go through the same lookup)
+    static const char *verbs[] = {
+        "look", "l", "north", "n", "take", "get", "examine", "x", "inventory",
+        "i", "use", "goto", "exit", "grab", "in", "lok", "through", "quit"
+    };
+    const int verb_count = (int)(sizeof(verbs) / sizeof(verbs[0]));
+    World world;
+    world_init(&world);
+    world_add_verb(&world, "grab", "take");
+    world_compile_conditions(&world);
+
+    double start = now_ns();
+    for (int i = 0; i < LOOKUPS; i++) {
+        sink += world_find_verb(&world, verbs[i % verb_count], strlen(verbs[i % verb_count]));
+    }
+    double table_ns = (now_ns() - start) / LOOKUPS;
+    start = now_ns();
+    for (int i = 0; i < LOOKUPS; i++) {
+        sink += verb_builtin(verbs[i % verb_count]);
+    }
+    double scan_ns = (now_ns() - start) / LOOKUPS;
+    world_free(&world);
+
+    printf("\n  %-10s %14s %14s\n", "verbs", "table ns/op", "scan ns/op");
+    printf("  %-10d %14.1f %14.1f\n", verb_count, table_ns, scan_ns);
+
+    printf("\n");
+    (void)sink;
+    return 0;
+}
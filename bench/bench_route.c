@@ -0,0 +1,106 @@
+/*
+ * Benchmark: travel routes
+ * Times next-hop table builds, cached lookups and incremental updates after
+ * unlocking a door on generated grid worlds with many locked exits.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "world_route.h"
+
+#define UNLOCKS 1000
+#define LOOKUPS 100000
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Grid world with one exit in four locked
+static bool build_world(World *world, int n) {
+    int width = 1;
+    while (width * width < n) width++;
+
+    world_init(world);
+    if (!world_reserve(world, n, 0, (size_t)n * 64)) return false;
+
+    char id[32];
+    for (int i = 0; i < n; i++) {
+        snprintf(id, sizeof(id), "room_%d", i);
+        if (world_add_room(world, id, "Room", "A generated room.") == -1) return false;
+    }
+    unsigned int seed = 99;
+    for (int i = 0; i < n; i++) {
+        int x = i % width;
+        if (i >= width) world_connect_rooms(world, i, DIR_NORTH, i - width);
+        if (i + width < n) world_connect_rooms(world, i, DIR_SOUTH, i + width);
+        if (x + 1 < width && i + 1 < n) world_connect_rooms(world, i, DIR_EAST, i + 1);
+        if (x > 0) world_connect_rooms(world, i, DIR_WEST, i - 1);
+        for (int d = 0; d < 4; d++) {
+            seed = seed * 1103515245u + 12345u;
+            if ((seed >> 16) % 4 == 0 && world_room_exit(world, i, (Direction)d) != -1) {
+                world_lock_exit(world, i, (Direction)d, "key");
+            }
+        }
+    }
+    return true;
+}
+
+int main(void) {
+    static const int sizes[] = {1000, 10000, 100000};
+    const int size_count = (int)(sizeof(sizes) / sizeof(sizes[0]));
+
+    printf("\n=== Travel Route Benchmark (%d cached targets) ===\n\n", ROUTE_CACHE_SLOTS);
+    printf("  %-8s %12s %12s %14s %14s\n",
+           "rooms", "build us", "lookup ns", "unlock us", "rebuild us");
+
+    for (int s = 0; s < size_count; s++) {
+        int n = sizes[s];
+        World world;
+        WorldRoutes routes;
+        if (!build_world(&world, n) || !world_routes_init(&routes, &world)) {
+            fprintf(stderr, "Error: out of memory\n");
+            return 1;
+        }
+        world.routes = &routes;
+
+        // Fill every slot: each is one backwards search over the whole map
+        double start = now_ns();
+        for (int t = 0; t < ROUTE_CACHE_SLOTS; t++) {
+            world_route_next(&world, 0, n - 1 - t * (n / ROUTE_CACHE_SLOTS), NULL);
+        }
+        double build_ns = (now_ns() - start) / ROUTE_CACHE_SLOTS;
+
+        // Cached lookups: what each step of a goto costs
+        unsigned int seed = 12345;
+        volatile unsigned int sink = 0;
+        start = now_ns();
+        for (int i = 0; i < LOOKUPS; i++) {
+            seed = seed * 1103515245u + 12345u;
+            sink += (unsigned int)world_route_next(&world, (int)((seed >> 8) % (unsigned)n), n - 1, NULL);
+        }
+        double lookup_ns = (now_ns() - start) / LOOKUPS;
+
+        // Unlocks update all cached tables in place
+        start = now_ns();
+        for (int i = 0; i < UNLOCKS; i++) {
+            seed = seed * 1103515245u + 12345u;
+            world_unlock_exit(&world, (int)((seed >> 8) % (unsigned)n), (Direction)((seed >> 4) % 4));
+        }
+        double unlock_ns = (now_ns() - start) / UNLOCKS;
+
+        printf("  %-8d %12.1f %12.1f %14.2f %14.1f\n", n, build_ns / 1000.0, lookup_ns,
+               unlock_ns / 1000.0, build_ns * ROUTE_CACHE_SLOTS / 1000.0);
+        (void)sink;
+
+        world_routes_free(&routes);
+        world_free(&world);
+    }
+
+    printf("\n");
+    return 0;
+}
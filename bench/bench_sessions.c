@@ -0,0 +1,79 @@
+/*
+ * Benchmark: memory per game session
+ * Loads a world once and starts 100 sessions that share its definition,
+ * then compares the footprint against 100 independent loads.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "world_loader.h"
+
+#define SESSIONS 100
+#define DEFAULT_WORLD "worlds/crystal_caverns.world"
+
+int main(int argc, char *argv[]) {
+    const char *path = argc > 1 ? argv[1] : DEFAULT_WORLD;
+
+    World base;
+    LoadError error;
+    if (!world_load_from_file(&base, path, &error)) {
+        fprintf(stderr, "Error: %s\n", world_loader_get_error(&error));
+        world_free(&base);
+        return 1;
+    }
+
+    World *sessions = malloc(SESSIONS * sizeof(World));
+    if (!sessions) {
+        fprintf(stderr, "Error: out of memory\n");
+        world_free(&base);
+        return 1;
+    }
+
+    int started = 0;
+    for (; started < SESSIONS; started++) {
+        if (!world_clone(&sessions[started], &base)) break;
+
+        // Give every session different state to show it is not shared
+        World *session = &sessions[started];
+        world_move(session, (Direction)(started % DIR_COUNT));
+        world_get_room_description(session, world_current_room(session));
+    }
+    if (started < SESSIONS) {
+        fprintf(stderr, "Error: out of memory after %d sessions\n", started);
+    }
+
+    const WorldDef *def = base.def;
+    size_t def_bytes = world_def_memory(def);
+    size_t state_bytes = 0;
+    int shared = 0;
+    for (int i = 0; i < started; i++) {
+        state_bytes += world_state_memory(&sessions[i]);
+        if (sessions[i].def == def) shared++;
+    }
+    size_t per_session = started > 0 ? state_bytes / (size_t)started : 0;
+    size_t shared_total = def_bytes + state_bytes;
+    size_t independent_total = (size_t)started * (def_bytes + per_session);
+
+    printf("\n=== Session Memory Report ===\n\n");
+    printf("  World:              %s (%d rooms, %d items)\n",
+           path, def->room_count, def->item_count);
+    printf("  Definition:         %zu bytes (%u bytes of text)\n",
+           def_bytes, def->strings.size);
+    printf("  State per session:  %zu bytes\n", per_session);
+    printf("  Sessions sharing:   %d of %d\n\n", shared, started);
+    printf("  %-22s %12s %14s\n", "", "total KB", "per session B");
+    printf("  %-22s %12.1f %14zu\n", "independent loads",
+           (double)independent_total / 1024.0, def_bytes + per_session);
+    printf("  %-22s %12.1f %14zu\n", "shared definition",
+           (double)shared_total / 1024.0, started > 0 ? shared_total / (size_t)started : 0);
+    printf("\n");
+
+    for (int i = 0; i < started; i++) {
+        world_free(&sessions[i]);
+    }
+    free(sessions);
+    world_free(&base);
+    return started == SESSIONS ? 0 : 1;
+}
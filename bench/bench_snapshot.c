@@ -0,0 +1,115 @@
+/*
+ * Benchmark: copy-on-write snapshots
+ * Plays random turns on a generated world, snapshotting before each one,
+ * and compares the memory kept for the last N turns against full copies.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "world_snapshot.h"
+
+#define TURNS 1000
+#define KEEP 32
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Grid world with an item in every tenth room
+static bool build_world(World *world, int n) {
+    int width = 1;
+    while (width * width < n) width++;
+
+    world_init(world);
+    if (!world_reserve(world, n, n / 10, (size_t)n * 64)) return false;
+
+    char id[32];
+    for (int i = 0; i < n; i++) {
+        snprintf(id, sizeof(id), "room_%d", i);
+        if (world_add_room(world, id, "Room", "A generated room.") == -1) return false;
+    }
+    for (int i = 0; i < n; i++) {
+        int x = i % width;
+        if (i >= width) world_connect_rooms(world, i, DIR_NORTH, i - width);
+        if (i + width < n) world_connect_rooms(world, i, DIR_SOUTH, i + width);
+        if (x + 1 < width && i + 1 < n) world_connect_rooms(world, i, DIR_EAST, i + 1);
+        if (x > 0) world_connect_rooms(world, i, DIR_WEST, i - 1);
+    }
+    for (int i = 0; i < n; i += 10) {
+        snprintf(id, sizeof(id), "item_%d", i);
+        int item = world_add_item(world, id, "trinket", "A trinket.", true);
+        if (item == -1) return false;
+        world_place_item(world, item, i);
+    }
+    return true;
+}
+
+int main(void) {
+    static const int sizes[] = {1000, 10000, 100000};
+    const int size_count = (int)(sizeof(sizes) / sizeof(sizes[0]));
+
+    printf("\n=== Snapshot Benchmark (%d turns, last %d kept) ===\n\n", TURNS, KEEP);
+    printf("  %-8s %12s %14s %14s %12s\n",
+           "rooms", "state KB", "full copies KB", "snapshots KB", "us/snapshot");
+
+    for (int s = 0; s < size_count; s++) {
+        int n = sizes[s];
+        World world;
+        if (!build_world(&world, n)) {
+            fprintf(stderr, "Error: out of memory\n");
+            return 1;
+        }
+
+        WorldSnapshot *ring[KEEP] = {0};
+        unsigned int seed = 12345;
+        double snapshot_ns = 0;
+
+        for (int t = 0; t < TURNS; t++) {
+            double start = now_ns();
+            WorldSnapshot *snapshot = world_snapshot(&world);
+            snapshot_ns += now_ns() - start;
+            if (!snapshot) {
+                fprintf(stderr, "Error: out of memory\n");
+                return 1;
+            }
+            world_snapshot_free(ring[t % KEEP]);
+            ring[t % KEEP] = snapshot;
+
+            // A turn: move, then pick up or drop something now and then
+            seed = seed * 1103515245u + 12345u;
+            world_move(&world, (Direction)((seed >> 8) % 4));
+            int here = world_first_item(&world, world.current_room);
+            if (here != -1) {
+                world_set_item_location(&world, here, ITEM_IN_INVENTORY);
+            } else if ((seed >> 16) % 4 == 0 && world.inventory_first != -1) {
+                world_set_item_location(&world, world.inventory_first, world.current_room);
+            }
+            world_get_room_description(&world, world_current_room(&world));
+        }
+
+        // Memory kept (upper bound): every chunk of the oldest snapshot plus
+        // the chunks each later snapshot copied
+        WorldSnapshot *oldest = ring[TURNS % KEEP];
+        size_t kept = (size_t)oldest->chunk_count * STATE_CHUNK_BYTES;
+        for (int i = 0; i < KEEP; i++) {
+            if (ring[i] != oldest) kept += ring[i]->copied_bytes;
+        }
+        size_t state = world_state_memory(&world);
+
+        printf("  %-8d %12.1f %14.1f %14.1f %12.2f\n", n, state / 1024.0,
+               (double)state * KEEP / 1024.0, kept / 1024.0, snapshot_ns / TURNS / 1000.0);
+
+        for (int i = 0; i < KEEP; i++) {
+            world_snapshot_free(ring[i]);
+        }
+        world_free(&world);
+    }
+
+    printf("\n");
+    return 0;
+}
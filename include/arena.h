@@ -0,0 +1,40 @@
+/*
+ * Adventure Engine - Arena Allocator
+ * Bump allocator that frees everything it handed out in one call
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// One contiguous block of arena memory
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;  // Previously filled block
+    size_t size;              // Usable bytes in data
+    size_t used;              // Bytes handed out so far
+    _Alignas(16) unsigned char data[];  // Allocations (16-byte aligned)
+} ArenaBlock;
+
+// Arena (allocations are never moved or freed individually)
+typedef struct {
+    ArenaBlock *head;         // Block currently being filled
+    size_t block_size;        // Minimum size of new blocks
+    size_t total;             // Total bytes reserved from malloc
+} Arena;
+
+// Initialize arena (no allocation until first use)
+void arena_init(Arena *arena, size_t block_size);
+
+// Make sure the next `size` bytes of allocations fit in a single block
+// Returns false on allocation failure
+bool arena_reserve(Arena *arena, size_t size);
+
+// Allocate zeroed, 16-byte aligned memory (returns NULL on failure)
+void* arena_alloc(Arena *arena, size_t size);
+
+// Free every block owned by the arena
+void arena_free(Arena *arena);
+
+#endif // ARENA_H
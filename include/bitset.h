@@ -0,0 +1,61 @@
+/*
+ * Adventure Engine - Bitsets
+ * Dense bit arrays for per-room and per-item state flags
+ */
+
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Number of 64-bit words needed for n bits
+#define BITSET_WORDS(n) (((size_t)(n) + 63) / 64)
+
+static inline bool bitset_test(const uint64_t *bits, size_t i) {
+    return (bits[i / 64] >> (i % 64)) & 1u;
+}
+
+static inline void bitset_set(uint64_t *bits, size_t i) {
+    bits[i / 64] |= (uint64_t)1 << (i % 64);
+}
+
+static inline void bitset_clear(uint64_t *bits, size_t i) {
+    bits[i / 64] &= ~((uint64_t)1 << (i % 64));
+}
+
+// Set or clear bit i; returns true if the bit changed
+static inline bool bitset_assign(uint64_t *bits, size_t i, bool on) {
+    uint64_t mask = (uint64_t)1 << (i % 64);
+    uint64_t old = bits[i / 64];
+    uint64_t updated = on ? (old | mask) : (old & ~mask);
+    bits[i / 64] = updated;
+    return updated != old;
+}
+
+// Count set bits among the first n
+static inline size_t bitset_count(const uint64_t *bits, size_t n) {
+    size_t count = 0;
+    for (size_t w = 0; w < n / 64; w++) {
+        count += (size_t)__builtin_popcountll(bits[w]);
+    }
+    if (n % 64) {
+        uint64_t tail = bits[n / 64] & (((uint64_t)1 << (n % 64)) - 1);
+        count += (size_t)__builtin_popcountll(tail);
+    }
+    return count;
+}
+
+// Copy the first n bits of src into dst (bits of dst past n are kept)
+static inline void bitset_copy(uint64_t *dst, const uint64_t *src, size_t n) {
+    for (size_t w = 0; w < n / 64; w++) {
+        dst[w] = src[w];
+    }
+    if (n % 64) {
+        uint64_t mask = ((uint64_t)1 << (n % 64)) - 1;
+        dst[n / 64] = (dst[n / 64] & ~mask) | (src[n / 64] & mask);
+    }
+}
+
+#endif // BITSET_H
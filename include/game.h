@@ -0,0 +1,112 @@
+/*
+ * Adventure Engine - Game Commands
+ * Runs player commands against a world and reports through an output sink,
+ * independent of any terminal UI. Everything a game needs lives in its Game
+ * handle, so any number of games can run in one process.
+ */
+
+#ifndef GAME_H
+#define GAME_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include "world.h"
+#include "world_image.h"
+#include "world_journal.h"
+#include "world_loader.h"
+#include "world_reload.h"
+#include "world_route.h"
+
+// How a line of output should be presented
+typedef enum {
+    OUTPUT_NORMAL,
+    OUTPUT_COMMENT,    // System messages (exits, travel, undo)
+    OUTPUT_SPECIAL     // Highlights (room names, headings, item use)
+} OutputStyle;
+
+typedef struct Recorder Recorder;
+
+// Destination for command output, one line per call (without newline)
+typedef struct {
+    void (*write)(void *ctx, const char *text, OutputStyle style);
+    void *ctx;
+} OutputSink;
+
+// One game: a world session plus everything the command layer keeps for it
+// The world points at the game's journal and routes, so a started game must
+// not be copied or moved.
+typedef struct {
+    World world;              // Session being played (owned)
+    char world_name[64];      // For save/load; changes when a save is loaded
+    WorldJournal journal;     // Undo/redo history (set up by game_start)
+    WorldRoutes routes;       // Shortest paths for goto/travel (set up by game_start)
+    OutputSink output;        // Where command output goes (write == NULL discards it)
+    Recorder *recorder;       // Records every command when set (recording.h)
+    int turns;                // Turns played since game_start (undo/redo and quit don't count)
+    bool started;             // Journal and routes are set up
+} Game;
+
+// Initialize a game with an empty world (sink NULL = discard output)
+void game_init(Game *game, const OutputSink *sink);
+
+// Free the game's world, history and routes (game must be re-initialized
+// before reuse)
+void game_free(Game *game);
+
+// Send command output to a sink (NULL discards it)
+void game_set_output(Game *game, const OutputSink *sink);
+
+// Sink writing each line to a stdio stream
+OutputSink game_stream_sink(FILE *stream);
+
+// Load worlds/<world_name>.world into the game, replacing its world
+// (world_name must pass is_safe_filename). A compiled worlds/<world_name>.worldc
+// at least as new as the .world file is mapped instead (world_image.h), and
+// builds with EMBEDDED_WORLDS open a linked-in world of that name without
+// touching worlds/. On failure the game is left with an empty world and
+// error describes why.
+bool game_open(Game *game, const char *world_name, LoadError *error);
+
+// Load a .world file, or a compiled image if the path ends in .worldc, from
+// any path, replacing the game's world; world_name is what saves record.
+// .world files are opened through the compiled world cache (world_cache.h).
+// The path is not checked, so it must not come from a player.
+bool game_open_file(Game *game, const char *path, const char *world_name, LoadError *error);
+
+// Load worlds/<world_name>.world as the file is now into world, through the
+// compiled world cache, for hot reloading games of it (world_reload.h).
+// On failure error says why and world holds nothing to free.
+bool game_load_world(const char *world_name, World *world, LoadError *error);
+
+// Check whether worlds/<world_name>.world was changed since stamp was taken
+// (size or modification time differ), then update stamp to the file as it
+// is now. A zeroed stamp counts as changed; a file that can't be read does
+// not (stamp unchanged).
+bool game_world_changed(const char *world_name, WorldSourceStamp *stamp);
+
+// Hot reload: move the game onto diff->to's definition (world_reload) and
+// tell its recorder, so its recording can seek to turns on either side.
+// Returns false if the game's world could not be moved (game unchanged).
+bool game_reload(Game *game, const WorldDiff *diff);
+
+// Replace the game's world with a copy of source's state that shares its
+// definition, so many games of one world keep a single copy of its text
+// (source's definition is read-only from then on)
+bool game_open_shared(Game *game, World *source, const char *world_name);
+
+// Load the world a save slot was made in, then apply the save on top
+bool game_open_save(Game *game, const char *slot_name);
+
+// Start playing the loaded world: set up undo history and travel routes,
+// then describe the first room
+void game_start(Game *game);
+
+// Run one line of player input; returns false once the player quits
+bool game_command(Game *game, const char *input);
+
+// Headless play: start the game, then run every line of `in` as a command
+// until end of input or quit. Output goes to the game's sink without any
+// terminal setup. Returns the number of turns played.
+int game_run_batch(Game *game, FILE *in);
+
+#endif // GAME_H
@@ -0,0 +1,54 @@
+/*
+ * Adventure Engine - Game Farm
+ * Runs many independent games on a pool of worker threads
+ */
+
+#ifndef GAME_FARM_H
+#define GAME_FARM_H
+
+#include <stdbool.h>
+#include "game.h"
+#include "world_reload.h"
+
+#define FARM_MAX_WORKERS 256
+#define FARM_QUEUE_LINES 64      // Input lines a game can have waiting
+#define FARM_SLICE 16            // Commands a worker runs per game before moving on
+
+typedef struct GameFarm GameFarm;
+
+// Start a pool of worker threads with room for max_games games
+// (returns NULL on failure)
+GameFarm* game_farm_create(int workers, int max_games);
+
+// Stop the workers and free the farm; games still queued are dropped.
+// Games added to the farm stay owned by the caller.
+void game_farm_destroy(GameFarm *farm);
+
+// Hand a started game to the farm (returns its farm ID, -1 on failure).
+// The game is pinned to worker id % workers; other workers only run it
+// while its own worker is busy. The farm must be the only user of the game
+// until game_farm_destroy; its output sink is called from worker threads.
+int game_farm_add(GameFarm *farm, Game *game);
+
+// Queue one line of input for a game (false if its queue is full or the
+// player has quit)
+bool game_farm_submit(GameFarm *farm, int game_id, const char *line);
+
+// Move every game playing world_name onto a reloaded version of it (see
+// world_reload.h) without stopping the farm: each game is claimed the way a
+// worker claims it, so it moves between two commands. Games on the same
+// definition share one diff. Returns the number of games moved, or -1 on
+// allocation failure.
+int game_farm_reload(GameFarm *farm, const char *world_name, World *next);
+
+// Wait until every queued line has been run
+void game_farm_drain(GameFarm *farm);
+
+// Check whether a game's player has quit
+bool game_farm_finished(GameFarm *farm, int game_id);
+
+// Commands run so far, and how many of them ran on a worker other than
+// the game's own (stolen)
+void game_farm_stats(GameFarm *farm, long long *commands, long long *stolen);
+
+#endif // GAME_FARM_H
@@ -0,0 +1,41 @@
+/*
+ * Adventure Engine - ID Index
+ * Open-addressed hash index mapping string IDs to array slots
+ */
+
+#ifndef ID_INDEX_H
+#define ID_INDEX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Returns the ID string stored at a slot (used to confirm hash matches)
+typedef const char* (*IdIndexKeyFn)(const void *ctx, int slot);
+
+// Hash index (linear probing, power-of-two capacity, never above 50% full)
+// The index does not own the ID strings; it stores a slot number plus the
+// full hash so most mismatches are rejected without a string compare.
+typedef struct {
+    uint32_t *hashes;  // Full hash per bucket (0 = empty bucket)
+    int *slots;        // Slot number per bucket
+    int capacity;      // Number of buckets (0 = not allocated yet)
+    int count;         // Number of occupied buckets
+} IdIndex;
+
+// Initialize index (empty, no allocation until first insert)
+void id_index_init(IdIndex *index);
+
+// Free index storage
+void id_index_free(IdIndex *index);
+
+// Hash an ID string (FNV-1a, never returns 0)
+uint32_t id_hash(const char *id);
+
+// Insert slot under ID (caller ensures the ID is not already present)
+// Returns false on allocation failure
+bool id_index_insert(IdIndex *index, const char *id, int slot);
+
+// Find slot for ID (returns -1 if not found)
+int id_index_find(const IdIndex *index, const char *id, IdIndexKeyFn key_at, const void *ctx);
+
+#endif // ID_INDEX_H
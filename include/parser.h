@@ -7,6 +7,7 @@
 #define PARSER_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 // Command structure
 typedef struct {
@@ -15,7 +16,29 @@ typedef struct {
     bool valid;       // Was parse successful?
 } Command;
 
-// Parse input string into command structure
+// Slice of an input line (points into the line; not NUL-terminated)
+typedef struct {
+    const char *text;
+    size_t len;
+} Token;
+
+// One command of an input line, as slices of the line
+typedef struct {
+    Token verb;       // First word, as typed
+    Token noun;       // Everything after it, trimmed (len 0 if none)
+    Token text;       // The whole command, verb through noun
+} CommandView;
+
+// Split the next command off *line without copying, and advance *line past
+// it. Commands are separated by ',' or the word "then" ("take key, north
+// then look"); empty ones are skipped. Returns false when none is left.
+bool parse_next_command(const char **line, CommandView *cmd);
+
+// Copy a token into buffer as a lowercase string (truncated to fit)
+void token_copy(Token token, char *buffer, size_t size);
+
+// Parse the first command of an input string into a command structure
+// (lowercased copies of parse_next_command's verb and noun)
 Command parse_input(const char *input);
 
 // Check if command matches verb (case-insensitive)
@@ -0,0 +1,115 @@
+/*
+ * Adventure Engine - Session Recordings
+ * Append-only logs of a game's commands with periodic keyframes of its state,
+ * so a viewer can jump to any turn without replaying from turn 0
+ */
+
+#ifndef RECORDING_H
+#define RECORDING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "game.h"
+
+#define RECORDING_VERSION 2       // v2 stores the definitions a hot reload switched between
+#define RECORDING_KEYFRAME_INTERVAL 256   // Commands between periodic keyframes
+
+// A turn the recording holds the full state for
+typedef struct {
+    int32_t turn;             // Commands recorded before this state
+    int64_t offset;           // File offset of the record holding it
+} RecordingKeyframe;
+
+// A world definition stored in the recording, as a compiled image
+// (world_image.h). Seeking restores keyframes into the layout they were
+// taken in, so a hot reload writes the definition the game started on (the
+// first time only) and the one it moved to, then a keyframe.
+typedef struct {
+    int64_t offset;           // File offset of the record holding it
+    bool start;               // Played before the first reload (else from this record on)
+    WorldDef *def;            // Opened on first use (reader only)
+} RecordingWorld;
+
+// Writer, attached to one game through Game.recorder
+// File layout: header, then one record per command and keyframe (type
+// byte, varint length, payload). Commands are written as typed; undo, redo,
+// save and load carry the state they produced instead of being rerun. Every
+// interval commands a keyframe (save_state_encode) is added and the file is
+// flushed, so a crash loses at most one interval; in between, a command
+// costs one buffered write of a few bytes. recorder_close appends an index
+// of the keyframes and stored definitions and a fixed trailer pointing at it.
+struct Recorder {
+    FILE *file;
+    int interval;             // Commands between periodic keyframes
+    int turn;                 // Commands recorded
+    int since_keyframe;       // Commands since the last periodic keyframe
+    bool started;             // Header written (by the first game_start)
+    bool failed;              // A write failed; nothing more is recorded
+    RecordingKeyframe *keyframes; // Index written at close
+    int keyframe_count;
+    int keyframe_capacity;
+    RecordingWorld *worlds;   // Index of stored definitions, written at close
+    int world_count;
+    int world_capacity;
+    bool start_saved;         // Definition the game started on has been stored
+    unsigned char *buffer;    // Record being encoded (reused)
+    size_t buffer_size;
+};
+
+// Reader: seeks a game to any turn of a recording
+typedef struct {
+    FILE *file;
+    char world_name[64];      // World the session was played in
+    int turns;                // Commands in the recording
+    RecordingKeyframe *keyframes; // In turn order
+    int keyframe_count;
+    RecordingWorld *worlds;   // In file order (none unless the world was hot reloaded)
+    int world_count;
+    int64_t records_end;      // End of the records (index or end of file)
+    bool indexed;             // Index read from the trailer (else rebuilt by a scan)
+    unsigned char *buffer;    // Payload of the record being read
+    size_t buffer_size;
+    // Where the last seek left its game, so stepping forward continues
+    // from there instead of going back to a keyframe
+    const Game *at_game;
+    int at_turn;
+    int64_t at_offset;
+} Recording;
+
+// Create a recording file (interval <= 0 uses RECORDING_KEYFRAME_INTERVAL)
+// Attach it with game->recorder = recorder before game_start; the game
+// writes the header and first keyframe when it starts.
+bool recorder_open(Recorder *recorder, const char *path, int interval);
+
+// Write the keyframe index and close the file (false if any write failed)
+bool recorder_close(Recorder *recorder);
+
+// Called by the game layer: game_start, and each command of a line (its
+// len characters of text) with whether it can be rerun from the world alone
+void recorder_start(Recorder *recorder, const Game *game);
+void recorder_command(Recorder *recorder, const Game *game, const char *input, size_t len,
+                      bool replayable);
+
+// Called by the game layer around a hot reload (game_reload): before, while
+// the game is still on its old definition, and after, once it is on the new
+// one (a state at the same turn, like a restart)
+void recorder_reloading(Recorder *recorder, Game *game);
+void recorder_reloaded(Recorder *recorder, Game *game);
+
+// Open a recording for viewing; the index comes from the trailer, or from
+// a scan of the records if the session never closed its recording
+bool recording_open(Recording *recording, const char *path);
+
+void recording_close(Recording *recording);
+
+// Put a started game of the recording's world in its state after `turn`
+// commands: restore the nearest keyframe at or before it, then rerun the
+// commands after that through game_command (output goes to the game's sink,
+// so a viewer stepping one turn at a time sees each command's output).
+// If the world was hot reloaded while recording, the game is moved onto the
+// stored definition each turn was played on (world_switch_definition).
+// Returns false if the turn is out of range or the recording is damaged.
+bool recording_seek(Recording *recording, Game *game, int turn);
+
+#endif // RECORDING_H
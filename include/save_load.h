@@ -17,9 +17,33 @@ bool game_save(const World *world, const char *slot_name, const char *world_name
 
 // Load game state from file
 // slot_name: save slot identifier
+// The world must already hold the definition the save was made from; state
+// for rooms/items the world doesn't have is ignored.
 // Returns true on success
 bool game_load(World *world, const char *slot_name, char *world_name, size_t world_name_size);
 
+// Read the world name recorded in a save slot (without applying any state)
+// Returns true on success
+bool game_read_world_name(const char *slot_name, char *world_name, size_t world_name_size);
+
+// Binary form of the state a save holds: current room, item locations and
+// the flag bitsets, plus the order of every location's item list so the
+// state comes back exactly (world_state_hash matches). Integers are varints
+// and runs of zero bitset words are skipped, so a keyframe of a fresh game
+// is a few bytes per item. Used for recording keyframes (recording.h).
+
+// Largest encoding of the world's state, for sizing a buffer
+size_t save_state_max_size(const World *world);
+
+// Encode the world's state into buffer (at least save_state_max_size bytes)
+// Returns the bytes written.
+size_t save_state_encode(const World *world, unsigned char *buffer);
+
+// Apply encoded state to a world of the same definition (false if the data
+// is corrupt or from another layout; the world is then unchanged)
+// Undo history is cleared, as after loading a save.
+bool save_state_decode(World *world, const unsigned char *data, size_t size);
+
 // List available save slots
 // Returns number of saves found
 int game_list_saves(char saves[][64], int max_saves);
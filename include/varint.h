@@ -0,0 +1,47 @@
+/*
+ * Adventure Engine - Varints
+ * LEB128 integers for compact binary state (keyframes, recordings)
+ */
+
+#ifndef VARINT_H
+#define VARINT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define VARINT_MAX_BYTES 10      // Longest encoding of a 64-bit value
+
+// Append value, 7 bits per byte; returns the end of what was written
+static inline unsigned char* varint_put(unsigned char *out, uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = (unsigned char)value;
+    return out;
+}
+
+// Append a signed value, zigzag coded so small negatives stay short
+static inline unsigned char* varint_put_signed(unsigned char *out, int64_t value) {
+    return varint_put(out, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+// Read a value from *in (advanced past it); false if it runs past end
+static inline bool varint_get(const unsigned char **in, const unsigned char *end, uint64_t *value) {
+    *value = 0;
+    for (int shift = 0; shift < 64 && *in < end; shift += 7) {
+        unsigned char byte = *(*in)++;
+        *value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+static inline bool varint_get_signed(const unsigned char **in, const unsigned char *end, int64_t *value) {
+    uint64_t raw;
+    if (!varint_get(in, end, &raw)) return false;
+    *value = (int64_t)(raw >> 1) ^ -(int64_t)(raw & 1);
+    return true;
+}
+
+#endif // VARINT_H
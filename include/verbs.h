@@ -0,0 +1,93 @@
+/*
+ * Adventure Engine - Verb Table
+ * Maps command words (and each world's synonyms) to the action they run
+ */
+
+#ifndef VERBS_H
+#define VERBS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Actions a command's first word can select
+typedef enum {
+    VERB_NONE = -1,           // Not a verb (maybe a named exit)
+    VERB_HELP = 0,
+    VERB_LOOK,
+    VERB_GO,
+    VERB_NORTH,
+    VERB_SOUTH,
+    VERB_EAST,
+    VERB_WEST,
+    VERB_UP,
+    VERB_DOWN,
+    VERB_GOTO,
+    VERB_TAKE,
+    VERB_DROP,
+    VERB_INVENTORY,
+    VERB_EXAMINE,
+    VERB_USE,
+    VERB_SAVE,
+    VERB_LOAD,
+    VERB_SAVES,
+    VERB_UNDO,
+    VERB_REDO,
+    VERB_QUIT,
+    VERB_COUNT
+} Verb;
+
+// A word and the verb it selects (input to verb_table_build)
+typedef struct {
+    const char *word;
+    Verb verb;
+} VerbWord;
+
+// One slot of a verb table
+typedef struct {
+    uint64_t hash;            // Full hash of the word
+    uint32_t word;            // Offset of the word in VerbTable.text
+    int32_t verb;             // VERB_NONE = empty slot
+} VerbSlot;
+
+// Perfect hash of every built-in word plus a world's synonyms (hash and
+// displace): a word's hash picks a bucket, the bucket's displacement picks
+// its slot, and one string compare confirms it. Every word has a slot no
+// other word uses, so a lookup never probes. Built once per world
+// definition by verb_table_build.
+typedef struct {
+    uint32_t *displace;       // Per bucket
+    VerbSlot *slots;
+    char *text;               // The words, NUL-terminated
+    int bucket_count;         // Power of two (0 = not built)
+    int slot_count;           // Power of two
+    int count;                // Words in the table
+    size_t text_size;
+} VerbTable;
+
+// Initialize table (empty, lookups fall through to VERB_NONE)
+void verb_table_init(VerbTable *table);
+
+// Free table storage
+void verb_table_free(VerbTable *table);
+
+// Build the table from the built-in words plus extra (lowercase words;
+// an extra word replaces a built-in or earlier extra word of the same
+// spelling). Replaces any previous contents; returns false on allocation
+// failure, leaving the table empty.
+bool verb_table_build(VerbTable *table, const VerbWord *extra, int extra_count);
+
+// Find the verb for the len characters at word, in any case (VERB_NONE if
+// unknown); word need not be NUL-terminated
+Verb verb_table_find(const VerbTable *table, const char *word, size_t len);
+
+// Find the verb for a built-in word without a table (VERB_NONE if unknown)
+Verb verb_builtin(const char *word);
+
+// Canonical word for a verb ("take" for VERB_TAKE; NULL if invalid)
+const char* verb_name(Verb verb);
+
+// Heap bytes held by a table
+size_t verb_table_memory(const VerbTable *table);
+
+#endif // VERBS_H
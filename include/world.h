@@ -7,9 +7,14 @@
 #define WORLD_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "arena.h"
+#include "bitset.h"
+#include "id_index.h"
+#include "verbs.h"
 
-#define MAX_ITEMS 50
-#define MAX_ROOMS 50
 #define MAX_INVENTORY 20
 #define MAX_CONDITIONAL_DESCS 8  // Maximum conditional descriptions per room
 
@@ -33,41 +38,93 @@ typedef enum {
     COND_ITEM_USED       // Has item ever been used? (for conditional descriptions)
 } ConditionType;
 
+// Offset of a NUL-terminated string in the world's string pool (0 = "")
+// Use world_str() to get the text. Offsets stay valid when the pool grows.
+typedef uint32_t StrRef;
+
+// String pool holding all world text
+typedef struct {
+    char *data;
+    uint32_t size;            // Bytes used (offset 0 is always the empty string)
+    uint32_t capacity;        // Bytes allocated
+} StringPool;
+
 // Conditional description (multiple can apply to a room)
 typedef struct {
     ConditionType type;
-    char subject[32];      // Item ID for item-based conditions
-    bool negate;           // If true, condition is inverted (!has_item)
-    char description[512]; // Description to show when condition is met
+    StrRef subject;          // Item ID for item-based conditions (0 if none)
+    bool negate;             // If true, condition is inverted (!has_item)
+    StrRef description;      // Description to show when condition is met
+    // Compiled by world_compile_conditions()
+    int32_t item;            // Item index for subject (-1 if none or unknown)
+    uint8_t priority;        // Higher wins; room's list is sorted by this
 } ConditionalDesc;
 
 // Item definition
 typedef struct {
-    char id[32];           // Unique identifier (e.g., "key", "sword")
-    char name[64];         // Display name (e.g., "rusty key")
-    char description[256]; // Full description
-    bool takeable;         // Can be picked up?
-    bool visible;          // Is it visible/discovered?
+    StrRef id;               // Unique identifier (e.g., "key", "sword")
+    StrRef name;             // Display name (e.g., "rusty key")
+    StrRef description;      // Full description
+    bool takeable;           // Can be picked up?
+    bool visible;            // Is it visible/discovered?
     // Issue #8: Use command support
-    char use_message[256]; // Message shown when item is used (empty = not usable)
-    bool use_consumable;   // Is item consumed after use?
-    bool used;             // Has this item been used? (for conditional descriptions)
+    StrRef use_message;      // Message shown when item is used (0 = not usable)
+    bool use_consumable;     // Is item consumed after use?
 } Item;
 
-// Room definition
+// Item locations (ItemLocation.where holds a room index or one of these)
+#define ITEM_NOWHERE      -1  // Not in play (e.g. consumed)
+#define ITEM_IN_INVENTORY -2  // Carried by the player
+
+// Where an item is, plus its links in that location's item list
+// Each room and the inventory keep a circular doubly linked list threaded
+// through World.item_location, so moving an item is O(1) and listing a
+// location is O(items there).
 typedef struct {
-    char id[32];              // Unique identifier
-    char name[64];            // Short name
-    char description[512];    // Full description
-    int exits[DIR_COUNT];     // Room IDs for each direction (-1 = no exit)
-    int items[MAX_ITEMS];     // Item IDs in this room (-1 = empty slot)
-    bool visited;             // Has player been here?
-    bool description_shown;   // Has room description been displayed? (for first_visit condition)
-    char locked_exits[DIR_COUNT][32];  // Item ID required to unlock each direction (empty = unlocked)
-    bool exit_unlocked[DIR_COUNT];     // Runtime state: has this exit been unlocked?
+    int32_t where;            // Room index, ITEM_IN_INVENTORY or ITEM_NOWHERE
+    int32_t next;             // Next item in the same location
+    int32_t prev;             // Previous item in the same location
+} ItemLocation;
+
+#define DIR_NONE DIR_COUNT  // Exit.dir of exits that aren't compass directions
+
+// Exit from one room to another (WorldDef.exits)
+// Exits are stored grouped by room in compressed sparse row form: room r's
+// exits are exits[exit_start[r]] up to exits[exit_start[r + 1]], so memory
+// follows the real number of exits and movement, exit listings and path
+// searches read each room's exits as one contiguous run.
+typedef struct {
+    int32_t to;               // Destination room index
+    StrRef name;              // "north", "in", "through the mirror"
+    StrRef key;               // Item ID required to unlock (0 = not locked)
+    int32_t key_item;         // Compiled: key's item index (-1 if none or unknown)
+    uint8_t dir;              // Direction for compass names, DIR_NONE otherwise
+} Exit;
+
+// Exit to add with world_add_exits
+typedef struct {
+    int32_t from;             // Room the exit leaves from
+    StrRef name;              // Exit name, already in the world's pool
+    int32_t to;               // Destination room index
+} ExitSpec;
+
+// World-specific word for a verb (from a .world file's [VERBS] section)
+typedef struct {
+    StrRef word;              // Lowercase, one word
+    int32_t verb;             // Verb it selects
+} VerbSynonym;
+
+// Cold room data: text and rarely-touched references
+typedef struct {
+    StrRef id;                // Unique identifier
+    StrRef name;              // Short name
+    StrRef description;       // Full description
     // Issue #6: Conditional descriptions
-    ConditionalDesc conditional_descs[MAX_CONDITIONAL_DESCS];
+    int32_t conditional_desc_start; // First in WorldDef.conditional_descs (-1 until first use)
     int conditional_desc_count;
+    // Set by world_compile_conditions() to drive each session's description cache
+    bool description_fixed;   // Conditions can never change outcome: cached entry is never dropped
+    bool depends_on_visits;   // Has first_visit/visited conditions: dropped when visited flags flip
 } Room;
 
 // Movement result codes (all non-negative for consistency)
@@ -77,42 +134,270 @@ typedef enum {
     MOVE_LOCKED = 2
 } MoveResult;
 
-// World state
+// World definition: everything a .world file describes
+// Rooms, exits and items live in the arena and text in the string pool; both grow
+// on demand while the world is being built. Once a second session shares
+// the definition (world_clone) it is read-only, and the last session to
+// release it frees everything at once. A definition opened from a compiled
+// image is read-only from the start: its arrays point into the mapping.
 typedef struct {
-    Room rooms[MAX_ROOMS];
-    Item items[MAX_ITEMS];
-    int inventory[MAX_INVENTORY]; // Item IDs in inventory (-1 = empty slot)
+    Room *rooms;
+    int32_t *exit_start;      // Per room: first of its exits (room_count + 1 entries)
+    Exit *exits;              // All exits, grouped by room
+    Item *items;
+    ConditionalDesc *conditional_descs; // Per room with any: MAX_CONDITIONAL_DESCS slots
     int room_count;
+    int exit_count;
     int item_count;
+    int room_capacity;        // Allocated room slots
+    int exit_capacity;        // Allocated exit slots
+    int item_capacity;        // Allocated item slots
+    int conditional_desc_used;     // conditional_descs slots handed to rooms
+    int conditional_desc_capacity; // Allocated conditional_descs slots
+    bool conditions_dirty;    // Conditions and exit keys need (re)compiling before use
+    int *item_dep_start;      // Per item: start of its rooms in item_dep_rooms (item_count + 1)
+    int *item_dep_rooms;      // Rooms whose conditions reference each item
+    int32_t *key_exit_start;  // Per item: start of its exits in key_exits (item_count + 1)
+    int32_t *key_exits;       // Exits each item unlocks, grouped by item
+    VerbSynonym *verb_synonyms; // In definition order (later ones win)
+    int verb_synonym_count;
+    int verb_synonym_capacity;
+    VerbTable verbs;          // Compiled: built-in words plus synonyms
+    Arena arena;              // Owns rooms, exits, items, and per-room arrays
+    StringPool strings;       // All world text
+    IdIndex room_index;       // Room ID -> room index (kept in sync by world_add_room)
+    IdIndex item_index;       // Item ID -> item index (kept in sync by world_add_item)
+    const void *image;        // Image or linked-in tables every array points into (world_image.h)
+    size_t image_size;        // Bytes mapped (0 = tables linked into the program)
+    atomic_int refcount;      // Sessions sharing this definition
+} WorldDef;
+
+// Per-session state arrays captured by snapshots (see world_snapshot.h)
+typedef enum {
+    STATE_ITEM_LOCATION,
+    STATE_ROOM_FIRST_ITEM,
+    STATE_VISITED,
+    STATE_DESCRIPTION_SHOWN,
+    STATE_EXIT_UNLOCKED,
+    STATE_ITEM_USED,
+    STATE_REGION_COUNT
+} StateRegion;
+
+#define STATE_CHUNK_BYTES 256    // Copy-on-write granularity of snapshots
+
+typedef struct StateChunk StateChunk;
+typedef struct WorldJournal WorldJournal;
+typedef struct WorldRoutes WorldRoutes;
+
+// World: one game session over a shared definition
+// Only positions, flags and the description cache are per session, so a
+// session costs a few bytes per room and item on top of the shared WorldDef.
+typedef struct {
+    WorldDef *def;            // Shared definition (see world_clone)
     int current_room;         // Current room ID
+    ItemLocation *item_location; // Authoritative item placement (same index as items)
+    int32_t *room_first_item; // Per room: head of its item list (-1 = empty)
+    int inventory_first;      // Head of the inventory item list (-1 = empty)
+    int inventory_count;      // Items carried (at most MAX_INVENTORY)
+    // Dynamic flags packed into bitsets (see bitset.h), sized with capacity
+    uint64_t *visited;           // Bit per room: has player been here?
+    uint64_t *description_shown; // Bit per room: description displayed (first_visit)
+    uint64_t *exit_unlocked;     // Bit per exit (same index as WorldDef.exits)
+    uint64_t *item_used;         // Bit per item: has it been used?
+    // Description cache, invalidated through WorldDef.item_dep_* and room state
+    uint64_t *description_cached; // Bit per room: cached_description is current
+    StrRef *cached_description;   // Per room
+    int room_capacity;        // Room slots allocated in the arrays above
+    int exit_capacity;        // Exit slots allocated in the arrays above
+    int item_capacity;        // Item slots allocated in the arrays above
+    // Copy-on-write tracking, set up by the first world_snapshot()
+    StateChunk **snapshot_base;  // Chunks of the last snapshot taken or restored
+    uint64_t *dirty_chunks;      // Bit per chunk: written since snapshot_base
+    int chunk_start[STATE_REGION_COUNT + 1]; // First chunk of each region
+    WorldJournal *journal;       // Records every state change when set (world_journal.h)
+    WorldRoutes *routes;         // Travel paths kept up to date when set (world_route.h)
 } World;
 
-// Initialize world (empty)
+// Initialize world (empty, with a new definition of its own)
 void world_init(World *world);
 
+// Free the session state and release its definition (world must be
+// re-initialized before reuse)
+void world_free(World *world);
+
+// Start a new session sharing source's definition, with a copy of its
+// current state (returns false on allocation failure)
+// Conditions are compiled first; the definition is read-only from then on.
+bool world_clone(World *session, World *source);
+
+// Start a new session of def with nothing placed or visited
+// (returns false on allocation failure)
+bool world_init_session(World *session, WorldDef *def);
+
+// Reference counting for sharing a definition outside of a session
+WorldDef* world_def_retain(WorldDef *def);
+void world_def_release(WorldDef *def);
+
+// Check whether a definition can still be modified (not shared, not an image)
+bool world_def_writable(const WorldDef *def);
+
+// Heap bytes held by a definition and by one session's state
+size_t world_def_memory(const WorldDef *def);
+size_t world_state_memory(const World *world);
+
+// Building: world_reserve, world_add_*, world_set_item_use,
+// world_connect_rooms, world_set_exit_key and world_lock_exit fail (or do nothing) once the
+// definition is shared with another session.
+
+// Pre-size world storage (e.g. from counts found in a .world file)
+// Returns false on allocation failure
+bool world_reserve(World *world, int rooms, int items, size_t text_bytes);
+
 // Add room to world (returns room ID)
 int world_add_room(World *world, const char *id, const char *name, const char *desc);
 
 // Add item to world (returns item ID)
 int world_add_item(World *world, const char *id, const char *name, const char *desc, bool takeable);
 
+// Set use command properties on an item (empty/NULL message = not usable)
+void world_set_item_use(World *world, int item_id, const char *use_message, bool consumable);
+
+// Item used state (drives item_used conditions)
+bool world_item_used(const World *world, int item_id);
+void world_set_item_used(World *world, int item_id, bool used);
+
+// Add a conditional description to a room (returns false if room is full)
+bool world_add_conditional_desc(World *world, int room_id, ConditionType type,
+                                const char *subject, bool negate, const char *desc);
+
+// A room's conditional descriptions (conditional_desc_count of them; sorted
+// by priority once compiled)
+ConditionalDesc* world_room_conditions(const WorldDef *def, const Room *room);
+
 // Place item in room
 void world_place_item(World *world, int item_id, int room_id);
 
-// Connect rooms with exit
+// Move item to a room index, ITEM_IN_INVENTORY or ITEM_NOWHERE
+// Returns false if the location is invalid or the inventory is full
+bool world_set_item_location(World *world, int item_id, int location);
+
+// Get item location (room index, ITEM_IN_INVENTORY or ITEM_NOWHERE)
+int world_item_location(const World *world, int item_id);
+
+// Iterate the items in a room or the inventory:
+//   for (int i = world_first_item(w, loc); i != -1; i = world_next_item(w, i))
+int world_first_item(const World *world, int location);
+int world_next_item(const World *world, int item_id);
+
+// Add a named exit ("north", "in", "through the mirror") from one room to
+// another, replacing any exit of the same name (returns exit index, -1 on
+// failure). Exits added to the last room are appended; earlier rooms'
+// exits are inserted in place.
+int world_add_exit(World *world, int from_room, const char *name, int to_room);
+
+// Add many exits as if by world_add_exit in order, but with one pass over
+// the exit list instead of one per exit (loaders use it, so a file of n
+// rooms loads in O(n) rather than O(n^2)). Entries with an invalid room or
+// empty name are skipped; returns false on allocation failure.
+bool world_add_exits(World *world, const ExitSpec *exits, int count);
+
+// Connect rooms with a compass exit
 void world_connect_rooms(World *world, int from_room, Direction dir, int to_room);
 
+// Require a key item to pass an exit (NULL or "" removes the lock)
+void world_set_exit_key(World *world, int exit_id, const char *key_item_id);
+
+// Iterate a room's exits:
+//   for (int e = world_exits_begin(w, r); e < world_exits_end(w, r); e++)
+int world_exits_begin(const World *world, int room_id);
+int world_exits_end(const World *world, int room_id);
+
+// Get exit by index (NULL if invalid)
+const Exit* world_exit(const World *world, int exit_id);
+
+// Find a room's exit by name, or by direction for aliases like "n"
+// (case-insensitive; returns exit index, -1 if none)
+int world_find_exit(const World *world, int room_id, const char *name);
+
+// Find a room's exit in a compass direction (returns exit index, -1 if none)
+int world_direction_exit(const World *world, int room_id, Direction dir);
+
+// Check whether the player can pass an exit now (not locked, or unlocked)
+bool world_exit_open(const World *world, int exit_id);
+
+// Unlock or re-lock an exit for this session
+void world_set_exit_unlocked(World *world, int exit_id, bool unlocked);
+
 // Find room by ID (returns index, -1 if not found)
 int world_find_room(World *world, const char *id);
 
 // Find item by ID (returns index, -1 if not found)
 int world_find_item(World *world, const char *id);
 
+// Get text for a string pool offset (valid until more text is added)
+const char* world_str(const World *world, StrRef ref);
+
+// Copy len bytes of text (not NUL-terminated) into the pool as one string
+// (0 for empty text or on failure). world_add_* given the world_str of such
+// a ref share it instead of copying the text again.
+StrRef world_add_text(World *world, const char *text, size_t len);
+
 // Get current room
 Room* world_current_room(World *world);
 
+// Get destination of an exit (-1 if none or invalid)
+int world_room_exit(const World *world, int room_id, Direction dir);
+
+// Room visit state
+bool world_room_visited(const World *world, int room_id);
+void world_set_room_visited(World *world, int room_id, bool visited);
+
+// Room description-shown state (drives first_visit descriptions)
+bool world_room_description_shown(const World *world, int room_id);
+void world_set_room_description_shown(World *world, int room_id, bool shown);
+
+// Get key item ID required for an exit (NULL if exit is not locked)
+const char* world_exit_key(const World *world, int room_id, Direction dir);
+
+// Check whether a locked exit has been unlocked
+bool world_exit_unlocked(const World *world, int room_id, Direction dir);
+
+// Resolve condition subjects and exit keys to item indices, sort each room's
+// conditions by priority, index exits by key and build the verb table (run
+// by the loader; evaluation, movement and verb lookups also run it on demand
+// after rooms, exits, items, conditions or verb synonyms are added)
+void world_compile_conditions(World *world);
+
+// Add a world-specific synonym for a verb, named by any of its built-in
+// words (e.g. "grab" for "take"); replaces an earlier synonym or built-in
+// meaning of the word. Returns false if the verb is unknown, the word is
+// empty or has spaces, or the definition is shared.
+bool world_add_verb(World *world, const char *word, const char *verb);
+
+// Find the verb a command word selects: the len characters at word, in
+// any case (VERB_NONE if none)
+Verb world_find_verb(World *world, const char *word, size_t len);
+
+// Exits an item unlocks, in exit order: sets *exits to their indices and
+// returns how many there are
+int world_key_exits(World *world, int item_id, const int32_t **exits);
+
+// Unlock the still-locked exits of a room that an item is the key for
+// (room_id -1 = every room); returns how many were unlocked
+int world_unlock_with_key(World *world, int item_id, int room_id);
+
+// Drop cached room descriptions (rooms whose description is fixed keep theirs)
+void world_invalidate_descriptions(World *world);
+
+// Call after writing state arrays directly (e.g. loading a save): drops
+// cached descriptions, makes the next snapshot copy all state and clears
+// the journal
+void world_state_changed(World *world);
+
 // Get room description (evaluates conditional descriptions)
-// Returns the most specific matching description, or default if none match
+// Returns the most specific matching description, or default if none match.
+// Results are cached per room until an item the room's conditions reference
+// moves or is used, or the room's visited/description-shown state changes.
 const char* world_get_room_description(World *world, Room *room);
 
 // Move to room in direction (returns true if successful)
@@ -121,6 +406,9 @@ bool world_move(World *world, Direction dir);
 // Move with extended result (returns MoveResult, fills key_needed if locked)
 MoveResult world_move_ex(World *world, Direction dir, char *key_needed, size_t key_size);
 
+// Move through an exit of the current room (as world_move_ex)
+MoveResult world_move_exit(World *world, int exit_id, char *key_needed, size_t key_size);
+
 // Check if exit in direction is locked
 bool world_exit_is_locked(World *world, Direction dir);
 
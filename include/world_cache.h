@@ -0,0 +1,45 @@
+/*
+ * Adventure Engine - Compiled World Cache
+ * Compiled images (world_image.h) of the .world files a process opens,
+ * kept in a cache directory so unchanged worlds are never parsed twice
+ */
+
+#ifndef WORLD_CACHE_H
+#define WORLD_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "world_image.h"
+
+// Environment variable naming the cache directory (empty = no cache)
+#define WORLD_CACHE_ENV "ADVENTURE_WORLD_CACHE"
+
+// How world_cache_load got its world
+typedef enum {
+    WORLD_CACHE_HIT,          // Image's source stamp matched: no parsing
+    WORLD_CACHE_REVALIDATED,  // File touched but its content hash matched: no parsing
+    WORLD_CACHE_MISS,         // Parsed, and the image written for next time
+    WORLD_CACHE_UNCACHED      // Parsed, but no image could be written
+} WorldCacheResult;
+
+// The cache directory: $ADVENTURE_WORLD_CACHE, else
+// $XDG_CACHE_HOME/adventure-engine, else $HOME/.cache/adventure-engine
+// Returns false if there is none (caching off).
+bool world_cache_dir(char *buffer, size_t size);
+
+// Path of the cached image for a .world file: its name plus a hash of its
+// real path, so files with the same name in different places don't collide
+void world_cache_path(const char *cache_dir, const char *source_path, char *buffer, size_t size);
+
+// Load a .world file through the cache in cache_dir (NULL = parse only)
+// A cached image is used when its recorded size and mtime match the file,
+// or when only the mtime changed but the content hash still matches (the
+// image is then restamped). Otherwise the file is parsed and its image
+// written under a temporary name and renamed into place, so concurrent
+// processes never see half an image. Cache problems never fail the load;
+// result (may be NULL) says which path was taken. Returns false if the
+// world does not load, with the reason in error.
+bool world_cache_load(World *world, const char *source_path, const char *cache_dir,
+                      LoadError *error, WorldCacheResult *result);
+
+#endif // WORLD_CACHE_H
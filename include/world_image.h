@@ -0,0 +1,136 @@
+/*
+ * Adventure Engine - Compiled World Images
+ * A world's definition written out as one binary file (.worldc) that the
+ * engine maps and uses in place, with no parsing, or as C tables linked
+ * into the program (world-embed)
+ */
+
+#ifndef WORLD_IMAGE_H
+#define WORLD_IMAGE_H
+
+#include <stdbool.h>
+#include "world.h"
+#include "world_loader.h"
+
+#define WORLD_IMAGE_VERSION 2  // v2 records the source file's stamp
+#define WORLD_IMAGE_EXTENSION ".worldc"
+
+// File layout: a fixed header (magic, version, the platform's struct sizes
+// and byte order, counts, the source file's stamp, and the offset and size
+// of each section), then
+// the sections, each 64-byte aligned: rooms, exit rows and exits, items,
+// conditional descriptions, the compiled item/key/verb indices, the room
+// and item ID hash indices, each item's starting location, and the string
+// pool. Every reference is an index or pool offset, so the definition's
+// arrays point straight into the mapping and processes opening the same
+// image share its pages. Images are build outputs for one platform: an
+// image from another version or platform is rejected, not converted.
+
+// A compiled world's definition as flat read-only tables: the sections of
+// a mapped image, or static const arrays generated by world-embed and
+// linked into the program. Counts give each array's length; the index
+// start arrays have one more entry than their rooms or items.
+typedef struct {
+    const char *name;              // World name as game_open takes it (linked-in worlds)
+    const Room *rooms;
+    const int32_t *exit_start;
+    const Exit *exits;
+    const Item *items;
+    const ConditionalDesc *conditions; // Each room's packed into one run
+    int room_count;
+    int exit_count;
+    int item_count;
+    int condition_count;
+    const int *item_dep_start;
+    const int *item_dep_rooms;
+    const int32_t *key_exit_start;
+    const int32_t *key_exits;
+    const VerbSynonym *verb_synonyms;
+    int verb_synonym_count;
+    const uint32_t *verb_displace;
+    const VerbSlot *verb_slots;
+    const char *verb_text;
+    size_t verb_text_size;
+    int verb_bucket_count;
+    int verb_slot_count;
+    int verb_count;
+    const uint32_t *room_hashes;
+    const int *room_slots;
+    int room_index_capacity;
+    int room_index_count;
+    const uint32_t *item_hashes;
+    const int *item_slots;
+    int item_index_capacity;
+    int item_index_count;
+    const char *strings;
+    uint32_t strings_size;
+    const int32_t *item_start;     // Each item's starting location
+    int start_room;                // Room the player starts in
+} WorldTables;
+
+// Worlds linked into the program, NULL-terminated (defined by the source
+// world-embed generates; only builds with EMBEDDED_WORLDS have it)
+extern const WorldTables *const embedded_worlds[];
+
+// Flatten world's definition into tables (conditions are compiled first),
+// with its current room and item locations as the starting state
+// The tables point into world's definition, which must outlive them, plus
+// a few packed arrays freed by world_tables_free. Returns false on
+// failure, with the reason in error.
+bool world_tables_build(World *world, WorldTables *tables, LoadError *error);
+void world_tables_free(WorldTables *tables);
+
+// Open tables as a new session of their world, without copying them
+// The tables must outlive every session (e.g. static const data); the
+// definition is read-only. Returns false if out of memory.
+bool world_tables_open(World *world, const WorldTables *tables, LoadError *error);
+
+// The .world file an image was compiled from, as it was then
+typedef struct {
+    uint64_t hash;            // FNV-1a of the file's bytes (0 = not hashed)
+    uint64_t size;            // Bytes
+    int64_t mtime_sec;        // Modification time
+    int64_t mtime_nsec;
+} WorldSourceStamp;
+
+// Stamp the file at path; hash_content false only stats it (hash 0)
+// Returns false if the file cannot be read.
+bool world_source_stamp(const char *path, bool hash_content, WorldSourceStamp *stamp);
+
+// Encode world's definition as an image in memory, laid out as
+// world_image_write writes it (conditions are compiled first). Returns the
+// image (free it) with its size in image_size, or NULL on failure with the
+// reason in error.
+void* world_image_encode(World *world, const WorldSourceStamp *source, size_t *image_size,
+                         LoadError *error);
+
+// Write world's definition to path (conditions are compiled first), with
+// its current room and item locations as the starting state and source
+// (NULL if unknown) as the file it came from
+// The file is written under a temporary name and renamed into place, so
+// processes that have the old image mapped keep a consistent copy.
+// Returns false on failure, with the reason in error.
+bool world_image_write(World *world, const char *path, const WorldSourceStamp *source,
+                       LoadError *error);
+
+// Read the source stamp from an image's header, without opening the world
+// Returns false if path is not an image of this version and platform.
+bool world_image_source(const char *path, WorldSourceStamp *source);
+
+// Open an image as a new session of its world (one mmap, no parsing)
+// The definition is read-only and shared by every clone of the session.
+// Returns false if the file is not an image of this version and platform
+// or is damaged, with the reason in error; world is then empty (free it
+// with world_free either way).
+bool world_image_load(World *world, const char *path, LoadError *error);
+
+// Open an image held in memory (e.g. one stored in a recording) as a new
+// session of its world; the image is copied, so the caller keeps its
+// buffer. Fails like world_image_load.
+bool world_image_open(World *world, const void *image, size_t size, LoadError *error);
+
+// Whether an image exists and is at least as new as its source file
+// (also true when the source is missing)
+bool world_image_current(const char *image_path, const char *source_path);
+
+#endif // WORLD_IMAGE_H
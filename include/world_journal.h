@@ -0,0 +1,70 @@
+/*
+ * Adventure Engine - World Journal
+ * Bounded per-game log of state changes for turn-by-turn undo and redo
+ */
+
+#ifndef WORLD_JOURNAL_H
+#define WORLD_JOURNAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "world.h"
+
+#define JOURNAL_DEFAULT_CAPACITY 4096  // Records kept by main.c (about 80 KB)
+
+typedef enum {
+    JOURNAL_TURN,          // Start of a turn
+    JOURNAL_ITEM_MOVE,     // Item changed location
+    JOURNAL_ROOM,          // Player changed room
+    JOURNAL_FLAG           // State bit flipped (visited, shown, unlocked, used)
+} JournalType;
+
+// One change, with enough of the old state to reverse it exactly
+typedef struct {
+    uint8_t type;          // JournalType
+    uint8_t region;        // JOURNAL_FLAG: StateRegion holding the bit
+    uint8_t was_head;      // JOURNAL_ITEM_MOVE: item headed its old location's list
+    int32_t index;         // Item index or bit index
+    int32_t before;        // Old location, room or bit value
+    int32_t after;         // New location, room or bit value
+    int32_t before_next;   // JOURNAL_ITEM_MOVE: old successor in its list (-1 if alone)
+} JournalRecord;
+
+// Ring buffer of records (allocated once, oldest turns dropped when full)
+// Positions count records ever written; a record lives at pos % capacity.
+struct WorldJournal {
+    JournalRecord *records;
+    int capacity;
+    uint64_t first;        // Oldest record kept (always a turn marker)
+    uint64_t cursor;       // End of the applied records; undo walks back from here
+    uint64_t last;         // End of redoable records
+    bool turn_pending;     // Next record starts a new turn
+    bool overflowed;       // Current turn outgrew the buffer and cannot be undone
+    bool replaying;        // Applying records (don't record the changes again)
+};
+
+// Allocate a journal holding up to capacity records (returns false on failure)
+bool world_journal_init(WorldJournal *journal, int capacity);
+
+// Free journal storage
+void world_journal_free(WorldJournal *journal);
+
+// Forget all recorded turns (keeps the storage)
+void world_journal_clear(WorldJournal *journal);
+
+// Mark the start of a turn; changes until the next call undo together
+void world_journal_begin_turn(WorldJournal *journal);
+
+// Undo the last recorded turn of the world's journal (false if none)
+bool world_journal_undo(World *world);
+
+// Redo the last undone turn (false if none, or if a new turn was recorded)
+bool world_journal_redo(World *world);
+
+// Append a record (called by world.c for every state change)
+void world_journal_record(WorldJournal *journal, const JournalRecord *record);
+
+// Apply a record forwards or backwards (implemented in world.c)
+void world_journal_apply(World *world, const JournalRecord *record, bool undo);
+
+#endif // WORLD_JOURNAL_H
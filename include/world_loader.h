@@ -21,7 +21,7 @@ typedef struct {
 // If error, details are in the error parameter
 bool world_load_from_file(World *world, const char *filename, LoadError *error);
 
-// Get user-friendly error message
+// Get user-friendly error message (valid until the calling thread's next call)
 const char* world_loader_get_error(const LoadError *error);
 
 #endif // WORLD_LOADER_H
@@ -0,0 +1,61 @@
+/*
+ * Adventure Engine - World Hot Reload
+ * Moves running sessions onto a new version of their world's definition,
+ * keeping each player's position, inventory and flags
+ */
+
+#ifndef WORLD_RELOAD_H
+#define WORLD_RELOAD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "world.h"
+
+// Differences between a loaded definition and a new version of its file
+// Definitions are shared and read-only (often mapped from an image), so a
+// reload never edits one: the file is loaded again as a new definition,
+// matched to the old one by room and item ID and exit name, and every
+// session is moved across. When no room, item or exit was added, removed
+// or reordered (a typo fix, a new description, a moved exit) the session's
+// state arrays stay where they are; only the changed rooms' cached
+// descriptions are dropped, and undo history survives.
+typedef struct {
+    const WorldDef *from;     // Definition the sessions are on now
+    World *to;                // New version, as loaded (owned by the caller)
+    int32_t *room_map;        // Per old room: its index in the new version (-1 = removed)
+    int32_t *exit_map;        // Per old exit: its index in the new version (-1 = removed)
+    int32_t *item_map;        // Per old item: its index in the new version (-1 = removed)
+    int32_t *item_source;     // Per new item: its old index (-1 = new to the file)
+    uint64_t *room_changed;   // Bit per new room: new, or its text, conditions or exits differ
+    int rooms_changed;        // Rooms with room_changed set
+    int rooms_removed;
+    int items_changed;        // Items added, removed or with different text or flags
+    int exits_changed;        // Exits added, removed, or with a new destination or key
+    bool same_layout;         // Same rooms, exits and items at the same indices
+} WorldDiff;
+
+// Compare a session's definition with a newly loaded version of its file
+// (conditions are compiled first, so the new definition can be shared).
+// Returns false on allocation failure.
+bool world_diff_build(WorldDiff *diff, const World *current, World *next);
+
+// Free a diff's tables (the worlds it compared are left alone)
+void world_diff_free(WorldDiff *diff);
+
+// Move a session onto diff->to's definition
+// The player stays in their room, carried items stay carried, and visited,
+// unlocked and used flags carry over by ID. A player whose room was removed
+// goes to the new start room; items that are new, or whose room was
+// removed, start where the file places them. Undo history and travel
+// routes are cleared only if the layout changed. Returns false if the
+// session is not on diff->from or on allocation failure (session unchanged).
+bool world_reload(World *world, const WorldDiff *diff);
+
+// Move a session onto another definition with nothing placed or visited,
+// for a caller about to restore a state saved on that definition
+// (save_state_decode). Undo history and
+// travel routes are cleared. Returns false on allocation failure (session
+// unchanged).
+bool world_switch_definition(World *world, WorldDef *def);
+
+#endif // WORLD_RELOAD_H
@@ -0,0 +1,60 @@
+/*
+ * Adventure Engine - World Routes
+ * Shortest paths over open exits for "goto <room>" travel
+ */
+
+#ifndef WORLD_ROUTE_H
+#define WORLD_ROUTE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "world.h"
+
+#define ROUTE_CACHE_SLOTS 8          // Destinations whose next-hop tables are kept
+#define ROUTE_UNREACHABLE INT32_MAX  // Distance of rooms with no open path
+
+// Next-hop table towards one destination
+// Built by a breadth-first search backwards from the destination, so every
+// room learns the exit of its first step and its distance in moves.
+typedef struct {
+    int target;               // Destination room (-1 = slot unused)
+    uint32_t last_used;       // For evicting the least recently used slot
+    int32_t *distance;        // Per room: moves to target (ROUTE_UNREACHABLE if none)
+    int32_t *next_exit;       // Per room: exit to take first
+} RouteTable;
+
+// Per-session route cache
+// Reverse adjacency (CSR: the exits leading into each room) is built once
+// from the definition. Opening an exit updates the cached tables in place;
+// closing one (undo, loading a save) or editing the map drops them.
+struct WorldRoutes {
+    int room_count;           // Layout the tables were built for (-1 = rebuild)
+    int exit_count;
+    int32_t *in_start;        // Per room: start of its entries in in_from (room_count + 1)
+    int32_t *in_from;         // Room each incoming exit leaves from
+    int32_t *in_exit;         // Index of each incoming exit
+    int32_t *queue;           // Search queue (room_count entries)
+    RouteTable tables[ROUTE_CACHE_SLOTS];
+    uint32_t clock;
+};
+
+// Build the reverse adjacency for the world's current layout
+// (returns false on allocation failure)
+bool world_routes_init(WorldRoutes *routes, const World *world);
+
+// Free route storage
+void world_routes_free(WorldRoutes *routes);
+
+// Drop all cached tables and the adjacency (rebuilt by the next query)
+void world_routes_invalidate(WorldRoutes *routes);
+
+// Update cached tables for an exit that became passable or impassable
+// (called by world.c when an exit is unlocked or locked again)
+void world_routes_exit_changed(World *world, int exit_id, bool open);
+
+// Exit to take first on a shortest open path from room `from` to `target`
+// (-1 if unreachable or already there); fills *moves with the path length
+// when moves is not NULL
+int world_route_next(World *world, int from, int target, int *moves);
+
+#endif // WORLD_ROUTE_H
@@ -0,0 +1,58 @@
+/*
+ * Adventure Engine - World Snapshots
+ * Copy-on-write captures of a session's state for undo and forking
+ */
+
+#ifndef WORLD_SNAPSHOT_H
+#define WORLD_SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "world.h"
+
+// Snapshot of one session's state
+// State arrays are cut into STATE_CHUNK_BYTES chunks. A chunk nobody wrote
+// since the previous snapshot is shared with it (reference counted), so
+// keeping the last N turns costs memory proportional to what changed.
+typedef struct {
+    WorldDef *def;            // Definition the state belongs to (retained)
+    int room_count;           // Layout the chunks were cut from
+    int exit_count;
+    int item_count;
+    int current_room;
+    int inventory_first;
+    int inventory_count;
+    StateChunk **chunks;      // One per chunk of every StateRegion, in order
+    int chunk_count;
+    size_t copied_bytes;      // Chunk bytes not shared with the previous snapshot
+} WorldSnapshot;
+
+// Capture the world's current state (returns NULL on allocation failure)
+// Like world_clone, this shares the definition, making it read-only.
+WorldSnapshot* world_snapshot(World *world);
+
+// Put the world back in a snapshot's state, copying only the chunks that
+// differ (returns false if the snapshot is from another definition)
+bool world_restore(World *world, const WorldSnapshot *snapshot);
+
+// Start a new session in a snapshot's state, sharing its definition
+// (returns false on allocation failure)
+bool world_fork(World *session, const WorldSnapshot *snapshot);
+
+// Check whether the world still matches the last snapshot taken or restored
+bool world_snapshot_matches(const World *world, const WorldSnapshot *snapshot);
+
+// Hash of the session's state: room, inventory and every StateRegion
+// Equal states hash equal on the same platform, so a replayed game can be
+// checked against a recorded hash (see src/replay_main.c).
+uint64_t world_state_hash(const World *world);
+
+// Free a snapshot (chunks still shared with others stay alive)
+void world_snapshot_free(WorldSnapshot *snapshot);
+
+// Stop tracking changes and drop the world's references to snapshot chunks
+// (called by world_free and when rooms or items are added)
+void world_snapshot_detach(World *world);
+
+#endif // WORLD_SNAPSHOT_H
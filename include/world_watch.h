@@ -0,0 +1,39 @@
+/*
+ * Adventure Engine - World File Watcher
+ * Reports .world files that were saved in a directory, for hot reloading
+ */
+
+#ifndef WORLD_WATCH_H
+#define WORLD_WATCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define WORLD_WATCH_PENDING 64    // Changed worlds remembered between polls
+#define WORLD_WATCH_RESCAN "*"    // Reported when saves were missed (never a world name)
+
+typedef struct WorldWatcher WorldWatcher;
+
+// Watch a directory (not its subdirectories) with inotify
+// A file counts as saved when it is closed after writing or renamed into
+// place, so editors that save through a temporary file are seen once, when
+// the new version is complete. Returns NULL if the directory can't be
+// watched or the platform has no inotify.
+WorldWatcher* world_watcher_open(const char *dir);
+
+// Stop watching and free the watcher (NULL is ignored)
+void world_watcher_close(WorldWatcher *watcher);
+
+// File descriptor that becomes readable when files change, for poll()
+int world_watcher_fd(const WorldWatcher *watcher);
+
+// Next world saved since the last call: its name (file name without
+// .world) in name. Never blocks; returns false when nothing is pending.
+// A world saved several times between calls is reported once. If saves
+// were missed (more than WORLD_WATCH_PENDING worlds saved between calls,
+// or the kernel's event queue overflowed), WORLD_WATCH_RESCAN is reported
+// once after the names that were kept: any world may have changed, so
+// check each loaded one against its file (game_world_changed).
+bool world_watcher_next(WorldWatcher *watcher, char *name, size_t size);
+
+#endif // WORLD_WATCH_H
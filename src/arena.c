@@ -0,0 +1,65 @@
+/*
+ * Adventure Engine - Arena Allocator Implementation
+ */
+
+#include <stdlib.h>
+#include "arena.h"
+
+#define ARENA_ALIGN 16
+#define ARENA_DEFAULT_BLOCK (64 * 1024)
+
+static size_t align_up(size_t n) {
+    return (n + (ARENA_ALIGN - 1)) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+void arena_init(Arena *arena, size_t block_size) {
+    arena->head = NULL;
+    arena->block_size = block_size ? block_size : ARENA_DEFAULT_BLOCK;
+    arena->total = 0;
+}
+
+// Helper: Start a new block large enough for `size` bytes
+static bool add_block(Arena *arena, size_t size) {
+    size_t block_size = size > arena->block_size ? size : arena->block_size;
+    ArenaBlock *block = calloc(1, sizeof(ArenaBlock) + block_size);
+    if (!block) return false;
+
+    block->size = block_size;
+    block->used = 0;
+    block->next = arena->head;
+    arena->head = block;
+    arena->total += block_size;
+    return true;
+}
+
+bool arena_reserve(Arena *arena, size_t size) {
+    ArenaBlock *head = arena->head;
+    if (head && head->size - head->used >= size) return true;
+    return add_block(arena, align_up(size));
+}
+
+void* arena_alloc(Arena *arena, size_t size) {
+    size = align_up(size ? size : 1);
+
+    ArenaBlock *head = arena->head;
+    if (!head || head->size - head->used < size) {
+        if (!add_block(arena, size)) return NULL;
+        head = arena->head;
+    }
+
+    // Blocks come from calloc and are never reused, so memory is already zeroed
+    void *ptr = head->data + head->used;
+    head->used += size;
+    return ptr;
+}
+
+void arena_free(Arena *arena) {
+    ArenaBlock *block = arena->head;
+    while (block) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->head = NULL;
+    arena->total = 0;
+}
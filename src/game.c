@@ -0,0 +1,826 @@
+/*
+ * Adventure Engine - Game Commands Implementation
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "game.h"
+#include "parser.h"
+#include "recording.h"
+#include "save_load.h"
+#include "world_cache.h"
+#include "world_image.h"
+
+// Forward declarations
+static void handle_command(Game *game, Verb verb, const CommandView *cmd);
+static void cmd_look(Game *game);
+static void cmd_go(Game *game, const char *direction);
+static void cmd_take(Game *game, const char *item_id);
+static void cmd_drop(Game *game, const char *item_id);
+static void cmd_inventory(Game *game);
+static void cmd_examine(Game *game, const char *item_id);
+static void cmd_use(Game *game, const char *item_id);
+static void cmd_save(Game *game, const char *slot_name);
+static void cmd_load(Game *game, const char *slot_name);
+static void cmd_saves(Game *game);
+static void cmd_undo(Game *game);
+static void cmd_redo(Game *game);
+static void cmd_goto(Game *game, const char *room_name);
+static void cmd_help(Game *game);
+
+// Helper: Write one line of output
+static void output(Game *game, const char *text, OutputStyle style) {
+    if (game->output.write) game->output.write(game->output.ctx, text, style);
+}
+
+void game_init(Game *game, const OutputSink *sink) {
+    memset(game, 0, sizeof(Game));
+    world_init(&game->world);
+    snprintf(game->world_name, sizeof(game->world_name), "unknown");
+    game_set_output(game, sink);
+}
+
+// Helper: Release undo history and travel routes
+static void stop(Game *game) {
+    if (!game->started) return;
+    game->world.journal = NULL;
+    game->world.routes = NULL;
+    world_journal_free(&game->journal);
+    world_routes_free(&game->routes);
+    game->started = false;
+}
+
+void game_free(Game *game) {
+    stop(game);
+    world_free(&game->world);
+}
+
+void game_set_output(Game *game, const OutputSink *sink) {
+    if (sink) {
+        game->output = *sink;
+    } else {
+        memset(&game->output, 0, sizeof(game->output));
+    }
+}
+
+// Helper: Sink callback for stdio streams
+static void write_stream(void *ctx, const char *text, OutputStyle style) {
+    (void)style;
+    FILE *stream = ctx;
+    fputs(text, stream);
+    putc('\n', stream);
+}
+
+OutputSink game_stream_sink(FILE *stream) {
+    OutputSink sink = { .write = write_stream, .ctx = stream };
+    return sink;
+}
+
+// Helper: Name the game's newly opened world, or leave it empty if it
+// did not load
+static bool finish_open(Game *game, bool loaded, const char *world_name) {
+    if (!loaded) {
+        world_free(&game->world);
+        world_init(&game->world);
+        return false;
+    }
+    snprintf(game->world_name, sizeof(game->world_name), "%s", world_name);
+    return true;
+}
+
+bool game_open(Game *game, const char *world_name, LoadError *error) {
+    // Validate world file name to prevent path traversal
+    if (!is_safe_filename(world_name)) {
+        error->has_error = true;
+        error->line_number = 0;
+        snprintf(error->message, sizeof(error->message),
+                 "Invalid world file name. Only alphanumeric, underscore, and hyphen allowed.");
+        return false;
+    }
+
+#ifdef EMBEDDED_WORLDS
+    // Kiosk builds: worlds linked into the program need no files at all
+    for (int i = 0; embedded_worlds[i]; i++) {
+        if (strcmp(embedded_worlds[i]->name, world_name) == 0) {
+            stop(game);
+            world_free(&game->world);
+            return finish_open(game, world_tables_open(&game->world, embedded_worlds[i], error),
+                               world_name);
+        }
+    }
+#endif
+
+    char full_path[512];
+    char image_path[512];
+    snprintf(full_path, sizeof(full_path), "worlds/%s.world", world_name);
+    snprintf(image_path, sizeof(image_path), "worlds/%s%s", world_name, WORLD_IMAGE_EXTENSION);
+
+    // A stale or unreadable image (e.g. from another engine version) falls
+    // back to parsing the source
+    if (world_image_current(image_path, full_path) &&
+        game_open_file(game, image_path, world_name, error)) {
+        return true;
+    }
+    return game_open_file(game, full_path, world_name, error);
+}
+
+bool game_open_file(Game *game, const char *path, const char *world_name, LoadError *error) {
+    stop(game);
+    world_free(&game->world);
+
+    size_t len = strlen(path);
+    size_t ext = strlen(WORLD_IMAGE_EXTENSION);
+    if (len > ext && strcmp(path + len - ext, WORLD_IMAGE_EXTENSION) == 0) {
+        return finish_open(game, world_image_load(&game->world, path, error), world_name);
+    }
+
+    // .world files go through the compiled world cache, so an unchanged
+    // file is parsed once, not on every open
+    char cache_dir[512];
+    bool cached = world_cache_dir(cache_dir, sizeof(cache_dir));
+    return finish_open(game, world_cache_load(&game->world, path, cached ? cache_dir : NULL,
+                                              error, NULL),
+                       world_name);
+}
+
+bool game_load_world(const char *world_name, World *world, LoadError *error) {
+    memset(world, 0, sizeof(World));
+    if (!is_safe_filename(world_name)) {
+        error->has_error = true;
+        error->line_number = 0;
+        snprintf(error->message, sizeof(error->message),
+                 "Invalid world file name. Only alphanumeric, underscore, and hyphen allowed.");
+        return false;
+    }
+
+    char full_path[512];
+    char cache_dir[512];
+    snprintf(full_path, sizeof(full_path), "worlds/%s.world", world_name);
+    bool cached = world_cache_dir(cache_dir, sizeof(cache_dir));
+    if (!world_cache_load(world, full_path, cached ? cache_dir : NULL, error, NULL)) {
+        world_free(world);
+        return false;
+    }
+    return true;
+}
+
+bool game_world_changed(const char *world_name, WorldSourceStamp *stamp) {
+    char full_path[512];
+    WorldSourceStamp now;
+    if (!is_safe_filename(world_name)) return false;
+    snprintf(full_path, sizeof(full_path), "worlds/%s.world", world_name);
+    if (!world_source_stamp(full_path, false, &now)) return false;
+
+    bool changed = now.size != stamp->size || now.mtime_sec != stamp->mtime_sec ||
+                   now.mtime_nsec != stamp->mtime_nsec;
+    *stamp = now;
+    return changed;
+}
+
+bool game_reload(Game *game, const WorldDiff *diff) {
+    if (game->world.def != diff->from) return false;
+
+    // Keyframes before and after are in different layouts, so the recording
+    // stores both definitions
+    if (game->recorder) recorder_reloading(game->recorder, game);
+    if (!world_reload(&game->world, diff)) return false;
+    if (game->recorder) recorder_reloaded(game->recorder, game);
+    return true;
+}
+
+bool game_open_shared(Game *game, World *source, const char *world_name) {
+    stop(game);
+    world_free(&game->world);
+    if (!world_clone(&game->world, source)) {
+        world_init(&game->world);
+        return false;
+    }
+    snprintf(game->world_name, sizeof(game->world_name), "%s", world_name ? world_name : "unknown");
+    return true;
+}
+
+bool game_open_save(Game *game, const char *slot_name) {
+    char world_name[64];
+    LoadError error;
+    if (!game_read_world_name(slot_name, world_name, sizeof(world_name)) ||
+        !game_open(game, world_name, &error)) {
+        return false;
+    }
+
+    if (!game_load(&game->world, slot_name, game->world_name, sizeof(game->world_name))) {
+        world_free(&game->world);
+        world_init(&game->world);
+        return false;
+    }
+    return true;
+}
+
+void game_start(Game *game) {
+    stop(game);
+    game->turns = 0;
+
+    // Show initial room
+    cmd_look(game);
+
+    // Record changes from here on for undo/redo
+    if (world_journal_init(&game->journal, JOURNAL_DEFAULT_CAPACITY)) {
+        game->world.journal = &game->journal;
+    }
+    if (world_routes_init(&game->routes, &game->world)) {
+        game->world.routes = &game->routes;
+    }
+    game->started = true;
+    if (game->recorder) recorder_start(game->recorder, game);
+}
+
+// Helper: Run one command of a line; returns false once the player quits
+static bool run_command(Game *game, const CommandView *cmd) {
+    Verb verb = world_find_verb(&game->world, cmd->verb.text, cmd->verb.len);
+    bool running = true;
+    bool replayable = true;   // Rerunning it on the same world gives the same state
+    if (verb == VERB_QUIT) {
+        output(game, "", OUTPUT_NORMAL);
+        output(game, "Thanks for playing! Goodbye.", OUTPUT_NORMAL);
+        running = false;
+    } else if (verb == VERB_UNDO) {
+        cmd_undo(game);
+        replayable = false;
+    } else if (verb == VERB_REDO) {
+        cmd_redo(game);
+        replayable = false;
+    } else {
+        if (game->world.journal) world_journal_begin_turn(game->world.journal);
+        handle_command(game, verb, cmd);
+        game->turns++;
+        // Save slots live outside the game
+        replayable = verb != VERB_SAVE && verb != VERB_LOAD;
+    }
+
+    // Each command of a line is recorded on its own
+    if (game->recorder) {
+        recorder_command(game->recorder, game, cmd->text.text, cmd->text.len, replayable);
+    }
+    return running;
+}
+
+bool game_command(Game *game, const char *input) {
+    if (!input || input[0] == '\0') return true;
+
+    // A line can chain commands ("take key, north then look"); they run in
+    // order until one quits, and the caller redraws once for the whole line
+    const char *rest = input;
+    CommandView cmd;
+    bool running = true;
+    bool ran = false;
+    while (running && parse_next_command(&rest, &cmd)) {
+        running = run_command(game, &cmd);
+        ran = true;
+    }
+    if (!ran && input[strspn(input, " \t\r\n\v\f")] != '\0') {
+        output(game, "I don't understand that.", OUTPUT_NORMAL);
+    }
+    return running;
+}
+
+int game_run_batch(Game *game, FILE *in) {
+    game_start(game);
+
+    // Input is read a line at a time; the parser only looks at the first
+    // 255 characters, so the rest of an overlong line is skipped
+    char line[256];
+    while (fgets(line, sizeof(line), in)) {
+        size_t len = strcspn(line, "\r\n");
+        if (line[len] == '\0' && len == sizeof(line) - 1) {
+            int c;
+            while ((c = getc(in)) != EOF && c != '\n') {}
+        }
+        line[len] = '\0';
+        if (!game_command(game, line)) break;
+    }
+    return game->turns;
+}
+
+// Helper: Find item by partial name match
+static Item* find_item_fuzzy(World *world, const char *name, bool check_inventory, bool check_room) {
+    // First try exact match in inventory
+    if (check_inventory) {
+        Item *item = world_get_inventory_item(world, name);
+        if (item) return item;
+    }
+
+    // Try exact match in room
+    if (check_room) {
+        Item *item = world_get_room_item(world, name);
+        if (item) return item;
+    }
+
+    // Try partial match by checking if item name contains the search string
+    if (check_inventory) {
+        for (int i = world_first_item(world, ITEM_IN_INVENTORY); i != -1;
+             i = world_next_item(world, i)) {
+            Item *item = &world->def->items[i];
+            if (strstr(world_str(world, item->name), name) != NULL ||
+                strstr(world_str(world, item->id), name) != NULL) {
+                return item;
+            }
+        }
+    }
+
+    if (check_room) {
+        for (int i = world_first_item(world, world->current_room); i != -1;
+             i = world_next_item(world, i)) {
+            Item *item = &world->def->items[i];
+            if (strstr(world_str(world, item->name), name) != NULL ||
+                strstr(world_str(world, item->id), name) != NULL) {
+                return item;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+// Run a verb the game layer doesn't handle itself (see game_command)
+static void handle_command(Game *game, Verb verb, const CommandView *cmd) {
+    World *world = &game->world;
+
+    // Handlers match nouns against lowercase IDs and names
+    char noun[64];
+    token_copy(cmd->noun, noun, sizeof(noun));
+
+    switch (verb) {
+        case VERB_HELP:
+            cmd_help(game);
+            break;
+        case VERB_LOOK:
+            cmd_look(game);
+            break;
+        case VERB_GO:
+            cmd_go(game, noun);
+            break;
+        case VERB_NORTH:
+            cmd_go(game, "north");
+            break;
+        case VERB_SOUTH:
+            cmd_go(game, "south");
+            break;
+        case VERB_EAST:
+            cmd_go(game, "east");
+            break;
+        case VERB_WEST:
+            cmd_go(game, "west");
+            break;
+        case VERB_UP:
+            cmd_go(game, "up");
+            break;
+        case VERB_DOWN:
+            cmd_go(game, "down");
+            break;
+        case VERB_GOTO:
+            cmd_goto(game, noun);
+            break;
+        case VERB_TAKE:
+            cmd_take(game, noun);
+            break;
+        case VERB_DROP:
+            cmd_drop(game, noun);
+            break;
+        case VERB_INVENTORY:
+            cmd_inventory(game);
+            break;
+        case VERB_EXAMINE:
+            cmd_examine(game, noun);
+            break;
+        case VERB_USE:
+            cmd_use(game, noun);
+            break;
+        case VERB_SAVE:
+            cmd_save(game, noun);
+            break;
+        case VERB_LOAD:
+            cmd_load(game, noun);
+            break;
+        case VERB_SAVES:
+            cmd_saves(game);
+            break;
+        default: {
+            // A named exit of this room typed on its own ("in", "through the mirror")
+            char verb_word[64];
+            char exit_name[sizeof(verb_word) + sizeof(noun) + 1];
+            token_copy(cmd->verb, verb_word, sizeof(verb_word));
+            snprintf(exit_name, sizeof(exit_name), "%s%s%s", verb_word,
+                     noun[0] ? " " : "", noun);
+            if (world_find_exit(world, world->current_room, exit_name) != -1) {
+                cmd_go(game, exit_name);
+            } else {
+                output(game, "I don't know how to do that. Type 'help' for commands.", OUTPUT_NORMAL);
+            }
+            break;
+        }
+    }
+}
+
+static void cmd_help(Game *game) {
+    output(game, "", OUTPUT_NORMAL);
+    output(game, "=== COMMANDS ===", OUTPUT_SPECIAL);
+    output(game, "  look, l              - Look around current room", OUTPUT_NORMAL);
+    output(game, "  go <dir>, <dir>      - Move (north/south/east/west/up/down)", OUTPUT_NORMAL);
+    output(game, "  go <exit>, <exit>    - Use a named exit (in, out, ...)", OUTPUT_NORMAL);
+    output(game, "  goto <room>, travel  - Walk to a room you have visited", OUTPUT_NORMAL);
+    output(game, "  take <item>          - Pick up an item", OUTPUT_NORMAL);
+    output(game, "  drop <item>          - Drop an item", OUTPUT_NORMAL);
+    output(game, "  examine <item>       - Examine an item closely", OUTPUT_NORMAL);
+    output(game, "  use <item>           - Use an item from inventory", OUTPUT_NORMAL);
+    output(game, "  inventory, i         - Show your inventory", OUTPUT_NORMAL);
+    output(game, "  save <slot>          - Save game to slot", OUTPUT_NORMAL);
+    output(game, "  load <slot>          - Load game from slot", OUTPUT_NORMAL);
+    output(game, "  saves                - List all save slots", OUTPUT_NORMAL);
+    output(game, "  undo                 - Take back the last turn", OUTPUT_NORMAL);
+    output(game, "  redo                 - Replay an undone turn", OUTPUT_NORMAL);
+    output(game, "  help, ?              - Show this help", OUTPUT_NORMAL);
+    output(game, "  quit, exit           - Quit the game", OUTPUT_NORMAL);
+    output(game, "  <cmd>, <cmd> / then  - Run several commands in one line", OUTPUT_NORMAL);
+    output(game, "", OUTPUT_NORMAL);
+}
+
+static void cmd_look(Game *game) {
+    World *world = &game->world;
+    Room *room = world_current_room(world);
+    if (!room) {
+        output(game, "You are nowhere. This is a bug.", OUTPUT_NORMAL);
+        return;
+    }
+
+    output(game, "", OUTPUT_NORMAL);
+    output(game, world_str(world, room->name), OUTPUT_SPECIAL);
+    output(game, world_get_room_description(world, room), OUTPUT_NORMAL);
+
+    // Show exits
+    char exits_buf[256];
+    size_t buf_len = sizeof(exits_buf);
+    size_t offset = 0;
+
+    // Start with "Exits: "
+    offset = snprintf(exits_buf, buf_len, "Exits: ");
+
+    int exit_count = 0;
+    int end = world_exits_end(world, world->current_room);
+    for (int e = world_exits_begin(world, world->current_room); e < end; e++) {
+        // Add comma separator if not first exit
+        if (exit_count > 0 && offset < buf_len) {
+            offset += snprintf(exits_buf + offset, buf_len - offset, ", ");
+        }
+        // Add exit name with bounds checking
+        if (offset < buf_len) {
+            offset += snprintf(exits_buf + offset, buf_len - offset, "%s",
+                               world_str(world, world_exit(world, e)->name));
+        }
+        exit_count++;
+    }
+    if (exit_count == 0 && offset < buf_len) {
+        snprintf(exits_buf + offset, buf_len - offset, "none");
+    }
+    output(game, exits_buf, OUTPUT_COMMENT);
+
+    // Show items
+    for (int i = world_first_item(world, world->current_room); i != -1;
+         i = world_next_item(world, i)) {
+        Item *item = &world->def->items[i];
+        if (item->visible) {
+            char item_buf[128];
+            snprintf(item_buf, sizeof(item_buf), "You see: %s", world_str(world, item->name));
+            output(game, item_buf, OUTPUT_NORMAL);
+        }
+    }
+
+    output(game, "", OUTPUT_NORMAL);
+}
+
+static void cmd_go(Game *game, const char *direction) {
+    World *world = &game->world;
+    if (!direction || strlen(direction) == 0) {
+        output(game, "Go where? Try 'go north' or just 'north'.", OUTPUT_NORMAL);
+        return;
+    }
+
+    int exit = world_find_exit(world, world->current_room, direction);
+    if (exit == -1 && str_to_direction(direction) == -1) {
+        output(game, "I don't know that direction.", OUTPUT_NORMAL);
+        return;
+    }
+
+    char key_needed[32];
+    MoveResult result = exit == -1 ? MOVE_NO_EXIT :
+                        world_move_exit(world, exit, key_needed, sizeof(key_needed));
+
+    switch (result) {
+        case MOVE_SUCCESS:
+            output(game, "", OUTPUT_NORMAL);
+            cmd_look(game);
+            break;
+        case MOVE_NO_EXIT:
+            output(game, "You can't go that way.", OUTPUT_NORMAL);
+            break;
+        case MOVE_LOCKED: {
+            char msg[128];
+            // Look up the key's display name from the item
+            int key_idx = world_find_item(world, key_needed);
+            if (key_idx != -1) {
+                snprintf(msg, sizeof(msg), "The way %s is locked. You need the %s.",
+                        direction, world_str(world, world->def->items[key_idx].name));
+            } else {
+                snprintf(msg, sizeof(msg), "The way %s is locked.", direction);
+            }
+            output(game, msg, OUTPUT_NORMAL);
+            break;
+        }
+    }
+}
+
+static void cmd_take(Game *game, const char *item_id) {
+    World *world = &game->world;
+    if (!item_id || strlen(item_id) == 0) {
+        output(game, "Take what?", OUTPUT_NORMAL);
+        return;
+    }
+
+    Item *item = find_item_fuzzy(world, item_id, false, true);
+    if (!item) {
+        output(game, "You don't see that here.", OUTPUT_NORMAL);
+        return;
+    }
+
+    if (!item->takeable) {
+        char buf[128];
+        snprintf(buf, sizeof(buf), "You can't take the %s.", world_str(world, item->name));
+        output(game, buf, OUTPUT_NORMAL);
+        return;
+    }
+
+    if (world_take_item(world, world_str(world, item->id))) {
+        char buf[128];
+        snprintf(buf, sizeof(buf), "You take the %s.", world_str(world, item->name));
+        output(game, buf, OUTPUT_NORMAL);
+    } else {
+        output(game, "Your inventory is full!", OUTPUT_NORMAL);
+    }
+}
+
+static void cmd_drop(Game *game, const char *item_id) {
+    World *world = &game->world;
+    if (!item_id || strlen(item_id) == 0) {
+        output(game, "Drop what?", OUTPUT_NORMAL);
+        return;
+    }
+
+    Item *item = find_item_fuzzy(world, item_id, true, false);
+    if (!item) {
+        output(game, "You don't have that.", OUTPUT_NORMAL);
+        return;
+    }
+
+    if (world_drop_item(world, world_str(world, item->id))) {
+        char buf[128];
+        snprintf(buf, sizeof(buf), "You drop the %s.", world_str(world, item->name));
+        output(game, buf, OUTPUT_NORMAL);
+    } else {
+        output(game, "You can't drop that here.", OUTPUT_NORMAL);
+    }
+}
+
+static void cmd_inventory(Game *game) {
+    World *world = &game->world;
+    output(game, "", OUTPUT_NORMAL);
+    output(game, "=== INVENTORY ===", OUTPUT_SPECIAL);
+
+    for (int i = world_first_item(world, ITEM_IN_INVENTORY); i != -1;
+         i = world_next_item(world, i)) {
+        char buf[128];
+        snprintf(buf, sizeof(buf), "  - %s", world_str(world, world->def->items[i].name));
+        output(game, buf, OUTPUT_NORMAL);
+    }
+
+    if (world->inventory_count == 0) {
+        output(game, "  (empty)", OUTPUT_COMMENT);
+    }
+
+    output(game, "", OUTPUT_NORMAL);
+}
+
+static void cmd_examine(Game *game, const char *item_id) {
+    World *world = &game->world;
+    if (!item_id || strlen(item_id) == 0) {
+        output(game, "Examine what?", OUTPUT_NORMAL);
+        return;
+    }
+
+    // Check both inventory and room
+    Item *item = find_item_fuzzy(world, item_id, true, true);
+
+    if (!item) {
+        output(game, "You don't see that here.", OUTPUT_NORMAL);
+        return;
+    }
+
+    output(game, "", OUTPUT_NORMAL);
+    output(game, world_str(world, item->name), OUTPUT_SPECIAL);
+    output(game, world_str(world, item->description), OUTPUT_NORMAL);
+    output(game, "", OUTPUT_NORMAL);
+}
+
+static void cmd_save(Game *game, const char *slot_name) {
+    World *world = &game->world;
+    if (!slot_name || strlen(slot_name) == 0) {
+        output(game, "Save to which slot? Example: save slot1", OUTPUT_NORMAL);
+        return;
+    }
+
+    if (game_save(world, slot_name, game->world_name)) {
+        char buf[128];
+        snprintf(buf, sizeof(buf), "Game saved to slot '%s'", slot_name);
+        output(game, buf, OUTPUT_SPECIAL);
+    } else {
+        output(game, "Failed to save game.", OUTPUT_NORMAL);
+    }
+}
+
+static void cmd_load(Game *game, const char *slot_name) {
+    World *world = &game->world;
+    if (!slot_name || strlen(slot_name) == 0) {
+        output(game, "Load from which slot? Example: load slot1", OUTPUT_NORMAL);
+        return;
+    }
+
+    char loaded_world[64];
+    if (game_load(world, slot_name, loaded_world, sizeof(loaded_world))) {
+        snprintf(game->world_name, sizeof(game->world_name), "%s", loaded_world);
+        output(game, "", OUTPUT_NORMAL);
+        output(game, "Game loaded successfully!", OUTPUT_SPECIAL);
+        output(game, "", OUTPUT_NORMAL);
+        cmd_look(game);
+    } else {
+        output(game, "Failed to load game. Slot may not exist.", OUTPUT_NORMAL);
+    }
+}
+
+static void cmd_saves(Game *game) {
+    char saves[50][64];
+    int count = game_list_saves(saves, 50);
+
+    output(game, "", OUTPUT_NORMAL);
+    output(game, "=== SAVE SLOTS ===", OUTPUT_SPECIAL);
+
+    if (count == 0) {
+        output(game, "  (no saves found)", OUTPUT_COMMENT);
+    } else {
+        for (int i = 0; i < count; i++) {
+            char buf[sizeof(saves[i]) + 8];
+            snprintf(buf, sizeof(buf), "  - %.63s", saves[i]);
+            output(game, buf, OUTPUT_NORMAL);
+        }
+    }
+
+    output(game, "", OUTPUT_NORMAL);
+}
+
+static void cmd_use(Game *game, const char *item_id) {
+    World *world = &game->world;
+    if (!item_id || strlen(item_id) == 0) {
+        output(game, "Use what?", OUTPUT_NORMAL);
+        return;
+    }
+
+    // Find item in inventory only (must have item to use it)
+    Item *item = find_item_fuzzy(world, item_id, true, false);
+
+    if (!item) {
+        output(game, "You don't have that.", OUTPUT_NORMAL);
+        return;
+    }
+
+    // Keys open the locked exits they fit in this room
+    int item_idx = (int)(item - world->def->items);
+    int unlocked = world_unlock_with_key(world, item_idx, world->current_room);
+
+    // Check if item is usable
+    if (item->use_message == 0 && unlocked == 0) {
+        char buf[128];
+        snprintf(buf, sizeof(buf), "You can't use the %s.", world_str(world, item->name));
+        output(game, buf, OUTPUT_NORMAL);
+        return;
+    }
+
+    // Mark item as used (for conditional descriptions)
+    world_set_item_used(world, item_idx, true);
+
+    if (unlocked > 0) {
+        char buf[128];
+        if (unlocked == 1) {
+            snprintf(buf, sizeof(buf), "You unlock the exit with the %s.",
+                     world_str(world, item->name));
+        } else {
+            snprintf(buf, sizeof(buf), "You unlock %d exits with the %s.", unlocked,
+                     world_str(world, item->name));
+        }
+        output(game, buf, OUTPUT_SPECIAL);
+    }
+
+    // Display use message
+    if (item->use_message != 0) {
+        output(game, "", OUTPUT_NORMAL);
+        output(game, world_str(world, item->use_message), OUTPUT_SPECIAL);
+        output(game, "", OUTPUT_NORMAL);
+    }
+
+    // Remove item if consumable
+    if (item->use_consumable) {
+        world_remove_from_inventory(world, world_str(world, item->id));
+        char buf[128];
+        snprintf(buf, sizeof(buf), "The %s is consumed.", world_str(world, item->name));
+        output(game, buf, OUTPUT_COMMENT);
+    }
+}
+
+// Helper: Say where the player ended up after undo/redo
+// (a full look would mark the description shown and start a new turn)
+static void report_position(Game *game, const char *what) {
+    World *world = &game->world;
+    char buf[256];
+    Room *room = world_current_room(world);
+    snprintf(buf, sizeof(buf), "%s You are in the %s.", what,
+             room ? world_str(world, room->name) : "void");
+    output(game, buf, OUTPUT_COMMENT);
+}
+
+static void cmd_undo(Game *game) {
+    World *world = &game->world;
+    if (!world_journal_undo(world)) {
+        output(game, "Nothing to undo.", OUTPUT_NORMAL);
+        return;
+    }
+    report_position(game, "Undone.");
+}
+
+static void cmd_redo(Game *game) {
+    World *world = &game->world;
+    if (!world_journal_redo(world)) {
+        output(game, "Nothing to redo.", OUTPUT_NORMAL);
+        return;
+    }
+    report_position(game, "Redone.");
+}
+
+// Helper: Find a room by ID or by name (case-insensitive)
+static int find_room_named(World *world, const char *name) {
+    int room = world_find_room(world, name);
+    if (room != -1) return room;
+
+    for (int r = 0; r < world->def->room_count; r++) {
+        if (strcasecmp(world_str(world, world->def->rooms[r].name), name) == 0) return r;
+    }
+    return -1;
+}
+
+static void cmd_goto(Game *game, const char *room_name) {
+    World *world = &game->world;
+    if (!room_name || strlen(room_name) == 0) {
+        output(game, "Go to where? Try 'goto <room>'.", OUTPUT_NORMAL);
+        return;
+    }
+
+    int target = find_room_named(world, room_name);
+    if (target == -1 || !world_room_visited(world, target)) {
+        output(game, "You don't know of a place like that.", OUTPUT_NORMAL);
+        return;
+    }
+    if (target == world->current_room) {
+        output(game, "You're already there.", OUTPUT_NORMAL);
+        return;
+    }
+
+    // Walk the path one exit at a time, so moves behave like typed ones
+    char path[256] = "";
+    size_t used = 0;
+    int moves = 0;
+    int exit = world_route_next(world, world->current_room, target, &moves);
+    if (exit == -1) {
+        output(game, "You can't find an open way there from here.", OUTPUT_NORMAL);
+        return;
+    }
+    for (int step = 0; exit != -1 && step < moves; step++) {
+        if (world_move_exit(world, exit, NULL, 0) != MOVE_SUCCESS) break;
+        if (used < sizeof(path)) {
+            used += (size_t)snprintf(path + used, sizeof(path) - used, "%s%s",
+                                     step ? ", " : "", world_str(world, world_exit(world, exit)->name));
+        }
+        exit = world_route_next(world, world->current_room, target, NULL);
+    }
+
+    char msg[320];
+    snprintf(msg, sizeof(msg), "You travel %s.", path);
+    output(game, msg, OUTPUT_COMMENT);
+    output(game, "", OUTPUT_NORMAL);
+    cmd_look(game);
+}
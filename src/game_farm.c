@@ -0,0 +1,322 @@
+/*
+ * Adventure Engine - Game Farm Implementation
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "game_farm.h"
+
+#define FARM_LINE_SIZE 256       // Longest input line kept (as batch mode)
+
+// A game and its input queue
+typedef struct {
+    Game *game;
+    pthread_mutex_t lock;        // Guards head, count and lines
+    int head;
+    int count;
+    char lines[FARM_QUEUE_LINES][FARM_LINE_SIZE];
+    atomic_int pending;          // count, readable without the lock
+    atomic_bool claimed;         // A worker is running this game
+    atomic_bool finished;        // Player quit; further input is dropped
+} FarmGame;
+
+typedef struct {
+    GameFarm *farm;
+    int id;
+} Worker;
+
+struct GameFarm {
+    pthread_t threads[FARM_MAX_WORKERS];
+    Worker workers[FARM_MAX_WORKERS];
+    int worker_count;
+    int started;                 // Threads created (for cleanup after a failed create)
+    FarmGame *games;
+    int max_games;
+    atomic_int game_count;       // Slots filled; a slot is complete before it counts
+    atomic_int pending;          // Lines queued across all games
+    atomic_int sleeping;         // Workers waiting for work
+    atomic_uint runnable;        // Bumped whenever a game may have become runnable
+    atomic_int reloading;        // game_farm_reload calls waiting for games
+    atomic_bool stopping;
+    pthread_mutex_t lock;        // Guards the condition variables
+    pthread_cond_t work;         // A game may have become runnable
+    pthread_cond_t released;     // A game was released while a reload waits
+    pthread_cond_t drained;      // pending reached zero
+    atomic_llong commands;
+    atomic_llong stolen;
+};
+
+// Helper: Account for lines that were run or dropped
+static void finish_lines(GameFarm *farm, FarmGame *slot, int lines) {
+    atomic_fetch_sub(&slot->pending, lines);
+    if (atomic_fetch_sub(&farm->pending, lines) == lines) {
+        pthread_mutex_lock(&farm->lock);
+        pthread_cond_broadcast(&farm->drained);
+        pthread_mutex_unlock(&farm->lock);
+    }
+}
+
+// Helper: Tell the farm a game may have become runnable (input arrived, or
+// it was released with input left) and wake a sleeping worker for it.
+// Sleepers count themselves before their last look at runnable, so either
+// they see the bump or we see them.
+static void announce_runnable(GameFarm *farm) {
+    atomic_fetch_add(&farm->runnable, 1);
+    if (atomic_load(&farm->sleeping) > 0) {
+        pthread_mutex_lock(&farm->lock);
+        pthread_cond_signal(&farm->work);
+        pthread_mutex_unlock(&farm->lock);
+    }
+}
+
+// Helper: Give back a game claimed by a worker or a reload
+static void release_game(GameFarm *farm, FarmGame *slot) {
+    atomic_store(&slot->claimed, false);
+    if (atomic_load(&slot->pending) > 0) announce_runnable(farm);
+    // A reload counts itself before trying to claim, so it sees this
+    // release or we see it
+    if (atomic_load(&farm->reloading) > 0) {
+        pthread_mutex_lock(&farm->lock);
+        pthread_cond_broadcast(&farm->released);
+        pthread_mutex_unlock(&farm->lock);
+    }
+}
+
+// Helper: Run up to FARM_SLICE queued commands of one game, if no other
+// worker is running it. Returns true if anything ran.
+static bool run_slice(GameFarm *farm, int game_id, bool stealing) {
+    FarmGame *slot = &farm->games[game_id];
+    if (atomic_load(&slot->pending) == 0) return false;
+
+    bool expected = false;
+    if (!atomic_compare_exchange_strong(&slot->claimed, &expected, true)) return false;
+
+    int ran = 0;
+    char line[FARM_LINE_SIZE];
+    while (ran < FARM_SLICE) {
+        pthread_mutex_lock(&slot->lock);
+        if (slot->count == 0) {
+            pthread_mutex_unlock(&slot->lock);
+            break;
+        }
+        memcpy(line, slot->lines[slot->head], sizeof(line));
+        slot->head = (slot->head + 1) % FARM_QUEUE_LINES;
+        slot->count--;
+        pthread_mutex_unlock(&slot->lock);
+
+        bool running = game_command(slot->game, line);
+        ran++;
+
+        // Counted before the line is finished, so stats are complete
+        // once game_farm_drain returns
+        atomic_fetch_add(&farm->commands, 1);
+        if (stealing) atomic_fetch_add(&farm->stolen, 1);
+        finish_lines(farm, slot, 1);
+
+        if (!running) {
+            // Drop whatever the player typed after quitting
+            atomic_store(&slot->finished, true);
+            pthread_mutex_lock(&slot->lock);
+            int dropped = slot->count;
+            slot->count = 0;
+            pthread_mutex_unlock(&slot->lock);
+            if (dropped > 0) finish_lines(farm, slot, dropped);
+            break;
+        }
+    }
+
+    release_game(farm, slot);
+    return ran > 0;
+}
+
+// Helper: Sleep until a game may have become runnable since `seen` was
+// read, or the farm stops
+static void wait_for_work(GameFarm *farm, unsigned seen) {
+    pthread_mutex_lock(&farm->lock);
+    atomic_fetch_add(&farm->sleeping, 1);
+    while (atomic_load(&farm->runnable) == seen && !atomic_load(&farm->stopping)) {
+        pthread_cond_wait(&farm->work, &farm->lock);
+    }
+    atomic_fetch_sub(&farm->sleeping, 1);
+    pthread_mutex_unlock(&farm->lock);
+}
+
+static void* worker_main(void *arg) {
+    Worker *worker = arg;
+    GameFarm *farm = worker->farm;
+    int step = farm->worker_count;
+    int victim = worker->id;
+
+    while (!atomic_load(&farm->stopping)) {
+        // Read before looking, so nothing that becomes runnable during the
+        // search is slept through
+        unsigned seen = atomic_load(&farm->runnable);
+        int count = atomic_load(&farm->game_count);
+
+        // Own games first: they stay on this worker's cache
+        bool ran = false;
+        for (int g = worker->id; g < count; g += step) {
+            if (run_slice(farm, g, false)) ran = true;
+        }
+        if (ran) continue;
+
+        // Own games idle: take one slice of another worker's backlog,
+        // starting where the last search stopped so victims rotate
+        for (int i = 0; i < count && !ran; i++) {
+            victim = (victim + 1) % count;
+            if (victim % step != worker->id) ran = run_slice(farm, victim, true);
+        }
+        if (ran) continue;
+
+        // Nothing to run, or every game with input is being run elsewhere:
+        // sleep until input arrives or one of those games is released
+        wait_for_work(farm, seen);
+    }
+    return NULL;
+}
+
+GameFarm* game_farm_create(int workers, int max_games) {
+    if (workers < 1 || workers > FARM_MAX_WORKERS || max_games < 1) return NULL;
+
+    GameFarm *farm = calloc(1, sizeof(GameFarm));
+    if (!farm) return NULL;
+    farm->games = calloc((size_t)max_games, sizeof(FarmGame));
+    if (!farm->games) {
+        free(farm);
+        return NULL;
+    }
+    farm->max_games = max_games;
+    farm->worker_count = workers;
+    pthread_mutex_init(&farm->lock, NULL);
+    pthread_cond_init(&farm->work, NULL);
+    pthread_cond_init(&farm->released, NULL);
+    pthread_cond_init(&farm->drained, NULL);
+
+    for (int w = 0; w < workers; w++) {
+        farm->workers[w].farm = farm;
+        farm->workers[w].id = w;
+        if (pthread_create(&farm->threads[w], NULL, worker_main, &farm->workers[w]) != 0) {
+            game_farm_destroy(farm);
+            return NULL;
+        }
+        farm->started++;
+    }
+    return farm;
+}
+
+void game_farm_destroy(GameFarm *farm) {
+    if (!farm) return;
+
+    atomic_store(&farm->stopping, true);
+    pthread_mutex_lock(&farm->lock);
+    pthread_cond_broadcast(&farm->work);
+    pthread_mutex_unlock(&farm->lock);
+    for (int w = 0; w < farm->started; w++) {
+        pthread_join(farm->threads[w], NULL);
+    }
+
+    int count = atomic_load(&farm->game_count);
+    for (int g = 0; g < count; g++) {
+        pthread_mutex_destroy(&farm->games[g].lock);
+    }
+    pthread_cond_destroy(&farm->drained);
+    pthread_cond_destroy(&farm->released);
+    pthread_cond_destroy(&farm->work);
+    pthread_mutex_destroy(&farm->lock);
+    free(farm->games);
+    free(farm);
+}
+
+int game_farm_add(GameFarm *farm, Game *game) {
+    // Games are added by one thread; workers only see complete slots
+    int id = atomic_load(&farm->game_count);
+    if (id >= farm->max_games || !game) return -1;
+
+    FarmGame *slot = &farm->games[id];
+    slot->game = game;
+    pthread_mutex_init(&slot->lock, NULL);
+    atomic_init(&slot->pending, 0);
+    atomic_init(&slot->claimed, false);
+    atomic_init(&slot->finished, false);
+    atomic_store(&farm->game_count, id + 1);
+    return id;
+}
+
+bool game_farm_submit(GameFarm *farm, int game_id, const char *line) {
+    if (game_id < 0 || game_id >= atomic_load(&farm->game_count) || !line) return false;
+
+    FarmGame *slot = &farm->games[game_id];
+    if (atomic_load(&slot->finished)) return false;
+
+    pthread_mutex_lock(&slot->lock);
+    if (slot->count == FARM_QUEUE_LINES) {
+        pthread_mutex_unlock(&slot->lock);
+        return false;
+    }
+    char *dest = slot->lines[(slot->head + slot->count) % FARM_QUEUE_LINES];
+    strncpy(dest, line, FARM_LINE_SIZE - 1);
+    dest[FARM_LINE_SIZE - 1] = '\0';
+    slot->count++;
+    atomic_fetch_add(&slot->pending, 1);
+    atomic_fetch_add(&farm->pending, 1);
+    pthread_mutex_unlock(&slot->lock);
+
+    announce_runnable(farm);
+    return true;
+}
+
+void game_farm_drain(GameFarm *farm) {
+    pthread_mutex_lock(&farm->lock);
+    while (atomic_load(&farm->pending) > 0) {
+        pthread_cond_wait(&farm->drained, &farm->lock);
+    }
+    pthread_mutex_unlock(&farm->lock);
+}
+
+int game_farm_reload(GameFarm *farm, const char *world_name, World *next) {
+    WorldDiff diff = {0};
+    WorldDef *from = NULL;    // Held so diff.from outlives the games moved off it
+    int moved = 0;
+    int count = atomic_load(&farm->game_count);
+    atomic_fetch_add(&farm->reloading, 1);
+    for (int g = 0; g < count && moved >= 0; g++) {
+        FarmGame *slot = &farm->games[g];
+
+        // Wait out the worker running it (workers skip claimed games)
+        pthread_mutex_lock(&farm->lock);
+        bool expected = false;
+        while (!atomic_compare_exchange_strong(&slot->claimed, &expected, true)) {
+            pthread_cond_wait(&farm->released, &farm->lock);
+            expected = false;
+        }
+        pthread_mutex_unlock(&farm->lock);
+
+        Game *game = slot->game;
+        if (strcmp(game->world_name, world_name) == 0 && game->world.def != next->def) {
+            if (game->world.def != from) {
+                world_diff_free(&diff);
+                world_def_release(from);
+                from = world_def_retain(game->world.def);
+                if (!world_diff_build(&diff, &game->world, next)) moved = -1;
+            }
+            if (moved >= 0 && game_reload(game, &diff)) moved++;
+        }
+        release_game(farm, slot);
+    }
+    atomic_fetch_sub(&farm->reloading, 1);
+    world_diff_free(&diff);
+    world_def_release(from);
+    return moved;
+}
+
+bool game_farm_finished(GameFarm *farm, int game_id) {
+    if (game_id < 0 || game_id >= atomic_load(&farm->game_count)) return false;
+    return atomic_load(&farm->games[game_id].finished);
+}
+
+void game_farm_stats(GameFarm *farm, long long *commands, long long *stolen) {
+    if (commands) *commands = atomic_load(&farm->commands);
+    if (stolen) *stolen = atomic_load(&farm->stolen);
+}
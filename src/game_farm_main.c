@@ -0,0 +1,198 @@
+/*
+ * Game Farm - runs many single-player games on one worker pool
+ *
+ * Usage: game-farm <world> <games> <workers> [script]
+ *
+ * Every game plays the script (stdin if omitted), one line per game in
+ * turn, the way a room full of players would type. All games share one
+ * copy of the world definition. Reports commands per second and how much
+ * work was stolen between workers. Saving worlds/<world>.world while it
+ * runs moves every game onto the new version (world_reload.h).
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <time.h>
+#include "game_farm.h"
+#include "world_watch.h"
+
+#define MAX_SCRIPT_LINES 100000
+
+// Output is counted, not printed: a game's sink only ever runs on the
+// worker currently running that game
+static void count_line(void *ctx, const char *text, OutputStyle style) {
+    (void)text;
+    (void)style;
+    (*(long long *)ctx)++;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Helper: Read the script into memory, one string per line
+static char** read_script(FILE *in, int *count) {
+    char **lines = malloc(MAX_SCRIPT_LINES * sizeof(char *));
+    if (!lines) return NULL;
+
+    char buffer[256];
+    *count = 0;
+    while (*count < MAX_SCRIPT_LINES && fgets(buffer, sizeof(buffer), in)) {
+        buffer[strcspn(buffer, "\r\n")] = '\0';
+        lines[*count] = strdup(buffer);
+        if (!lines[*count]) break;
+        (*count)++;
+    }
+    return lines;
+}
+
+// Helper: Move the games onto a saved version of their world (loaded is
+// the stamp of the file version they are on)
+static void reload_changed_world(GameFarm *farm, WorldWatcher *watcher, const char *world_name,
+                                 WorldSourceStamp *loaded) {
+    char name[64];
+    bool changed = false;
+    while (world_watcher_next(watcher, name, sizeof(name))) {
+        if (strcmp(name, world_name) == 0) {
+            changed = true;
+        } else if (strcmp(name, WORLD_WATCH_RESCAN) == 0) {
+            // Saves were missed: compare the file with the version loaded
+            changed = changed || game_world_changed(world_name, loaded);
+        }
+    }
+    if (!changed) return;
+    game_world_changed(world_name, loaded);
+
+    World next;
+    LoadError error;
+    if (!game_load_world(world_name, &next, &error)) {
+        fprintf(stderr, "Warning: %s changed but did not load: %s\n", world_name,
+                world_loader_get_error(&error));
+        return;
+    }
+    int moved = game_farm_reload(farm, world_name, &next);
+    fprintf(stderr, "Reloaded %s: %d games moved\n", world_name, moved);
+    world_free(&next);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 4 || argc > 5) {
+        fprintf(stderr, "Usage: %s <world> <games> <workers> [script]\n", argv[0]);
+        return 2;
+    }
+    const char *world_name = argv[1];
+    int game_count = atoi(argv[2]);
+    int worker_count = atoi(argv[3]);
+    if (game_count < 1 || worker_count < 1 || worker_count > FARM_MAX_WORKERS) {
+        fprintf(stderr, "Error: need at least one game and 1-%d workers\n", FARM_MAX_WORKERS);
+        return 2;
+    }
+
+    FILE *in = stdin;
+    if (argc == 5 && strcmp(argv[4], "-") != 0) {
+        in = fopen(argv[4], "r");
+        if (!in) {
+            fprintf(stderr, "Error: Cannot open script: %s\n", argv[4]);
+            return 1;
+        }
+    }
+    int script_len = 0;
+    char **script = read_script(in, &script_len);
+    if (in != stdin) fclose(in);
+    if (!script) {
+        fprintf(stderr, "Error: out of memory\n");
+        return 1;
+    }
+
+    // One load; every game shares its definition
+    Game base;
+    LoadError error;
+    game_init(&base, NULL);
+    if (!game_open(&base, world_name, &error)) {
+        fprintf(stderr, "Error: %s\n", world_loader_get_error(&error));
+        game_free(&base);
+        return 1;
+    }
+
+    Game *games = malloc((size_t)game_count * sizeof(Game));
+    long long *output_lines = calloc((size_t)game_count, sizeof(long long));
+    GameFarm *farm = game_farm_create(worker_count, game_count);
+    if (!games || !output_lines || !farm) {
+        fprintf(stderr, "Error: cannot start %d games on %d workers\n", game_count, worker_count);
+        return 1;
+    }
+
+    int started = 0;
+    for (; started < game_count; started++) {
+        Game *game = &games[started];
+        OutputSink sink = { .write = count_line, .ctx = &output_lines[started] };
+        game_init(game, &sink);
+        if (!game_open_shared(game, &base.world, world_name)) {
+            game_free(game);
+            break;
+        }
+        game_start(game);
+        game_farm_add(farm, game);
+    }
+    if (started < game_count) {
+        fprintf(stderr, "Warning: only %d games started\n", started);
+    }
+
+    // Feed line i of the script to every game before line i + 1; a full
+    // queue means that game's worker is behind, so move on and come back
+    WorldWatcher *watcher = world_watcher_open("worlds");
+    WorldSourceStamp loaded = {0};
+    game_world_changed(world_name, &loaded);
+    double start = now_sec();
+    int *next_line = calloc((size_t)started + 1, sizeof(int));
+    int remaining = started;
+    while (remaining > 0 && next_line) {
+        bool progress = false;
+        remaining = 0;
+        for (int g = 0; g < started; g++) {
+            if (next_line[g] >= script_len || game_farm_finished(farm, g)) continue;
+            if (game_farm_submit(farm, g, script[next_line[g]])) {
+                next_line[g]++;
+                progress = true;
+            }
+            if (next_line[g] < script_len) remaining++;
+        }
+        if (!progress) sched_yield();
+        if (watcher) reload_changed_world(farm, watcher, world_name, &loaded);
+    }
+    game_farm_drain(farm);
+    double elapsed = now_sec() - start;
+
+    long long commands = 0, stolen = 0, lines = 0;
+    game_farm_stats(farm, &commands, &stolen);
+    for (int g = 0; g < started; g++) {
+        lines += output_lines[g];
+    }
+
+    printf("games: %d  workers: %d  script: %d lines\n", started, worker_count, script_len);
+    printf("commands: %lld in %.3f s (%.0f commands/s)\n", commands, elapsed,
+           elapsed > 0 ? (double)commands / elapsed : 0.0);
+    printf("stolen: %lld (%.1f%%)  output lines: %lld\n", stolen,
+           commands > 0 ? 100.0 * (double)stolen / (double)commands : 0.0, lines);
+
+    world_watcher_close(watcher);
+    game_farm_destroy(farm);
+    for (int g = 0; g < started; g++) {
+        game_free(&games[g]);
+    }
+    game_free(&base);
+    for (int i = 0; i < script_len; i++) {
+        free(script[i]);
+    }
+    free(script);
+    free(next_line);
+    free(output_lines);
+    free(games);
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * Adventure Engine - ID Index Implementation
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "id_index.h"
+
+#define ID_INDEX_MIN_CAPACITY 16
+
+void id_index_init(IdIndex *index) {
+    index->hashes = NULL;
+    index->slots = NULL;
+    index->capacity = 0;
+    index->count = 0;
+}
+
+void id_index_free(IdIndex *index) {
+    free(index->hashes);
+    free(index->slots);
+    id_index_init(index);
+}
+
+uint32_t id_hash(const char *id) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)id; *p; p++) {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    // 0 marks an empty bucket
+    return hash ? hash : 1;
+}
+
+// Helper: Place a pre-hashed entry (table must have a free bucket)
+static void place_entry(uint32_t *hashes, int *slots, int capacity, uint32_t hash, int slot) {
+    int mask = capacity - 1;
+    int bucket = (int)(hash & (uint32_t)mask);
+    while (hashes[bucket] != 0) {
+        bucket = (bucket + 1) & mask;
+    }
+    hashes[bucket] = hash;
+    slots[bucket] = slot;
+}
+
+// Helper: Grow to new_capacity and rehash (stored hashes avoid re-reading keys)
+static bool grow(IdIndex *index, int new_capacity) {
+    uint32_t *hashes = calloc((size_t)new_capacity, sizeof(uint32_t));
+    int *slots = malloc((size_t)new_capacity * sizeof(int));
+    if (!hashes || !slots) {
+        free(hashes);
+        free(slots);
+        return false;
+    }
+
+    for (int i = 0; i < index->capacity; i++) {
+        if (index->hashes[i] != 0) {
+            place_entry(hashes, slots, new_capacity, index->hashes[i], index->slots[i]);
+        }
+    }
+
+    free(index->hashes);
+    free(index->slots);
+    index->hashes = hashes;
+    index->slots = slots;
+    index->capacity = new_capacity;
+    return true;
+}
+
+bool id_index_insert(IdIndex *index, const char *id, int slot) {
+    // Keep load factor at or below 50% so probe chains stay short
+    if ((index->count + 1) * 2 > index->capacity) {
+        int new_capacity = index->capacity ? index->capacity * 2 : ID_INDEX_MIN_CAPACITY;
+        if (!grow(index, new_capacity)) return false;
+    }
+
+    place_entry(index->hashes, index->slots, index->capacity, id_hash(id), slot);
+    index->count++;
+    return true;
+}
+
+int id_index_find(const IdIndex *index, const char *id, IdIndexKeyFn key_at, const void *ctx) {
+    if (index->capacity == 0 || !id) return -1;
+
+    uint32_t hash = id_hash(id);
+    int mask = index->capacity - 1;
+    int bucket = (int)(hash & (uint32_t)mask);
+
+    while (index->hashes[bucket] != 0) {
+        if (index->hashes[bucket] == hash &&
+            strcmp(key_at(ctx, index->slots[bucket]), id) == 0) {
+            return index->slots[bucket];
+        }
+        bucket = (bucket + 1) & mask;
+    }
+    return -1;
+}
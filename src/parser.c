@@ -6,14 +6,18 @@
  *   - Single-word commands (look, quit, inventory)
  *   - Two-word commands (go north, take key)
  *   - Multi-word nouns (take rusty key, examine burning torch)
+ *   - Several commands in one line (take key, north then look)
  *   - Case-insensitive matching
  *   - Whitespace normalization
  *
  * Algorithm:
- *   1. Copy input to working buffer
- *   2. Trim and lowercase the input
- *   3. Split on first space: verb + noun
- *   4. Noun contains everything after first space (allows multi-word items)
+ *   1. Skip whitespace and separators (',' and "then")
+ *   2. Take words up to the next separator as one command
+ *   3. Split on the first whitespace: verb + noun
+ *   4. Noun contains everything after the verb (allows multi-word items)
+ *
+ * The tokenizer returns slices of the input, so running a command copies
+ * nothing; parse_input makes lowercased copies for callers that want them.
  *
  * Examples:
  *   "look"              -> verb="look", noun=""
@@ -26,54 +30,105 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <strings.h>
 #include "parser.h"
 
 /*
- * Helper: Convert string to lowercase in-place
- * Used for case-insensitive command matching
+ * Helper: Length of the word at p (up to whitespace, ',' or the end)
  */
-static void to_lower(char *str) {
-    for (int i = 0; str[i]; i++) {
-        str[i] = tolower(str[i]);
-    }
+static size_t word_length(const char *p) {
+    size_t len = 0;
+    while (p[len] && p[len] != ',' && !isspace((unsigned char)p[len])) len++;
+    return len;
 }
 
 /*
- * Helper: Trim leading and trailing whitespace from string
- * Returns pointer to trimmed string (modifies in-place)
+ * Helper: Check whether a word is the separator "then" (any case)
+ */
+static bool is_then(const char *word, size_t len) {
+    return len == 4 && strncasecmp(word, "then", 4) == 0;
+}
+
+/*
+ * Split the next command off an input line
+ *
+ * Nothing is copied or modified: the verb, noun and whole command are
+ * slices of the line, in the case they were typed. A command ends at a
+ * ',' or at the word "then", so one line can hold several commands.
+ *
+ * Parameters:
+ *   line - Position in the input line; advanced past the command
+ *   cmd  - Filled with slices of the command
+ *
+ * Returns:
+ *   true if a command was found, false at the end of the line
  *
  * Examples:
- *   "  hello  " -> "hello"
- *   "\thello\n" -> "hello"
+ *   "look"                   -> verb="look", noun=""
+ *   "  take   rusty key "    -> verb="take", noun="rusty key"
+ *   "take key, north"        -> "take key", then "north"
+ *   "open door then go in"   -> "open door", then "go in"
  */
-static char* trim(char *str) {
-    // Trim leading whitespace
-    while (isspace(*str)) str++;
+bool parse_next_command(const char **line, CommandView *cmd) {
+    const char *p = *line;
+    if (!p) return false;
+
+    // Skip whitespace and separators in front of the command
+    for (;;) {
+        while (*p == ',' || isspace((unsigned char)*p)) p++;
+        size_t len = word_length(p);
+        if (!is_then(p, len)) break;
+        p += len;
+    }
+    if (*p == '\0') {
+        *line = p;
+        return false;
+    }
 
-    // Handle empty string
-    if (*str == 0) return str;
+    // The command runs word by word up to the next separator
+    const char *start = p;
+    const char *end = p;
+    while (*p && *p != ',') {
+        size_t len = word_length(p);
+        if (p != start && is_then(p, len)) break;
+        p += len;
+        end = p;
+        while (isspace((unsigned char)*p)) p++;
+    }
 
-    // Trim trailing whitespace
-    char *end = str + strlen(str) - 1;
-    while (end > str && isspace(*end)) end--;
-    *(end + 1) = 0;  // Null terminate
+    cmd->verb.text = start;
+    cmd->verb.len = word_length(start);
+    const char *noun = start + cmd->verb.len;
+    while (noun < end && isspace((unsigned char)*noun)) noun++;
+    cmd->noun.text = noun;
+    cmd->noun.len = (size_t)(end - noun);
+    cmd->text.text = start;
+    cmd->text.len = (size_t)(end - start);
+    *line = p;
+    return true;
+}
 
-    return str;
+void token_copy(Token token, char *buffer, size_t size) {
+    if (size == 0) return;
+    size_t len = token.len < size - 1 ? token.len : size - 1;
+    for (size_t i = 0; i < len; i++) {
+        buffer[i] = (char)tolower((unsigned char)token.text[i]);
+    }
+    buffer[len] = '\0';
 }
 
 /*
  * Parse user input into a Command structure
  *
- * This is the main parsing function. It extracts a verb (action) and optional
- * noun (target) from user input. Multi-word nouns are supported by treating
- * everything after the first space as the noun.
+ * Copies the first command of the input (see parse_next_command) into the
+ * Command's fixed buffers, lowercased. Multi-word nouns are kept whole.
  *
  * Parameters:
  *   input - Raw user input string
  *
  * Returns:
  *   Command structure with verb and noun populated
- *   valid=true if parsing succeeded, false otherwise
+ *   valid=true if the input held a command, false otherwise
  *
  * Examples:
  *   "look"           -> {verb="look", noun="", valid=true}
@@ -85,56 +140,14 @@ Command parse_input(const char *input) {
     Command cmd = {0};
     cmd.valid = false;
 
-    // Handle NULL or empty input
-    if (!input || strlen(input) == 0) {
-        return cmd;
-    }
-
-    // Make a working copy to avoid modifying original
-    char buffer[256];
-    strncpy(buffer, input, sizeof(buffer) - 1);
-    buffer[sizeof(buffer) - 1] = '\0';
-
-    // Normalize: trim whitespace and convert to lowercase
-    char *trimmed = trim(buffer);
-    to_lower(trimmed);
-
-    // Handle single-word commands (e.g., "quit", "help", "inventory", "look")
-    // These have no noun component
-    if (strchr(trimmed, ' ') == NULL) {
-        strncpy(cmd.verb, trimmed, sizeof(cmd.verb) - 1);
-        cmd.noun[0] = '\0';
-        cmd.valid = true;
+    CommandView view;
+    if (!parse_next_command(&input, &view)) {
         return cmd;
     }
 
-    // Parse verb + noun pattern
-    // Split on first space: everything before = verb, everything after = noun
-    // This allows multi-word nouns like "rusty key" or "burning torch"
-    char *space = strchr(trimmed, ' ');
-    if (space) {
-        // Extract verb (everything before first space)
-        size_t verb_len = space - trimmed;
-        if (verb_len >= sizeof(cmd.verb)) {
-            verb_len = sizeof(cmd.verb) - 1;  // Clamp to buffer size
-        }
-        strncpy(cmd.verb, trimmed, verb_len);
-        cmd.verb[verb_len] = '\0';
-
-        // Extract noun (everything after first space, trimmed)
-        // Trim again to handle multiple spaces between verb and noun
-        char *noun_start = trim(space + 1);
-        strncpy(cmd.noun, noun_start, sizeof(cmd.noun) - 1);
-        cmd.noun[sizeof(cmd.noun) - 1] = '\0';
-
-        cmd.valid = true;
-    } else {
-        // Fallback: single word (redundant with above check, but safe)
-        strncpy(cmd.verb, trimmed, sizeof(cmd.verb) - 1);
-        cmd.noun[0] = '\0';
-        cmd.valid = true;
-    }
-
+    token_copy(view.verb, cmd.verb, sizeof(cmd.verb));
+    token_copy(view.noun, cmd.noun, sizeof(cmd.noun));
+    cmd.valid = true;
     return cmd;
 }
 
@@ -0,0 +1,572 @@
+/*
+ * Adventure Engine - Session Recordings Implementation
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include "recording.h"
+#include "save_load.h"
+#include "varint.h"
+#include "world_image.h"
+#include "world_reload.h"
+
+#define RECORDING_MAGIC "AERC"
+#define INDEX_MAGIC "AERI"
+#define TRAILER_SIZE 12          // Index offset (8 bytes, little-endian) + INDEX_MAGIC
+#define MAX_RECORD_SIZE (64u << 20)
+
+// Record types
+#define RECORD_COMMAND 'C'       // Command text, rerun when seeking
+#define RECORD_STATE_COMMAND 'S' // Command text plus the state it produced
+#define RECORD_KEYFRAME 'K'      // State between commands
+#define RECORD_WORLD 'W'         // A definition: kind byte, then its image
+#define RECORD_INDEX 'I'         // Keyframe and definition index, written at close
+
+// Kinds of definition record
+#define WORLD_START 'S'          // Played before the first reload
+#define WORLD_RELOAD 'R'         // Played from this record on
+
+// Helper: Grow a record buffer to hold size bytes
+static bool reserve(unsigned char **buffer, size_t *buffer_size, size_t size) {
+    if (size <= *buffer_size) return true;
+    size_t grown = *buffer_size ? *buffer_size : 1024;
+    while (grown < size) grown *= 2;
+    unsigned char *data = realloc(*buffer, grown);
+    if (!data) return false;
+    *buffer = data;
+    *buffer_size = grown;
+    return true;
+}
+
+// Helper: Write one record: type byte, varint payload length, payload
+static void write_record(Recorder *recorder, char type, const unsigned char *payload, size_t size) {
+    unsigned char header[1 + VARINT_MAX_BYTES];
+    header[0] = (unsigned char)type;
+    size_t header_size = (size_t)(varint_put(header + 1, size) - header);
+    if (fwrite(header, 1, header_size, recorder->file) != header_size ||
+        fwrite(payload, 1, size, recorder->file) != size) {
+        recorder->failed = true;
+    }
+}
+
+// Helper: Remember that the next record holds the state at the current turn
+static void add_keyframe(Recorder *recorder) {
+    if (recorder->keyframe_count == recorder->keyframe_capacity) {
+        int capacity = recorder->keyframe_capacity ? recorder->keyframe_capacity * 2 : 64;
+        RecordingKeyframe *grown = realloc(recorder->keyframes, (size_t)capacity * sizeof(RecordingKeyframe));
+        if (!grown) {
+            recorder->failed = true;
+            return;
+        }
+        recorder->keyframes = grown;
+        recorder->keyframe_capacity = capacity;
+    }
+    off_t offset = ftello(recorder->file);
+    if (offset < 0) {
+        recorder->failed = true;
+        return;
+    }
+    recorder->keyframes[recorder->keyframe_count++] = (RecordingKeyframe){ recorder->turn, offset };
+}
+
+// Helper: Write a state record (a keyframe, or a command with its result)
+static void write_state(Recorder *recorder, const Game *game, char type, const char *input, size_t len) {
+    size_t size = 2 * VARINT_MAX_BYTES + len + save_state_max_size(&game->world);
+    if (!reserve(&recorder->buffer, &recorder->buffer_size, size)) {
+        recorder->failed = true;
+        return;
+    }
+
+    unsigned char *out = varint_put(recorder->buffer, (uint64_t)game->turns);
+    if (type == RECORD_STATE_COMMAND) {
+        out = varint_put(out, len);
+        memcpy(out, input, len);
+        out += len;
+    }
+    out += save_state_encode(&game->world, out);
+
+    add_keyframe(recorder);
+    if (recorder->failed) return;
+    write_record(recorder, type, recorder->buffer, (size_t)(out - recorder->buffer));
+}
+
+// Helper: Write a periodic keyframe and flush, so everything up to here
+// survives a crash
+static void write_keyframe(Recorder *recorder, const Game *game) {
+    write_state(recorder, game, RECORD_KEYFRAME, NULL, 0);
+    if (fflush(recorder->file) != 0) recorder->failed = true;
+    recorder->since_keyframe = 0;
+}
+
+// Helper: Add a definition to a writer's or reader's index
+static bool push_world(RecordingWorld **worlds, int *count, int *capacity, int64_t offset,
+                       bool start) {
+    if (*count == *capacity) {
+        int grown_capacity = *capacity ? *capacity * 2 : 4;
+        RecordingWorld *grown = realloc(*worlds, (size_t)grown_capacity * sizeof(RecordingWorld));
+        if (!grown) return false;
+        *worlds = grown;
+        *capacity = grown_capacity;
+    }
+    (*worlds)[(*count)++] = (RecordingWorld){ offset, start, NULL };
+    return true;
+}
+
+// Helper: Store the game's definition as a compiled image
+static void write_world(Recorder *recorder, Game *game, char kind) {
+    LoadError error;
+    size_t size;
+    void *image = world_image_encode(&game->world, NULL, &size, &error);
+    off_t offset = ftello(recorder->file);
+    if (!image || offset < 0 ||
+        !push_world(&recorder->worlds, &recorder->world_count, &recorder->world_capacity,
+                    offset, kind == WORLD_START)) {
+        free(image);
+        recorder->failed = true;
+        return;
+    }
+
+    unsigned char header[2 + VARINT_MAX_BYTES];
+    header[0] = RECORD_WORLD;
+    unsigned char *out = varint_put(header + 1, 1 + size);
+    *out++ = (unsigned char)kind;
+    size_t header_size = (size_t)(out - header);
+    if (fwrite(header, 1, header_size, recorder->file) != header_size ||
+        fwrite(image, 1, size, recorder->file) != size) {
+        recorder->failed = true;
+    }
+    free(image);
+}
+
+bool recorder_open(Recorder *recorder, const char *path, int interval) {
+    memset(recorder, 0, sizeof(Recorder));
+    recorder->interval = interval > 0 ? interval : RECORDING_KEYFRAME_INTERVAL;
+    recorder->file = fopen(path, "wb");
+    if (!recorder->file) return false;
+
+    // Commands are small; let them collect into large writes
+    setvbuf(recorder->file, NULL, _IOFBF, 1 << 16);
+    return true;
+}
+
+void recorder_start(Recorder *recorder, const Game *game) {
+    if (recorder->failed) return;
+
+    if (!recorder->started) {
+        unsigned char header[4 + 1 + VARINT_MAX_BYTES + 1 + sizeof(game->world_name)];
+        unsigned char *out = header;
+        memcpy(out, RECORDING_MAGIC, 4);
+        out += 4;
+        *out++ = RECORDING_VERSION;
+        out = varint_put(out, (uint64_t)recorder->interval);
+        size_t name_len = strnlen(game->world_name, sizeof(game->world_name) - 1);
+        *out++ = (unsigned char)name_len;
+        memcpy(out, game->world_name, name_len);
+        out += name_len;
+        size_t size = (size_t)(out - header);
+        if (fwrite(header, 1, size, recorder->file) != size) recorder->failed = true;
+        recorder->started = true;
+    }
+
+    // A restarted game is a new state at the same turn
+    write_keyframe(recorder, game);
+}
+
+void recorder_command(Recorder *recorder, const Game *game, const char *input, size_t len,
+                      bool replayable) {
+    if (recorder->failed || !recorder->started) return;
+
+    recorder->turn++;
+    if (replayable) {
+        write_record(recorder, RECORD_COMMAND, (const unsigned char *)input, len);
+    } else {
+        write_state(recorder, game, RECORD_STATE_COMMAND, input, len);
+    }
+    if (++recorder->since_keyframe >= recorder->interval && !recorder->failed) {
+        write_keyframe(recorder, game);
+    }
+}
+
+void recorder_reloading(Recorder *recorder, Game *game) {
+    if (recorder->failed || !recorder->started || recorder->start_saved) return;
+
+    // Until now the world file named the definition; it is about to change
+    write_world(recorder, game, WORLD_START);
+    recorder->start_saved = true;
+}
+
+void recorder_reloaded(Recorder *recorder, Game *game) {
+    if (recorder->failed || !recorder->started) return;
+
+    // Keyframes from here on are in the new definition's layout
+    write_world(recorder, game, WORLD_RELOAD);
+    if (!recorder->failed) write_keyframe(recorder, game);
+}
+
+bool recorder_close(Recorder *recorder) {
+    if (!recorder->file) return false;
+
+    if (recorder->started && !recorder->failed) {
+        // Index: turn count, then (turn, offset) of every keyframe as deltas,
+        // then (offset delta, kind) of every stored definition
+        size_t size = (3 + 2 * (size_t)recorder->keyframe_count + 2 * (size_t)recorder->world_count) *
+                      VARINT_MAX_BYTES;
+        off_t index_offset = ftello(recorder->file);
+        if (index_offset < 0 || !reserve(&recorder->buffer, &recorder->buffer_size, size)) {
+            recorder->failed = true;
+        } else {
+            unsigned char *out = varint_put(recorder->buffer, (uint64_t)recorder->turn);
+            out = varint_put(out, (uint64_t)recorder->keyframe_count);
+            RecordingKeyframe last = { 0, 0 };
+            for (int k = 0; k < recorder->keyframe_count; k++) {
+                RecordingKeyframe *keyframe = &recorder->keyframes[k];
+                out = varint_put(out, (uint64_t)(keyframe->turn - last.turn));
+                out = varint_put(out, (uint64_t)(keyframe->offset - last.offset));
+                last = *keyframe;
+            }
+            out = varint_put(out, (uint64_t)recorder->world_count);
+            int64_t last_world = 0;
+            for (int w = 0; w < recorder->world_count; w++) {
+                RecordingWorld *world = &recorder->worlds[w];
+                out = varint_put(out, (uint64_t)(world->offset - last_world));
+                out = varint_put(out, world->start ? WORLD_START : WORLD_RELOAD);
+                last_world = world->offset;
+            }
+            write_record(recorder, RECORD_INDEX, recorder->buffer, (size_t)(out - recorder->buffer));
+
+            unsigned char trailer[TRAILER_SIZE];
+            for (int b = 0; b < 8; b++) {
+                trailer[b] = (unsigned char)((uint64_t)index_offset >> (8 * b));
+            }
+            memcpy(trailer + 8, INDEX_MAGIC, 4);
+            if (fwrite(trailer, 1, TRAILER_SIZE, recorder->file) != TRAILER_SIZE) recorder->failed = true;
+        }
+    }
+
+    if (fclose(recorder->file) != 0) recorder->failed = true;
+    bool ok = !recorder->failed;
+    free(recorder->keyframes);
+    free(recorder->worlds);
+    free(recorder->buffer);
+    memset(recorder, 0, sizeof(Recorder));
+    return ok;
+}
+
+// Helper: Read a varint straight from the file
+static bool read_varint(FILE *file, uint64_t *value) {
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = getc(file);
+        if (byte == EOF) return false;
+        *value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// Helper: Read the record at the file position into the buffer (NUL
+// terminated); false at the end of the records or if it is cut short
+static bool read_record(Recording *recording, char *type, size_t *size) {
+    off_t start = ftello(recording->file);
+    int byte = getc(recording->file);
+    uint64_t len;
+    if (start < 0 || start >= recording->records_end || byte == EOF ||
+        !read_varint(recording->file, &len) || len > MAX_RECORD_SIZE ||
+        ftello(recording->file) + (off_t)len > recording->records_end ||
+        !reserve(&recording->buffer, &recording->buffer_size, (size_t)len + 1)) {
+        return false;
+    }
+    if (fread(recording->buffer, 1, (size_t)len, recording->file) != len) return false;
+    recording->buffer[len] = '\0';
+    *type = (char)byte;
+    *size = (size_t)len;
+    return true;
+}
+
+// Helper: Add a keyframe to the reader's index
+static bool push_keyframe(Recording *recording, int *capacity, int turn, int64_t offset) {
+    if (recording->keyframe_count == *capacity) {
+        *capacity = *capacity ? *capacity * 2 : 64;
+        RecordingKeyframe *grown = realloc(recording->keyframes, (size_t)*capacity * sizeof(RecordingKeyframe));
+        if (!grown) return false;
+        recording->keyframes = grown;
+    }
+    recording->keyframes[recording->keyframe_count++] = (RecordingKeyframe){ turn, offset };
+    return true;
+}
+
+// Helper: Load the index the trailer points at
+static bool read_index(Recording *recording, int version, off_t file_size, off_t records_start) {
+    unsigned char trailer[TRAILER_SIZE];
+    if (file_size < records_start + TRAILER_SIZE ||
+        fseeko(recording->file, file_size - TRAILER_SIZE, SEEK_SET) != 0 ||
+        fread(trailer, 1, TRAILER_SIZE, recording->file) != TRAILER_SIZE ||
+        memcmp(trailer + 8, INDEX_MAGIC, 4) != 0) {
+        return false;
+    }
+    uint64_t index_offset = 0;
+    for (int b = 0; b < 8; b++) {
+        index_offset |= (uint64_t)trailer[b] << (8 * b);
+    }
+    if (index_offset < (uint64_t)records_start || index_offset >= (uint64_t)(file_size - TRAILER_SIZE)) {
+        return false;
+    }
+
+    char type;
+    size_t size;
+    recording->records_end = file_size - TRAILER_SIZE;
+    if (fseeko(recording->file, (off_t)index_offset, SEEK_SET) != 0 ||
+        !read_record(recording, &type, &size) || type != RECORD_INDEX) {
+        return false;
+    }
+
+    const unsigned char *in = recording->buffer, *end = in + size;
+    uint64_t turns, count;
+    if (!varint_get(&in, end, &turns) || !varint_get(&in, end, &count) ||
+        turns > INT32_MAX || count > size) {
+        return false;
+    }
+    int capacity = 0;
+    uint64_t turn = 0, offset = 0;
+    for (uint64_t k = 0; k < count; k++) {
+        uint64_t turn_delta, offset_delta;
+        if (!varint_get(&in, end, &turn_delta) || !varint_get(&in, end, &offset_delta)) return false;
+        turn += turn_delta;
+        offset += offset_delta;
+        if (turn > turns || offset < (uint64_t)records_start || offset >= index_offset ||
+            !push_keyframe(recording, &capacity, (int)turn, (int64_t)offset)) {
+            return false;
+        }
+    }
+
+    // Stored definitions (v2)
+    uint64_t worlds = 0;
+    if (version >= 2 && (!varint_get(&in, end, &worlds) || worlds > size)) return false;
+    int world_capacity = 0;
+    offset = 0;
+    for (uint64_t w = 0; w < worlds; w++) {
+        uint64_t offset_delta, kind;
+        if (!varint_get(&in, end, &offset_delta) || !varint_get(&in, end, &kind)) return false;
+        offset += offset_delta;
+        if (offset < (uint64_t)records_start || offset >= index_offset ||
+            (kind != WORLD_START && kind != WORLD_RELOAD) ||
+            !push_world(&recording->worlds, &recording->world_count, &world_capacity,
+                        (int64_t)offset, kind == WORLD_START)) {
+            return false;
+        }
+    }
+    recording->turns = (int)turns;
+    recording->records_end = (int64_t)index_offset;
+    recording->indexed = true;
+    return true;
+}
+
+// Helper: Rebuild the index by walking the records (a session that never
+// closed its recording); stops at the first damaged or cut-off record
+static bool scan_records(Recording *recording, off_t file_size, off_t records_start) {
+    int capacity = 0;
+    int world_capacity = 0;
+    recording->keyframe_count = 0;
+    recording->world_count = 0;
+    recording->turns = 0;
+    recording->records_end = file_size;
+    if (fseeko(recording->file, records_start, SEEK_SET) != 0) return false;
+
+    while (true) {
+        off_t offset = ftello(recording->file);
+        int type = getc(recording->file);
+        uint64_t len;
+        off_t payload;
+        if (type == EOF || !read_varint(recording->file, &len) ||
+            (payload = ftello(recording->file)) < 0 || payload + (off_t)len > file_size) {
+            recording->records_end = offset;
+            break;
+        }
+        int kind = type == RECORD_WORLD && len > 0 ? getc(recording->file) : EOF;
+        if (fseeko(recording->file, payload + (off_t)len, SEEK_SET) != 0) {
+            recording->records_end = offset;
+            break;
+        }
+        if (type == RECORD_COMMAND || type == RECORD_STATE_COMMAND) {
+            recording->turns++;
+        }
+        if (type == RECORD_STATE_COMMAND || type == RECORD_KEYFRAME) {
+            if (!push_keyframe(recording, &capacity, recording->turns, offset)) return false;
+        } else if (type == RECORD_WORLD && (kind == WORLD_START || kind == WORLD_RELOAD)) {
+            if (!push_world(&recording->worlds, &recording->world_count, &world_capacity,
+                            offset, kind == WORLD_START)) {
+                return false;
+            }
+        } else if (type != RECORD_COMMAND) {
+            recording->records_end = offset;
+            break;
+        }
+    }
+    return true;
+}
+
+bool recording_open(Recording *recording, const char *path) {
+    memset(recording, 0, sizeof(Recording));
+    recording->file = fopen(path, "rb");
+    if (!recording->file) return false;
+
+    // Header: magic, version, keyframe interval, world name
+    // (v1 recordings differ only in their index, which has no definitions)
+    unsigned char magic[5];
+    uint64_t interval;
+    int name_len;
+    bool ok = fread(magic, 1, 5, recording->file) == 5 &&
+              memcmp(magic, RECORDING_MAGIC, 4) == 0 &&
+              magic[4] >= 1 && magic[4] <= RECORDING_VERSION &&
+              read_varint(recording->file, &interval) &&
+              (name_len = getc(recording->file)) != EOF &&
+              (size_t)name_len < sizeof(recording->world_name) &&
+              fread(recording->world_name, 1, (size_t)name_len, recording->file) == (size_t)name_len;
+
+    off_t records_start = ok ? ftello(recording->file) : -1;
+    off_t file_size = -1;
+    if (ok && fseeko(recording->file, 0, SEEK_END) == 0) file_size = ftello(recording->file);
+    ok = ok && records_start >= 0 && file_size >= records_start;
+
+    if (ok && !read_index(recording, magic[4], file_size, records_start)) {
+        free(recording->keyframes);
+        free(recording->worlds);
+        recording->keyframes = NULL;
+        recording->keyframe_count = 0;
+        recording->worlds = NULL;
+        recording->world_count = 0;
+        ok = scan_records(recording, file_size, records_start);
+    }
+
+    // Seeking needs the starting state
+    ok = ok && recording->keyframe_count > 0 && recording->keyframes[0].turn == 0;
+    if (!ok) {
+        recording_close(recording);
+        return false;
+    }
+    return true;
+}
+
+void recording_close(Recording *recording) {
+    if (recording->file) fclose(recording->file);
+    for (int w = 0; w < recording->world_count; w++) {
+        world_def_release(recording->worlds[w].def);
+    }
+    free(recording->worlds);
+    free(recording->keyframes);
+    free(recording->buffer);
+    memset(recording, 0, sizeof(Recording));
+}
+
+// Helper: Apply the state in a keyframe or state-command record
+static bool apply_state(Recording *recording, Game *game, char type, size_t size) {
+    const unsigned char *in = recording->buffer, *end = in + size;
+    uint64_t turns, len = 0;
+    if (!varint_get(&in, end, &turns) || turns > INT32_MAX) return false;
+    if (type == RECORD_STATE_COMMAND) {
+        if (!varint_get(&in, end, &len) || len > (uint64_t)(end - in)) return false;
+        in += len;
+    }
+    if (!save_state_decode(&game->world, in, (size_t)(end - in))) return false;
+    game->turns = (int)turns;
+    return true;
+}
+
+// Helper: Stored definition the records at offset were played on (NULL if
+// the world was never reloaded, so the game's own is the one)
+static RecordingWorld* world_at(Recording *recording, int64_t offset) {
+    RecordingWorld *found = NULL;
+    for (int w = 0; w < recording->world_count; w++) {
+        RecordingWorld *world = &recording->worlds[w];
+        if (world->start ? !found : world->offset < offset) found = world;
+    }
+    return found;
+}
+
+// Helper: Move the game onto a stored definition, opening it on first use
+// (moves the file position)
+static bool use_world(Recording *recording, Game *game, RecordingWorld *world) {
+    if (!world->def) {
+        char type;
+        size_t size;
+        World opened;
+        LoadError error;
+        if (fseeko(recording->file, world->offset, SEEK_SET) != 0 ||
+            !read_record(recording, &type, &size) || type != RECORD_WORLD || size < 1) {
+            return false;
+        }
+        bool ok = world_image_open(&opened, recording->buffer + 1, size - 1, &error);
+        if (ok) world->def = world_def_retain(opened.def);
+        world_free(&opened);
+        if (!ok) return false;
+    }
+    return world_switch_definition(&game->world, world->def);
+}
+
+bool recording_seek(Recording *recording, Game *game, int turn) {
+    if (turn < 0 || turn > recording->turns) return false;
+
+    // Last keyframe at or before the turn
+    int lo = 0, hi = recording->keyframe_count - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (recording->keyframes[mid].turn <= turn) lo = mid;
+        else hi = mid - 1;
+    }
+    const RecordingKeyframe *keyframe = &recording->keyframes[lo];
+
+    char type;
+    size_t size;
+    int current;
+    bool ok;
+    if (recording->at_game == game && recording->at_turn <= turn && keyframe->turn <= recording->at_turn) {
+        // Already past the keyframe: carry on from the last seek
+        current = recording->at_turn;
+        ok = fseeko(recording->file, recording->at_offset, SEEK_SET) == 0;
+    } else {
+        current = keyframe->turn;
+        RecordingWorld *world = world_at(recording, keyframe->offset);
+        ok = (!world || use_world(recording, game, world)) &&
+             fseeko(recording->file, keyframe->offset, SEEK_SET) == 0 &&
+             read_record(recording, &type, &size) &&
+             (type == RECORD_KEYFRAME || type == RECORD_STATE_COMMAND) &&
+             apply_state(recording, game, type, size);
+    }
+
+    // Rerun commands up to the turn without recording them again
+    Recorder *recorder = game->recorder;
+    game->recorder = NULL;
+    while (ok && current < turn) {
+        off_t start = ftello(recording->file);
+        ok = read_record(recording, &type, &size);
+        if (!ok) break;
+        if (type == RECORD_WORLD) {
+            // A hot reload: the keyframe after it holds the state
+            RecordingWorld *world = world_at(recording, start + 1);
+            off_t next = ftello(recording->file);
+            ok = size > 0 && (recording->buffer[0] != WORLD_RELOAD ||
+                              (world && world->offset == start && use_world(recording, game, world) &&
+                               fseeko(recording->file, next, SEEK_SET) == 0));
+        } else if (type == RECORD_COMMAND) {
+            game_command(game, (const char *)recording->buffer);
+            current++;
+        } else if (type == RECORD_STATE_COMMAND) {
+            ok = apply_state(recording, game, type, size);
+            current++;
+        } else {
+            // Usually the state the game is already in, but a restarted
+            // game is only recorded as a keyframe
+            ok = type == RECORD_KEYFRAME && apply_state(recording, game, type, size);
+        }
+    }
+    game->recorder = recorder;
+
+    off_t offset = ok ? ftello(recording->file) : -1;
+    recording->at_game = offset >= 0 ? game : NULL;
+    recording->at_turn = current;
+    recording->at_offset = offset;
+    return offset >= 0;
+}
@@ -0,0 +1,273 @@
+/*
+ * Replay - plays a recorded transcript against a world and checks the result
+ *
+ * Usage: replay <world> <transcript> [--hash HEX] [--expect FILE] [--runs N]
+ *
+ * <world> is a path to a .world file, or the name of one in worlds/. The
+ * transcript holds one command per line, as typed; lines starting with '#'
+ * are comments, and a "# hash: HEX" comment gives the expected final state
+ * hash when --hash isn't used. --expect compares the full output with a
+ * file, e.g. one written by `adventure-engine --batch`. --runs plays the
+ * transcript N times (every run must end in the same state) for steadier
+ * timing. Reports turns per second and the final state hash.
+ *
+ * Exit status: 0 if every check passed, 1 on a mismatch, 2 on bad usage or
+ * unreadable input.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "game.h"
+#include "world_snapshot.h"
+
+#define MAX_TRANSCRIPT_LINES 100000
+
+// Command output collected in memory
+typedef struct {
+    char *data;
+    size_t len;
+    size_t capacity;
+    bool failed;              // Ran out of memory; data is incomplete
+} Capture;
+
+static void capture_line(void *ctx, const char *text, OutputStyle style) {
+    (void)style;
+    Capture *capture = ctx;
+    size_t len = strlen(text);
+    if (capture->failed) return;
+
+    if (capture->len + len + 2 > capture->capacity) {
+        size_t capacity = capture->capacity ? capture->capacity : 4096;
+        while (capture->len + len + 2 > capacity) capacity *= 2;
+        char *data = realloc(capture->data, capacity);
+        if (!data) {
+            capture->failed = true;
+            return;
+        }
+        capture->data = data;
+        capture->capacity = capacity;
+    }
+    memcpy(capture->data + capture->len, text, len);
+    capture->len += len;
+    capture->data[capture->len++] = '\n';
+    capture->data[capture->len] = '\0';
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Helper: Read a whole file into a NUL-terminated buffer
+static char* read_file(const char *path, size_t *len) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    size_t capacity = 4096;
+    char *data = malloc(capacity);
+    *len = 0;
+    while (data) {
+        *len += fread(data + *len, 1, capacity - *len - 1, file);
+        if (*len < capacity - 1) break;
+        capacity *= 2;
+        char *grown = realloc(data, capacity);
+        if (!grown) free(data);
+        data = grown;
+    }
+    if (data) data[*len] = '\0';
+    fclose(file);
+    return data;
+}
+
+// Helper: Read the transcript's commands, picking up a "# hash:" comment
+static char** read_transcript(FILE *in, int *count, uint64_t *hash, bool *has_hash) {
+    char **lines = malloc(MAX_TRANSCRIPT_LINES * sizeof(char *));
+    if (!lines) return NULL;
+
+    char buffer[256];
+    *count = 0;
+    while (*count < MAX_TRANSCRIPT_LINES && fgets(buffer, sizeof(buffer), in)) {
+        buffer[strcspn(buffer, "\r\n")] = '\0';
+        if (buffer[0] == '#') {
+            if (strncmp(buffer, "# hash:", 7) == 0 && !*has_hash) {
+                *hash = strtoull(buffer + 7, NULL, 16);
+                *has_hash = true;
+            }
+            continue;
+        }
+        lines[*count] = strdup(buffer);
+        if (!lines[*count]) break;
+        (*count)++;
+    }
+    return lines;
+}
+
+// Helper: Report the first line where the output differs from what was expected
+static void report_difference(const char *expected, const char *actual) {
+    int line = 1;
+    const char *e = expected, *a = actual;
+    while (*e && *e == *a) {
+        if (*e == '\n') {
+            line++;
+            expected = e + 1;
+            actual = a + 1;
+        }
+        e++;
+        a++;
+    }
+    int expected_len = (int)strcspn(expected, "\n");
+    int actual_len = (int)strcspn(actual, "\n");
+    fprintf(stderr, "Output differs at line %d\n", line);
+    fprintf(stderr, "  expected: %.*s%s\n", expected_len, expected, *expected ? "" : "(end of output)");
+    fprintf(stderr, "  actual:   %.*s%s\n", actual_len, actual, *actual ? "" : "(end of output)");
+}
+
+// Helper: Open <world> as a path if it looks like one, else from worlds/
+static bool open_world(Game *game, const char *world, LoadError *error) {
+    size_t len = strlen(world);
+    if (strchr(world, '/') || (len > 6 && strcmp(world + len - 6, ".world") == 0) ||
+        (len > 7 && strcmp(world + len - 7, ".worldc") == 0)) {
+        const char *base = strrchr(world, '/');
+        base = base ? base + 1 : world;
+        char name[64];
+        snprintf(name, sizeof(name), "%.*s", (int)strcspn(base, "."), base);
+        return game_open_file(game, world, name, error);
+    }
+    return game_open(game, world, error);
+}
+
+int main(int argc, char *argv[]) {
+    const char *usage = "Usage: %s <world> <transcript> [--hash HEX] [--expect FILE] [--runs N]\n";
+    if (argc < 3) {
+        fprintf(stderr, usage, argv[0]);
+        return 2;
+    }
+
+    uint64_t expected_hash = 0;
+    bool has_hash = false;
+    const char *expect_path = NULL;
+    int runs = 1;
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--hash") == 0 && i + 1 < argc) {
+            expected_hash = strtoull(argv[++i], NULL, 16);
+            has_hash = true;
+        } else if (strcmp(argv[i], "--expect") == 0 && i + 1 < argc) {
+            expect_path = argv[++i];
+        } else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, usage, argv[0]);
+            return 2;
+        }
+    }
+    if (runs < 1) {
+        fprintf(stderr, "Error: --runs needs a positive count\n");
+        return 2;
+    }
+
+    FILE *in = strcmp(argv[2], "-") == 0 ? stdin : fopen(argv[2], "r");
+    if (!in) {
+        fprintf(stderr, "Error: Cannot open transcript: %s\n", argv[2]);
+        return 2;
+    }
+    int length = 0;
+    char **transcript = read_transcript(in, &length, &expected_hash, &has_hash);
+    if (in != stdin) fclose(in);
+    if (!transcript) {
+        fprintf(stderr, "Error: out of memory\n");
+        return 2;
+    }
+
+    size_t expected_len = 0;
+    char *expected = NULL;
+    if (expect_path) {
+        expected = read_file(expect_path, &expected_len);
+        if (!expected) {
+            fprintf(stderr, "Error: Cannot read expected output: %s\n", expect_path);
+            return 2;
+        }
+    }
+
+    // One load; every run starts from a fresh copy of its state
+    Game base;
+    LoadError error;
+    game_init(&base, NULL);
+    if (!open_world(&base, argv[1], &error)) {
+        fprintf(stderr, "Error: %s\n", world_loader_get_error(&error));
+        game_free(&base);
+        return 2;
+    }
+
+    int status = 0;
+    uint64_t hash = 0;
+    long long commands = 0, turns = 0;
+    double elapsed = 0.0;
+    Capture capture = {0};
+    for (int run = 0; run < runs && status == 0; run++) {
+        // Only the first run's output is kept; later runs measure play alone
+        OutputSink sink = { .write = capture_line, .ctx = &capture };
+        Game game;
+        game_init(&game, run == 0 ? &sink : NULL);
+        if (!game_open_shared(&game, &base.world, base.world_name)) {
+            fprintf(stderr, "Error: out of memory\n");
+            game_free(&game);
+            status = 2;
+            break;
+        }
+        game_start(&game);
+
+        double start = now_sec();
+        int played = 0;
+        while (played < length && game_command(&game, transcript[played])) {
+            played++;
+        }
+        if (played < length) played++;    // The quit itself
+        elapsed += now_sec() - start;
+        commands += played;
+        turns += game.turns;
+
+        uint64_t run_hash = world_state_hash(&game.world);
+        if (run > 0 && run_hash != hash) {
+            fprintf(stderr, "Run %d ended in a different state: %016" PRIx64 " (first run %016" PRIx64 ")\n",
+                    run + 1, run_hash, hash);
+            status = 1;
+        }
+        hash = run_hash;
+        game_free(&game);
+    }
+
+    if (status == 0) {
+        printf("commands: %lld  turns: %lld in %.3f s (%.0f turns/s)\n", commands, turns,
+               elapsed, elapsed > 0 ? (double)turns / elapsed : 0.0);
+        printf("state hash: %016" PRIx64 "\n", hash);
+
+        if (has_hash && hash != expected_hash) {
+            fprintf(stderr, "State hash mismatch: expected %016" PRIx64 "\n", expected_hash);
+            status = 1;
+        }
+        if (expected && capture.failed) {
+            fprintf(stderr, "Error: out of memory capturing output\n");
+            status = 2;
+        } else if (expected && (capture.len != expected_len ||
+                                (capture.len > 0 && memcmp(capture.data, expected, expected_len) != 0))) {
+            report_difference(expected, capture.data ? capture.data : "");
+            status = 1;
+        }
+        if (status == 0) printf("OK\n");
+    }
+
+    free(capture.data);
+    free(expected);
+    game_free(&base);
+    for (int i = 0; i < length; i++) {
+        free(transcript[i]);
+    }
+    free(transcript);
+    return status;
+}
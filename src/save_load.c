@@ -12,10 +12,12 @@
 #include <dirent.h>
 #include <unistd.h>
 #include <ctype.h>
+#include <inttypes.h>
 #include "save_load.h"
+#include "varint.h"
 
 #define SAVE_DIR_NAME ".adventure-saves"
-#define SAVE_VERSION 3  // v3 adds description_shown and item used states
+#define SAVE_VERSION 6  // v6 indexes unlocked exits by exit rather than room * 6 + direction
 
 // Get the save directory path
 static void get_save_dir(char *buffer, size_t buffer_size) {
@@ -76,7 +78,9 @@ bool is_safe_filename(const char *filename) {
 void get_save_path(const char *slot_name, char *buffer, size_t buffer_size) {
     char save_dir[512];
     get_save_dir(save_dir, sizeof(save_dir));
-    snprintf(buffer, buffer_size, "%s/%s.sav", save_dir, slot_name);
+    // A cut-off path would name a different file; leave it empty instead
+    int len = snprintf(buffer, buffer_size, "%s/%s.sav", save_dir, slot_name);
+    if (len < 0 || (size_t)len >= buffer_size) buffer[0] = '\0';
 }
 
 bool save_exists(const char *slot_name) {
@@ -87,6 +91,18 @@ bool save_exists(const char *slot_name) {
     return stat(path, &st) == 0;
 }
 
+// Helper: Write a bitset section as one 64-bit hex word per line (v5+)
+// Bit i of word w is entry w * 64 + i.
+static void write_bits(FILE *file, const char *section, const uint64_t *bits, size_t count) {
+    fprintf(file, "[%s]\n", section);
+    for (size_t w = 0; w < BITSET_WORDS(count); w++) {
+        uint64_t word = bits[w];
+        if (w == count / 64) word &= ((uint64_t)1 << (count % 64)) - 1;
+        fprintf(file, "%016" PRIx64 "\n", word);
+    }
+    fprintf(file, "\n");
+}
+
 bool game_save(const World *world, const char *slot_name, const char *world_name) {
     // Validate slot_name to prevent path traversal
     if (!is_safe_filename(slot_name)) {
@@ -115,69 +131,125 @@ bool game_save(const World *world, const char *slot_name, const char *world_name
     // Write current state
     fprintf(file, "[STATE]\n");
     fprintf(file, "current_room: %d\n", world->current_room);
-    fprintf(file, "room_count: %d\n", world->room_count);
-    fprintf(file, "item_count: %d\n", world->item_count);
+    fprintf(file, "room_count: %d\n", world->def->room_count);
+    fprintf(file, "exit_count: %d\n", world->def->exit_count);
+    fprintf(file, "item_count: %d\n", world->def->item_count);
     fprintf(file, "\n");
 
-    // Write inventory
-    fprintf(file, "[INVENTORY]\n");
-    for (int i = 0; i < MAX_INVENTORY; i++) {
-        if (world->inventory[i] != -1) {
-            fprintf(file, "%d\n", world->inventory[i]);
-        }
+    // Write item locations (v4+): room index, -2 = inventory, -1 = nowhere
+    fprintf(file, "[ITEM_LOCATIONS]\n");
+    for (int i = 0; i < world->def->item_count; i++) {
+        fprintf(file, "%d\n", world->item_location[i].where);
     }
     fprintf(file, "\n");
 
-    // Write room visited states
-    fprintf(file, "[VISITED]\n");
-    for (int i = 0; i < world->room_count; i++) {
-        fprintf(file, "%d\n", world->rooms[i].visited ? 1 : 0);
+    // Write flag bitsets (v5+; unlocked exits are indexed by exit since v6)
+    size_t rooms = (size_t)world->def->room_count;
+    write_bits(file, "VISITED", world->visited, rooms);
+    write_bits(file, "UNLOCKED_EXITS", world->exit_unlocked, (size_t)world->def->exit_count);
+    write_bits(file, "DESCRIPTION_SHOWN", world->description_shown, rooms);
+    write_bits(file, "ITEMS_USED", world->item_used, (size_t)world->def->item_count);
+
+    fclose(file);
+    return true;
+}
+
+// Growable int list for save sections whose length depends on the world
+typedef struct {
+    int *data;
+    int count;
+    int capacity;
+} IntList;
+
+static bool int_list_push(IntList *list, int value) {
+    if (list->count >= list->capacity) {
+        int capacity = list->capacity ? list->capacity * 2 : 64;
+        int *data = realloc(list->data, (size_t)capacity * sizeof(int));
+        if (!data) return false;
+        list->data = data;
+        list->capacity = capacity;
     }
-    fprintf(file, "\n");
+    list->data[list->count++] = value;
+    return true;
+}
 
-    // Write room item placements
-    fprintf(file, "[ROOM_ITEMS]\n");
-    for (int i = 0; i < world->room_count; i++) {
-        fprintf(file, "ROOM:%d:", i);
-        int first = 1;
-        for (int j = 0; j < MAX_ITEMS; j++) {
-            if (world->rooms[i].items[j] != -1) {
-                if (!first) fprintf(file, ",");
-                fprintf(file, "%d", world->rooms[i].items[j]);
-                first = 0;
-            }
-        }
-        fprintf(file, "\n");
+// Growable bitset for flag sections (read as words in v5+, bit by bit before)
+typedef struct {
+    uint64_t *words;
+    size_t count;     // Words in use
+    size_t capacity;
+} BitList;
+
+// Helper: Make sure at least `words` words exist (new words are zero)
+static bool bit_list_reserve(BitList *list, size_t words) {
+    if (words <= list->count) return true;
+    if (words > list->capacity) {
+        size_t capacity = list->capacity ? list->capacity : 8;
+        while (capacity < words) capacity *= 2;
+        uint64_t *data = realloc(list->words, capacity * sizeof(uint64_t));
+        if (!data) return false;
+        list->words = data;
+        list->capacity = capacity;
     }
-    fprintf(file, "\n");
+    memset(list->words + list->count, 0, (words - list->count) * sizeof(uint64_t));
+    list->count = words;
+    return true;
+}
 
-    // Write unlocked exits state (v2+)
-    fprintf(file, "[UNLOCKED_EXITS]\n");
-    for (int i = 0; i < world->room_count; i++) {
-        fprintf(file, "ROOM:%d:", i);
-        for (int j = 0; j < DIR_COUNT; j++) {
-            fprintf(file, "%d", world->rooms[i].exit_unlocked[j] ? 1 : 0);
-            if (j < DIR_COUNT - 1) fprintf(file, ",");
-        }
-        fprintf(file, "\n");
+static void bit_list_push_word(BitList *list, uint64_t word) {
+    if (bit_list_reserve(list, list->count + 1)) {
+        list->words[list->count - 1] = word;
     }
-    fprintf(file, "\n");
+}
 
-    // Write description_shown states (v3+)
-    fprintf(file, "[DESCRIPTION_SHOWN]\n");
-    for (int i = 0; i < world->room_count; i++) {
-        fprintf(file, "%d\n", world->rooms[i].description_shown ? 1 : 0);
+static void bit_list_set(BitList *list, size_t bit) {
+    if (bit_list_reserve(list, bit / 64 + 1)) {
+        bitset_set(list->words, bit);
     }
-    fprintf(file, "\n");
+}
 
-    // Write item used states (v3+)
-    fprintf(file, "[ITEMS_USED]\n");
-    for (int i = 0; i < world->item_count; i++) {
-        fprintf(file, "%d\n", world->items[i].used ? 1 : 0);
+// Helper: Read one line of a flag section; `entry` counts lines in the section
+static void bit_list_parse(BitList *list, const char *line, int version, size_t entry) {
+    if (version >= 5) {
+        char *end;
+        uint64_t word = strtoull(line, &end, 16);
+        if (end != line) bit_list_push_word(list, word);
+    } else {
+        int value;
+        if (sscanf(line, "%d", &value) == 1 && value != 0) bit_list_set(list, entry);
     }
+}
 
-    fclose(file);
-    return true;
+// Helper: Copy the first `count` loaded bits into a world bitset
+static void bit_list_apply(BitList *list, uint64_t *bits, size_t count) {
+    if (bit_list_reserve(list, BITSET_WORDS(count))) {
+        bitset_copy(bits, list->words, count);
+    }
+}
+
+// Helper: Apply unlocked exits from saves before v6, indexed
+// room * DIR_COUNT + direction, to the first `rooms` rooms' exits
+static void apply_legacy_unlocked(World *world, const BitList *list, int rooms) {
+    int exits = rooms > 0 ? world_exits_end(world, rooms - 1) : 0;
+    for (int e = 0; e < exits; e++) {
+        bitset_clear(world->exit_unlocked, (size_t)e);
+    }
+    for (size_t bit = 0; bit < list->count * 64; bit++) {
+        if (!bitset_test(list->words, bit)) continue;
+        int room = (int)(bit / DIR_COUNT);
+        if (room >= rooms) break;
+        int exit_id = world_direction_exit(world, room, (Direction)(bit % DIR_COUNT));
+        if (exit_id != -1) bitset_set(world->exit_unlocked, (size_t)exit_id);
+    }
+}
+
+// Helper: Return pointer to the value list after "ROOM:<n>:" (NULL if none)
+static char* room_line_values(char *line) {
+    char *colon = strchr(line, ':');
+    if (!colon) return NULL;
+    colon = strchr(colon + 1, ':');
+    if (!colon || colon[1] == '\0') return NULL;
+    return colon + 1;
 }
 
 bool game_load(World *world, const char *slot_name, char *world_name, size_t world_name_size) {
@@ -199,41 +271,22 @@ bool game_load(World *world, const char *slot_name, char *world_name, size_t wor
     char section[64] = "";
     int version = 0;
     int room_count = 0;
+    int exit_count = 0;
     int item_count = 0;
     int current_room = 0;
 
-    // Temporary storage for loaded data
-    int inventory[MAX_INVENTORY];
-    int visited[MAX_ROOMS];
-    int room_items[MAX_ROOMS][MAX_ITEMS];
+    // Temporary storage for loaded data (sized by the save, applied at the end)
+    int inventory[MAX_INVENTORY]; // v1-v3
+    IntList item_locations = {0}; // v4+
+    IntList room_items = {0};     // (room, item) pairs, v1-v3
+    BitList visited = {0};
+    BitList unlocked_exits = {0}; // By exit (v6+), room * DIR_COUNT + direction (v2-v5)
+    BitList description_shown = {0}; // v3+
+    BitList items_used = {0};        // v3+
+    size_t entry = 0;                // Line number within the current section
 
-    // Temporary storage for unlocked exits (v2+)
-    bool unlocked_exits[MAX_ROOMS][DIR_COUNT];
-
-    // Temporary storage for v3+ features
-    bool description_shown[MAX_ROOMS];
-    bool items_used[MAX_ITEMS];
-
-    // Initialize
     for (int i = 0; i < MAX_INVENTORY; i++) inventory[i] = -1;
-    for (int i = 0; i < MAX_ROOMS; i++) {
-        visited[i] = 0;
-        description_shown[i] = false;
-        for (int j = 0; j < MAX_ITEMS; j++) {
-            room_items[i][j] = -1;
-        }
-        for (int j = 0; j < DIR_COUNT; j++) {
-            unlocked_exits[i][j] = false;
-        }
-    }
-    for (int i = 0; i < MAX_ITEMS; i++) {
-        items_used[i] = false;
-    }
-
     int inv_idx = 0;
-    int visited_idx = 0;
-    int desc_shown_idx = 0;
-    int items_used_idx = 0;
 
     while (fgets(line, sizeof(line), file)) {
         // Remove newline
@@ -250,6 +303,7 @@ bool game_load(World *world, const char *slot_name, char *world_name, size_t wor
         // Check for section
         if (line[0] == '[') {
             sscanf(line, "[%63[^]]]", section);
+            entry = 0;
             continue;
         }
 
@@ -267,6 +321,8 @@ bool game_load(World *world, const char *slot_name, char *world_name, size_t wor
                 sscanf(line + 13, "%d", &current_room);
             } else if (strncmp(line, "room_count:", 11) == 0) {
                 sscanf(line + 11, "%d", &room_count);
+            } else if (strncmp(line, "exit_count:", 11) == 0) {
+                sscanf(line + 11, "%d", &exit_count);
             } else if (strncmp(line, "item_count:", 11) == 0) {
                 sscanf(line + 11, "%d", &item_count);
             }
@@ -277,141 +333,318 @@ bool game_load(World *world, const char *slot_name, char *world_name, size_t wor
                     inventory[inv_idx++] = item_id;
                 }
             }
-        } else if (strcmp(section, "VISITED") == 0) {
-            int vis;
-            if (sscanf(line, "%d", &vis) == 1) {
-                if (visited_idx < MAX_ROOMS) {
-                    visited[visited_idx++] = vis;
-                }
+        } else if (strcmp(section, "ITEM_LOCATIONS") == 0) {
+            int where;
+            if (sscanf(line, "%d", &where) == 1) {
+                int_list_push(&item_locations, where);
             }
+        } else if (strcmp(section, "VISITED") == 0) {
+            bit_list_parse(&visited, line, version, entry);
         } else if (strcmp(section, "ROOM_ITEMS") == 0) {
-            if (strncmp(line, "ROOM:", 5) == 0) {
-                int room_idx;
-                char items_str[512];
-                if (sscanf(line, "ROOM:%d:%s", &room_idx, items_str) >= 1) {
-                    if (room_idx >= 0 && room_idx < MAX_ROOMS) {
-                        // Parse comma-separated item list
-                        char *colon = strchr(line, ':');
-                        if (colon) {
-                            colon = strchr(colon + 1, ':');
-                            if (colon && colon[1] != '\0') {
-                                char *items = colon + 1;
-                                int item_slot = 0;
-                                char *saveptr;
-                                char *token = strtok_r(items, ",", &saveptr);
-                                while (token && item_slot < MAX_ITEMS) {
-                                    int item_id;
-                                    if (sscanf(token, "%d", &item_id) == 1) {
-                                        room_items[room_idx][item_slot++] = item_id;
-                                    }
-                                    token = strtok_r(NULL, ",", &saveptr);
-                                }
-                            }
+            int room_idx;
+            if (sscanf(line, "ROOM:%d:", &room_idx) == 1 && room_idx >= 0) {
+                // Parse comma-separated item list
+                char *items = room_line_values(line);
+                if (items) {
+                    char *saveptr;
+                    char *token = strtok_r(items, ",", &saveptr);
+                    while (token) {
+                        int item_id;
+                        if (sscanf(token, "%d", &item_id) == 1) {
+                            int_list_push(&room_items, room_idx);
+                            int_list_push(&room_items, item_id);
                         }
+                        token = strtok_r(NULL, ",", &saveptr);
                     }
                 }
             }
+        } else if (strcmp(section, "UNLOCKED_EXITS") == 0 && version >= 5) {
+            bit_list_parse(&unlocked_exits, line, version, entry);
         } else if (strcmp(section, "UNLOCKED_EXITS") == 0) {
             // Parse: ROOM:0:0,0,1,0,0,0 (one value per direction)
-            if (strncmp(line, "ROOM:", 5) == 0) {
-                int room_idx;
-                if (sscanf(line, "ROOM:%d:", &room_idx) == 1) {
-                    if (room_idx >= 0 && room_idx < MAX_ROOMS) {
-                        char *colon = strchr(line, ':');
-                        if (colon) {
-                            colon = strchr(colon + 1, ':');
-                            if (colon && colon[1] != '\0') {
-                                char *exits = colon + 1;
-                                int dir_slot = 0;
-                                char *saveptr;
-                                char *token = strtok_r(exits, ",", &saveptr);
-                                while (token && dir_slot < DIR_COUNT) {
-                                    int unlocked;
-                                    if (sscanf(token, "%d", &unlocked) == 1) {
-                                        unlocked_exits[room_idx][dir_slot] = (unlocked != 0);
-                                    }
-                                    dir_slot++;
-                                    token = strtok_r(NULL, ",", &saveptr);
-                                }
-                            }
+            int room_idx;
+            if (sscanf(line, "ROOM:%d:", &room_idx) == 1 && room_idx >= 0) {
+                char *exits = room_line_values(line);
+                if (exits) {
+                    int dir_slot = 0;
+                    char *saveptr;
+                    char *token = strtok_r(exits, ",", &saveptr);
+                    while (token && dir_slot < DIR_COUNT) {
+                        int unlocked;
+                        if (sscanf(token, "%d", &unlocked) == 1 && unlocked != 0) {
+                            bit_list_set(&unlocked_exits, (size_t)room_idx * DIR_COUNT + (size_t)dir_slot);
                         }
+                        dir_slot++;
+                        token = strtok_r(NULL, ",", &saveptr);
                     }
                 }
             }
         } else if (strcmp(section, "DESCRIPTION_SHOWN") == 0) {
-            int shown;
-            if (sscanf(line, "%d", &shown) == 1) {
-                if (desc_shown_idx < MAX_ROOMS) {
-                    description_shown[desc_shown_idx++] = (shown != 0);
+            bit_list_parse(&description_shown, line, version, entry);
+        } else if (strcmp(section, "ITEMS_USED") == 0) {
+            bit_list_parse(&items_used, line, version, entry);
+        }
+        entry++;
+    }
+
+    fclose(file);
+
+    // Validate version (accept v1-v3 saves, v1 saves won't have unlocked exits)
+    bool ok = version >= 1 && version <= SAVE_VERSION;
+
+    if (ok) {
+        // Apply loaded state to world
+        world->current_room = current_room;
+
+        // Only apply state to rooms/items present in both the save and the
+        // current world structure
+        int rooms_to_apply = world->def->room_count < room_count ? world->def->room_count : room_count;
+        int items_to_apply = world->def->item_count < item_count ? world->def->item_count : item_count;
+
+        if (version >= 4) {
+            // Item locations (ignore rooms the current world doesn't have);
+            // clear first so a full inventory can't block a saved placement
+            for (int i = 0; i < items_to_apply; i++) {
+                world_set_item_location(world, i, ITEM_NOWHERE);
+            }
+            for (int i = 0; i < items_to_apply; i++) {
+                int where = i < item_locations.count ? item_locations.data[i] : ITEM_NOWHERE;
+                if (where >= rooms_to_apply) where = ITEM_NOWHERE;
+                world_set_item_location(world, i, where);
+            }
+        } else {
+            // Older saves list the inventory and each room's items; anything
+            // not listed for an applied room is out of play
+            for (int i = 0; i < world->def->item_count; i++) {
+                int where = world->item_location[i].where;
+                if (where == ITEM_IN_INVENTORY || (where >= 0 && where < rooms_to_apply)) {
+                    world_set_item_location(world, i, ITEM_NOWHERE);
                 }
             }
-        } else if (strcmp(section, "ITEMS_USED") == 0) {
-            int used;
-            if (sscanf(line, "%d", &used) == 1) {
-                if (items_used_idx < MAX_ITEMS) {
-                    items_used[items_used_idx++] = (used != 0);
+            for (int i = 0; i < MAX_INVENTORY; i++) {
+                world_set_item_location(world, inventory[i], ITEM_IN_INVENTORY);
+            }
+            for (int i = 0; i + 1 < room_items.count; i += 2) {
+                int room_idx = room_items.data[i];
+                if (room_idx < rooms_to_apply) {
+                    world_place_item(world, room_items.data[i + 1], room_idx);
                 }
             }
         }
-    }
 
-    fclose(file);
+        // Apply flag bitsets (sections missing from older saves read as clear)
+        size_t rooms = (size_t)rooms_to_apply;
+        bit_list_apply(&visited, world->visited, rooms);
+        bit_list_apply(&description_shown, world->description_shown, rooms);
+        if (version >= 6) {
+            // Exits of the applied rooms, as far as the save has them
+            int exits = rooms_to_apply > 0 ? world_exits_end(world, rooms_to_apply - 1) : 0;
+            if (exit_count < exits) exits = exit_count;
+            bit_list_apply(&unlocked_exits, world->exit_unlocked, (size_t)exits);
+        } else {
+            apply_legacy_unlocked(world, &unlocked_exits, rooms_to_apply);
+        }
+        bit_list_apply(&items_used, world->item_used, (size_t)items_to_apply);
 
-    // Validate version (accept v1 and v2 saves, v1 saves won't have unlocked exits)
-    if (version < 1 || version > SAVE_VERSION) {
-        return false;
+        // Room flags and item states were written directly
+        world_state_changed(world);
     }
 
-    // Apply loaded state to world
-    world->current_room = current_room;
+    free(item_locations.data);
+    free(room_items.data);
+    free(visited.words);
+    free(unlocked_exits.words);
+    free(description_shown.words);
+    free(items_used.words);
+    return ok;
+}
+
+// Helper: Encode a bitset as (zero words skipped, word) pairs; bits past
+// count are masked off
+static unsigned char* put_bits(unsigned char *out, const uint64_t *bits, size_t count) {
+    size_t words = BITSET_WORDS(count);
+    size_t w = 0;
+    while (w < words) {
+        size_t start = w;
+        while (w < words && bits[w] == 0) w++;
+        out = varint_put(out, w - start);
+        if (w == words) break;
+
+        uint64_t word = bits[w];
+        if (w == count / 64) word &= ((uint64_t)1 << (count % 64)) - 1;
+        out = varint_put(out, word);
+        w++;
+    }
+    return out;
+}
 
-    // Apply inventory
-    for (int i = 0; i < MAX_INVENTORY; i++) {
-        world->inventory[i] = inventory[i];
+static bool get_bits(const unsigned char **in, const unsigned char *end, uint64_t *bits, size_t count) {
+    size_t words = BITSET_WORDS(count);
+    memset(bits, 0, words * sizeof(uint64_t));
+    size_t w = 0;
+    while (w < words) {
+        uint64_t skip, word;
+        if (!varint_get(in, end, &skip) || skip > words - w) return false;
+        w += skip;
+        if (w == words) break;
+        if (!varint_get(in, end, &word)) return false;
+        bits[w++] = word;
+    }
+    if (count % 64) {
+        if (words > 0 && (bits[words - 1] >> (count % 64)) != 0) return false;
     }
+    return true;
+}
+
+size_t save_state_max_size(const World *world) {
+    size_t rooms = (size_t)world->def->room_count;
+    size_t exits = (size_t)world->def->exit_count;
+    size_t items = (size_t)world->def->item_count;
+    // Each bitset word may need a skip count before it, plus a final one
+    size_t bit_words = 2 * BITSET_WORDS(rooms) + BITSET_WORDS(exits) + BITSET_WORDS(items) + 4;
+    return (5 + 2 * items + 2 * bit_words) * VARINT_MAX_BYTES;
+}
 
-    // Apply visited states and room items
-    // Use the minimum of world's room count and save file's room count to avoid
-    // applying states to rooms that don't exist in the current world structure.
-    // If world->room_count is 0 (loading into empty world), use save file's count.
-    int rooms_to_apply = world->room_count > 0 ? world->room_count : room_count;
-    if (room_count < rooms_to_apply) rooms_to_apply = room_count;
-    if (rooms_to_apply > MAX_ROOMS) rooms_to_apply = MAX_ROOMS;
+// Helper: Encode one location's item list in order
+static unsigned char* put_location(unsigned char *out, const World *world, int location, int first) {
+    if (first == -1) return out;
+    int item = first;
+    do {
+        out = varint_put(out, (uint64_t)item);
+        out = varint_put_signed(out, location);
+        item = world->item_location[item].next;
+    } while (item != first);
+    return out;
+}
 
-    // Apply visited states
-    for (int i = 0; i < rooms_to_apply; i++) {
-        world->rooms[i].visited = visited[i];
+size_t save_state_encode(const World *world, unsigned char *buffer) {
+    const WorldDef *def = world->def;
+    unsigned char *out = buffer;
+    out = varint_put(out, (uint64_t)def->room_count);
+    out = varint_put(out, (uint64_t)def->exit_count);
+    out = varint_put(out, (uint64_t)def->item_count);
+    out = varint_put_signed(out, world->current_room);
+
+    // Placed items as (item, location) pairs, each list in its own order
+    int placed = 0;
+    for (int i = 0; i < def->item_count; i++) {
+        if (world->item_location[i].where != ITEM_NOWHERE) placed++;
+    }
+    out = varint_put(out, (uint64_t)placed);
+    out = put_location(out, world, ITEM_IN_INVENTORY, world->inventory_first);
+    for (int r = 0; r < def->room_count; r++) {
+        out = put_location(out, world, r, world->room_first_item[r]);
     }
 
-    // Apply room items using the same room count
-    for (int i = 0; i < rooms_to_apply; i++) {
-        for (int j = 0; j < MAX_ITEMS; j++) {
-            world->rooms[i].items[j] = room_items[i][j];
-        }
+    // The same flag sections as a save
+    size_t rooms = (size_t)def->room_count;
+    out = put_bits(out, world->visited, rooms);
+    out = put_bits(out, world->exit_unlocked, (size_t)def->exit_count);
+    out = put_bits(out, world->description_shown, rooms);
+    out = put_bits(out, world->item_used, (size_t)def->item_count);
+    return (size_t)(out - buffer);
+}
+
+bool save_state_decode(World *world, const unsigned char *data, size_t size) {
+    const WorldDef *def = world->def;
+    const unsigned char *in = data, *end = data + size;
+    uint64_t rooms, exits, items, placed;
+    int64_t current_room;
+    if (!varint_get(&in, end, &rooms) || !varint_get(&in, end, &exits) ||
+        !varint_get(&in, end, &items) || !varint_get_signed(&in, end, &current_room)) {
+        return false;
+    }
+    if (rooms != (uint64_t)def->room_count || exits != (uint64_t)def->exit_count ||
+        items != (uint64_t)def->item_count || current_room < 0 || current_room >= def->room_count ||
+        !varint_get(&in, end, &placed) || placed > items) {
+        return false;
     }
 
-    // Apply unlocked exits state (v2+)
-    for (int i = 0; i < rooms_to_apply; i++) {
-        for (int j = 0; j < DIR_COUNT; j++) {
-            world->rooms[i].exit_unlocked[j] = unlocked_exits[i][j];
+    // Decode everything before touching the world: item pairs, a seen bit
+    // per item, then the four bitsets
+    size_t room_words = BITSET_WORDS(rooms), exit_words = BITSET_WORDS(exits);
+    size_t item_words = BITSET_WORDS(items);
+    size_t total_words = item_words + 2 * room_words + exit_words + item_words;
+    int32_t *pairs = malloc((2 * (size_t)placed + 1) * sizeof(int32_t));
+    uint64_t *words = calloc(total_words + 1, sizeof(uint64_t));
+    if (!pairs || !words) {
+        free(pairs);
+        free(words);
+        return false;
+    }
+    uint64_t *seen = words;
+    uint64_t *visited = seen + item_words;
+    uint64_t *unlocked = visited + room_words;
+    uint64_t *shown = unlocked + exit_words;
+    uint64_t *used = shown + room_words;
+
+    bool ok = true;
+    int carried = 0;
+    for (uint64_t p = 0; p < placed && ok; p++) {
+        uint64_t item;
+        int64_t where;
+        ok = varint_get(&in, end, &item) && varint_get_signed(&in, end, &where) &&
+             item < items && !bitset_test(seen, item) &&
+             (where == ITEM_IN_INVENTORY || (where >= 0 && where < (int64_t)rooms));
+        if (!ok) break;
+        if (where == ITEM_IN_INVENTORY && ++carried > MAX_INVENTORY) ok = false;
+        bitset_set(seen, item);
+        pairs[2 * p] = (int32_t)item;
+        pairs[2 * p + 1] = (int32_t)where;
+    }
+    ok = ok && get_bits(&in, end, visited, rooms) && get_bits(&in, end, unlocked, exits) &&
+         get_bits(&in, end, shown, rooms) && get_bits(&in, end, used, items) && in == end;
+
+    if (ok) {
+        // Take everything out of play, then put items back list by list so
+        // each list keeps its order
+        for (int i = 0; i < def->item_count; i++) {
+            world_set_item_location(world, i, ITEM_NOWHERE);
+        }
+        for (uint64_t p = 0; p < placed; p++) {
+            world_set_item_location(world, pairs[2 * p], pairs[2 * p + 1]);
         }
+        world->current_room = (int)current_room;
+        memcpy(world->visited, visited, room_words * sizeof(uint64_t));
+        memcpy(world->exit_unlocked, unlocked, exit_words * sizeof(uint64_t));
+        memcpy(world->description_shown, shown, room_words * sizeof(uint64_t));
+        memcpy(world->item_used, used, item_words * sizeof(uint64_t));
+        world_state_changed(world);
     }
 
-    // Apply description_shown states (v3+)
-    for (int i = 0; i < rooms_to_apply; i++) {
-        world->rooms[i].description_shown = description_shown[i];
+    free(pairs);
+    free(words);
+    return ok;
+}
+
+bool game_read_world_name(const char *slot_name, char *world_name, size_t world_name_size) {
+    if (!is_safe_filename(slot_name)) {
+        return false;
     }
 
-    // Apply item used states (v3+)
-    int items_to_apply = world->item_count > 0 ? world->item_count : item_count;
-    if (item_count < items_to_apply) items_to_apply = item_count;
-    if (items_to_apply > MAX_ITEMS) items_to_apply = MAX_ITEMS;
+    char path[512];
+    get_save_path(slot_name, path, sizeof(path));
+
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        return false;
+    }
 
-    for (int i = 0; i < items_to_apply; i++) {
-        world->items[i].used = items_used[i];
+    char line[512];
+    bool found = false;
+    while (!found && fgets(line, sizeof(line), file)) {
+        if (line[0] == '[') break;  // Header ends at the first section
+        if (strncmp(line, "WORLD:", 6) == 0) {
+            size_t len = strlen(line);
+            if (len > 0 && line[len-1] == '\n') line[len-1] = '\0';
+            strncpy(world_name, line + 7, world_name_size - 1);
+            world_name[world_name_size - 1] = '\0';
+            found = true;
+        }
     }
 
-    return true;
+    fclose(file);
+    return found;
 }
 
 int game_list_saves(char saves[][64], int max_saves) {
@@ -0,0 +1,300 @@
+/*
+ * Adventure Engine - Verb Table Implementation
+ */
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "verbs.h"
+
+#define VERB_MAX_DISPLACE 65536   // Displacements tried per bucket before growing
+#define VERB_MAX_ATTEMPTS 8       // Table doublings before giving up
+
+// Built-in words; the first word of each verb is its canonical name
+static const VerbWord builtin_words[] = {
+    { "help", VERB_HELP },         { "?", VERB_HELP },
+    { "look", VERB_LOOK },         { "l", VERB_LOOK },
+    { "go", VERB_GO },             { "move", VERB_GO },
+    { "north", VERB_NORTH },       { "n", VERB_NORTH },
+    { "south", VERB_SOUTH },       { "s", VERB_SOUTH },
+    { "east", VERB_EAST },         { "e", VERB_EAST },
+    { "west", VERB_WEST },         { "w", VERB_WEST },
+    { "up", VERB_UP },             { "u", VERB_UP },
+    { "down", VERB_DOWN },         { "d", VERB_DOWN },
+    { "goto", VERB_GOTO },         { "travel", VERB_GOTO },
+    { "take", VERB_TAKE },         { "get", VERB_TAKE },
+    { "drop", VERB_DROP },         { "put", VERB_DROP },
+    { "inventory", VERB_INVENTORY }, { "i", VERB_INVENTORY },
+    { "examine", VERB_EXAMINE },   { "x", VERB_EXAMINE },   { "inspect", VERB_EXAMINE },
+    { "use", VERB_USE },
+    { "save", VERB_SAVE },
+    { "load", VERB_LOAD },
+    { "saves", VERB_SAVES },
+    { "undo", VERB_UNDO },
+    { "redo", VERB_REDO },
+    { "quit", VERB_QUIT },         { "exit", VERB_QUIT },
+};
+
+#define BUILTIN_COUNT ((int)(sizeof(builtin_words) / sizeof(builtin_words[0])))
+
+// Word being placed while building
+typedef struct {
+    const char *word;
+    Verb verb;
+    uint64_t hash;
+} VerbKey;
+
+// Bucket in placement order (largest first)
+typedef struct {
+    int size;
+    int bucket;
+} BucketOrder;
+
+// Helper: Spread every input bit over the whole word
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+// Helper: 64-bit FNV-1a of the lowercased word, mixed so the high half
+// (which picks the bucket) differs between words that differ only in
+// their last letters
+static uint64_t verb_hash(const char *word, size_t len) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char)tolower((unsigned char)word[i]);
+        hash *= 1099511628211ull;
+    }
+    return mix64(hash);
+}
+
+// Helper: Slot (before masking) for a hash under a displacement
+static uint32_t slot_index(uint64_t hash, uint32_t displace) {
+    return (uint32_t)mix64(hash ^ ((uint64_t)displace * 0x9e3779b97f4a7c15ull));
+}
+
+static uint32_t bucket_index(const VerbTable *table, uint64_t hash) {
+    return (uint32_t)(hash >> 32) & (uint32_t)(table->bucket_count - 1);
+}
+
+static int compare_buckets(const void *a, const void *b) {
+    const BucketOrder *x = a, *y = b;
+    if (x->size != y->size) return y->size - x->size;
+    return x->bucket - y->bucket;
+}
+
+void verb_table_init(VerbTable *table) {
+    table->displace = NULL;
+    table->slots = NULL;
+    table->text = NULL;
+    table->bucket_count = 0;
+    table->slot_count = 0;
+    table->count = 0;
+    table->text_size = 0;
+}
+
+void verb_table_free(VerbTable *table) {
+    free(table->displace);
+    free(table->slots);
+    free(table->text);
+    verb_table_init(table);
+}
+
+// Helper: Find a displacement for every bucket, largest buckets first so
+// the hardest ones see the emptiest table. Returns false if some bucket
+// has none within VERB_MAX_DISPLACE (the caller retries with more slots).
+static bool place_keys(VerbTable *table, const VerbKey *keys, const int *bucket_start,
+                       const int *bucket_keys, const BucketOrder *order) {
+    uint32_t mask = (uint32_t)table->slot_count - 1;
+    uint32_t chosen[64];
+
+    for (int o = 0; o < table->bucket_count && order[o].size > 0; o++) {
+        int b = order[o].bucket;
+        int first = bucket_start[b];
+        int size = order[o].size;
+        if (size > (int)(sizeof(chosen) / sizeof(chosen[0]))) return false;
+
+        bool placed = false;
+        for (uint32_t d = 0; d < VERB_MAX_DISPLACE && !placed; d++) {
+            placed = true;
+            for (int k = 0; k < size && placed; k++) {
+                uint32_t slot = slot_index(keys[bucket_keys[first + k]].hash, d) & mask;
+                if (table->slots[slot].verb != VERB_NONE) placed = false;
+                for (int j = 0; j < k && placed; j++) {
+                    if (chosen[j] == slot) placed = false;
+                }
+                chosen[k] = slot;
+            }
+            if (placed) table->displace[b] = d;
+        }
+        if (!placed) return false;
+
+        for (int k = 0; k < size; k++) {
+            const VerbKey *key = &keys[bucket_keys[first + k]];
+            VerbSlot *slot = &table->slots[chosen[k]];
+            slot->hash = key->hash;
+            slot->verb = key->verb;
+            slot->word = 0;   // Filled in once the text block is laid out
+        }
+    }
+    return true;
+}
+
+// Helper: Allocate buckets and slots for count words and place them
+static bool try_build(VerbTable *table, const VerbKey *keys, int count, int slot_count) {
+    int bucket_count = 1;
+    while (bucket_count * 2 < count) bucket_count *= 2;
+
+    table->displace = calloc((size_t)bucket_count, sizeof(uint32_t));
+    table->slots = malloc((size_t)slot_count * sizeof(VerbSlot));
+    int *bucket_start = calloc((size_t)bucket_count + 1, sizeof(int));
+    int *bucket_keys = malloc((size_t)count * sizeof(int));
+    BucketOrder *order = malloc((size_t)bucket_count * sizeof(BucketOrder));
+    bool ok = table->displace && table->slots && bucket_start && bucket_keys && order;
+
+    if (ok) {
+        table->bucket_count = bucket_count;
+        table->slot_count = slot_count;
+        for (int s = 0; s < slot_count; s++) {
+            table->slots[s].verb = VERB_NONE;
+        }
+
+        // Group the words by bucket (counting sort)
+        for (int k = 0; k < count; k++) {
+            bucket_start[bucket_index(table, keys[k].hash) + 1]++;
+        }
+        for (int b = 0; b < bucket_count; b++) {
+            order[b].size = bucket_start[b + 1];
+            order[b].bucket = b;
+            bucket_start[b + 1] += bucket_start[b];
+        }
+        int *fill = malloc((size_t)bucket_count * sizeof(int));
+        ok = fill != NULL;
+        if (ok) {
+            memcpy(fill, bucket_start, (size_t)bucket_count * sizeof(int));
+            for (int k = 0; k < count; k++) {
+                bucket_keys[fill[bucket_index(table, keys[k].hash)]++] = k;
+            }
+            free(fill);
+            qsort(order, (size_t)bucket_count, sizeof(BucketOrder), compare_buckets);
+            ok = place_keys(table, keys, bucket_start, bucket_keys, order);
+        }
+    }
+
+    free(bucket_start);
+    free(bucket_keys);
+    free(order);
+    if (!ok) {
+        free(table->displace);
+        free(table->slots);
+        table->displace = NULL;
+        table->slots = NULL;
+        table->bucket_count = 0;
+        table->slot_count = 0;
+    }
+    return ok;
+}
+
+bool verb_table_build(VerbTable *table, const VerbWord *extra, int extra_count) {
+    verb_table_free(table);
+
+    int total = BUILTIN_COUNT + (extra_count > 0 ? extra_count : 0);
+    VerbKey *keys = malloc((size_t)total * sizeof(VerbKey));
+    if (!keys) return false;
+
+    // Later words replace earlier ones of the same spelling; the word
+    // lists are short, so a scan of the hashes is enough
+    int count = 0;
+    for (int i = 0; i < total; i++) {
+        const VerbWord *entry = i < BUILTIN_COUNT ? &builtin_words[i] : &extra[i - BUILTIN_COUNT];
+        if (!entry->word || entry->word[0] == '\0' ||
+            entry->verb <= VERB_NONE || entry->verb >= VERB_COUNT) {
+            continue;
+        }
+        uint64_t hash = verb_hash(entry->word, strlen(entry->word));
+        int k = 0;
+        while (k < count && (keys[k].hash != hash || strcmp(keys[k].word, entry->word) != 0)) {
+            k++;
+        }
+        keys[k].word = entry->word;
+        keys[k].verb = entry->verb;
+        keys[k].hash = hash;
+        if (k == count) count++;
+    }
+
+    // Half-full tables almost always place on the first try
+    int slot_count = 16;
+    while (slot_count < count * 2) slot_count *= 2;
+    bool ok = false;
+    for (int attempt = 0; attempt < VERB_MAX_ATTEMPTS && !ok; attempt++) {
+        ok = try_build(table, keys, count, slot_count);
+        slot_count *= 2;
+    }
+
+    // Copy the words into one block and point the slots at them
+    size_t text_size = 0;
+    for (int k = 0; k < count && ok; k++) {
+        text_size += strlen(keys[k].word) + 1;
+    }
+    table->text = ok ? malloc(text_size) : NULL;
+    if (table->text) {
+        size_t offset = 0;
+        for (int k = 0; k < count; k++) {
+            size_t len = strlen(keys[k].word) + 1;
+            memcpy(table->text + offset, keys[k].word, len);
+            uint32_t b = bucket_index(table, keys[k].hash);
+            uint32_t s = slot_index(keys[k].hash, table->displace[b]) & (uint32_t)(table->slot_count - 1);
+            table->slots[s].word = (uint32_t)offset;
+            offset += len;
+        }
+        table->text_size = text_size;
+        table->count = count;
+    }
+    free(keys);
+
+    if (!table->text) {
+        verb_table_free(table);
+        return false;
+    }
+    return true;
+}
+
+Verb verb_table_find(const VerbTable *table, const char *word, size_t len) {
+    if (table->bucket_count == 0 || !word) return VERB_NONE;
+
+    uint64_t hash = verb_hash(word, len);
+    uint32_t b = bucket_index(table, hash);
+    uint32_t s = slot_index(hash, table->displace[b]) & (uint32_t)(table->slot_count - 1);
+    const VerbSlot *slot = &table->slots[s];
+    const char *stored = table->text + slot->word;
+    if (slot->verb == VERB_NONE || slot->hash != hash ||
+        strncasecmp(stored, word, len) != 0 || stored[len] != '\0') {
+        return VERB_NONE;
+    }
+    return (Verb)slot->verb;
+}
+
+Verb verb_builtin(const char *word) {
+    if (!word) return VERB_NONE;
+    for (int i = 0; i < BUILTIN_COUNT; i++) {
+        if (strcmp(builtin_words[i].word, word) == 0) return builtin_words[i].verb;
+    }
+    return VERB_NONE;
+}
+
+const char* verb_name(Verb verb) {
+    for (int i = 0; i < BUILTIN_COUNT; i++) {
+        if (builtin_words[i].verb == verb) return builtin_words[i].word;
+    }
+    return NULL;
+}
+
+size_t verb_table_memory(const VerbTable *table) {
+    return (size_t)table->bucket_count * sizeof(uint32_t) +
+           (size_t)table->slot_count * sizeof(VerbSlot) + table->text_size;
+}
@@ -2,179 +2,1163 @@
  * Adventure Engine - World System Implementation
  */
 
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
 #include "world.h"
+#include "world_journal.h"
+#include "world_route.h"
+#include "world_snapshot.h"
+
+#define WORLD_MIN_CAPACITY 16
+#define STRING_POOL_MIN_CAPACITY 4096
 
 void world_init(World *world) {
     memset(world, 0, sizeof(World));
 
-    world->room_count = 0;
-    world->item_count = 0;
+    world->item_location = NULL;
+    world->room_first_item = NULL;
     world->current_room = 0;
 
-    // Initialize exits to -1 (no exit) and locked_exits to empty
-    for (int i = 0; i < MAX_ROOMS; i++) {
-        for (int j = 0; j < DIR_COUNT; j++) {
-            world->rooms[i].exits[j] = -1;
-            world->rooms[i].locked_exits[j][0] = '\0';
-            world->rooms[i].exit_unlocked[j] = false;
-        }
-        for (int j = 0; j < MAX_ITEMS; j++) {
-            world->rooms[i].items[j] = -1;
-        }
+    // Initialize inventory
+    world->inventory_first = -1;
+    world->inventory_count = 0;
+
+    // Definition storage, string pool and ID indices allocate lazily on
+    // first insert (without a definition every world_add_* call fails)
+    world->def = calloc(1, sizeof(WorldDef));
+    if (world->def) {
+        arena_init(&world->def->arena, 0);
+        id_index_init(&world->def->room_index);
+        id_index_init(&world->def->item_index);
+        verb_table_init(&world->def->verbs);
+        atomic_init(&world->def->refcount, 1);
     }
+}
 
-    // Initialize inventory
-    for (int i = 0; i < MAX_INVENTORY; i++) {
-        world->inventory[i] = -1;
+// Helper: Free per-session state arrays
+static void free_state(World *world) {
+    free(world->item_location);
+    free(world->room_first_item);
+    free(world->visited);
+    free(world->description_shown);
+    free(world->exit_unlocked);
+    free(world->item_used);
+    free(world->description_cached);
+    free(world->cached_description);
+    world->item_location = NULL;
+    world->room_first_item = NULL;
+    world->visited = NULL;
+    world->description_shown = NULL;
+    world->exit_unlocked = NULL;
+    world->item_used = NULL;
+    world->description_cached = NULL;
+    world->cached_description = NULL;
+    world->inventory_first = -1;
+    world->inventory_count = 0;
+    world->room_capacity = 0;
+    world->exit_capacity = 0;
+    world->item_capacity = 0;
+}
+
+void world_free(World *world) {
+    world_snapshot_detach(world);
+    free_state(world);
+    world_def_release(world->def);
+    world->def = NULL;
+}
+
+WorldDef* world_def_retain(WorldDef *def) {
+    if (def) atomic_fetch_add(&def->refcount, 1);
+    return def;
+}
+
+void world_def_release(WorldDef *def) {
+    if (!def || atomic_fetch_sub(&def->refcount, 1) != 1) return;
+
+    // An image's arrays are all in its mapping (or linked into the program)
+    if (def->image) {
+        if (def->image_size > 0) munmap((void *)def->image, def->image_size);
+        free(def);
+        return;
+    }
+
+    arena_free(&def->arena);
+    id_index_free(&def->room_index);
+    id_index_free(&def->item_index);
+    free(def->strings.data);
+    free(def->item_dep_start);
+    free(def->item_dep_rooms);
+    free(def->key_exit_start);
+    free(def->key_exits);
+    free(def->verb_synonyms);
+    verb_table_free(&def->verbs);
+    free(def);
+}
+
+bool world_def_writable(const WorldDef *def) {
+    return def && !def->image && atomic_load(&def->refcount) == 1;
+}
+
+// Helper: Grow a bitset from old_bits to new_bits capacity (new bits clear)
+static bool grow_bits(uint64_t **bits, size_t old_bits, size_t new_bits) {
+    size_t old_words = *bits ? BITSET_WORDS(old_bits) : 0;
+    size_t new_words = BITSET_WORDS(new_bits);
+    if (new_words <= old_words) return true;
+
+    uint64_t *grown = realloc(*bits, new_words * sizeof(uint64_t));
+    if (!grown) return false;
+    memset(grown + old_words, 0, (new_words - old_words) * sizeof(uint64_t));
+    *bits = grown;
+    return true;
+}
+
+// Helper: Grow the session's per-room state
+static bool grow_room_state(World *world, int capacity) {
+    if (capacity <= world->room_capacity) return true;
+
+    size_t old_cap = (size_t)world->room_capacity;
+    if (!grow_bits(&world->visited, old_cap, (size_t)capacity) ||
+        !grow_bits(&world->description_shown, old_cap, (size_t)capacity) ||
+        !grow_bits(&world->description_cached, old_cap, (size_t)capacity)) {
+        return false;
+    }
+
+    int32_t *first = realloc(world->room_first_item, (size_t)capacity * sizeof(int32_t));
+    if (!first) return false;
+    world->room_first_item = first;
+    StrRef *cached = realloc(world->cached_description, (size_t)capacity * sizeof(StrRef));
+    if (!cached) return false;
+    world->cached_description = cached;
+
+    world->room_capacity = capacity;
+    return true;
+}
+
+// Helper: Grow the session's per-exit state
+static bool grow_exit_state(World *world, int capacity) {
+    if (capacity <= world->exit_capacity) return true;
+
+    if (!grow_bits(&world->exit_unlocked, (size_t)world->exit_capacity, (size_t)capacity)) {
+        return false;
+    }
+    world->exit_capacity = capacity;
+    return true;
+}
+
+// Helper: Grow the session's per-item state
+static bool grow_item_state(World *world, int capacity) {
+    if (capacity <= world->item_capacity) return true;
+
+    if (!grow_bits(&world->item_used, (size_t)world->item_capacity, (size_t)capacity)) {
+        return false;
+    }
+    ItemLocation *location = realloc(world->item_location, (size_t)capacity * sizeof(ItemLocation));
+    if (!location) return false;
+    world->item_location = location;
+
+    world->item_capacity = capacity;
+    return true;
+}
+
+// Helper: Move rooms and exit offsets to larger arena arrays (old arrays
+// stay in the arena)
+static bool grow_rooms(World *world, int capacity) {
+    WorldDef *def = world->def;
+    if (!grow_room_state(world, capacity)) return false;
+    if (capacity <= def->room_capacity) return true;
+
+    Room *rooms = arena_alloc(&def->arena, (size_t)capacity * sizeof(Room));
+    int32_t *exit_start = arena_alloc(&def->arena, ((size_t)capacity + 1) * sizeof(int32_t));
+    if (!rooms || !exit_start) return false;
+    if (def->room_count > 0) {
+        memcpy(rooms, def->rooms, (size_t)def->room_count * sizeof(Room));
+    }
+    if (def->exit_start) {
+        memcpy(exit_start, def->exit_start, ((size_t)def->room_count + 1) * sizeof(int32_t));
+    }
+    def->rooms = rooms;
+    def->exit_start = exit_start;
+    def->room_capacity = capacity;
+    return true;
+}
+
+// Helper: Move exits to a larger arena array
+static bool grow_exits(World *world, int capacity) {
+    WorldDef *def = world->def;
+    if (!grow_exit_state(world, capacity)) return false;
+    if (capacity <= def->exit_capacity) return true;
+
+    Exit *exits = arena_alloc(&def->arena, (size_t)capacity * sizeof(Exit));
+    if (!exits) return false;
+    if (def->exit_count > 0) {
+        memcpy(exits, def->exits, (size_t)def->exit_count * sizeof(Exit));
+    }
+    def->exits = exits;
+    def->exit_capacity = capacity;
+    return true;
+}
+
+// Helper: Move items to a larger arena array
+static bool grow_items(World *world, int capacity) {
+    WorldDef *def = world->def;
+    if (!grow_item_state(world, capacity)) return false;
+    if (capacity <= def->item_capacity) return true;
+
+    Item *items = arena_alloc(&def->arena, (size_t)capacity * sizeof(Item));
+    if (!items) return false;
+    if (def->item_count > 0) {
+        memcpy(items, def->items, (size_t)def->item_count * sizeof(Item));
+    }
+    def->items = items;
+    def->item_capacity = capacity;
+    return true;
+}
+
+// Helper: Check that the world's definition exists and is not shared
+static bool can_build(const World *world) {
+    return world_def_writable(world->def);
+}
+
+// Helper: Record a write to bytes [offset, offset + len) of a state region so
+// the next snapshot copies the chunks involved (no-op until the first snapshot)
+static void touch_state(World *world, StateRegion region, size_t offset, size_t len) {
+    if (!world->dirty_chunks) return;
+
+    size_t start = (size_t)world->chunk_start[region];
+    size_t last = start + (offset + len - 1) / STATE_CHUNK_BYTES;
+    for (size_t c = start + offset / STATE_CHUNK_BYTES; c <= last; c++) {
+        bitset_set(world->dirty_chunks, c);
+    }
+}
+
+// Helper: Record a write to the 64-bit word holding a state bit
+static void touch_bit(World *world, StateRegion region, size_t bit) {
+    touch_state(world, region, bit / 64 * sizeof(uint64_t), sizeof(uint64_t));
+}
+
+// Helper: Record a write to an item's location entry
+static void touch_item(World *world, int item_id) {
+    touch_state(world, STATE_ITEM_LOCATION, (size_t)item_id * sizeof(ItemLocation),
+                sizeof(ItemLocation));
+}
+
+// Helper: Record a write to a location's list head (the inventory head is
+// a scalar that snapshots always copy)
+static void touch_head(World *world, int location) {
+    if (location >= 0) {
+        touch_state(world, STATE_ROOM_FIRST_ITEM, (size_t)location * sizeof(int32_t),
+                    sizeof(int32_t));
+    }
+}
+
+void world_state_changed(World *world) {
+    world_invalidate_descriptions(world);
+    if (world->journal) world_journal_clear(world->journal);
+    world_routes_invalidate(world->routes);
+    if (world->dirty_chunks) {
+        memset(world->dirty_chunks, 0xff,
+               BITSET_WORDS(world->chunk_start[STATE_REGION_COUNT]) * sizeof(uint64_t));
+    }
+}
+
+bool world_init_session(World *session, WorldDef *def) {
+    memset(session, 0, sizeof(World));
+    session->inventory_first = -1;
+    if (!def) return false;
+
+    if (!grow_room_state(session, def->room_count) ||
+        !grow_exit_state(session, def->exit_count) ||
+        !grow_item_state(session, def->item_count)) {
+        free_state(session);
+        return false;
+    }
+    for (int r = 0; r < def->room_count; r++) {
+        session->room_first_item[r] = -1;
+    }
+    for (int i = 0; i < def->item_count; i++) {
+        session->item_location[i].where = ITEM_NOWHERE;
+        session->item_location[i].next = -1;
+        session->item_location[i].prev = -1;
+    }
+    session->def = world_def_retain(def);
+    return true;
+}
+
+bool world_clone(World *session, World *source) {
+    WorldDef *def = source->def;
+
+    // Compile while the definition can still be written, so sharing
+    // sessions never have to
+    if (def && def->conditions_dirty && world_def_writable(def)) {
+        world_compile_conditions(source);
+    }
+    if (!world_init_session(session, def)) return false;
+
+    size_t rooms = (size_t)def->room_count;
+    size_t items = (size_t)def->item_count;
+    if (rooms > 0) {
+        memcpy(session->room_first_item, source->room_first_item, rooms * sizeof(int32_t));
+        memcpy(session->cached_description, source->cached_description, rooms * sizeof(StrRef));
+        bitset_copy(session->visited, source->visited, rooms);
+        bitset_copy(session->description_shown, source->description_shown, rooms);
+        bitset_copy(session->description_cached, source->description_cached, rooms);
     }
+    if (def->exit_count > 0) {
+        bitset_copy(session->exit_unlocked, source->exit_unlocked, (size_t)def->exit_count);
+    }
+    if (items > 0) {
+        memcpy(session->item_location, source->item_location, items * sizeof(ItemLocation));
+        bitset_copy(session->item_used, source->item_used, items);
+    }
+    session->current_room = source->current_room;
+    session->inventory_first = source->inventory_first;
+    session->inventory_count = source->inventory_count;
+    return true;
+}
+
+size_t world_def_memory(const WorldDef *def) {
+    if (!def) return 0;
+
+    // Image pages are shared, file-backed memory rather than heap
+    if (def->image) return sizeof(WorldDef);
+
+    size_t bytes = sizeof(WorldDef) + def->arena.total + def->strings.capacity;
+    bytes += (size_t)(def->room_index.capacity + def->item_index.capacity) *
+             (sizeof(uint32_t) + sizeof(int));
+    if (def->item_dep_start && !def->conditions_dirty) {
+        bytes += ((size_t)def->item_count + 1) * sizeof(int);
+        bytes += (size_t)def->item_dep_start[def->item_count] * sizeof(int);
+    }
+    if (def->key_exit_start && !def->conditions_dirty) {
+        bytes += ((size_t)def->item_count + 1) * sizeof(int32_t);
+        bytes += (size_t)def->key_exit_start[def->item_count] * sizeof(int32_t);
+    }
+    bytes += (size_t)def->verb_synonym_capacity * sizeof(VerbSynonym);
+    bytes += verb_table_memory(&def->verbs);
+    return bytes;
+}
+
+size_t world_state_memory(const World *world) {
+    size_t rooms = (size_t)world->room_capacity;
+    size_t items = (size_t)world->item_capacity;
+    return rooms * (sizeof(int32_t) + sizeof(StrRef)) +
+           3 * BITSET_WORDS(rooms) * sizeof(uint64_t) +
+           BITSET_WORDS(world->exit_capacity) * sizeof(uint64_t) +
+           items * sizeof(ItemLocation) +
+           BITSET_WORDS(items) * sizeof(uint64_t);
+}
+
+// Helper: Make room for at least `bytes` more text in the string pool
+static bool pool_reserve(StringPool *pool, size_t bytes) {
+    size_t used = pool->size ? pool->size : 1;
+    if (used + bytes <= pool->capacity) return true;
+    if (used + bytes > UINT32_MAX) return false;
+
+    size_t capacity = pool->capacity ? pool->capacity : STRING_POOL_MIN_CAPACITY;
+    while (capacity < used + bytes) capacity *= 2;
+    if (capacity > UINT32_MAX) capacity = UINT32_MAX;
+
+    char *data = realloc(pool->data, capacity);
+    if (!data) return false;
+    if (pool->size == 0) {
+        data[0] = '\0';  // Offset 0 is the shared empty string
+        pool->size = 1;
+    }
+    pool->data = data;
+    pool->capacity = (uint32_t)capacity;
+    return true;
+}
+
+bool world_reserve(World *world, int rooms, int items, size_t text_bytes) {
+    if (!can_build(world)) return false;
+
+    // One block for the arrays avoids growth copies during loading
+    WorldDef *def = world->def;
+    size_t bytes = (size_t)rooms * (sizeof(Room) + sizeof(int32_t)) +
+                   (size_t)items * sizeof(Item);
+    if (!arena_reserve(&def->arena, bytes)) return false;
+    if (!pool_reserve(&def->strings, text_bytes)) return false;
+
+    return grow_rooms(world, rooms) && grow_items(world, items);
+}
+
+// Helper: Append a string to the pool (0 for NULL, "" or on failure)
+static StrRef world_strdup(World *world, const char *str) {
+    if (!str || str[0] == '\0') return 0;
+
+    // Text already in the pool (e.g. from world_str) must survive a realloc
+    StringPool *pool = &world->def->strings;
+    bool in_pool = pool->data && str >= pool->data && str < pool->data + pool->size;
+    size_t src = in_pool ? (size_t)(str - pool->data) : 0;
+
+    // A whole pool string (from world_add_text) is shared, not copied
+    if (in_pool && pool->data[src - 1] == '\0') return (StrRef)src;
+
+    size_t len = strlen(str) + 1;
+    if (!pool_reserve(pool, len)) return 0;
+    if (in_pool) str = pool->data + src;
+
+    StrRef ref = pool->size;
+    memcpy(pool->data + ref, str, len);
+    pool->size += (uint32_t)len;
+    return ref;
+}
+
+StrRef world_add_text(World *world, const char *text, size_t len) {
+    if (!can_build(world) || !text || len == 0) return 0;
+
+    StringPool *pool = &world->def->strings;
+    if (!pool_reserve(pool, len + 1)) return 0;
+
+    StrRef ref = pool->size;
+    memcpy(pool->data + ref, text, len);
+    pool->data[ref + len] = '\0';
+    pool->size += (uint32_t)(len + 1);
+    return ref;
+}
+
+const char* world_str(const World *world, StrRef ref) {
+    const StringPool *pool = &world->def->strings;
+    if (ref == 0 || ref >= pool->size) return "";
+    return pool->data + ref;
+}
+
+// Helper: ID accessors for the hash indices
+static const char* room_id_at(const void *ctx, int slot) {
+    const World *world = ctx;
+    return world_str(world, world->def->rooms[slot].id);
+}
+
+static const char* item_id_at(const void *ctx, int slot) {
+    const World *world = ctx;
+    return world_str(world, world->def->items[slot].id);
 }
 
 int world_add_room(World *world, const char *id, const char *name, const char *desc) {
-    if (world->room_count >= MAX_ROOMS) return -1;
+    if (!can_build(world)) return -1;
+
+    // Snapshots cannot describe a different number of rooms
+    world_snapshot_detach(world);
+
+    WorldDef *def = world->def;
+    if (def->room_count >= def->room_capacity || def->room_count >= world->room_capacity) {
+        int capacity = def->room_capacity ? def->room_capacity * 2 : WORLD_MIN_CAPACITY;
+        if (!grow_rooms(world, capacity)) return -1;
+    }
 
-    int idx = world->room_count++;
-    Room *room = &world->rooms[idx];
+    int idx = def->room_count++;
+    Room *room = &def->rooms[idx];
 
-    strncpy(room->id, id, sizeof(room->id) - 1);
-    strncpy(room->name, name, sizeof(room->name) - 1);
-    strncpy(room->description, desc, sizeof(room->description) - 1);
-    room->visited = false;
-    room->description_shown = false;
+    room->id = world_strdup(world, id);
+    room->name = world_strdup(world, name);
+    room->description = world_strdup(world, desc);
+    room->conditional_desc_start = -1;
     room->conditional_desc_count = 0;
+    room->description_fixed = false;
+    room->depends_on_visits = false;
 
-    // Initialize exits and locked exits
-    for (int i = 0; i < DIR_COUNT; i++) {
-        room->exits[i] = -1;
-        room->locked_exits[i][0] = '\0';
-        room->exit_unlocked[i] = false;
-    }
+    // No exits yet: the room's run starts and ends at the end of the list
+    def->exit_start[idx + 1] = def->exit_count;
+
+    world->room_first_item[idx] = -1;
+    world->cached_description[idx] = 0;
+    bitset_clear(world->description_cached, (size_t)idx);
 
-    // Initialize items
-    for (int i = 0; i < MAX_ITEMS; i++) {
-        room->items[i] = -1;
+    // Index by ID (first room with a given ID wins, matching the old linear scan)
+    const char *room_id = world_str(world, room->id);
+    if (id_index_find(&def->room_index, room_id, room_id_at, world) == -1) {
+        id_index_insert(&def->room_index, room_id, idx);
     }
 
     return idx;
 }
 
 int world_add_item(World *world, const char *id, const char *name, const char *desc, bool takeable) {
-    if (world->item_count >= MAX_ITEMS) return -1;
+    if (!can_build(world)) return -1;
+
+    world_snapshot_detach(world);
 
-    int idx = world->item_count++;
-    Item *item = &world->items[idx];
+    WorldDef *def = world->def;
+    if (def->item_count >= def->item_capacity || def->item_count >= world->item_capacity) {
+        int capacity = def->item_capacity ? def->item_capacity * 2 : WORLD_MIN_CAPACITY;
+        if (!grow_items(world, capacity)) return -1;
+    }
+
+    int idx = def->item_count++;
+    Item *item = &def->items[idx];
 
-    strncpy(item->id, id, sizeof(item->id) - 1);
-    strncpy(item->name, name, sizeof(item->name) - 1);
-    strncpy(item->description, desc, sizeof(item->description) - 1);
+    item->id = world_strdup(world, id);
+    item->name = world_strdup(world, name);
+    item->description = world_strdup(world, desc);
     item->takeable = takeable;
     item->visible = true;
     // Issue #8: Initialize use command fields
-    item->use_message[0] = '\0';
+    item->use_message = 0;
     item->use_consumable = false;
-    item->used = false;
+
+    // Items start out of play until placed
+    world->item_location[idx].where = ITEM_NOWHERE;
+    world->item_location[idx].next = -1;
+    world->item_location[idx].prev = -1;
+
+    // A new item may resolve a condition subject that was unknown
+    def->conditions_dirty = true;
+
+    const char *item_id = world_str(world, item->id);
+    if (id_index_find(&def->item_index, item_id, item_id_at, world) == -1) {
+        id_index_insert(&def->item_index, item_id, idx);
+    }
 
     return idx;
 }
 
-void world_place_item(World *world, int item_id, int room_id) {
-    if (item_id < 0 || item_id >= world->item_count) return;
-    if (room_id < 0 || room_id >= world->room_count) return;
+void world_set_item_use(World *world, int item_id, const char *use_message, bool consumable) {
+    if (!can_build(world)) return;
+    if (item_id < 0 || item_id >= world->def->item_count) return;
+
+    Item *item = &world->def->items[item_id];
+    item->use_message = world_strdup(world, use_message);
+    // No use message means item is not usable, so cannot be consumable
+    item->use_consumable = item->use_message != 0 && consumable;
+}
 
-    Room *room = &world->rooms[room_id];
+// Helper: Drop cached descriptions of rooms whose conditions reference item
+static void invalidate_item_dependents(World *world, int item_id) {
+    // A dirty world recompiles (clearing every cache) before the next lookup
+    const WorldDef *def = world->def;
+    if (def->conditions_dirty || !def->item_dep_start) return;
 
-    // Find empty slot
-    for (int i = 0; i < MAX_ITEMS; i++) {
-        if (room->items[i] == -1) {
-            room->items[i] = item_id;
-            return;
+    for (int i = def->item_dep_start[item_id]; i < def->item_dep_start[item_id + 1]; i++) {
+        bitset_clear(world->description_cached, (size_t)def->item_dep_rooms[i]);
+    }
+}
+
+// Helper: Bitset holding a state region's flags (NULL for non-flag regions)
+static uint64_t* region_bits(World *world, StateRegion region) {
+    switch (region) {
+        case STATE_VISITED: return world->visited;
+        case STATE_DESCRIPTION_SHOWN: return world->description_shown;
+        case STATE_EXIT_UNLOCKED: return world->exit_unlocked;
+        case STATE_ITEM_USED: return world->item_used;
+        default: return NULL;
+    }
+}
+
+// Helper: Set or clear a state flag; if it changed, record the write for
+// snapshots and the journal and drop cached descriptions that depend on it
+static void set_state_bit(World *world, StateRegion region, size_t bit, bool on) {
+    uint64_t *bits = region_bits(world, region);
+    if (!bits || !bitset_assign(bits, bit, on)) return;
+
+    touch_bit(world, region, bit);
+    if (world->journal) {
+        JournalRecord record = {
+            .type = JOURNAL_FLAG, .region = (uint8_t)region, .index = (int32_t)bit,
+            .before = !on, .after = on
+        };
+        world_journal_record(world->journal, &record);
+    }
+
+    if (region == STATE_ITEM_USED) {
+        invalidate_item_dependents(world, (int)bit);
+    } else if (region == STATE_EXIT_UNLOCKED) {
+        if (world->routes) {
+            world_routes_exit_changed(world, (int)bit, on);
         }
+    } else if (world->def->rooms[bit].depends_on_visits) {
+        bitset_clear(world->description_cached, bit);
     }
 }
 
-void world_connect_rooms(World *world, int from_room, Direction dir, int to_room) {
-    if (from_room < 0 || from_room >= world->room_count) return;
-    if (to_room < 0 || to_room >= world->room_count) return;
-    if (dir < 0 || dir >= DIR_COUNT) return;
+bool world_item_used(const World *world, int item_id) {
+    if (item_id < 0 || item_id >= world->def->item_count) return false;
+    return bitset_test(world->item_used, (size_t)item_id);
+}
+
+void world_set_item_used(World *world, int item_id, bool used) {
+    if (item_id < 0 || item_id >= world->def->item_count) return;
 
-    world->rooms[from_room].exits[dir] = to_room;
+    set_state_bit(world, STATE_ITEM_USED, (size_t)item_id, used);
 }
 
-int world_find_room(World *world, const char *id) {
-    for (int i = 0; i < world->room_count; i++) {
-        if (strcmp(world->rooms[i].id, id) == 0) {
-            return i;
+bool world_add_conditional_desc(World *world, int room_id, ConditionType type,
+                                const char *subject, bool negate, const char *desc) {
+    if (!can_build(world)) return false;
+
+    WorldDef *def = world->def;
+    if (room_id < 0 || room_id >= def->room_count) return false;
+
+    Room *room = &def->rooms[room_id];
+    if (room->conditional_desc_count >= MAX_CONDITIONAL_DESCS) return false;
+
+    // A room's first condition claims a run of MAX_CONDITIONAL_DESCS slots
+    if (room->conditional_desc_start < 0) {
+        if (def->conditional_desc_used + MAX_CONDITIONAL_DESCS > def->conditional_desc_capacity) {
+            int capacity = def->conditional_desc_capacity ? def->conditional_desc_capacity * 2
+                                                          : WORLD_MIN_CAPACITY * MAX_CONDITIONAL_DESCS;
+            ConditionalDesc *conds = arena_alloc(&def->arena, (size_t)capacity * sizeof(ConditionalDesc));
+            if (!conds) return false;
+            if (def->conditional_desc_used > 0) {
+                memcpy(conds, def->conditional_descs,
+                       (size_t)def->conditional_desc_used * sizeof(ConditionalDesc));
+            }
+            def->conditional_descs = conds;
+            def->conditional_desc_capacity = capacity;
         }
+        room->conditional_desc_start = def->conditional_desc_used;
+        def->conditional_desc_used += MAX_CONDITIONAL_DESCS;
     }
-    return -1;
+
+    ConditionalDesc *cond = &def->conditional_descs[room->conditional_desc_start +
+                                                    room->conditional_desc_count++];
+    cond->type = type;
+    cond->subject = world_strdup(world, subject);
+    cond->negate = negate;
+    cond->description = world_strdup(world, desc);
+    cond->item = -1;
+    cond->priority = 0;
+    def->conditions_dirty = true;
+    return true;
 }
 
-int world_find_item(World *world, const char *id) {
-    for (int i = 0; i < world->item_count; i++) {
-        if (strcmp(world->items[i].id, id) == 0) {
-            return i;
+ConditionalDesc* world_room_conditions(const WorldDef *def, const Room *room) {
+    if (room->conditional_desc_count == 0) return NULL;
+    return def->conditional_descs + room->conditional_desc_start;
+}
+
+// Helper: Head of the item list for a location (NULL for ITEM_NOWHERE)
+static int32_t* location_head(World *world, int location) {
+    if (location == ITEM_IN_INVENTORY) return &world->inventory_first;
+    if (location >= 0 && location < world->def->room_count) return &world->room_first_item[location];
+    return NULL;
+}
+
+// Helper: Remove item from its current location's list
+static void item_unlink(World *world, int item_id) {
+    ItemLocation *loc = &world->item_location[item_id];
+    int32_t *head = location_head(world, loc->where);
+    touch_item(world, item_id);
+    if (head) {
+        if (loc->next == item_id) {
+            *head = -1;  // Only item in the list
+            touch_head(world, loc->where);
+        } else {
+            world->item_location[loc->prev].next = loc->next;
+            world->item_location[loc->next].prev = loc->prev;
+            touch_item(world, loc->prev);
+            touch_item(world, loc->next);
+            if (*head == item_id) {
+                *head = loc->next;
+                touch_head(world, loc->where);
+            }
         }
+        if (loc->where == ITEM_IN_INVENTORY) world->inventory_count--;
     }
+    loc->where = ITEM_NOWHERE;
+    loc->next = -1;
+    loc->prev = -1;
+}
+
+// Helper: Append item to the end of a location's list
+static void item_link(World *world, int item_id, int location) {
+    ItemLocation *loc = &world->item_location[item_id];
+    int32_t *head = location_head(world, location);
+    loc->where = location;
+    touch_item(world, item_id);
+    if (!head) return;
+
+    if (*head == -1) {
+        *head = item_id;
+        touch_head(world, location);
+        loc->next = item_id;
+        loc->prev = item_id;
+    } else {
+        // Circular list: the head's prev is the tail
+        int first = *head;
+        int last = world->item_location[first].prev;
+        loc->next = first;
+        loc->prev = last;
+        world->item_location[last].next = item_id;
+        world->item_location[first].prev = item_id;
+        touch_item(world, last);
+        touch_item(world, first);
+    }
+    if (location == ITEM_IN_INVENTORY) world->inventory_count++;
+}
+
+bool world_set_item_location(World *world, int item_id, int location) {
+    if (item_id < 0 || item_id >= world->def->item_count) return false;
+    if (location != ITEM_NOWHERE && !location_head(world, location)) return false;
+
+    int current = world->item_location[item_id].where;
+    if (current == location) return true;
+    if (location == ITEM_IN_INVENTORY && world->inventory_count >= MAX_INVENTORY) {
+        return false;
+    }
+
+    if (world->journal) {
+        const ItemLocation *loc = &world->item_location[item_id];
+        int32_t *head = location_head(world, current);
+        JournalRecord record = {
+            .type = JOURNAL_ITEM_MOVE, .index = item_id, .before = current, .after = location,
+            .was_head = head && *head == item_id,
+            .before_next = loc->next == item_id ? -1 : loc->next
+        };
+        world_journal_record(world->journal, &record);
+    }
+
+    item_unlink(world, item_id);
+    item_link(world, item_id, location);
+    invalidate_item_dependents(world, item_id);
+    return true;
+}
+
+// Helper: Put an item back in its old place in a location's list: before
+// `next` (-1 = append), and at the head if it was there
+static void item_link_before(World *world, int item_id, int location, int next, bool make_head) {
+    int32_t *head = location_head(world, location);
+    if (next == -1 || !head) {
+        item_link(world, item_id, location);
+        return;
+    }
+
+    ItemLocation *loc = &world->item_location[item_id];
+    int prev = world->item_location[next].prev;
+    loc->where = location;
+    loc->next = next;
+    loc->prev = prev;
+    world->item_location[prev].next = item_id;
+    world->item_location[next].prev = item_id;
+    touch_item(world, item_id);
+    touch_item(world, prev);
+    touch_item(world, next);
+    if (make_head) {
+        *head = item_id;
+        touch_head(world, location);
+    }
+    if (location == ITEM_IN_INVENTORY) world->inventory_count++;
+}
+
+void world_journal_apply(World *world, const JournalRecord *record, bool undo) {
+    switch ((JournalType)record->type) {
+        case JOURNAL_ITEM_MOVE:
+            item_unlink(world, record->index);
+            if (undo) {
+                item_link_before(world, record->index, record->before,
+                                 record->before_next, record->was_head);
+            } else {
+                item_link(world, record->index, record->after);
+            }
+            invalidate_item_dependents(world, record->index);
+            break;
+
+        case JOURNAL_ROOM:
+            world->current_room = undo ? record->before : record->after;
+            break;
+
+        case JOURNAL_FLAG:
+            set_state_bit(world, (StateRegion)record->region, (size_t)record->index,
+                          undo ? record->before : record->after);
+            break;
+
+        case JOURNAL_TURN:
+            break;
+    }
+}
+
+int world_item_location(const World *world, int item_id) {
+    if (item_id < 0 || item_id >= world->def->item_count) return ITEM_NOWHERE;
+    return world->item_location[item_id].where;
+}
+
+int world_first_item(const World *world, int location) {
+    if (location == ITEM_IN_INVENTORY) return world->inventory_first;
+    if (location >= 0 && location < world->def->room_count) return world->room_first_item[location];
     return -1;
 }
 
-Room* world_current_room(World *world) {
-    if (world->current_room < 0 || world->current_room >= world->room_count) {
-        return NULL;
+int world_next_item(const World *world, int item_id) {
+    const ItemLocation *loc = &world->item_location[item_id];
+    int next = loc->next;
+    if (next == -1 || next == world_first_item(world, loc->where)) return -1;
+    return next;
+}
+
+void world_place_item(World *world, int item_id, int room_id) {
+    if (room_id < 0 || room_id >= world->def->room_count) return;
+    world_set_item_location(world, item_id, room_id);
+}
+
+// Helper: Open a gap for a new exit at the end of a room's run, shifting
+// later rooms' exits (and their session bits) up by one
+static int insert_exit_slot(World *world, int room_id) {
+    WorldDef *def = world->def;
+    int pos = def->exit_start[room_id + 1];
+    int tail = def->exit_count - pos;
+    if (tail > 0) {
+        memmove(&def->exits[pos + 1], &def->exits[pos], (size_t)tail * sizeof(Exit));
+        for (int e = def->exit_count; e > pos; e--) {
+            bitset_assign(world->exit_unlocked, (size_t)e,
+                          bitset_test(world->exit_unlocked, (size_t)e - 1));
+        }
+    }
+    bitset_clear(world->exit_unlocked, (size_t)pos);
+    for (int r = room_id + 1; r <= def->room_count; r++) {
+        def->exit_start[r]++;
+    }
+    def->exit_count++;
+    return pos;
+}
+
+int world_add_exit(World *world, int from_room, const char *name, int to_room) {
+    if (!can_build(world)) return -1;
+
+    WorldDef *def = world->def;
+    if (from_room < 0 || from_room >= def->room_count) return -1;
+    if (to_room < 0 || to_room >= def->room_count) return -1;
+    if (!name || name[0] == '\0') return -1;
+
+    world_routes_invalidate(world->routes);
+
+    // Re-pointing an existing exit keeps its index, key and state
+    int existing = world_find_exit(world, from_room, name);
+    if (existing != -1) {
+        def->exits[existing].to = to_room;
+        return existing;
+    }
+
+    // Inserting shifts exit indices in the key index
+    def->conditions_dirty = true;
+
+    // Snapshots cannot describe a different number of exits
+    world_snapshot_detach(world);
+
+    if (def->exit_count >= def->exit_capacity || def->exit_count >= world->exit_capacity) {
+        int capacity = def->exit_capacity ? def->exit_capacity * 2 : WORLD_MIN_CAPACITY;
+        if (!grow_exits(world, capacity)) return -1;
     }
-    return &world->rooms[world->current_room];
+
+    StrRef exit_name = world_strdup(world, name);
+    if (!exit_name) return -1;
+    int dir = str_to_direction(name);
+
+    int idx = insert_exit_slot(world, from_room);
+    Exit *exit = &def->exits[idx];
+    exit->to = to_room;
+    exit->name = exit_name;
+    exit->key = 0;
+    exit->key_item = -1;
+    exit->dir = (uint8_t)(dir == -1 ? DIR_NONE : dir);
+    return idx;
+}
+
+// Helper: Whether two exit names select the same exit of a room (same
+// name in any case, or the same compass direction as world_find_exit does)
+static bool same_exit_name(const World *world, StrRef a, int dir_a, StrRef b, int dir_b) {
+    if (dir_a != DIR_NONE && dir_a == dir_b) return true;
+    return strcasecmp(world_str(world, a), world_str(world, b)) == 0;
+}
+
+// Helper: Whether a world_add_exits entry names real rooms and a name
+static bool exit_spec_valid(const WorldDef *def, const ExitSpec *spec) {
+    return spec->from >= 0 && spec->from < def->room_count &&
+           spec->to >= 0 && spec->to < def->room_count &&
+           spec->name != 0 && spec->name < def->strings.size;
 }
 
-// Helper: Check if item is in the given room
-static bool room_has_item(World *world, Room *room, const char *item_id) {
-    for (int i = 0; i < MAX_ITEMS; i++) {
-        if (room->items[i] != -1) {
-            Item *item = &world->items[room->items[i]];
-            if (strcmp(item->id, item_id) == 0) {
-                return true;
+bool world_add_exits(World *world, const ExitSpec *specs, int count) {
+    if (!can_build(world)) return false;
+    if (count <= 0) return true;
+
+    WorldDef *def = world->def;
+    int rooms = def->room_count;
+    world_routes_invalidate(world->routes);
+
+    // Group the specs by room, keeping their order within a room (counting sort)
+    int *run = calloc((size_t)rooms + 1, sizeof(int));
+    int *fill = malloc(((size_t)rooms + 1) * sizeof(int));
+    int *order = malloc((size_t)count * sizeof(int));
+    int32_t *to = malloc((size_t)count * sizeof(int32_t));
+    uint8_t *dirs = malloc((size_t)count);
+    if (!run || !fill || !order || !to || !dirs) {
+        free(run);
+        free(fill);
+        free(order);
+        free(to);
+        free(dirs);
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const ExitSpec *spec = &specs[i];
+        if (!exit_spec_valid(def, spec)) continue;
+        run[spec->from + 1]++;
+    }
+    for (int r = 0; r < rooms; r++) {
+        run[r + 1] += run[r];
+    }
+    memcpy(fill, run, ((size_t)rooms + 1) * sizeof(int));
+    for (int i = 0; i < count; i++) {
+        const ExitSpec *spec = &specs[i];
+        if (!exit_spec_valid(def, spec)) continue;
+        int k = fill[spec->from]++;
+        int dir = str_to_direction(world_str(world, spec->name));
+        order[k] = i;
+        to[k] = spec->to;
+        dirs[k] = (uint8_t)(dir == -1 ? DIR_NONE : dir);
+    }
+
+    // Re-point existing exits and merge repeats within the batch (the later
+    // target wins, the first position is kept); fill[r] becomes the number
+    // of new exits for room r
+    int added = 0;
+    for (int r = 0; r < rooms; r++) {
+        int kept = 0;
+        for (int k = run[r]; k < run[r + 1]; k++) {
+            StrRef name = specs[order[k]].name;
+            int existing = world_find_exit(world, r, world_str(world, name));
+            if (existing != -1) {
+                def->exits[existing].to = to[k];
+                continue;
+            }
+            int j = run[r];
+            while (j < run[r] + kept &&
+                   !same_exit_name(world, specs[order[j]].name, dirs[j], name, dirs[k])) {
+                j++;
+            }
+            if (j < run[r] + kept) {
+                to[j] = to[k];
+                continue;
+            }
+            order[j] = order[k];
+            to[j] = to[k];
+            dirs[j] = dirs[k];
+            kept++;
+        }
+        fill[r] = kept;
+        added += kept;
+    }
+
+    bool ok = true;
+    int total = def->exit_count + added;
+    if (added > 0 && (total > def->exit_capacity || total > world->exit_capacity)) {
+        int capacity = def->exit_capacity ? def->exit_capacity : WORLD_MIN_CAPACITY;
+        while (capacity < total) capacity *= 2;
+        ok = grow_exits(world, capacity);
+    }
+
+    if (ok && added > 0) {
+        // Inserting shifts exit indices in the key index
+        def->conditions_dirty = true;
+
+        // Snapshots cannot describe a different number of exits
+        world_snapshot_detach(world);
+
+        // From the last room down, move each room's run (and its session
+        // bits) up by the new exits of the rooms before it, then append
+        // its own new exits
+        int shift = added;
+        for (int r = rooms - 1; r >= 0; r--) {
+            shift -= fill[r];
+            int begin = def->exit_start[r];
+            int end = def->exit_start[r + 1];
+            if (shift > 0) {
+                memmove(&def->exits[begin + shift], &def->exits[begin],
+                        (size_t)(end - begin) * sizeof(Exit));
+                for (int e = end - 1; e >= begin; e--) {
+                    bitset_assign(world->exit_unlocked, (size_t)(e + shift),
+                                  bitset_test(world->exit_unlocked, (size_t)e));
+                }
             }
+            for (int n = 0; n < fill[r]; n++) {
+                int idx = end + shift + n;
+                Exit *exit = &def->exits[idx];
+                exit->to = to[run[r] + n];
+                exit->name = specs[order[run[r] + n]].name;
+                exit->key = 0;
+                exit->key_item = -1;
+                exit->dir = dirs[run[r] + n];
+                bitset_clear(world->exit_unlocked, (size_t)idx);
+            }
+            def->exit_start[r + 1] = end + shift + fill[r];
         }
+        def->exit_count = total;
     }
-    return false;
+
+    free(run);
+    free(fill);
+    free(order);
+    free(to);
+    free(dirs);
+    return ok;
 }
 
-// Helper: Check if item has been used
-static bool item_was_used(World *world, const char *item_id) {
-    int idx = world_find_item(world, item_id);
-    if (idx >= 0) {
-        return world->items[idx].used;
+void world_connect_rooms(World *world, int from_room, Direction dir, int to_room) {
+    if (dir < 0 || dir >= DIR_COUNT) return;
+    world_add_exit(world, from_room, direction_to_str(dir), to_room);
+}
+
+void world_set_exit_key(World *world, int exit_id, const char *key_item_id) {
+    if (!can_build(world)) return;
+    if (exit_id < 0 || exit_id >= world->def->exit_count) return;
+
+    world->def->exits[exit_id].key = key_item_id ? world_strdup(world, key_item_id) : 0;
+    world->def->exits[exit_id].key_item = -1;
+    world->def->conditions_dirty = true;
+    set_state_bit(world, STATE_EXIT_UNLOCKED, (size_t)exit_id, false);
+    world_routes_invalidate(world->routes);
+}
+
+int world_exits_begin(const World *world, int room_id) {
+    if (room_id < 0 || room_id >= world->def->room_count) return 0;
+    return world->def->exit_start[room_id];
+}
+
+int world_exits_end(const World *world, int room_id) {
+    if (room_id < 0 || room_id >= world->def->room_count) return 0;
+    return world->def->exit_start[room_id + 1];
+}
+
+const Exit* world_exit(const World *world, int exit_id) {
+    if (exit_id < 0 || exit_id >= world->def->exit_count) return NULL;
+    return &world->def->exits[exit_id];
+}
+
+int world_find_exit(const World *world, int room_id, const char *name) {
+    if (room_id < 0 || room_id >= world->def->room_count || !name) return -1;
+
+    const WorldDef *def = world->def;
+    for (int e = def->exit_start[room_id]; e < def->exit_start[room_id + 1]; e++) {
+        if (strcasecmp(world_str(world, def->exits[e].name), name) == 0) return e;
+    }
+
+    // Short forms of compass directions ("n", "u")
+    int dir = str_to_direction(name);
+    return dir == -1 ? -1 : world_direction_exit(world, room_id, (Direction)dir);
+}
+
+int world_direction_exit(const World *world, int room_id, Direction dir) {
+    if (room_id < 0 || room_id >= world->def->room_count) return -1;
+
+    const WorldDef *def = world->def;
+    for (int e = def->exit_start[room_id]; e < def->exit_start[room_id + 1]; e++) {
+        if (def->exits[e].dir == dir) return e;
+    }
+    return -1;
+}
+
+bool world_exit_open(const World *world, int exit_id) {
+    if (exit_id < 0 || exit_id >= world->def->exit_count) return false;
+    return world->def->exits[exit_id].key == 0 ||
+           bitset_test(world->exit_unlocked, (size_t)exit_id);
+}
+
+void world_set_exit_unlocked(World *world, int exit_id, bool unlocked) {
+    if (exit_id < 0 || exit_id >= world->def->exit_count) return;
+    set_state_bit(world, STATE_EXIT_UNLOCKED, (size_t)exit_id, unlocked);
+}
+
+int world_find_room(World *world, const char *id) {
+    return id_index_find(&world->def->room_index, id, room_id_at, world);
+}
+
+int world_find_item(World *world, const char *id) {
+    return id_index_find(&world->def->item_index, id, item_id_at, world);
+}
+
+Room* world_current_room(World *world) {
+    if (world->current_room < 0 || world->current_room >= world->def->room_count) {
+        return NULL;
+    }
+    return &world->def->rooms[world->current_room];
+}
+
+int world_room_exit(const World *world, int room_id, Direction dir) {
+    int exit_id = world_direction_exit(world, room_id, dir);
+    return exit_id == -1 ? -1 : world->def->exits[exit_id].to;
+}
+
+bool world_room_visited(const World *world, int room_id) {
+    if (room_id < 0 || room_id >= world->def->room_count) return false;
+    return bitset_test(world->visited, (size_t)room_id);
+}
+
+void world_set_room_visited(World *world, int room_id, bool visited) {
+    if (room_id < 0 || room_id >= world->def->room_count) return;
+    set_state_bit(world, STATE_VISITED, (size_t)room_id, visited);
+}
+
+bool world_room_description_shown(const World *world, int room_id) {
+    if (room_id < 0 || room_id >= world->def->room_count) return false;
+    return bitset_test(world->description_shown, (size_t)room_id);
+}
+
+void world_set_room_description_shown(World *world, int room_id, bool shown) {
+    if (room_id < 0 || room_id >= world->def->room_count) return;
+    set_state_bit(world, STATE_DESCRIPTION_SHOWN, (size_t)room_id, shown);
+}
+
+const char* world_exit_key(const World *world, int room_id, Direction dir) {
+    int exit_id = world_direction_exit(world, room_id, dir);
+    if (exit_id == -1 || world->def->exits[exit_id].key == 0) return NULL;
+    return world_str(world, world->def->exits[exit_id].key);
+}
+
+bool world_exit_unlocked(const World *world, int room_id, Direction dir) {
+    int exit_id = world_direction_exit(world, room_id, dir);
+    return exit_id != -1 && bitset_test(world->exit_unlocked, (size_t)exit_id);
+}
+
+// Helper: Priority of a condition type
+// item_used > has_item > room_has_item > first_visit/visited
+static uint8_t condition_priority(ConditionType type) {
+    switch (type) {
+        case COND_ITEM_USED: return 4;
+        case COND_HAS_ITEM: return 3;
+        case COND_ROOM_HAS_ITEM: return 2;
+        case COND_FIRST_VISIT:
+        case COND_VISITED: return 1;
     }
-    return false;
+    return 0;
+}
+
+// Helper: Check if a condition's result can never change
+// (item-based conditions whose item doesn't exist)
+static bool condition_is_constant(const ConditionalDesc *cond) {
+    return cond->type != COND_FIRST_VISIT && cond->type != COND_VISITED && cond->item == -1;
 }
 
-// Helper: Evaluate a single condition
-static bool evaluate_condition(World *world, Room *room, ConditionalDesc *cond) {
+// Helper: Evaluate a single compiled condition (no string lookups)
+static bool evaluate_condition(const World *world, int room_id, const ConditionalDesc *cond) {
     bool result = false;
 
     switch (cond->type) {
         case COND_FIRST_VISIT:
             // First time showing room description - uses description_shown flag
             // which is set AFTER the description is displayed (not on room entry)
-            result = !room->description_shown;
+            result = !bitset_test(world->description_shown, (size_t)room_id);
             break;
 
         case COND_VISITED:
             // Has been visited before (return visit)
-            result = room->visited;
+            result = bitset_test(world->visited, (size_t)room_id);
             break;
 
         case COND_HAS_ITEM:
-            result = world_has_item(world, cond->subject);
+            result = cond->item >= 0 &&
+                     world->item_location[cond->item].where == ITEM_IN_INVENTORY;
             break;
 
         case COND_ROOM_HAS_ITEM:
-            result = room_has_item(world, room, cond->subject);
+            result = cond->item >= 0 && world->item_location[cond->item].where == room_id;
             break;
 
         case COND_ITEM_USED:
-            result = item_was_used(world, cond->subject);
+            result = cond->item >= 0 && bitset_test(world->item_used, (size_t)cond->item);
             break;
     }
 
@@ -182,52 +1166,300 @@ static bool evaluate_condition(World *world, Room *room, ConditionalDesc *cond)
     return cond->negate ? !result : result;
 }
 
-const char* world_get_room_description(World *world, Room *room) {
-    if (!world || !room) return "";
+// Helper: First matching description in a compiled (priority-sorted) list
+static StrRef match_conditions(const World *world, int room_id) {
+    const Room *room = &world->def->rooms[room_id];
+    const ConditionalDesc *conds = world_room_conditions(world->def, room);
+    for (int i = 0; i < room->conditional_desc_count; i++) {
+        if (evaluate_condition(world, room_id, &conds[i])) {
+            return conds[i].description;
+        }
+    }
+    return room->description;
+}
 
-    // Priority: item_used > has_item > room_has_item > first_visit/visited > default
-    // Highest priority matching condition wins; ties broken by definition order
-    const char *best_desc = NULL;
-    int best_priority = -1;
+// Helper: Build the item -> dependent rooms index (counting sort by item)
+// Returns false on allocation failure
+static bool build_item_deps(WorldDef *def) {
+    free(def->item_dep_start);
+    free(def->item_dep_rooms);
+    def->item_dep_rooms = NULL;
+    def->item_dep_start = calloc((size_t)def->item_count + 1, sizeof(int));
+    if (!def->item_dep_start) return false;
+
+    int total = 0;
+    for (int r = 0; r < def->room_count; r++) {
+        const Room *room = &def->rooms[r];
+        if (room->description_fixed) continue;
+        const ConditionalDesc *conds = world_room_conditions(def, room);
+        for (int i = 0; i < room->conditional_desc_count; i++) {
+            int item = conds[i].item;
+            if (item >= 0) {
+                def->item_dep_start[item + 1]++;
+                total++;
+            }
+        }
+    }
+    for (int i = 0; i < def->item_count; i++) {
+        def->item_dep_start[i + 1] += def->item_dep_start[i];
+    }
+    if (total == 0) return true;
 
-    for (int i = 0; i < room->conditional_desc_count; i++) {
-        ConditionalDesc *cond = &room->conditional_descs[i];
+    def->item_dep_rooms = malloc((size_t)total * sizeof(int));
+    int *fill = malloc((size_t)def->item_count * sizeof(int));
+    if (!def->item_dep_rooms || !fill) {
+        free(fill);
+        return false;
+    }
+    memcpy(fill, def->item_dep_start, (size_t)def->item_count * sizeof(int));
+    for (int r = 0; r < def->room_count; r++) {
+        const Room *room = &def->rooms[r];
+        if (room->description_fixed) continue;
+        const ConditionalDesc *conds = world_room_conditions(def, room);
+        for (int i = 0; i < room->conditional_desc_count; i++) {
+            int item = conds[i].item;
+            if (item >= 0) def->item_dep_rooms[fill[item]++] = r;
+        }
+    }
+    free(fill);
+    return true;
+}
+
+// Helper: Resolve exit keys and build the item -> exits index (counting
+// sort by key item). Returns false on allocation failure
+static bool build_key_exits(World *world) {
+    WorldDef *def = world->def;
+    free(def->key_exit_start);
+    free(def->key_exits);
+    def->key_exits = NULL;
+    def->key_exit_start = calloc((size_t)def->item_count + 1, sizeof(int32_t));
+    if (!def->key_exit_start) return false;
+
+    int total = 0;
+    for (int e = 0; e < def->exit_count; e++) {
+        Exit *exit = &def->exits[e];
+        exit->key_item = exit->key ? world_find_item(world, world_str(world, exit->key)) : -1;
+        if (exit->key_item >= 0) {
+            def->key_exit_start[exit->key_item + 1]++;
+            total++;
+        }
+    }
+    for (int i = 0; i < def->item_count; i++) {
+        def->key_exit_start[i + 1] += def->key_exit_start[i];
+    }
+    if (total == 0) return true;
+
+    def->key_exits = malloc((size_t)total * sizeof(int32_t));
+    int32_t *fill = malloc((size_t)def->item_count * sizeof(int32_t));
+    if (!def->key_exits || !fill) {
+        free(fill);
+        return false;
+    }
+    memcpy(fill, def->key_exit_start, (size_t)def->item_count * sizeof(int32_t));
+    for (int e = 0; e < def->exit_count; e++) {
+        int item = def->exits[e].key_item;
+        if (item >= 0) def->key_exits[fill[item]++] = e;
+    }
+    free(fill);
+    return true;
+}
+
+// Helper: Build the verb table from the built-in words and the world's
+// synonyms. Returns false on allocation failure
+static bool build_verbs(World *world) {
+    WorldDef *def = world->def;
+    VerbWord *words = NULL;
+    if (def->verb_synonym_count > 0) {
+        words = malloc((size_t)def->verb_synonym_count * sizeof(VerbWord));
+        if (!words) {
+            verb_table_free(&def->verbs);
+            return false;
+        }
+        for (int i = 0; i < def->verb_synonym_count; i++) {
+            words[i].word = world_str(world, def->verb_synonyms[i].word);
+            words[i].verb = (Verb)def->verb_synonyms[i].verb;
+        }
+    }
+    bool ok = verb_table_build(&def->verbs, words, def->verb_synonym_count);
+    free(words);
+    return ok;
+}
+
+void world_compile_conditions(World *world) {
+    // A shared definition is read-only (world_clone compiles before sharing)
+    if (!can_build(world)) return;
+
+    WorldDef *def = world->def;
+    for (int r = 0; r < def->room_count; r++) {
+        Room *room = &def->rooms[r];
+        ConditionalDesc *conds = world_room_conditions(def, room);
+        bool fixed = true;
+        bool visits = false;
+
+        for (int i = 0; i < room->conditional_desc_count; i++) {
+            ConditionalDesc *cond = &conds[i];
+            cond->item = cond->subject ? world_find_item(world, world_str(world, cond->subject)) : -1;
+            cond->priority = condition_priority(cond->type);
+            if (!condition_is_constant(cond)) fixed = false;
+            if (cond->type == COND_FIRST_VISIT || cond->type == COND_VISITED) visits = true;
+        }
+
+        // Stable insertion sort by descending priority, so ties keep
+        // definition order and evaluation can stop at the first match
+        for (int i = 1; i < room->conditional_desc_count; i++) {
+            ConditionalDesc cond = conds[i];
+            int j = i - 1;
+            while (j >= 0 && conds[j].priority < cond.priority) {
+                conds[j + 1] = conds[j];
+                j--;
+            }
+            conds[j + 1] = cond;
+        }
+
+        room->description_fixed = fixed;
+        room->depends_on_visits = visits;
+    }
+    // Which rooms are fixed may have just changed, so drop every entry
+    if (world->room_capacity > 0) {
+        memset(world->description_cached, 0,
+               BITSET_WORDS(world->room_capacity) * sizeof(uint64_t));
+    }
+
+    // Without the dependency index no cache could be invalidated, so stay
+    // dirty and evaluate uncached until a compile succeeds
+    bool deps = build_item_deps(def);
+    bool keys = build_key_exits(world);
+    bool verbs = build_verbs(world);
+    def->conditions_dirty = !deps || !keys || !verbs;
+}
+
+bool world_add_verb(World *world, const char *word, const char *verb) {
+    if (!can_build(world) || !word || !verb) return false;
+
+    // Commands reach the table lowercased by the parser
+    char lower[64];
+    size_t len = strlen(word);
+    if (len == 0 || len >= sizeof(lower)) return false;
+    for (size_t i = 0; i <= len; i++) {
+        lower[i] = (char)tolower((unsigned char)word[i]);
+        if (isspace((unsigned char)lower[i])) return false;
+    }
+    char target[64];
+    snprintf(target, sizeof(target), "%s", verb);
+    for (char *p = target; *p; p++) {
+        *p = (char)tolower((unsigned char)*p);
+    }
+    Verb id = verb_builtin(target);
+    if (id == VERB_NONE) return false;
+
+    WorldDef *def = world->def;
+    if (def->verb_synonym_count >= def->verb_synonym_capacity) {
+        int capacity = def->verb_synonym_capacity ? def->verb_synonym_capacity * 2 : 8;
+        VerbSynonym *grown = realloc(def->verb_synonyms, (size_t)capacity * sizeof(VerbSynonym));
+        if (!grown) return false;
+        def->verb_synonyms = grown;
+        def->verb_synonym_capacity = capacity;
+    }
+    StrRef ref = world_strdup(world, lower);
+    if (!ref) return false;
+
+    VerbSynonym *synonym = &def->verb_synonyms[def->verb_synonym_count++];
+    synonym->word = ref;
+    synonym->verb = id;
+    def->conditions_dirty = true;
+    return true;
+}
 
-        if (!evaluate_condition(world, room, cond)) {
-            continue;
+Verb world_find_verb(World *world, const char *word, size_t len) {
+    const WorldDef *def = world->def;
+    if (def->conditions_dirty) {
+        world_compile_conditions(world);
+    }
+    if (def->verbs.bucket_count > 0) return verb_table_find(&def->verbs, word, len);
+
+    // No table (a compile ran out of memory): synonyms newest first, then
+    // the built-in words
+    char lower[64];
+    if (len >= sizeof(lower)) return VERB_NONE;
+    for (size_t i = 0; i < len; i++) {
+        lower[i] = (char)tolower((unsigned char)word[i]);
+    }
+    lower[len] = '\0';
+    for (int i = def->verb_synonym_count - 1; i >= 0; i--) {
+        if (strcmp(world_str(world, def->verb_synonyms[i].word), lower) == 0) {
+            return (Verb)def->verb_synonyms[i].verb;
         }
+    }
+    return verb_builtin(lower);
+}
+
+int world_key_exits(World *world, int item_id, const int32_t **exits) {
+    *exits = NULL;
+    if (world->def->conditions_dirty) {
+        world_compile_conditions(world);
+    }
+
+    const WorldDef *def = world->def;
+    if (item_id < 0 || item_id >= def->item_count || !def->key_exit_start) return 0;
+    *exits = def->key_exits + def->key_exit_start[item_id];
+    return def->key_exit_start[item_id + 1] - def->key_exit_start[item_id];
+}
+
+int world_unlock_with_key(World *world, int item_id, int room_id) {
+    const int32_t *exits;
+    int count = world_key_exits(world, item_id, &exits);
 
-        // Assign priority based on condition type
-        int priority;
-        switch (cond->type) {
-            case COND_ITEM_USED:
-                priority = 4;
-                break;
-            case COND_HAS_ITEM:
-                priority = 3;
-                break;
-            case COND_ROOM_HAS_ITEM:
-                priority = 2;
-                break;
-            case COND_FIRST_VISIT:
-            case COND_VISITED:
-                priority = 1;
-                break;
-            default:
-                priority = 0;
+    // A room's exits are one contiguous range of indices
+    int first = room_id == -1 ? 0 : world_exits_begin(world, room_id);
+    int last = room_id == -1 ? world->def->exit_count : world_exits_end(world, room_id);
+
+    int unlocked = 0;
+    for (int i = 0; i < count; i++) {
+        int e = exits[i];
+        if (e < first || e >= last || bitset_test(world->exit_unlocked, (size_t)e)) continue;
+        set_state_bit(world, STATE_EXIT_UNLOCKED, (size_t)e, true);
+        unlocked++;
+    }
+    return unlocked;
+}
+
+void world_invalidate_descriptions(World *world) {
+    // Only cached rooms are visited; fixed ones read the same in any state
+    size_t words = BITSET_WORDS((size_t)world->room_capacity);
+    for (size_t w = 0; w < words; w++) {
+        uint64_t bits = world->description_cached[w];
+        while (bits) {
+            size_t r = w * 64 + (size_t)__builtin_ctzll(bits);
+            bits &= bits - 1;
+            if (!world->def->rooms[r].description_fixed) bitset_clear(world->description_cached, r);
         }
+    }
+}
 
-        if (priority > best_priority) {
-            best_priority = priority;
-            best_desc = cond->description;
+const char* world_get_room_description(World *world, Room *room) {
+    if (!world || !room) return "";
+
+    if (world->def->conditions_dirty) {
+        world_compile_conditions(world);
+    }
+
+    int room_id = (int)(room - world->def->rooms);
+    StrRef desc;
+    if (bitset_test(world->description_cached, (size_t)room_id)) {
+        desc = world->cached_description[room_id];
+    } else {
+        desc = match_conditions(world, room_id);
+        world->cached_description[room_id] = desc;
+        if (!world->def->conditions_dirty) {
+            bitset_set(world->description_cached, (size_t)room_id);
         }
     }
 
-    // Mark that this room's description has been shown (for first_visit tracking)
-    room->description_shown = true;
+    // Mark that this room's description has been shown (for first_visit tracking);
+    // the first time this invalidates the entry just cached for first_visit rooms
+    set_state_bit(world, STATE_DESCRIPTION_SHOWN, (size_t)room_id, true);
 
-    // Return best matching conditional description, or default
-    return best_desc ? best_desc : room->description;
+    return world_str(world, desc);
 }
 
 bool world_move(World *world, Direction dir) {
@@ -241,190 +1473,126 @@ MoveResult world_move_ex(World *world, Direction dir, char *key_needed, size_t k
         key_needed[0] = '\0';
     }
 
-    Room *room = world_current_room(world);
-    if (!room) return MOVE_NO_EXIT;
+    int exit_id = world_direction_exit(world, world->current_room, dir);
+    if (exit_id == -1) return MOVE_NO_EXIT;
+    return world_move_exit(world, exit_id, key_needed, key_size);
+}
+
+MoveResult world_move_exit(World *world, int exit_id, char *key_needed, size_t key_size) {
+    if (key_needed && key_size > 0) {
+        key_needed[0] = '\0';
+    }
+
+    // The exit must leave the current room
+    const WorldDef *def = world->def;
+    int here = world->current_room;
+    if (here < 0 || here >= def->room_count) return MOVE_NO_EXIT;
+    if (exit_id < def->exit_start[here] || exit_id >= def->exit_start[here + 1]) return MOVE_NO_EXIT;
 
-    int next_room = room->exits[dir];
-    if (next_room == -1) return MOVE_NO_EXIT;
+    // Only the exit itself is touched unless it is locked
+    const Exit *exit = &def->exits[exit_id];
+    int next_room = exit->to;
 
     // Check if exit is locked
-    if (room->locked_exits[dir][0] != '\0' && !room->exit_unlocked[dir]) {
+    if (exit->key && !bitset_test(world->exit_unlocked, (size_t)exit_id)) {
+        // Keys are resolved to item indices while the world is built
+        if (def->conditions_dirty) {
+            world_compile_conditions(world);
+        }
+
         // Exit is locked - check if player has the key
-        const char *required_key = room->locked_exits[dir];
-        if (world_has_item(world, required_key)) {
+        int key_item = exit->key_item;
+        if (key_item >= 0 && world->item_location[key_item].where == ITEM_IN_INVENTORY) {
             // Player has key - auto-unlock and proceed
-            room->exit_unlocked[dir] = true;
+            set_state_bit(world, STATE_EXIT_UNLOCKED, (size_t)exit_id, true);
         } else {
             // Player doesn't have key
             if (key_needed && key_size > 0) {
-                strncpy(key_needed, required_key, key_size - 1);
+                strncpy(key_needed, world_str(world, exit->key), key_size - 1);
                 key_needed[key_size - 1] = '\0';
             }
             return MOVE_LOCKED;
         }
     }
 
+    if (world->journal) {
+        JournalRecord record = {
+            .type = JOURNAL_ROOM, .before = here, .after = next_room
+        };
+        world_journal_record(world->journal, &record);
+    }
     world->current_room = next_room;
-    world->rooms[next_room].visited = true;
+    set_state_bit(world, STATE_VISITED, (size_t)next_room, true);
     return MOVE_SUCCESS;
 }
 
 bool world_exit_is_locked(World *world, Direction dir) {
-    Room *room = world_current_room(world);
-    if (!room) return false;
-
     // Exit is locked if it has a required key AND hasn't been unlocked yet
-    return room->locked_exits[dir][0] != '\0' && !room->exit_unlocked[dir];
+    int exit_id = world_direction_exit(world, world->current_room, dir);
+    return exit_id != -1 && !world_exit_open(world, exit_id);
 }
 
 void world_unlock_exit(World *world, int room_id, Direction dir) {
-    if (room_id < 0 || room_id >= world->room_count) return;
-    if (dir < 0 || dir >= DIR_COUNT) return;
-
-    world->rooms[room_id].exit_unlocked[dir] = true;
+    world_set_exit_unlocked(world, world_direction_exit(world, room_id, dir), true);
 }
 
 void world_lock_exit(World *world, int room_id, Direction dir, const char *key_item_id) {
-    if (room_id < 0 || room_id >= world->room_count) return;
-    if (dir < 0 || dir >= DIR_COUNT) return;
     if (!key_item_id) return;
-
-    strncpy(world->rooms[room_id].locked_exits[dir],
-            key_item_id,
-            sizeof(world->rooms[room_id].locked_exits[dir]) - 1);
-    world->rooms[room_id].locked_exits[dir][sizeof(world->rooms[room_id].locked_exits[dir]) - 1] = '\0';
-    world->rooms[room_id].exit_unlocked[dir] = false;
+    world_set_exit_key(world, world_direction_exit(world, room_id, dir), key_item_id);
 }
 
 const char* world_get_required_key(World *world, Direction dir) {
-    Room *room = world_current_room(world);
-    if (!room) return NULL;
+    return world_exit_key(world, world->current_room, dir);
+}
 
-    if (room->locked_exits[dir][0] != '\0') {
-        return room->locked_exits[dir];
-    }
-    return NULL;
+// Helper: Find item by ID if it is in the given location (-1 if not)
+static int find_item_at(World *world, const char *item_id, int location) {
+    int idx = world_find_item(world, item_id);
+    if (idx >= 0 && world->item_location[idx].where == location) return idx;
+    return -1;
 }
 
 bool world_take_item(World *world, const char *item_id) {
-    Room *room = world_current_room(world);
-    if (!room) return false;
-
-    // Find item in room
-    int item_idx = -1;
-    int room_slot = -1;
-
-    for (int i = 0; i < MAX_ITEMS; i++) {
-        if (room->items[i] != -1) {
-            Item *item = &world->items[room->items[i]];
-            if (strcmp(item->id, item_id) == 0) {
-                item_idx = room->items[i];
-                room_slot = i;
-                break;
-            }
-        }
-    }
+    if (!world_current_room(world)) return false;
 
+    int item_idx = find_item_at(world, item_id, world->current_room);
     if (item_idx == -1) return false;
+    if (!world->def->items[item_idx].takeable) return false;
 
-    Item *item = &world->items[item_idx];
-    if (!item->takeable) return false;
-
-    // Find empty inventory slot
-    for (int i = 0; i < MAX_INVENTORY; i++) {
-        if (world->inventory[i] == -1) {
-            world->inventory[i] = item_idx;
-            room->items[room_slot] = -1;
-            return true;
-        }
-    }
-
-    return false; // Inventory full
+    // Fails if inventory is full
+    return world_set_item_location(world, item_idx, ITEM_IN_INVENTORY);
 }
 
 bool world_drop_item(World *world, const char *item_id) {
-    Room *room = world_current_room(world);
-    if (!room) return false;
-
-    // Find item in inventory
-    int item_idx = -1;
-    int inv_slot = -1;
-
-    for (int i = 0; i < MAX_INVENTORY; i++) {
-        if (world->inventory[i] != -1) {
-            Item *item = &world->items[world->inventory[i]];
-            if (strcmp(item->id, item_id) == 0) {
-                item_idx = world->inventory[i];
-                inv_slot = i;
-                break;
-            }
-        }
-    }
+    if (!world_current_room(world)) return false;
 
+    int item_idx = find_item_at(world, item_id, ITEM_IN_INVENTORY);
     if (item_idx == -1) return false;
 
-    // Find empty room slot
-    for (int i = 0; i < MAX_ITEMS; i++) {
-        if (room->items[i] == -1) {
-            room->items[i] = item_idx;
-            world->inventory[inv_slot] = -1;
-            return true;
-        }
-    }
-
-    return false; // Room full (shouldn't happen normally)
+    return world_set_item_location(world, item_idx, world->current_room);
 }
 
 bool world_has_item(World *world, const char *item_id) {
-    for (int i = 0; i < MAX_INVENTORY; i++) {
-        if (world->inventory[i] != -1) {
-            Item *item = &world->items[world->inventory[i]];
-            if (strcmp(item->id, item_id) == 0) {
-                return true;
-            }
-        }
-    }
-    return false;
+    return find_item_at(world, item_id, ITEM_IN_INVENTORY) != -1;
 }
 
 bool world_remove_from_inventory(World *world, const char *item_id) {
-    for (int i = 0; i < MAX_INVENTORY; i++) {
-        if (world->inventory[i] != -1) {
-            Item *item = &world->items[world->inventory[i]];
-            if (strcmp(item->id, item_id) == 0) {
-                world->inventory[i] = -1;
-                return true;
-            }
-        }
-    }
-    return false;
+    int item_idx = find_item_at(world, item_id, ITEM_IN_INVENTORY);
+    if (item_idx == -1) return false;
+
+    return world_set_item_location(world, item_idx, ITEM_NOWHERE);
 }
 
 Item* world_get_inventory_item(World *world, const char *item_id) {
-    for (int i = 0; i < MAX_INVENTORY; i++) {
-        if (world->inventory[i] != -1) {
-            Item *item = &world->items[world->inventory[i]];
-            if (strcmp(item->id, item_id) == 0) {
-                return item;
-            }
-        }
-    }
-    return NULL;
+    int item_idx = find_item_at(world, item_id, ITEM_IN_INVENTORY);
+    return item_idx == -1 ? NULL : &world->def->items[item_idx];
 }
 
 Item* world_get_room_item(World *world, const char *item_id) {
-    Room *room = world_current_room(world);
-    if (!room) return NULL;
-
-    for (int i = 0; i < MAX_ITEMS; i++) {
-        if (room->items[i] != -1) {
-            Item *item = &world->items[room->items[i]];
-            if (strcmp(item->id, item_id) == 0) {
-                return item;
-            }
-        }
-    }
-    return NULL;
+    if (!world_current_room(world)) return NULL;
+
+    int item_idx = find_item_at(world, item_id, world->current_room);
+    return item_idx == -1 ? NULL : &world->def->items[item_idx];
 }
 
 int str_to_direction(const char *str) {
@@ -0,0 +1,124 @@
+/*
+ * Adventure Engine - Compiled World Cache Implementation
+ */
+
+#define _DEFAULT_SOURCE  // For realpath()
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "world_cache.h"
+
+#define CACHE_SUBDIR "adventure-engine"
+
+bool world_cache_dir(char *buffer, size_t size) {
+    const char *dir = getenv(WORLD_CACHE_ENV);
+    if (dir) {
+        snprintf(buffer, size, "%s", dir);
+        return dir[0] != '\0';
+    }
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    if (xdg && xdg[0] != '\0') {
+        snprintf(buffer, size, "%s/%s", xdg, CACHE_SUBDIR);
+        return true;
+    }
+    const char *home = getenv("HOME");
+    if (home && home[0] != '\0') {
+        snprintf(buffer, size, "%s/.cache/%s", home, CACHE_SUBDIR);
+        return true;
+    }
+    return false;
+}
+
+void world_cache_path(const char *cache_dir, const char *source_path, char *buffer, size_t size) {
+    char real[PATH_MAX];
+    const char *key = realpath(source_path, real) ? real : source_path;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const unsigned char *p = (const unsigned char *)key; *p; p++) {
+        hash ^= *p;
+        hash *= 0x100000001b3ULL;
+    }
+
+    const char *base = strrchr(source_path, '/');
+    base = base ? base + 1 : source_path;
+    size_t len = strlen(base);
+    if (len > 6 && strcmp(base + len - 6, ".world") == 0) len -= 6;
+    snprintf(buffer, size, "%s/%.*s-%016llx%s", cache_dir, (int)len, base,
+             (unsigned long long)hash, WORLD_IMAGE_EXTENSION);
+}
+
+// Helper: Create dir and any missing parents (private to the user)
+static bool make_dirs(const char *dir) {
+    char path[PATH_MAX];
+    int len = snprintf(path, sizeof(path), "%s", dir);
+    if (len <= 0 || (size_t)len >= sizeof(path)) return false;
+    for (char *p = path + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        if (mkdir(path, 0700) != 0 && errno != EEXIST) return false;
+        *p = '/';
+    }
+    return mkdir(path, 0700) == 0 || errno == EEXIST;
+}
+
+static bool same_file_time(const WorldSourceStamp *a, const WorldSourceStamp *b) {
+    return a->size == b->size && a->mtime_sec == b->mtime_sec && a->mtime_nsec == b->mtime_nsec;
+}
+
+bool world_cache_load(World *world, const char *source_path, const char *cache_dir,
+                      LoadError *error, WorldCacheResult *result) {
+    WorldCacheResult ignored;
+    if (!result) result = &ignored;
+    *result = WORLD_CACHE_UNCACHED;
+
+    WorldSourceStamp source;
+    if (!cache_dir || !world_source_stamp(source_path, false, &source)) {
+        return world_load_from_file(world, source_path, error);
+    }
+
+    char image_path[PATH_MAX];
+    world_cache_path(cache_dir, source_path, image_path, sizeof(image_path));
+
+    // Same size and mtime: trust the image. Same size only: the file was
+    // touched or copied, so compare content hashes before trusting it.
+    WorldSourceStamp cached;
+    if (world_image_source(image_path, &cached) && cached.size == source.size &&
+        cached.hash != 0) {
+        bool fresh = same_file_time(&cached, &source);
+        bool same_content = fresh ||
+            (world_source_stamp(source_path, true, &source) && source.hash == cached.hash);
+        if (same_content) {
+            if (world_image_load(world, image_path, error)) {
+                if (!fresh) {
+                    // Record the new mtime so the next open skips the hash
+                    LoadError ignored_error;
+                    world_image_write(world, image_path, &source, &ignored_error);
+                }
+                *result = fresh ? WORLD_CACHE_HIT : WORLD_CACHE_REVALIDATED;
+                return true;
+            }
+            world_free(world);  // Damaged image: parse instead, and replace it
+        }
+    }
+
+    // Hash before parsing; if the file changes under us, its stamp no
+    // longer matches and the image is not written
+    if (source.hash == 0 && !world_source_stamp(source_path, true, &source)) {
+        return world_load_from_file(world, source_path, error);
+    }
+    if (!world_load_from_file(world, source_path, error)) {
+        return false;
+    }
+
+    WorldSourceStamp after;
+    LoadError write_error;
+    if (world_source_stamp(source_path, false, &after) && same_file_time(&after, &source) &&
+        make_dirs(cache_dir) && world_image_write(world, image_path, &source, &write_error)) {
+        *result = WORLD_CACHE_MISS;
+    }
+    return true;
+}
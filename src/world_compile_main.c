@@ -0,0 +1,81 @@
+/*
+ * World Compile - turns a .world file into a compiled image (.worldc)
+ *
+ * Usage: world-compile <input.world> [output.worldc]
+ *
+ * Loads and validates the world as the engine would, then writes its
+ * definition as a binary image the engine maps without parsing (see
+ * world_image.h). The output defaults to the input path with the .worldc
+ * extension; `game_open` uses worlds/<name>.worldc instead of the .world
+ * file whenever the image is at least as new.
+ *
+ * Exit status: 0 on success, 1 if the world does not load or the image
+ * cannot be written, 2 on bad usage.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "world_image.h"
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "Usage: %s <input.world> [output.worldc]\n", argv[0]);
+        return 2;
+    }
+
+    const char *input = argv[1];
+    char output[1024];
+    if (argc == 3) {
+        snprintf(output, sizeof(output), "%s", argv[2]);
+    } else {
+        size_t len = strlen(input);
+        if (len > 6 && strcmp(input + len - 6, ".world") == 0) len -= 6;
+        snprintf(output, sizeof(output), "%.*s%s", (int)len, input, WORLD_IMAGE_EXTENSION);
+    }
+
+    // Recorded in the image, so caches can tell whether it is still current
+    WorldSourceStamp source;
+    if (!world_source_stamp(input, true, &source)) {
+        fprintf(stderr, "Error: cannot read %s\n", input);
+        return 1;
+    }
+
+    World world;
+    LoadError error;
+    double start = now_sec();
+    if (!world_load_from_file(&world, input, &error)) {
+        fprintf(stderr, "Error: %s: %s\n", input, world_loader_get_error(&error));
+        world_free(&world);
+        return 1;
+    }
+    double parsed = now_sec();
+    if (!world_image_write(&world, output, &source, &error)) {
+        fprintf(stderr, "Error: %s\n", world_loader_get_error(&error));
+        world_free(&world);
+        return 1;
+    }
+    double written = now_sec();
+    printf("%s -> %s: %d rooms, %d exits, %d items (parse %.2f ms, write %.2f ms)\n", input,
+           output, world.def->room_count, world.def->exit_count, world.def->item_count,
+           (parsed - start) * 1e3, (written - parsed) * 1e3);
+    world_free(&world);
+
+    // Open the image as the engine will, so a bad image fails the build
+    start = now_sec();
+    if (!world_image_load(&world, output, &error)) {
+        fprintf(stderr, "Error: %s\n", world_loader_get_error(&error));
+        return 1;
+    }
+    printf("  image opens in %.3f ms\n", (now_sec() - start) * 1e3);
+    world_free(&world);
+    return 0;
+}
@@ -0,0 +1,335 @@
+/*
+ * World Embed - turns .world files into C tables linked into the engine
+ *
+ * Usage: world-embed <output.c> <input.world>...
+ *
+ * Loads and validates each world as the engine would, then writes one C
+ * source file holding every world's definition as static const arrays (a
+ * WorldTables per world, see world_image.h) plus the NULL-terminated
+ * embedded_worlds list. Built with EMBEDDED_WORLDS (make EMBED_WORLDS=...),
+ * the engine opens these by name with no file I/O or parsing, and the
+ * tables sit in .rodata, shared by every process running the binary.
+ * Each world is named by its file name without .world, as game_open takes it.
+ *
+ * The tables are written with designated initializers against the
+ * engine's own headers, so they compile on any platform; regenerate them
+ * whenever the world files or the engine's world structures change.
+ *
+ * Exit status: 0 on success, 1 if a world does not load or the output
+ * cannot be written, 2 on bad usage.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "save_load.h"
+#include "world_image.h"
+
+#define NUMBERS_PER_LINE 12
+#define TEXT_LINE_CHARS 72
+
+typedef enum {
+    NUMBER_INT,
+    NUMBER_INT32,
+    NUMBER_UINT32
+} NumberKind;
+
+// Helper: Emit an array of integers; empty arrays are left out (NULL)
+static void emit_numbers(FILE *out, const char *prefix, const char *name, NumberKind kind,
+                         const void *values, int count) {
+    static const char *types[] = { "int", "int32_t", "uint32_t" };
+    if (count <= 0 || !values) return;
+
+    fprintf(out, "static const %s %s_%s[%d] = {", types[kind], prefix, name, count);
+    for (int i = 0; i < count; i++) {
+        fputs(i % NUMBERS_PER_LINE == 0 ? "\n    " : " ", out);
+        switch (kind) {
+            case NUMBER_INT:
+                fprintf(out, "%d,", ((const int *)values)[i]);
+                break;
+            case NUMBER_INT32:
+                fprintf(out, "%" PRId32 ",", ((const int32_t *)values)[i]);
+                break;
+            case NUMBER_UINT32:
+                fprintf(out, "%" PRIu32 "u,", ((const uint32_t *)values)[i]);
+                break;
+        }
+    }
+    fprintf(out, "\n};\n\n");
+}
+
+// Helper: Emit NUL-separated text as a char array, one string per line
+// The array is size bytes; its last byte is the literal's own terminator.
+static void emit_text(FILE *out, const char *prefix, const char *name, const char *text,
+                      size_t size) {
+    if (size == 0 || !text) return;
+
+    fprintf(out, "static const char %s_%s[%zu] =\n    \"", prefix, name, size);
+    int column = 0;
+    for (size_t i = 0; i + 1 < size; i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\') {
+            column += fprintf(out, "\\%c", c);
+        } else if (c == '?') {
+            column += fprintf(out, "\\?");  // Never part of a trigraph
+        } else if (c >= 0x20 && c < 0x7f) {
+            fputc(c, out);
+            column++;
+        } else {
+            column += fprintf(out, "\\%03o", c);  // Always 3 digits: a digit may follow
+        }
+        if ((c == '\0' || column >= TEXT_LINE_CHARS) && i + 2 < size) {
+            fputs("\"\n    \"", out);
+            column = 0;
+        }
+    }
+    fprintf(out, "\";\n\n");
+}
+
+// Helper: An array's name in the WorldTables initializer (NULL if left out)
+static void emit_ref(FILE *out, const char *field, const char *prefix, const char *name,
+                     bool present) {
+    if (present) {
+        fprintf(out, "    .%s = %s_%s,\n", field, prefix, name);
+    } else {
+        fprintf(out, "    .%s = NULL,\n", field);
+    }
+}
+
+static const char* yes(bool value) {
+    return value ? "true" : "false";
+}
+
+// Helper: Emit one world's tables and its WorldTables (world_<prefix>)
+static void emit_world(FILE *out, const char *name, const char *prefix, const char *source,
+                       const WorldTables *t) {
+    int rooms = t->room_count;
+    int items = t->item_count;
+    fprintf(out, "/* %s: %s (%d rooms, %d exits, %d items) */\n\n", name, source, rooms,
+            t->exit_count, items);
+
+    fprintf(out, "static const Room %s_rooms[%d] = {\n", prefix, rooms);
+    for (int r = 0; r < rooms; r++) {
+        const Room *room = &t->rooms[r];
+        fprintf(out, "    { .id = %" PRIu32 "u, .name = %" PRIu32 "u, .description = %" PRIu32 "u, "
+                     ".conditional_desc_start = %" PRId32 ", .conditional_desc_count = %d, "
+                     ".description_fixed = %s, .depends_on_visits = %s },\n",
+                room->id, room->name, room->description, room->conditional_desc_start,
+                room->conditional_desc_count, yes(room->description_fixed),
+                yes(room->depends_on_visits));
+    }
+    fprintf(out, "};\n\n");
+
+    emit_numbers(out, prefix, "exit_start", NUMBER_INT32, t->exit_start, rooms + 1);
+    if (t->exit_count > 0) {
+        fprintf(out, "static const Exit %s_exits[%d] = {\n", prefix, t->exit_count);
+        for (int e = 0; e < t->exit_count; e++) {
+            const Exit *exit = &t->exits[e];
+            fprintf(out, "    { .to = %" PRId32 ", .name = %" PRIu32 "u, .key = %" PRIu32 "u, "
+                         ".key_item = %" PRId32 ", .dir = %u },\n",
+                    exit->to, exit->name, exit->key, exit->key_item, (unsigned)exit->dir);
+        }
+        fprintf(out, "};\n\n");
+    }
+
+    if (items > 0) {
+        fprintf(out, "static const Item %s_items[%d] = {\n", prefix, items);
+        for (int i = 0; i < items; i++) {
+            const Item *item = &t->items[i];
+            fprintf(out, "    { .id = %" PRIu32 "u, .name = %" PRIu32 "u, .description = %" PRIu32 "u, "
+                         ".takeable = %s, .visible = %s, .use_message = %" PRIu32 "u, "
+                         ".use_consumable = %s },\n",
+                    item->id, item->name, item->description, yes(item->takeable),
+                    yes(item->visible), item->use_message, yes(item->use_consumable));
+        }
+        fprintf(out, "};\n\n");
+    }
+
+    if (t->condition_count > 0) {
+        fprintf(out, "static const ConditionalDesc %s_conditions[%d] = {\n", prefix,
+                t->condition_count);
+        for (int c = 0; c < t->condition_count; c++) {
+            const ConditionalDesc *cond = &t->conditions[c];
+            fprintf(out, "    { .type = %d, .subject = %" PRIu32 "u, .negate = %s, "
+                         ".description = %" PRIu32 "u, .item = %" PRId32 ", .priority = %u },\n",
+                    (int)cond->type, cond->subject, yes(cond->negate), cond->description,
+                    cond->item, (unsigned)cond->priority);
+        }
+        fprintf(out, "};\n\n");
+    }
+
+    int dep_count = t->item_dep_start[items];
+    int key_count = t->key_exit_start[items];
+    emit_numbers(out, prefix, "item_dep_start", NUMBER_INT, t->item_dep_start, items + 1);
+    emit_numbers(out, prefix, "item_dep_rooms", NUMBER_INT, t->item_dep_rooms, dep_count);
+    emit_numbers(out, prefix, "key_exit_start", NUMBER_INT32, t->key_exit_start, items + 1);
+    emit_numbers(out, prefix, "key_exits", NUMBER_INT32, t->key_exits, key_count);
+
+    if (t->verb_synonym_count > 0) {
+        fprintf(out, "static const VerbSynonym %s_verb_synonyms[%d] = {\n", prefix,
+                t->verb_synonym_count);
+        for (int v = 0; v < t->verb_synonym_count; v++) {
+            fprintf(out, "    { .word = %" PRIu32 "u, .verb = %" PRId32 " },\n",
+                    t->verb_synonyms[v].word, t->verb_synonyms[v].verb);
+        }
+        fprintf(out, "};\n\n");
+    }
+    emit_numbers(out, prefix, "verb_displace", NUMBER_UINT32, t->verb_displace,
+                 t->verb_bucket_count);
+    if (t->verb_slot_count > 0) {
+        fprintf(out, "static const VerbSlot %s_verb_slots[%d] = {\n", prefix, t->verb_slot_count);
+        for (int v = 0; v < t->verb_slot_count; v++) {
+            const VerbSlot *slot = &t->verb_slots[v];
+            fprintf(out, "    { .hash = UINT64_C(0x%016" PRIx64 "), .word = %" PRIu32 "u, "
+                         ".verb = %" PRId32 " },\n", slot->hash, slot->word, slot->verb);
+        }
+        fprintf(out, "};\n\n");
+    }
+    emit_text(out, prefix, "verb_text", t->verb_text, t->verb_text_size);
+
+    emit_numbers(out, prefix, "room_hashes", NUMBER_UINT32, t->room_hashes, t->room_index_capacity);
+    emit_numbers(out, prefix, "room_slots", NUMBER_INT, t->room_slots, t->room_index_capacity);
+    emit_numbers(out, prefix, "item_hashes", NUMBER_UINT32, t->item_hashes, t->item_index_capacity);
+    emit_numbers(out, prefix, "item_slots", NUMBER_INT, t->item_slots, t->item_index_capacity);
+    emit_numbers(out, prefix, "item_start", NUMBER_INT32, t->item_start, items);
+    emit_text(out, prefix, "strings", t->strings, t->strings_size);
+
+    fprintf(out, "static const WorldTables world_%s = {\n", prefix);
+    fprintf(out, "    .name = \"%s\",\n", name);
+    emit_ref(out, "rooms", prefix, "rooms", true);
+    emit_ref(out, "exit_start", prefix, "exit_start", true);
+    emit_ref(out, "exits", prefix, "exits", t->exit_count > 0);
+    emit_ref(out, "items", prefix, "items", items > 0);
+    emit_ref(out, "conditions", prefix, "conditions", t->condition_count > 0);
+    fprintf(out, "    .room_count = %d,\n    .exit_count = %d,\n    .item_count = %d,\n"
+                 "    .condition_count = %d,\n",
+            rooms, t->exit_count, items, t->condition_count);
+    emit_ref(out, "item_dep_start", prefix, "item_dep_start", true);
+    emit_ref(out, "item_dep_rooms", prefix, "item_dep_rooms", dep_count > 0);
+    emit_ref(out, "key_exit_start", prefix, "key_exit_start", true);
+    emit_ref(out, "key_exits", prefix, "key_exits", key_count > 0);
+    emit_ref(out, "verb_synonyms", prefix, "verb_synonyms", t->verb_synonym_count > 0);
+    fprintf(out, "    .verb_synonym_count = %d,\n", t->verb_synonym_count);
+    emit_ref(out, "verb_displace", prefix, "verb_displace", t->verb_bucket_count > 0);
+    emit_ref(out, "verb_slots", prefix, "verb_slots", t->verb_slot_count > 0);
+    emit_ref(out, "verb_text", prefix, "verb_text", t->verb_text_size > 0);
+    fprintf(out, "    .verb_text_size = %zu,\n    .verb_bucket_count = %d,\n"
+                 "    .verb_slot_count = %d,\n    .verb_count = %d,\n",
+            t->verb_text_size, t->verb_bucket_count, t->verb_slot_count, t->verb_count);
+    emit_ref(out, "room_hashes", prefix, "room_hashes", t->room_index_capacity > 0);
+    emit_ref(out, "room_slots", prefix, "room_slots", t->room_index_capacity > 0);
+    fprintf(out, "    .room_index_capacity = %d,\n    .room_index_count = %d,\n",
+            t->room_index_capacity, t->room_index_count);
+    emit_ref(out, "item_hashes", prefix, "item_hashes", t->item_index_capacity > 0);
+    emit_ref(out, "item_slots", prefix, "item_slots", t->item_index_capacity > 0);
+    fprintf(out, "    .item_index_capacity = %d,\n    .item_index_count = %d,\n",
+            t->item_index_capacity, t->item_index_count);
+    emit_ref(out, "strings", prefix, "strings", true);
+    fprintf(out, "    .strings_size = %" PRIu32 "u,\n", t->strings_size);
+    emit_ref(out, "item_start", prefix, "item_start", items > 0);
+    fprintf(out, "    .start_room = %d,\n};\n\n", t->start_room);
+}
+
+// Helper: World name from its path (file name without .world); false if
+// game_open could not take it
+static bool world_name_from_path(const char *path, char *name, size_t size) {
+    const char *base = strrchr(path, '/');
+    base = base ? base + 1 : path;
+    size_t len = strlen(base);
+    if (len > 6 && strcmp(base + len - 6, ".world") == 0) len -= 6;
+    if (len == 0 || len >= size) return false;
+    memcpy(name, base, len);
+    name[len] = '\0';
+    return is_safe_filename(name);
+}
+
+// Helper: C identifier prefix for the index'th world (unique, '-' as '_')
+static void world_prefix(int index, const char *name, char *prefix, size_t size) {
+    snprintf(prefix, size, "w%d_%s", index, name);
+    for (char *c = prefix; *c; c++) {
+        if (*c == '-') *c = '_';
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <output.c> <input.world>...\n", argv[0]);
+        return 2;
+    }
+
+    const char *output = argv[1];
+    char temp_path[1024];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp.%ld", output, (long)getpid());
+    FILE *out = fopen(temp_path, "w");
+    if (!out) {
+        fprintf(stderr, "Error: cannot write %s\n", temp_path);
+        return 1;
+    }
+
+    fprintf(out, "/*\n * Embedded worlds - generated by world-embed, do not edit\n *\n");
+    for (int i = 2; i < argc; i++) {
+        fprintf(out, " * %s\n", argv[i]);
+    }
+    fprintf(out, " */\n\n#include <stddef.h>\n#include <stdint.h>\n#include \"world_image.h\"\n\n");
+
+    int status = 0;
+    char name[64];
+    char prefix[80];
+    for (int i = 2; i < argc && status == 0; i++) {
+        char other[64];
+        if (!world_name_from_path(argv[i], name, sizeof(name))) {
+            fprintf(stderr, "Error: %s: world name must be letters, digits, '_' or '-'\n", argv[i]);
+            status = 1;
+            break;
+        }
+        for (int j = 2; j < i && status == 0; j++) {
+            if (world_name_from_path(argv[j], other, sizeof(other)) && strcmp(name, other) == 0) {
+                fprintf(stderr, "Error: %s: world '%s' listed twice\n", argv[i], name);
+                status = 1;
+            }
+        }
+        if (status != 0) break;
+
+        World world;
+        LoadError error;
+        WorldTables tables;
+        if (!world_load_from_file(&world, argv[i], &error) ||
+            !world_tables_build(&world, &tables, &error)) {
+            fprintf(stderr, "Error: %s: %s\n", argv[i], world_loader_get_error(&error));
+            world_free(&world);
+            status = 1;
+            break;
+        }
+        world_prefix(i - 2, name, prefix, sizeof(prefix));
+        emit_world(out, name, prefix, argv[i], &tables);
+        printf("%s: %d rooms, %d exits, %d items\n", argv[i], tables.room_count,
+               tables.exit_count, tables.item_count);
+        world_tables_free(&tables);
+        world_free(&world);
+    }
+
+    if (status == 0) {
+        fprintf(out, "const WorldTables *const embedded_worlds[] = {\n");
+        for (int i = 2; i < argc; i++) {
+            world_name_from_path(argv[i], name, sizeof(name));
+            world_prefix(i - 2, name, prefix, sizeof(prefix));
+            fprintf(out, "    &world_%s,\n", prefix);
+        }
+        fprintf(out, "    NULL\n};\n");
+    }
+
+    // Renamed into place only when complete, so make never sees half a file
+    if (fclose(out) != 0 && status == 0) {
+        fprintf(stderr, "Error: cannot write %s\n", temp_path);
+        status = 1;
+    }
+    if (status == 0 && rename(temp_path, output) != 0) {
+        fprintf(stderr, "Error: cannot write %s\n", output);
+        status = 1;
+    }
+    if (status != 0) unlink(temp_path);
+    return status;
+}
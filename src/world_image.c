@@ -0,0 +1,670 @@
+/*
+ * Adventure Engine - Compiled World Image Implementation
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE  // For MAP_ANONYMOUS
+
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "world_image.h"
+
+#define IMAGE_MAGIC "AEWORLDC"        // First 8 bytes (no NUL)
+#define IMAGE_ALIGN 64                // Section alignment (one cache line)
+#define IMAGE_BYTE_ORDER 0x01020304u  // Reads back differently on the other byte order
+
+typedef enum {
+    SECTION_ROOMS,
+    SECTION_EXIT_START,
+    SECTION_EXITS,
+    SECTION_ITEMS,
+    SECTION_CONDITIONS,
+    SECTION_ITEM_DEP_START,
+    SECTION_ITEM_DEP_ROOMS,
+    SECTION_KEY_EXIT_START,
+    SECTION_KEY_EXITS,
+    SECTION_VERB_SYNONYMS,
+    SECTION_VERB_DISPLACE,
+    SECTION_VERB_SLOTS,
+    SECTION_VERB_TEXT,
+    SECTION_ROOM_HASHES,
+    SECTION_ROOM_SLOTS,
+    SECTION_ITEM_HASHES,
+    SECTION_ITEM_SLOTS,
+    SECTION_ITEM_START,
+    SECTION_STRINGS,
+    SECTION_COUNT
+} ImageSection;
+
+typedef struct {
+    uint64_t offset;          // From the start of the file (IMAGE_ALIGN multiple)
+    uint64_t size;            // Bytes
+} ImageExtent;
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    // Sizes of the structs stored as they are in memory
+    uint16_t room_size;
+    uint16_t exit_size;
+    uint16_t item_size;
+    uint16_t condition_size;
+    uint16_t synonym_size;
+    uint16_t verb_slot_size;
+    uint16_t int_size;
+    uint16_t reserved;
+    uint64_t file_size;
+    int32_t room_count;
+    int32_t exit_count;
+    int32_t item_count;
+    int32_t condition_count;
+    int32_t verb_synonym_count;
+    int32_t verb_bucket_count;
+    int32_t verb_slot_count;
+    int32_t verb_count;
+    int32_t room_index_capacity;
+    int32_t room_index_count;
+    int32_t item_index_capacity;
+    int32_t item_index_count;
+    int32_t start_room;       // Room the player starts in
+    int32_t reserved2;
+    WorldSourceStamp source;  // File the image was compiled from (all 0 if unknown)
+    ImageExtent sections[SECTION_COUNT];
+} ImageHeader;
+
+// Helper: Record an error; returns false for the caller to return
+static bool image_error(LoadError *error, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(error->message, sizeof(error->message), format, args);
+    va_end(args);
+    error->has_error = true;
+    error->line_number = 0;
+    return false;
+}
+
+static uint64_t align_up(uint64_t offset) {
+    return (offset + IMAGE_ALIGN - 1) & ~(uint64_t)(IMAGE_ALIGN - 1);
+}
+
+// Helper: Header fields describing this build of the engine
+static void header_init(ImageHeader *header) {
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, IMAGE_MAGIC, sizeof(header->magic));
+    header->version = WORLD_IMAGE_VERSION;
+    header->byte_order = IMAGE_BYTE_ORDER;
+    header->room_size = (uint16_t)sizeof(Room);
+    header->exit_size = (uint16_t)sizeof(Exit);
+    header->item_size = (uint16_t)sizeof(Item);
+    header->condition_size = (uint16_t)sizeof(ConditionalDesc);
+    header->synonym_size = (uint16_t)sizeof(VerbSynonym);
+    header->verb_slot_size = (uint16_t)sizeof(VerbSlot);
+    header->int_size = (uint16_t)sizeof(int);
+}
+
+bool world_tables_build(World *world, WorldTables *tables, LoadError *error) {
+    error->has_error = false;
+    error->line_number = 0;
+    error->message[0] = '\0';
+    memset(tables, 0, sizeof(*tables));
+
+    WorldDef *def = world->def;
+    if (def->conditions_dirty) {
+        world_compile_conditions(world);
+    }
+    if (def->conditions_dirty) {
+        return image_error(error, "Cannot compile world (out of memory or shared)");
+    }
+
+    // Rooms with their conditions packed into one run each (the live
+    // definition keeps MAX_CONDITIONAL_DESCS slots per room)
+    size_t rooms = (size_t)def->room_count;
+    size_t items = (size_t)def->item_count;
+    int condition_count = 0;
+    for (size_t r = 0; r < rooms; r++) {
+        condition_count += def->rooms[r].conditional_desc_count;
+    }
+    Room *packed_rooms = malloc(rooms ? rooms * sizeof(Room) : 1);
+    ConditionalDesc *packed_conds = malloc(condition_count ? (size_t)condition_count * sizeof(ConditionalDesc) : 1);
+    int32_t *item_start = malloc(items ? items * sizeof(int32_t) : 1);
+    if (!packed_rooms || !packed_conds || !item_start) {
+        free(packed_rooms);
+        free(packed_conds);
+        free(item_start);
+        return image_error(error, "Out of memory");
+    }
+
+    if (rooms > 0) memcpy(packed_rooms, def->rooms, rooms * sizeof(Room));
+    int next = 0;
+    for (size_t r = 0; r < rooms; r++) {
+        Room *room = &packed_rooms[r];
+        int count = room->conditional_desc_count;
+        if (count > 0) {
+            memcpy(&packed_conds[next], world_room_conditions(def, &def->rooms[r]),
+                   (size_t)count * sizeof(ConditionalDesc));
+        }
+        room->conditional_desc_start = count > 0 ? next : -1;
+        next += count;
+    }
+    for (size_t i = 0; i < items; i++) {
+        item_start[i] = world->item_location[i].where;
+    }
+
+    tables->rooms = packed_rooms;
+    tables->exit_start = def->exit_start;
+    tables->exits = def->exits;
+    tables->items = def->items;
+    tables->conditions = packed_conds;
+    tables->room_count = def->room_count;
+    tables->exit_count = def->exit_count;
+    tables->item_count = def->item_count;
+    tables->condition_count = condition_count;
+    tables->item_dep_start = def->item_dep_start;
+    tables->item_dep_rooms = def->item_dep_rooms;
+    tables->key_exit_start = def->key_exit_start;
+    tables->key_exits = def->key_exits;
+    tables->verb_synonyms = def->verb_synonyms;
+    tables->verb_synonym_count = def->verb_synonym_count;
+    tables->verb_displace = def->verbs.displace;
+    tables->verb_slots = def->verbs.slots;
+    tables->verb_text = def->verbs.text;
+    tables->verb_text_size = def->verbs.text_size;
+    tables->verb_bucket_count = def->verbs.bucket_count;
+    tables->verb_slot_count = def->verbs.slot_count;
+    tables->verb_count = def->verbs.count;
+    tables->room_hashes = def->room_index.hashes;
+    tables->room_slots = def->room_index.slots;
+    tables->room_index_capacity = def->room_index.capacity;
+    tables->room_index_count = def->room_index.count;
+    tables->item_hashes = def->item_index.hashes;
+    tables->item_slots = def->item_index.slots;
+    tables->item_index_capacity = def->item_index.capacity;
+    tables->item_index_count = def->item_index.count;
+    tables->strings = def->strings.data;
+    tables->strings_size = def->strings.size;
+    tables->item_start = item_start;
+    tables->start_room = world->current_room;
+    return true;
+}
+
+void world_tables_free(WorldTables *tables) {
+    // Only these are copies; the rest belongs to the world's definition
+    free((void *)tables->rooms);
+    free((void *)tables->conditions);
+    free((void *)tables->item_start);
+    memset(tables, 0, sizeof(*tables));
+}
+
+void* world_image_encode(World *world, const WorldSourceStamp *source, size_t *image_size,
+                         LoadError *error) {
+    WorldTables tables;
+    if (!world_tables_build(world, &tables, error)) {
+        return NULL;
+    }
+
+    size_t rooms = (size_t)tables.room_count;
+    size_t items = (size_t)tables.item_count;
+
+    ImageHeader header;
+    header_init(&header);
+    header.room_count = tables.room_count;
+    header.exit_count = tables.exit_count;
+    header.item_count = tables.item_count;
+    header.condition_count = tables.condition_count;
+    header.verb_synonym_count = tables.verb_synonym_count;
+    header.verb_bucket_count = tables.verb_bucket_count;
+    header.verb_slot_count = tables.verb_slot_count;
+    header.verb_count = tables.verb_count;
+    header.room_index_capacity = tables.room_index_capacity;
+    header.room_index_count = tables.room_index_count;
+    header.item_index_capacity = tables.item_index_capacity;
+    header.item_index_count = tables.item_index_count;
+    header.start_room = tables.start_room;
+    if (source) header.source = *source;
+
+    const void *data[SECTION_COUNT];
+    size_t size[SECTION_COUNT];
+    data[SECTION_ROOMS] = tables.rooms;
+    size[SECTION_ROOMS] = rooms * sizeof(Room);
+    data[SECTION_EXIT_START] = tables.exit_start;
+    size[SECTION_EXIT_START] = tables.exit_start ? (rooms + 1) * sizeof(int32_t) : 0;
+    data[SECTION_EXITS] = tables.exits;
+    size[SECTION_EXITS] = (size_t)tables.exit_count * sizeof(Exit);
+    data[SECTION_ITEMS] = tables.items;
+    size[SECTION_ITEMS] = items * sizeof(Item);
+    data[SECTION_CONDITIONS] = tables.conditions;
+    size[SECTION_CONDITIONS] = (size_t)tables.condition_count * sizeof(ConditionalDesc);
+    data[SECTION_ITEM_DEP_START] = tables.item_dep_start;
+    size[SECTION_ITEM_DEP_START] = (items + 1) * sizeof(int);
+    data[SECTION_ITEM_DEP_ROOMS] = tables.item_dep_rooms;
+    size[SECTION_ITEM_DEP_ROOMS] = (size_t)tables.item_dep_start[items] * sizeof(int);
+    data[SECTION_KEY_EXIT_START] = tables.key_exit_start;
+    size[SECTION_KEY_EXIT_START] = (items + 1) * sizeof(int32_t);
+    data[SECTION_KEY_EXITS] = tables.key_exits;
+    size[SECTION_KEY_EXITS] = (size_t)tables.key_exit_start[items] * sizeof(int32_t);
+    data[SECTION_VERB_SYNONYMS] = tables.verb_synonyms;
+    size[SECTION_VERB_SYNONYMS] = (size_t)tables.verb_synonym_count * sizeof(VerbSynonym);
+    data[SECTION_VERB_DISPLACE] = tables.verb_displace;
+    size[SECTION_VERB_DISPLACE] = (size_t)tables.verb_bucket_count * sizeof(uint32_t);
+    data[SECTION_VERB_SLOTS] = tables.verb_slots;
+    size[SECTION_VERB_SLOTS] = (size_t)tables.verb_slot_count * sizeof(VerbSlot);
+    data[SECTION_VERB_TEXT] = tables.verb_text;
+    size[SECTION_VERB_TEXT] = tables.verb_text_size;
+    data[SECTION_ROOM_HASHES] = tables.room_hashes;
+    size[SECTION_ROOM_HASHES] = (size_t)tables.room_index_capacity * sizeof(uint32_t);
+    data[SECTION_ROOM_SLOTS] = tables.room_slots;
+    size[SECTION_ROOM_SLOTS] = (size_t)tables.room_index_capacity * sizeof(int);
+    data[SECTION_ITEM_HASHES] = tables.item_hashes;
+    size[SECTION_ITEM_HASHES] = (size_t)tables.item_index_capacity * sizeof(uint32_t);
+    data[SECTION_ITEM_SLOTS] = tables.item_slots;
+    size[SECTION_ITEM_SLOTS] = (size_t)tables.item_index_capacity * sizeof(int);
+    data[SECTION_ITEM_START] = tables.item_start;
+    size[SECTION_ITEM_START] = items * sizeof(int32_t);
+    data[SECTION_STRINGS] = tables.strings;
+    size[SECTION_STRINGS] = tables.strings_size;
+
+    uint64_t offset = align_up(sizeof(header));
+    for (int s = 0; s < SECTION_COUNT; s++) {
+        header.sections[s].offset = offset;
+        header.sections[s].size = size[s];
+        offset = align_up(offset + size[s]);
+    }
+    header.file_size = offset;
+
+    // calloc leaves the padding between sections zeroed
+    char *image = calloc(1, (size_t)header.file_size);
+    if (image) {
+        memcpy(image, &header, sizeof(header));
+        for (int s = 0; s < SECTION_COUNT; s++) {
+            if (size[s] > 0) memcpy(image + header.sections[s].offset, data[s], size[s]);
+        }
+        *image_size = (size_t)header.file_size;
+    }
+    world_tables_free(&tables);
+    if (!image) image_error(error, "Out of memory");
+    return image;
+}
+
+bool world_image_write(World *world, const char *path, const WorldSourceStamp *source,
+                       LoadError *error) {
+    size_t size;
+    void *image = world_image_encode(world, source, &size, error);
+    if (!image) return false;
+
+    // Write beside the destination, then rename over it
+    char temp_path[1024];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp.%ld", path, (long)getpid());
+    FILE *file = fopen(temp_path, "wb");
+    bool ok = file != NULL;
+    if (ok) {
+        ok = fwrite(image, 1, size, file) == size;
+        ok = fclose(file) == 0 && ok;
+        ok = ok && rename(temp_path, path) == 0;
+        if (!ok) unlink(temp_path);
+    }
+
+    free(image);
+    if (!ok) return image_error(error, "Cannot write file: %s", path);
+    return true;
+}
+
+// Helper: Check a section lies inside the file with the expected size
+static bool section_ok(const ImageHeader *header, ImageSection s, uint64_t expected) {
+    const ImageExtent *extent = &header->sections[s];
+    return extent->offset % IMAGE_ALIGN == 0 && extent->offset <= header->file_size &&
+           extent->size <= header->file_size - extent->offset && extent->size == expected;
+}
+
+static bool power_of_two_or_zero(int32_t n) {
+    return n >= 0 && (n & (n - 1)) == 0;
+}
+
+// Helper: Why a header is not one this build can use (NULL if it is)
+static const char* check_header(const ImageHeader *header) {
+    if (memcmp(header->magic, IMAGE_MAGIC, sizeof(header->magic)) != 0) {
+        return "Not a compiled world image";
+    }
+    if (header->version != WORLD_IMAGE_VERSION) {
+        return "Compiled world image has another version";
+    }
+
+    ImageHeader expected;
+    header_init(&expected);
+    if (header->byte_order != expected.byte_order || header->room_size != expected.room_size ||
+        header->exit_size != expected.exit_size || header->item_size != expected.item_size ||
+        header->condition_size != expected.condition_size ||
+        header->synonym_size != expected.synonym_size ||
+        header->verb_slot_size != expected.verb_slot_size || header->int_size != expected.int_size) {
+        return "Compiled world image was built for another platform";
+    }
+    return NULL;
+}
+
+// Helper: Why a mapped file is not a usable image (NULL if it is)
+// Checks only the header and a few array ends, so the cost does not grow
+// with the world; images are trusted build outputs like object files.
+static const char* check_image(const char *base, size_t file_size) {
+    const ImageHeader *header = (const ImageHeader *)base;
+    if (file_size < sizeof(*header)) {
+        return "Not a compiled world image";
+    }
+    const char *reason = check_header(header);
+    if (reason) {
+        return reason;
+    }
+    if (header->file_size != file_size) {
+        return "Compiled world image is truncated";
+    }
+
+    const char *damaged = "Compiled world image is damaged";
+    if (header->room_count <= 0 || header->exit_count < 0 || header->item_count < 0 ||
+        header->condition_count < 0 || header->verb_synonym_count < 0 ||
+        header->start_room < 0 || header->start_room >= header->room_count ||
+        !power_of_two_or_zero(header->verb_bucket_count) ||
+        !power_of_two_or_zero(header->verb_slot_count) ||
+        !power_of_two_or_zero(header->room_index_capacity) ||
+        !power_of_two_or_zero(header->item_index_capacity)) {
+        return damaged;
+    }
+
+    uint64_t rooms = (uint64_t)header->room_count;
+    uint64_t items = (uint64_t)header->item_count;
+    if (!section_ok(header, SECTION_ROOMS, rooms * sizeof(Room)) ||
+        !section_ok(header, SECTION_EXIT_START, (rooms + 1) * sizeof(int32_t)) ||
+        !section_ok(header, SECTION_EXITS, (uint64_t)header->exit_count * sizeof(Exit)) ||
+        !section_ok(header, SECTION_ITEMS, items * sizeof(Item)) ||
+        !section_ok(header, SECTION_CONDITIONS, (uint64_t)header->condition_count * sizeof(ConditionalDesc)) ||
+        !section_ok(header, SECTION_ITEM_DEP_START, (items + 1) * sizeof(int)) ||
+        !section_ok(header, SECTION_KEY_EXIT_START, (items + 1) * sizeof(int32_t)) ||
+        !section_ok(header, SECTION_VERB_SYNONYMS, (uint64_t)header->verb_synonym_count * sizeof(VerbSynonym)) ||
+        !section_ok(header, SECTION_VERB_DISPLACE, (uint64_t)header->verb_bucket_count * sizeof(uint32_t)) ||
+        !section_ok(header, SECTION_VERB_SLOTS, (uint64_t)header->verb_slot_count * sizeof(VerbSlot)) ||
+        !section_ok(header, SECTION_VERB_TEXT, header->sections[SECTION_VERB_TEXT].size) ||
+        !section_ok(header, SECTION_ROOM_HASHES, (uint64_t)header->room_index_capacity * sizeof(uint32_t)) ||
+        !section_ok(header, SECTION_ROOM_SLOTS, (uint64_t)header->room_index_capacity * sizeof(int)) ||
+        !section_ok(header, SECTION_ITEM_HASHES, (uint64_t)header->item_index_capacity * sizeof(uint32_t)) ||
+        !section_ok(header, SECTION_ITEM_SLOTS, (uint64_t)header->item_index_capacity * sizeof(int)) ||
+        !section_ok(header, SECTION_ITEM_START, items * sizeof(int32_t)) ||
+        !section_ok(header, SECTION_STRINGS, header->sections[SECTION_STRINGS].size)) {
+        return damaged;
+    }
+
+    // Array ends that size the remaining sections
+    const int32_t *exit_start = (const int32_t *)(base + header->sections[SECTION_EXIT_START].offset);
+    const int *dep_start = (const int *)(base + header->sections[SECTION_ITEM_DEP_START].offset);
+    const int32_t *key_start = (const int32_t *)(base + header->sections[SECTION_KEY_EXIT_START].offset);
+    if (exit_start[0] != 0 || exit_start[rooms] != header->exit_count ||
+        dep_start[items] < 0 || key_start[items] < 0 ||
+        !section_ok(header, SECTION_ITEM_DEP_ROOMS, (uint64_t)dep_start[items] * sizeof(int)) ||
+        !section_ok(header, SECTION_KEY_EXITS, (uint64_t)key_start[items] * sizeof(int32_t))) {
+        return damaged;
+    }
+
+    // Text sections end in a NUL, so no string runs off the end
+    const ImageExtent *strings = &header->sections[SECTION_STRINGS];
+    const ImageExtent *verb_text = &header->sections[SECTION_VERB_TEXT];
+    if (strings->size == 0 || strings->size > UINT32_MAX || base[strings->offset] != '\0' ||
+        base[strings->offset + strings->size - 1] != '\0' ||
+        (header->verb_bucket_count > 0 &&
+         (verb_text->size == 0 || base[verb_text->offset + verb_text->size - 1] != '\0'))) {
+        return damaged;
+    }
+    return NULL;
+}
+
+// Helper: Start world as a session of a definition whose arrays are the
+// tables (backing is the mapping, image_size bytes, or the linked-in
+// tables themselves with image_size 0). On failure world is left empty.
+static bool open_tables(World *world, const WorldTables *tables, const void *backing,
+                        size_t image_size) {
+    WorldDef *def = calloc(1, sizeof(WorldDef));
+    if (!def) return false;
+
+    // Cast away const: an image definition is never writable (see
+    // world_def_writable), so nothing writes through these
+    def->rooms = (Room *)tables->rooms;
+    def->exit_start = (int32_t *)tables->exit_start;
+    def->exits = (Exit *)tables->exits;
+    def->items = (Item *)tables->items;
+    def->conditional_descs = (ConditionalDesc *)tables->conditions;
+    def->room_count = def->room_capacity = tables->room_count;
+    def->exit_count = def->exit_capacity = tables->exit_count;
+    def->item_count = def->item_capacity = tables->item_count;
+    def->conditional_desc_used = def->conditional_desc_capacity = tables->condition_count;
+    def->item_dep_start = (int *)tables->item_dep_start;
+    def->item_dep_rooms = (int *)tables->item_dep_rooms;
+    def->key_exit_start = (int32_t *)tables->key_exit_start;
+    def->key_exits = (int32_t *)tables->key_exits;
+    def->verb_synonyms = (VerbSynonym *)tables->verb_synonyms;
+    def->verb_synonym_count = def->verb_synonym_capacity = tables->verb_synonym_count;
+    def->verbs.displace = (uint32_t *)tables->verb_displace;
+    def->verbs.slots = (VerbSlot *)tables->verb_slots;
+    def->verbs.text = (char *)tables->verb_text;
+    def->verbs.bucket_count = tables->verb_bucket_count;
+    def->verbs.slot_count = tables->verb_slot_count;
+    def->verbs.count = tables->verb_count;
+    def->verbs.text_size = tables->verb_text_size;
+    def->strings.data = (char *)tables->strings;
+    def->strings.size = def->strings.capacity = tables->strings_size;
+    def->room_index.hashes = (uint32_t *)tables->room_hashes;
+    def->room_index.slots = (int *)tables->room_slots;
+    def->room_index.capacity = tables->room_index_capacity;
+    def->room_index.count = tables->room_index_count;
+    def->item_index.hashes = (uint32_t *)tables->item_hashes;
+    def->item_index.slots = (int *)tables->item_slots;
+    def->item_index.capacity = tables->item_index_capacity;
+    def->item_index.count = tables->item_index_count;
+    def->conditions_dirty = false;
+    def->image = backing;
+    def->image_size = image_size;
+    atomic_init(&def->refcount, 0);
+
+    world_free(world);
+    if (!world_init_session(world, def)) {
+        free(def);
+        world_init(world);
+        return false;
+    }
+
+    // The starting state: items in index order, as the loader placed them
+    for (int i = 0; i < def->item_count; i++) {
+        if (tables->item_start[i] != ITEM_NOWHERE) {
+            world_set_item_location(world, i, tables->item_start[i]);
+        }
+    }
+    world->current_room = tables->start_room;
+    world_set_room_visited(world, tables->start_room, true);
+    return true;
+}
+
+// Helper: Check a mapped image and start world as a session of it (the
+// mapping is the definition's from then on, or unmapped on failure)
+static bool open_image(World *world, void *map, size_t file_size, const char *path,
+                       LoadError *error) {
+    const char *base = map;
+    const char *reason = check_image(base, file_size);
+    if (reason) {
+        munmap(map, file_size);
+        return image_error(error, "%s: %s", reason, path);
+    }
+
+    const ImageHeader *header = map;
+    WorldTables tables;
+    memset(&tables, 0, sizeof(tables));
+#define SECTION(s) ((const void *)(base + header->sections[s].offset))
+    tables.rooms = SECTION(SECTION_ROOMS);
+    tables.exit_start = SECTION(SECTION_EXIT_START);
+    tables.exits = SECTION(SECTION_EXITS);
+    tables.items = SECTION(SECTION_ITEMS);
+    tables.conditions = SECTION(SECTION_CONDITIONS);
+    tables.room_count = header->room_count;
+    tables.exit_count = header->exit_count;
+    tables.item_count = header->item_count;
+    tables.condition_count = header->condition_count;
+    tables.item_dep_start = SECTION(SECTION_ITEM_DEP_START);
+    tables.item_dep_rooms = SECTION(SECTION_ITEM_DEP_ROOMS);
+    tables.key_exit_start = SECTION(SECTION_KEY_EXIT_START);
+    tables.key_exits = SECTION(SECTION_KEY_EXITS);
+    tables.verb_synonyms = SECTION(SECTION_VERB_SYNONYMS);
+    tables.verb_synonym_count = header->verb_synonym_count;
+    tables.verb_displace = SECTION(SECTION_VERB_DISPLACE);
+    tables.verb_slots = SECTION(SECTION_VERB_SLOTS);
+    tables.verb_text = SECTION(SECTION_VERB_TEXT);
+    tables.verb_text_size = (size_t)header->sections[SECTION_VERB_TEXT].size;
+    tables.verb_bucket_count = header->verb_bucket_count;
+    tables.verb_slot_count = header->verb_slot_count;
+    tables.verb_count = header->verb_count;
+    tables.room_hashes = SECTION(SECTION_ROOM_HASHES);
+    tables.room_slots = SECTION(SECTION_ROOM_SLOTS);
+    tables.room_index_capacity = header->room_index_capacity;
+    tables.room_index_count = header->room_index_count;
+    tables.item_hashes = SECTION(SECTION_ITEM_HASHES);
+    tables.item_slots = SECTION(SECTION_ITEM_SLOTS);
+    tables.item_index_capacity = header->item_index_capacity;
+    tables.item_index_count = header->item_index_count;
+    tables.strings = SECTION(SECTION_STRINGS);
+    tables.strings_size = (uint32_t)header->sections[SECTION_STRINGS].size;
+    tables.item_start = SECTION(SECTION_ITEM_START);
+    tables.start_room = header->start_room;
+#undef SECTION
+
+    if (!open_tables(world, &tables, map, file_size)) {
+        munmap(map, file_size);
+        return image_error(error, "Out of memory");
+    }
+    return true;
+}
+
+bool world_image_load(World *world, const char *path, LoadError *error) {
+    error->has_error = false;
+    error->line_number = 0;
+    error->message[0] = '\0';
+    world_init(world);  // Empty world on failure, as world_load_from_file leaves it
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return image_error(error, "Cannot open file: %s", path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || (size_t)st.st_size < sizeof(ImageHeader)) {
+        close(fd);
+        return image_error(error, "Not a compiled world image: %s", path);
+    }
+
+    // Read-only and never written, so every process mapping the image
+    // shares the same page cache pages
+    size_t file_size = (size_t)st.st_size;
+    void *map = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return image_error(error, "Cannot map file: %s", path);
+    }
+    return open_image(world, map, file_size, path, error);
+}
+
+bool world_image_open(World *world, const void *image, size_t size, LoadError *error) {
+    error->has_error = false;
+    error->line_number = 0;
+    error->message[0] = '\0';
+    world_init(world);  // Empty world on failure, as world_image_load leaves it
+    if (size < sizeof(ImageHeader)) {
+        return image_error(error, "Not a compiled world image: (in memory)");
+    }
+
+    // A private copy in its own mapping, so the definition is freed like
+    // one mapped from a file
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) {
+        return image_error(error, "Out of memory");
+    }
+    memcpy(map, image, size);
+    mprotect(map, size, PROT_READ);
+    return open_image(world, map, size, "(in memory)", error);
+}
+
+bool world_tables_open(World *world, const WorldTables *tables, LoadError *error) {
+    error->has_error = false;
+    error->line_number = 0;
+    error->message[0] = '\0';
+    world_init(world);  // Empty world on failure, as world_load_from_file leaves it
+    if (!open_tables(world, tables, tables, 0)) {
+        return image_error(error, "Out of memory");
+    }
+    return true;
+}
+
+bool world_image_source(const char *path, WorldSourceStamp *source) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return false;
+    ImageHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 && !check_header(&header);
+    fclose(file);
+    if (ok) *source = header.source;
+    return ok;
+}
+
+bool world_source_stamp(const char *path, bool hash_content, WorldSourceStamp *stamp) {
+    memset(stamp, 0, sizeof(*stamp));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return false;
+    }
+    stamp->size = (uint64_t)st.st_size;
+    stamp->mtime_sec = (int64_t)st.st_mtim.tv_sec;
+    stamp->mtime_nsec = (int64_t)st.st_mtim.tv_nsec;
+
+    bool ok = true;
+    if (hash_content) {
+        // FNV-1a over 8-byte words (a byte at a time runs at a fifth of
+        // the speed), then the tail bytes; never 0, so 0 means "not hashed"
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        unsigned char buffer[65536];
+        size_t used = 0;
+        for (;;) {
+            ssize_t n = read(fd, buffer + used, sizeof(buffer) - used);
+            if (n < 0) {
+                ok = false;
+                break;
+            }
+            used += (size_t)n;
+            if (n > 0 && used < sizeof(buffer)) continue;  // Whole buffers, so words align
+
+            size_t words = used / 8;
+            for (size_t i = 0; i < words; i++) {
+                uint64_t word;
+                memcpy(&word, buffer + i * 8, 8);
+                hash = (hash ^ word) * 0x100000001b3ULL;
+            }
+            for (size_t i = words * 8; i < used; i++) {
+                hash = (hash ^ buffer[i]) * 0x100000001b3ULL;
+            }
+            if (n == 0) break;
+            used = 0;
+        }
+        stamp->hash = hash ? hash : 1;
+    }
+    close(fd);
+    return ok;
+}
+
+bool world_image_current(const char *image_path, const char *source_path) {
+    struct stat image;
+    struct stat source;
+    if (stat(image_path, &image) != 0) return false;
+    if (stat(source_path, &source) != 0) return true;
+    if (image.st_mtim.tv_sec != source.st_mtim.tv_sec) {
+        return image.st_mtim.tv_sec > source.st_mtim.tv_sec;
+    }
+    return image.st_mtim.tv_nsec >= source.st_mtim.tv_nsec;
+}
@@ -0,0 +1,115 @@
+/*
+ * Adventure Engine - World Journal Implementation
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "world_journal.h"
+
+bool world_journal_init(WorldJournal *journal, int capacity) {
+    memset(journal, 0, sizeof(WorldJournal));
+    if (capacity < 2) return false;
+
+    journal->records = malloc((size_t)capacity * sizeof(JournalRecord));
+    if (!journal->records) return false;
+    journal->capacity = capacity;
+    journal->turn_pending = true;
+    return true;
+}
+
+void world_journal_free(WorldJournal *journal) {
+    free(journal->records);
+    memset(journal, 0, sizeof(WorldJournal));
+}
+
+void world_journal_clear(WorldJournal *journal) {
+    journal->first = journal->cursor = journal->last = 0;
+    journal->turn_pending = true;
+    journal->overflowed = false;
+}
+
+void world_journal_begin_turn(WorldJournal *journal) {
+    // The marker is written with the turn's first change, so turns that
+    // change nothing leave no trace
+    journal->turn_pending = true;
+    journal->overflowed = false;
+}
+
+// Helper: Record at an absolute position
+static JournalRecord* at(WorldJournal *journal, uint64_t pos) {
+    return &journal->records[pos % (uint64_t)journal->capacity];
+}
+
+// Helper: Append a record, dropping the oldest turns to make room
+// Returns false if the current turn no longer fits
+static bool push(WorldJournal *journal, const JournalRecord *record) {
+    if (journal->cursor - journal->first == (uint64_t)journal->capacity) {
+        uint64_t next = journal->first + 1;
+        while (next < journal->cursor && at(journal, next)->type != JOURNAL_TURN) next++;
+        if (next == journal->cursor) {
+            // Only the current turn is left; it is too big to undo
+            world_journal_clear(journal);
+            journal->turn_pending = false;
+            journal->overflowed = true;
+            return false;
+        }
+        journal->first = next;
+    }
+
+    *at(journal, journal->cursor) = *record;
+    journal->cursor++;
+    journal->last = journal->cursor;
+    return true;
+}
+
+void world_journal_record(WorldJournal *journal, const JournalRecord *record) {
+    if (journal->replaying || journal->overflowed) return;
+
+    // A new change makes the undone turns unreachable
+    journal->last = journal->cursor;
+
+    if (journal->turn_pending) {
+        JournalRecord marker = { .type = JOURNAL_TURN };
+        if (!push(journal, &marker)) return;
+        journal->turn_pending = false;
+    }
+    push(journal, record);
+}
+
+bool world_journal_undo(World *world) {
+    WorldJournal *journal = world->journal;
+    if (!journal || journal->cursor == journal->first) return false;
+
+    // Reverse the turn's changes, newest first, back to its marker
+    journal->replaying = true;
+    uint64_t pos = journal->cursor;
+    while (pos > journal->first) {
+        const JournalRecord *record = at(journal, --pos);
+        if (record->type == JOURNAL_TURN) break;
+        world_journal_apply(world, record, true);
+    }
+    journal->replaying = false;
+
+    journal->cursor = pos;
+    journal->turn_pending = true;
+    journal->overflowed = false;
+    return true;
+}
+
+bool world_journal_redo(World *world) {
+    WorldJournal *journal = world->journal;
+    if (!journal || journal->cursor == journal->last) return false;
+
+    // Replay from the turn marker up to the next one
+    journal->replaying = true;
+    uint64_t pos = journal->cursor + 1;
+    while (pos < journal->last && at(journal, pos)->type != JOURNAL_TURN) {
+        world_journal_apply(world, at(journal, pos), false);
+        pos++;
+    }
+    journal->replaying = false;
+
+    journal->cursor = pos;
+    journal->turn_pending = true;
+    return true;
+}
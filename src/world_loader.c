@@ -1,104 +1,196 @@
 /*
  * Adventure Engine - World Loader Implementation
  * Parses .world files and creates World structures
+ *
+ * The file is mapped (or read whole where it cannot be mapped) and parsed in
+ * one pass over its bytes: lines, keys and values are slices of the mapping,
+ * section and property names are dispatched on their hash, and text is
+ * copied once, straight into the world's string pool.
  */
 
 #define _POSIX_C_SOURCE 200809L
 
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "world_loader.h"
 
-#define MAX_LINE 1024
-
-// Helper: Trim whitespace (modifies string in place)
-static char* trim(char *str) {
-    while (isspace(*str)) str++;
-    if (*str == 0) return str;
-
-    char *end = str + strlen(str) - 1;
-    while (end > str && isspace(*end)) end--;
-    *(end + 1) = 0;
-
-    return str;
+#define MAX_ID 256            // Longest ID or exit name looked up (longer never match)
+#define READ_CHUNK 65536      // First buffer size when a file has to be read
+
+// Bytes of the file (not NUL-terminated)
+typedef struct {
+    const char *text;
+    size_t len;
+} Slice;
+
+// The whole file: mapped, or read into a buffer (pipes, empty files)
+typedef struct {
+    const char *data;
+    size_t size;
+    bool mapped;
+} FileText;
+
+typedef enum {
+    SECTION_OTHER,            // Before the first header, or an unknown [TYPE]
+    SECTION_WORLD,
+    SECTION_ROOM,
+    SECTION_ITEM,
+    SECTION_VERBS
+} SectionKind;
+
+typedef enum {
+    KEY_OTHER,
+    KEY_NAME,
+    KEY_START,
+    KEY_DESCRIPTION,
+    KEY_EXITS,
+    KEY_LOCKED_EXITS,
+    KEY_TAKEABLE,
+    KEY_LOCATION,
+    KEY_USE_MESSAGE,
+    KEY_USE_CONSUMABLE
+} PropertyKey;
+
+// Conditional description parsed from a room section (added to the world
+// when the section ends)
+typedef struct {
+    ConditionType type;
+    bool negate;
+    Slice subject;
+    Slice description;
+} PendingCondDesc;
+
+// Exit or lock parsed from a room section; resolved once every room exists,
+// so exits may lead to rooms defined later in the file
+typedef struct {
+    int room;                // Room the exit leaves from
+    bool lock;               // locked_exits entry rather than exits entry
+    Slice name;              // Exit name ("north", "n", "through the mirror")
+    Slice value;             // Target room ID, or key item ID for locks
+} PendingExit;
+
+typedef struct {
+    PendingExit *data;
+    int count;
+    int capacity;
+} PendingExits;
+
+// Properties of the section being parsed
+typedef struct {
+    SectionKind kind;
+    Slice id;
+    Slice name;
+    Slice description;
+    Slice exits;
+    Slice locked_exits;
+    Slice location;
+    Slice use_message;
+    bool takeable;
+    bool use_consumable;
+    // Issue #6: Conditional descriptions
+    PendingCondDesc conds[MAX_CONDITIONAL_DESCS];
+    int cond_count;
+} Section;
+
+// Helper: Slice of [begin, end) without surrounding whitespace
+static Slice slice_trim(const char *begin, const char *end) {
+    while (begin < end && isspace((unsigned char)*begin)) begin++;
+    while (end > begin && isspace((unsigned char)end[-1])) end--;
+    return (Slice){ begin, (size_t)(end - begin) };
 }
 
-// Helper: Check if line is comment or empty
-static bool is_empty_or_comment(char *line) {
-    char *trimmed = trim(line);
-    return trimmed[0] == '\0' || trimmed[0] == '#';
+// Helper: Whether a slice is exactly word
+static bool slice_is(Slice s, const char *word) {
+    size_t len = strlen(word);
+    return s.len == len && memcmp(s.text, word, len) == 0;
 }
 
-// Helper: Parse section header [TYPE:id] or [TYPE]
-static bool parse_section_header(const char *line, char *type, char *id) {
-    type[0] = '\0';
-    id[0] = '\0';
-
-    const char *start = strchr(line, '[');
-    const char *end = strchr(line, ']');
-
-    if (!start || !end || end <= start) return false;
-
-    start++; // Skip '['
-
-    const char *colon = strchr(start, ':');
-
-    if (colon && colon < end) {
-        // Has ID: [TYPE:id]
-        size_t type_len = colon - start;
-        strncpy(type, start, type_len);
-        type[type_len] = '\0';
-
-        size_t id_len = end - colon - 1;
-        strncpy(id, colon + 1, id_len);
-        id[id_len] = '\0';
-    } else {
-        // No ID: [TYPE]
-        size_t type_len = end - start;
-        strncpy(type, start, type_len);
-        type[type_len] = '\0';
-    }
+// Helper: Whether a slice starts with prefix
+static bool slice_starts(Slice s, const char *prefix) {
+    size_t len = strlen(prefix);
+    return s.len >= len && memcmp(s.text, prefix, len) == 0;
+}
 
+// Helper: Copy a short slice (an ID or name to look up) into buffer
+// Returns false if it does not fit.
+static bool slice_copy(Slice s, char *buffer, size_t size) {
+    if (s.len >= size) return false;
+    memcpy(buffer, s.text, s.len);
+    buffer[s.len] = '\0';
     return true;
 }
 
-// Helper: Parse property line "key: value"
-static bool parse_property(const char *line, char *key, char *value) {
-    key[0] = '\0';
-    value[0] = '\0';
-
-    const char *colon = strchr(line, ':');
-    if (!colon) return false;
-
-    // Extract key
-    size_t key_len = colon - line;
-    strncpy(key, line, key_len);
-    key[key_len] = '\0';
-
-    // Trim key
-    char *key_trimmed = trim(key);
-    if (key_trimmed != key) {
-        memmove(key, key_trimmed, strlen(key_trimmed) + 1);
+// Helper: 32-bit FNV-1a of a slice (section and property dispatch)
+static uint32_t slice_hash(Slice s) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < s.len; i++) {
+        hash ^= (unsigned char)s.text[i];
+        hash *= 16777619u;
     }
+    return hash;
+}
 
-    // Extract value (limit to 511 chars to ensure null-termination)
-    strncpy(value, colon + 1, 511);
-    value[511] = '\0';
-    char *value_trimmed = trim(value);
-    if (value_trimmed != value) {
-        memmove(value, value_trimmed, strlen(value_trimmed) + 1);
+// Helper: Section type of a header; one hash, then one compare
+static SectionKind section_kind(Slice type) {
+    switch (slice_hash(type)) {
+        case 0xe2e21e33u: return slice_is(type, "WORLD") ? SECTION_WORLD : SECTION_OTHER;
+        case 0x354f02bau: return slice_is(type, "ROOM") ? SECTION_ROOM : SECTION_OTHER;
+        case 0x9c8a0426u: return slice_is(type, "ITEM") ? SECTION_ITEM : SECTION_OTHER;
+        case 0x64ffb589u: return slice_is(type, "VERBS") ? SECTION_VERBS : SECTION_OTHER;
+        default: return SECTION_OTHER;
     }
+}
 
-    return true;
+// Helper: Property a key names; one hash, then one compare
+static PropertyKey property_key(Slice key) {
+    switch (slice_hash(key)) {
+        case 0x8d39bde6u: return slice_is(key, "name") ? KEY_NAME : KEY_OTHER;
+        case 0x652b04dfu: return slice_is(key, "start") ? KEY_START : KEY_OTHER;
+        case 0x346f3b69u: return slice_is(key, "description") ? KEY_DESCRIPTION : KEY_OTHER;
+        case 0x22417142u: return slice_is(key, "exits") ? KEY_EXITS : KEY_OTHER;
+        case 0x9b3406c5u: return slice_is(key, "locked_exits") ? KEY_LOCKED_EXITS : KEY_OTHER;
+        case 0x666992fau: return slice_is(key, "takeable") ? KEY_TAKEABLE : KEY_OTHER;
+        case 0x0bf5a9a6u: return slice_is(key, "location") ? KEY_LOCATION : KEY_OTHER;
+        case 0x9ca66a08u: return slice_is(key, "use_message") ? KEY_USE_MESSAGE : KEY_OTHER;
+        case 0x2e575edeu: return slice_is(key, "use_consumable") ? KEY_USE_CONSUMABLE : KEY_OTHER;
+        default: return KEY_OTHER;
+    }
 }
 
 // Helper: Parse boolean value
-static bool parse_bool(const char *str) {
-    if (strcmp(str, "yes") == 0 || strcmp(str, "true") == 0 || strcmp(str, "1") == 0) {
-        return true;
-    }
+static bool parse_bool(Slice value) {
+    return slice_is(value, "yes") || slice_is(value, "true") || slice_is(value, "1");
+}
+
+// Helper: Compass direction a slice names ("n", "north"; -1 if none)
+static int slice_direction(Slice s) {
+    char buffer[8];
+    return slice_copy(s, buffer, sizeof(buffer)) ? str_to_direction(buffer) : -1;
+}
+
+// Helper: Find a room by ID
+static int find_room(World *world, Slice id) {
+    char buffer[MAX_ID];
+    return slice_copy(id, buffer, sizeof(buffer)) ? world_find_room(world, buffer) : -1;
+}
+
+// Helper: Record an error; returns false for the caller to return
+static bool load_error(LoadError *error, int line_number, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(error->message, sizeof(error->message), format, args);
+    va_end(args);
+    error->has_error = true;
+    error->line_number = line_number;
     return false;
 }
 
@@ -107,465 +199,496 @@ static bool parse_bool(const char *str) {
 //   first_visit, visited, has_item=item_id, !has_item=item_id,
 //   room_has_item=item_id, item_used=item_id
 // Note: Uses '=' separator to avoid conflict with property ':' separator
-// Returns true if successfully parsed, fills out the ConditionalDesc
-static bool parse_cond_desc_key(const char *key, ConditionalDesc *cond) {
-    // Check if key starts with "description_if("
-    if (strncmp(key, "description_if(", 15) != 0) {
-        return false;
-    }
-
-    const char *cond_start = key + 15;
-    const char *cond_end = strchr(cond_start, ')');
-    if (!cond_end) {
+// Returns true if successfully parsed, fills out the PendingCondDesc
+static bool parse_cond_desc_key(Slice key, PendingCondDesc *cond) {
+    const char *start = key.text + 15;   // After "description_if("
+    const char *close = memchr(start, ')', key.len - 15);
+    if (!close) {
         return false;
     }
-
-    // Extract condition string
-    char condition[64];
-    size_t cond_len = cond_end - cond_start;
-    if (cond_len >= sizeof(condition)) {
-        cond_len = sizeof(condition) - 1;
-    }
-    strncpy(condition, cond_start, cond_len);
-    condition[cond_len] = '\0';
+    Slice condition = { start, (size_t)(close - start) };
 
     // Check for negation
     cond->negate = false;
-    char *cond_str = condition;
-    if (cond_str[0] == '!') {
+    if (condition.len > 0 && condition.text[0] == '!') {
         cond->negate = true;
-        cond_str++;
+        condition.text++;
+        condition.len--;
     }
 
     // Parse condition type (use '=' as separator for item conditions)
-    cond->subject[0] = '\0';
-
-    if (strcmp(cond_str, "first_visit") == 0) {
+    size_t prefix = 0;
+    if (slice_is(condition, "first_visit")) {
         cond->type = COND_FIRST_VISIT;
-    } else if (strcmp(cond_str, "visited") == 0) {
+    } else if (slice_is(condition, "visited")) {
         cond->type = COND_VISITED;
-    } else if (strncmp(cond_str, "has_item=", 9) == 0) {
+    } else if (slice_starts(condition, "has_item=")) {
         cond->type = COND_HAS_ITEM;
-        strncpy(cond->subject, cond_str + 9, sizeof(cond->subject) - 1);
-        cond->subject[sizeof(cond->subject) - 1] = '\0';
-    } else if (strncmp(cond_str, "room_has_item=", 14) == 0) {
+        prefix = 9;
+    } else if (slice_starts(condition, "room_has_item=")) {
         cond->type = COND_ROOM_HAS_ITEM;
-        strncpy(cond->subject, cond_str + 14, sizeof(cond->subject) - 1);
-        cond->subject[sizeof(cond->subject) - 1] = '\0';
-    } else if (strncmp(cond_str, "item_used=", 10) == 0) {
+        prefix = 14;
+    } else if (slice_starts(condition, "item_used=")) {
         cond->type = COND_ITEM_USED;
-        strncpy(cond->subject, cond_str + 10, sizeof(cond->subject) - 1);
-        cond->subject[sizeof(cond->subject) - 1] = '\0';
+        prefix = 10;
     } else {
         return false;  // Unknown condition type
     }
 
+    cond->subject = (Slice){ condition.text + prefix, prefix ? condition.len - prefix : 0 };
     return true;
 }
 
-// Helper: Apply use command properties to an item
-// Note: use_consumable is only valid when use_message is provided
-static void apply_use_properties(Item *item, const char *use_message, bool use_consumable) {
-    if (use_message[0] != '\0') {
-        strncpy(item->use_message, use_message, sizeof(item->use_message) - 1);
-        item->use_message[sizeof(item->use_message) - 1] = '\0';
-        item->use_consumable = use_consumable;
-    } else {
-        // No use message means item is not usable, so cannot be consumable
-        item->use_message[0] = '\0';
-        item->use_consumable = false;
+// Helper: Map a file, or read it whole where it cannot be mapped
+static bool file_text_open(FileText *file, const char *path) {
+    file->data = NULL;
+    file->size = 0;
+    file->mapped = false;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            posix_madvise(map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+            file->data = map;
+            file->size = (size_t)st.st_size;
+            file->mapped = true;
+            close(fd);
+            return true;
+        }
     }
+
+    char *buffer = NULL;
+    size_t capacity = 0;
+    for (;;) {
+        if (file->size == capacity) {
+            capacity = capacity ? capacity * 2 : READ_CHUNK;
+            char *grown = realloc(buffer, capacity);
+            if (!grown) break;
+            buffer = grown;
+        }
+        ssize_t got = read(fd, buffer + file->size, capacity - file->size);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) {
+            close(fd);
+            if (got < 0) {
+                free(buffer);
+                file->size = 0;
+                return false;
+            }
+            file->data = buffer;
+            return true;
+        }
+        file->size += (size_t)got;
+    }
+
+    close(fd);
+    free(buffer);
+    file->size = 0;
+    return false;
 }
 
-// Helper: Parse locked_exits string "north=iron_key, east=master_key"
-// Note: Key validation is deferred to end of load since items may be defined after rooms
-static void parse_locked_exits(World *world, int room_idx, const char *exits_str) {
-    char buffer[512];
-    strncpy(buffer, exits_str, sizeof(buffer) - 1);
-    buffer[sizeof(buffer) - 1] = '\0';
+static void file_text_close(FileText *file) {
+    if (file->mapped) {
+        munmap((void *)file->data, file->size);
+    } else {
+        free((void *)file->data);
+    }
+    file->data = NULL;
+    file->size = 0;
+}
 
-    char *saveptr;
-    char *token = strtok_r(buffer, ",", &saveptr);
-    while (token) {
-        token = trim(token);
+// Helper: Count room/item sections so the world can be sized before
+// parsing (one arena block instead of repeated growth); memchr skips to
+// each '[' without looking at the text in between
+static void presize_world(World *world, const FileText *file) {
+    const char *data = file->data;
+    const char *end = data + file->size;
+    int rooms = 0;
+    int items = 0;
+
+    for (const char *p = data; p && p < end; p = memchr(p + 1, '[', (size_t)(end - p - 1))) {
+        if (*p != '[' || (p > data && p[-1] != '\n') || end - p < 6) continue;
+        if (memcmp(p, "[ROOM:", 6) == 0) rooms++;
+        else if (memcmp(p, "[ITEM:", 6) == 0) items++;
+    }
 
-        char *equals = strchr(token, '=');
-        if (equals) {
-            *equals = '\0';
-            char *dir_str = trim(token);
-            char *key_id = trim(equals + 1);
-
-            int dir = str_to_direction(dir_str);
-            if (dir != -1) {
-                // Lock the exit - key validation happens at end of load
-                world_lock_exit(world, room_idx, (Direction)dir, key_id);
-            } else {
-                fprintf(stderr, "Warning: Room '%s' has invalid locked direction '%s'\n",
-                        world->rooms[room_idx].id, dir_str);
-            }
-        }
+    // File text is an upper bound for the strings kept from it
+    world_reserve(world, rooms, items, file->size);
+}
 
-        token = strtok_r(NULL, ",", &saveptr);
+// Helper: Queue one "name=value" entry of an exits or locked_exits list
+static void pending_push(PendingExits *pending, int room_idx, bool lock, Slice name, Slice value) {
+    if (pending->count >= pending->capacity) {
+        int capacity = pending->capacity ? pending->capacity * 2 : 64;
+        PendingExit *data = realloc(pending->data, (size_t)capacity * sizeof(PendingExit));
+        if (!data) return;
+        pending->data = data;
+        pending->capacity = capacity;
     }
+
+    PendingExit *entry = &pending->data[pending->count++];
+    entry->room = room_idx;
+    entry->lock = lock;
+    entry->name = name;
+    entry->value = value;
 }
 
-// Helper: Parse exits string "north=hall, east=chamber"
-static void parse_exits(World *world, int room_idx, const char *exits_str) {
-    char buffer[512];
-    strncpy(buffer, exits_str, sizeof(buffer) - 1);
-    buffer[sizeof(buffer) - 1] = '\0';
+// Helper: Parse exits "north=hall, through the mirror=mirror_room" or
+// locked_exits "north=iron_key" into the pending list
+static void parse_exit_list(PendingExits *pending, int room_idx, bool lock, Slice list) {
+    const char *p = list.text;
+    const char *end = list.text + list.len;
 
-    char *saveptr;
-    char *token = strtok_r(buffer, ",", &saveptr);
-    while (token) {
-        token = trim(token);
+    while (p < end) {
+        const char *comma = memchr(p, ',', (size_t)(end - p));
+        if (!comma) comma = end;
 
-        char *equals = strchr(token, '=');
+        const char *equals = memchr(p, '=', (size_t)(comma - p));
         if (equals) {
-            *equals = '\0';
-            char *dir_str = trim(token);
-            char *room_id = trim(equals + 1);
-
-            int dir = str_to_direction(dir_str);
-            if (dir != -1) {
-                int target_room = world_find_room(world, room_id);
-                if (target_room != -1) {
-                    world_connect_rooms(world, room_idx, (Direction)dir, target_room);
-                } else {
-                    fprintf(stderr, "Warning: Room '%s' has invalid exit '%s' to non-existent room '%s'\n",
-                            world->rooms[room_idx].id, dir_str, room_id);
-                }
-            } else {
-                fprintf(stderr, "Warning: Room '%s' has invalid direction '%s'\n",
-                        world->rooms[room_idx].id, dir_str);
+            Slice name = slice_trim(p, equals);
+            Slice value = slice_trim(equals + 1, comma);
+            if (name.len > 0 && value.len > 0) {
+                pending_push(pending, room_idx, lock, name, value);
             }
         }
-
-        token = strtok_r(NULL, ",", &saveptr);
+        p = comma + 1;
     }
 }
 
-// Main loader function
-bool world_load_from_file(World *world, const char *filename, LoadError *error) {
-    error->has_error = false;
-    error->line_number = 0;
-    error->message[0] = '\0';
-
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        error->has_error = true;
-        error->line_number = 0;
-        snprintf(error->message, sizeof(error->message), "Cannot open file: %s", filename);
-        return false;
+// Helper: Add a [VERBS] line's synonyms ("take: grab, snatch")
+static void parse_verb_list(World *world, Slice verb_slice, Slice list) {
+    char verb[64];
+    char word[64];
+    if (!slice_copy(verb_slice, verb, sizeof(verb)) || verb_builtin(verb) == VERB_NONE) {
+        fprintf(stderr, "Warning: [VERBS] names unknown verb '%.*s'\n",
+                (int)verb_slice.len, verb_slice.text);
+        return;
     }
 
-    world_init(world);
-
-    char line[MAX_LINE];
-    int line_num = 0;
-
-    char current_section[32] = "";
-    char current_id[32] = "";
-
-    // Properties for current item/room being parsed
-    char prop_name[64] = "";
-    char prop_description[512] = "";
-    char prop_exits[512] = "";
-    char prop_locked_exits[512] = "";
-    char prop_location[32] = "";
-    bool prop_takeable = false;
-    // Issue #8: Use command properties
-    char prop_use_message[256] = "";
-    bool prop_use_consumable = false;
-    // Issue #6: Conditional descriptions
-    ConditionalDesc prop_cond_descs[MAX_CONDITIONAL_DESCS];
-    int prop_cond_desc_count = 0;
+    const char *p = list.text;
+    const char *end = list.text + list.len;
+    while (p < end) {
+        const char *comma = memchr(p, ',', (size_t)(end - p));
+        if (!comma) comma = end;
+
+        Slice token = slice_trim(p, comma);
+        if (token.len > 0 &&
+            (!slice_copy(token, word, sizeof(word)) || !world_add_verb(world, word, verb))) {
+            fprintf(stderr, "Warning: Invalid synonym '%.*s' for verb '%s'\n",
+                    (int)token.len, token.text, verb);
+        }
+        p = comma + 1;
+    }
+}
 
-    char world_name[64] = "Untitled";
-    char world_start[32] = "";
+// Helper: Add a finished room or item section to the world
+static bool add_section(World *world, const Section *section, PendingExits *pending,
+                        LoadError *error, int line_num) {
+    if (section->id.len == 0) return true;
+    int id_len = (int)section->id.len;
 
-    while (fgets(line, sizeof(line), file)) {
-        line_num++;
+    if (section->kind == SECTION_ROOM) {
+        if (section->name.len == 0 || section->description.len == 0) {
+            return load_error(error, line_num, "Room '%.*s' missing required fields",
+                              id_len, section->id.text);
+        }
 
-        // Remove newline
-        size_t len = strlen(line);
-        if (len > 0 && line[len-1] == '\n') {
-            line[len-1] = '\0';
+        // Text goes into the pool once; world_add_room shares it
+        StrRef id = world_add_text(world, section->id.text, section->id.len);
+        StrRef name = world_add_text(world, section->name.text, section->name.len);
+        StrRef desc = world_add_text(world, section->description.text, section->description.len);
+        int room_idx = id && name && desc
+            ? world_add_room(world, world_str(world, id), world_str(world, name), world_str(world, desc))
+            : -1;
+        if (room_idx == -1) {
+            return load_error(error, line_num, "Failed to add room '%.*s' (out of memory)",
+                              id_len, section->id.text);
         }
 
-        // Skip comments and empty lines
-        if (is_empty_or_comment(line)) {
-            continue;
+        for (int i = 0; i < section->cond_count; i++) {
+            const PendingCondDesc *cond = &section->conds[i];
+            StrRef subject = world_add_text(world, cond->subject.text, cond->subject.len);
+            StrRef text = world_add_text(world, cond->description.text, cond->description.len);
+            world_add_conditional_desc(world, room_idx, cond->type, world_str(world, subject),
+                                       cond->negate, world_str(world, text));
         }
 
-        // Check for section header
-        if (line[0] == '[') {
-            // Save previous section if needed
-            if (strcmp(current_section, "ROOM") == 0 && current_id[0] != '\0') {
-                if (prop_name[0] == '\0' || prop_description[0] == '\0') {
-                    error->has_error = true;
-                    error->line_number = line_num;
-                    snprintf(error->message, sizeof(error->message),
-                             "Room '%s' missing required fields", current_id);
-                    fclose(file);
-                    return false;
-                }
+        // Queue exits and locked_exits until every room exists
+        parse_exit_list(pending, room_idx, false, section->exits);
+        parse_exit_list(pending, room_idx, true, section->locked_exits);
+    } else if (section->kind == SECTION_ITEM) {
+        if (section->name.len == 0 || section->description.len == 0 || section->location.len == 0) {
+            return load_error(error, line_num, "Item '%.*s' missing required fields",
+                              id_len, section->id.text);
+        }
 
-                int room_idx = world_add_room(world, current_id, prop_name, prop_description);
-                if (room_idx == -1) {
-                    error->has_error = true;
-                    error->line_number = line_num;
-                    snprintf(error->message, sizeof(error->message),
-                             "Failed to add room '%s' (too many rooms?)", current_id);
-                    fclose(file);
-                    return false;
-                }
+        StrRef id = world_add_text(world, section->id.text, section->id.len);
+        StrRef name = world_add_text(world, section->name.text, section->name.len);
+        StrRef desc = world_add_text(world, section->description.text, section->description.len);
+        int item_idx = id && name && desc
+            ? world_add_item(world, world_str(world, id), world_str(world, name),
+                             world_str(world, desc), section->takeable)
+            : -1;
+        if (item_idx == -1) {
+            return load_error(error, line_num, "Failed to add item '%.*s' (out of memory)",
+                              id_len, section->id.text);
+        }
 
-                // Copy conditional descriptions
-                Room *room = &world->rooms[room_idx];
-                room->conditional_desc_count = prop_cond_desc_count;
-                for (int i = 0; i < prop_cond_desc_count; i++) {
-                    room->conditional_descs[i] = prop_cond_descs[i];
-                }
+        // Set use command properties
+        StrRef use = world_add_text(world, section->use_message.text, section->use_message.len);
+        world_set_item_use(world, item_idx, world_str(world, use), section->use_consumable);
 
-                // Parse exits if present
-                if (prop_exits[0] != '\0') {
-                    parse_exits(world, room_idx, prop_exits);
-                }
+        // Place item in room
+        int room_idx = find_room(world, section->location);
+        if (room_idx != -1) {
+            world_place_item(world, item_idx, room_idx);
+        }
+    }
+    return true;
+}
 
-                // Parse locked_exits if present
-                if (prop_locked_exits[0] != '\0') {
-                    parse_locked_exits(world, room_idx, prop_locked_exits);
-                }
-            } else if (strcmp(current_section, "ITEM") == 0 && current_id[0] != '\0') {
-                if (prop_name[0] == '\0' || prop_description[0] == '\0' || prop_location[0] == '\0') {
-                    error->has_error = true;
-                    error->line_number = line_num;
-                    snprintf(error->message, sizeof(error->message),
-                             "Item '%s' missing required fields", current_id);
-                    fclose(file);
-                    return false;
-                }
+// Helper: Store a property line of the current section
+static void set_property(World *world, Section *section, Slice key, Slice value, Slice *world_start) {
+    switch (section->kind) {
+        case SECTION_WORLD:
+            if (property_key(key) == KEY_START) *world_start = value;
+            break;
 
-                int item_idx = world_add_item(world, current_id, prop_name, prop_description, prop_takeable);
-                if (item_idx == -1) {
-                    error->has_error = true;
-                    error->line_number = line_num;
-                    snprintf(error->message, sizeof(error->message),
-                             "Failed to add item '%s' (too many items?)", current_id);
-                    fclose(file);
-                    return false;
+        case SECTION_ROOM:
+            if (slice_starts(key, "description_if(")) {
+                // Issue #6: Parse conditional description
+                if (section->cond_count >= MAX_CONDITIONAL_DESCS) {
+                    fprintf(stderr, "Warning: Too many conditional descriptions in room '%.*s'\n",
+                            (int)section->id.len, section->id.text);
+                } else if (parse_cond_desc_key(key, &section->conds[section->cond_count])) {
+                    section->conds[section->cond_count++].description = value;
+                } else {
+                    fprintf(stderr, "Warning: Invalid conditional description '%.*s' in room '%.*s'\n",
+                            (int)key.len, key.text, (int)section->id.len, section->id.text);
                 }
+                break;
+            }
+            switch (property_key(key)) {
+                case KEY_NAME: section->name = value; break;
+                case KEY_DESCRIPTION: section->description = value; break;
+                case KEY_EXITS: section->exits = value; break;
+                case KEY_LOCKED_EXITS: section->locked_exits = value; break;
+                default: break;
+            }
+            break;
+
+        case SECTION_ITEM:
+            switch (property_key(key)) {
+                case KEY_NAME: section->name = value; break;
+                case KEY_DESCRIPTION: section->description = value; break;
+                case KEY_TAKEABLE: section->takeable = parse_bool(value); break;
+                case KEY_LOCATION: section->location = value; break;
+                case KEY_USE_MESSAGE: section->use_message = value; break;
+                case KEY_USE_CONSUMABLE: section->use_consumable = parse_bool(value); break;
+                default: break;
+            }
+            break;
 
-                // Set use command properties
-                apply_use_properties(&world->items[item_idx], prop_use_message, prop_use_consumable);
+        case SECTION_VERBS:
+            // verb: synonym, synonym, ...
+            parse_verb_list(world, key, value);
+            break;
 
-                // Place item in room
-                int room_idx = world_find_room(world, prop_location);
-                if (room_idx != -1) {
-                    world_place_item(world, item_idx, room_idx);
-                }
-            }
+        case SECTION_OTHER:
+            break;
+    }
+}
 
-            // Parse new section header
-            char section_type[32];
-            char section_id[32];
+// Helper: Read every section of a .world file into the world, queueing
+// exits in pending and the start room ID in world_start
+static bool parse_sections(World *world, const FileText *file, LoadError *error,
+                           PendingExits *pending, Slice *world_start) {
+    const char *p = file->data;
+    const char *end = file->data + file->size;
+    int line_num = 0;
 
-            if (!parse_section_header(line, section_type, section_id)) {
-                error->has_error = true;
-                error->line_number = line_num;
-                snprintf(error->message, sizeof(error->message), "Invalid section header");
-                fclose(file);
-                return false;
-            }
+    Section section;
+    memset(&section, 0, sizeof(section));
+    section.kind = SECTION_OTHER;
 
-            strncpy(current_section, section_type, sizeof(current_section) - 1);
-            current_section[sizeof(current_section) - 1] = '\0';
-            strncpy(current_id, section_id, sizeof(current_id) - 1);
-            current_id[sizeof(current_id) - 1] = '\0';
-
-            // Reset properties
-            prop_name[0] = '\0';
-            prop_description[0] = '\0';
-            prop_exits[0] = '\0';
-            prop_locked_exits[0] = '\0';
-            prop_location[0] = '\0';
-            prop_takeable = false;
-            prop_use_message[0] = '\0';
-            prop_use_consumable = false;
-            prop_cond_desc_count = 0;
+    while (p < end) {
+        const char *eol = memchr(p, '\n', (size_t)(end - p));
+        if (!eol) eol = end;
+        Slice line = slice_trim(p, eol);
+        p = eol + 1;
+        line_num++;
 
+        // Skip comments and empty lines
+        if (line.len == 0 || line.text[0] == '#') {
             continue;
         }
 
-        // Parse property
-        char key[64];
-        char value[512];
-
-        if (!parse_property(line, key, value)) {
-            error->has_error = true;
-            error->line_number = line_num;
-            snprintf(error->message, sizeof(error->message), "Invalid property line");
-            fclose(file);
-            return false;
-        }
+        // Section header [TYPE:id] or [TYPE]
+        if (line.text[0] == '[') {
+            if (!add_section(world, &section, pending, error, line_num)) return false;
 
-        // Handle property based on current section
-        // Security: Ensure null termination after all strncpy calls
-        if (strcmp(current_section, "WORLD") == 0) {
-            if (strcmp(key, "name") == 0) {
-                strncpy(world_name, value, sizeof(world_name) - 1);
-                world_name[sizeof(world_name) - 1] = '\0';
-            } else if (strcmp(key, "start") == 0) {
-                strncpy(world_start, value, sizeof(world_start) - 1);
-                world_start[sizeof(world_start) - 1] = '\0';
-            }
-        } else if (strcmp(current_section, "ROOM") == 0) {
-            if (strcmp(key, "name") == 0) {
-                strncpy(prop_name, value, sizeof(prop_name) - 1);
-                prop_name[sizeof(prop_name) - 1] = '\0';
-            } else if (strcmp(key, "description") == 0) {
-                strncpy(prop_description, value, sizeof(prop_description) - 1);
-                prop_description[sizeof(prop_description) - 1] = '\0';
-            } else if (strcmp(key, "exits") == 0) {
-                strncpy(prop_exits, value, sizeof(prop_exits) - 1);
-                prop_exits[sizeof(prop_exits) - 1] = '\0';
-            } else if (strcmp(key, "locked_exits") == 0) {
-                strncpy(prop_locked_exits, value, sizeof(prop_locked_exits) - 1);
-                prop_locked_exits[sizeof(prop_locked_exits) - 1] = '\0';
-            } else if (strncmp(key, "description_if(", 15) == 0) {
-                // Issue #6: Parse conditional description
-                if (prop_cond_desc_count < MAX_CONDITIONAL_DESCS) {
-                    ConditionalDesc *cond = &prop_cond_descs[prop_cond_desc_count];
-                    if (parse_cond_desc_key(key, cond)) {
-                        strncpy(cond->description, value, sizeof(cond->description) - 1);
-                        cond->description[sizeof(cond->description) - 1] = '\0';
-                        prop_cond_desc_count++;
-                    } else {
-                        fprintf(stderr, "Warning: Invalid conditional description '%s' in room '%s'\n",
-                                key, current_id);
-                    }
-                } else {
-                    fprintf(stderr, "Warning: Too many conditional descriptions in room '%s'\n",
-                            current_id);
-                }
+            const char *close = memchr(line.text, ']', line.len);
+            if (!close) {
+                return load_error(error, line_num, "Invalid section header");
             }
-        } else if (strcmp(current_section, "ITEM") == 0) {
-            if (strcmp(key, "name") == 0) {
-                strncpy(prop_name, value, sizeof(prop_name) - 1);
-                prop_name[sizeof(prop_name) - 1] = '\0';
-            } else if (strcmp(key, "description") == 0) {
-                strncpy(prop_description, value, sizeof(prop_description) - 1);
-                prop_description[sizeof(prop_description) - 1] = '\0';
-            } else if (strcmp(key, "takeable") == 0) {
-                prop_takeable = parse_bool(value);
-            } else if (strcmp(key, "location") == 0) {
-                strncpy(prop_location, value, sizeof(prop_location) - 1);
-                prop_location[sizeof(prop_location) - 1] = '\0';
-            } else if (strcmp(key, "use_message") == 0) {
-                strncpy(prop_use_message, value, sizeof(prop_use_message) - 1);
-                prop_use_message[sizeof(prop_use_message) - 1] = '\0';
-            } else if (strcmp(key, "use_consumable") == 0) {
-                prop_use_consumable = parse_bool(value);
+            const char *colon = memchr(line.text, ':', (size_t)(close - line.text));
+
+            memset(&section, 0, sizeof(section));
+            if (colon) {
+                section.kind = section_kind((Slice){ line.text + 1, (size_t)(colon - line.text - 1) });
+                section.id = (Slice){ colon + 1, (size_t)(close - colon - 1) };
+            } else {
+                section.kind = section_kind((Slice){ line.text + 1, (size_t)(close - line.text - 1) });
             }
+            continue;
+        }
+
+        // Property "key: value"
+        const char *colon = memchr(line.text, ':', line.len);
+        if (!colon) {
+            return load_error(error, line_num, "Invalid property line");
         }
+        set_property(world, &section, slice_trim(line.text, colon),
+                     slice_trim(colon + 1, line.text + line.len), world_start);
     }
 
     // Handle last section
-    if (strcmp(current_section, "ROOM") == 0 && current_id[0] != '\0') {
-        if (prop_name[0] == '\0' || prop_description[0] == '\0') {
-            error->has_error = true;
-            error->line_number = line_num;
-            snprintf(error->message, sizeof(error->message),
-                     "Room '%s' missing required fields", current_id);
-            fclose(file);
-            return false;
-        }
+    return add_section(world, &section, pending, error, line_num);
+}
 
-        int room_idx = world_add_room(world, current_id, prop_name, prop_description);
-        if (room_idx != -1) {
-            // Copy conditional descriptions
-            Room *room = &world->rooms[room_idx];
-            room->conditional_desc_count = prop_cond_desc_count;
-            for (int i = 0; i < prop_cond_desc_count; i++) {
-                room->conditional_descs[i] = prop_cond_descs[i];
-            }
+// Helper: Add queued exits in one batch, then their locks
+// Key validation is deferred to the end of load since items may be defined after rooms
+static bool resolve_exits(World *world, const PendingExits *pending) {
+    ExitSpec *specs = malloc((size_t)(pending->count ? pending->count : 1) * sizeof(ExitSpec));
+    if (!specs) return false;
+
+    // Compass exits share one pool string per direction; short forms ("n")
+    // are stored under their full name
+    StrRef dir_names[DIR_COUNT] = {0};
+    int count = 0;
+    for (int i = 0; i < pending->count; i++) {
+        const PendingExit *entry = &pending->data[i];
+        if (entry->lock) continue;
+
+        int target_room = find_room(world, entry->value);
+        if (target_room == -1) {
+            fprintf(stderr, "Warning: Room '%s' has invalid exit '%.*s' to non-existent room '%.*s'\n",
+                    world_str(world, world->def->rooms[entry->room].id),
+                    (int)entry->name.len, entry->name.text, (int)entry->value.len, entry->value.text);
+            continue;
+        }
 
-            if (prop_exits[0] != '\0') {
-                parse_exits(world, room_idx, prop_exits);
-            }
-            if (prop_locked_exits[0] != '\0') {
-                parse_locked_exits(world, room_idx, prop_locked_exits);
+        StrRef name;
+        int dir = slice_direction(entry->name);
+        if (dir != -1) {
+            if (!dir_names[dir]) {
+                const char *text = direction_to_str((Direction)dir);
+                dir_names[dir] = world_add_text(world, text, strlen(text));
             }
+            name = dir_names[dir];
+        } else {
+            name = world_add_text(world, entry->name.text, entry->name.len);
         }
-    } else if (strcmp(current_section, "ITEM") == 0 && current_id[0] != '\0') {
-        if (prop_name[0] == '\0' || prop_description[0] == '\0' || prop_location[0] == '\0') {
-            error->has_error = true;
-            error->line_number = line_num;
-            snprintf(error->message, sizeof(error->message),
-                     "Item '%s' missing required fields", current_id);
-            fclose(file);
-            return false;
+        specs[count++] = (ExitSpec){ entry->room, name, target_room };
+    }
+    bool added = world_add_exits(world, specs, count);
+    free(specs);
+    if (!added) return false;
+
+    for (int i = 0; i < pending->count; i++) {
+        const PendingExit *entry = &pending->data[i];
+        if (!entry->lock) continue;
+
+        char name[MAX_ID];
+        int exit_id = slice_copy(entry->name, name, sizeof(name))
+            ? world_find_exit(world, entry->room, name)
+            : -1;
+        if (exit_id != -1) {
+            StrRef key = world_add_text(world, entry->value.text, entry->value.len);
+            world_set_exit_key(world, exit_id, world_str(world, key));
+        } else {
+            fprintf(stderr, "Warning: Room '%s' has invalid locked exit '%.*s'\n",
+                    world_str(world, world->def->rooms[entry->room].id),
+                    (int)entry->name.len, entry->name.text);
         }
+    }
+    return true;
+}
 
-        int item_idx = world_add_item(world, current_id, prop_name, prop_description, prop_takeable);
-        if (item_idx != -1) {
-            // Set use command properties
-            apply_use_properties(&world->items[item_idx], prop_use_message, prop_use_consumable);
+// Main loader function
+bool world_load_from_file(World *world, const char *filename, LoadError *error) {
+    error->has_error = false;
+    error->line_number = 0;
+    error->message[0] = '\0';
 
-            int room_idx = world_find_room(world, prop_location);
-            if (room_idx != -1) {
-                world_place_item(world, item_idx, room_idx);
-            }
-        }
+    FileText file;
+    if (!file_text_open(&file, filename)) {
+        return load_error(error, 0, "Cannot open file: %s", filename);
     }
 
-    fclose(file);
+    world_init(world);
+    presize_world(world, &file);
+
+    PendingExits pending = {0};
+    Slice world_start = { NULL, 0 };
+    bool parsed = parse_sections(world, &file, error, &pending, &world_start);
+    if (parsed && !resolve_exits(world, &pending)) {
+        parsed = load_error(error, 0, "Failed to add exits (out of memory)");
+    }
 
     // Set starting room
-    if (world_start[0] != '\0') {
-        int start_room = world_find_room(world, world_start);
-        if (start_room != -1) {
-            world->current_room = start_room;
-            world->rooms[start_room].visited = true;
-        }
-    } else if (world->room_count > 0) {
+    int start_room = -1;
+    if (parsed && world_start.len > 0) {
+        start_room = find_room(world, world_start);
+    } else if (parsed && world->def->room_count > 0) {
         // Default to first room
-        world->current_room = 0;
-        world->rooms[0].visited = true;
+        start_room = 0;
+    }
+    if (start_room != -1) {
+        world->current_room = start_room;
+        world_set_room_visited(world, start_room, true);
     }
 
+    // Every slice into the file has been copied or resolved by now
+    free(pending.data);
+    file_text_close(&file);
+    if (!parsed) return false;
+
     // Validate world
-    if (world->room_count == 0) {
-        error->has_error = true;
-        error->line_number = 0;
-        snprintf(error->message, sizeof(error->message), "No rooms defined in world");
-        return false;
+    if (world->def->room_count == 0) {
+        return load_error(error, 0, "No rooms defined in world");
     }
 
     // Validate locked exits reference existing items
-    for (int i = 0; i < world->room_count; i++) {
-        for (int dir = 0; dir < DIR_COUNT; dir++) {
-            if (world->rooms[i].locked_exits[dir][0] != '\0') {
-                int key_item = world_find_item(world, world->rooms[i].locked_exits[dir]);
-                if (key_item == -1) {
-                    fprintf(stderr, "Warning: Room '%s' has locked exit '%s' requiring non-existent key '%s'\n",
-                            world->rooms[i].id, direction_to_str((Direction)dir),
-                            world->rooms[i].locked_exits[dir]);
-                }
+    for (int i = 0; i < world->def->room_count; i++) {
+        for (int e = world_exits_begin(world, i); e < world_exits_end(world, i); e++) {
+            const Exit *exit = world_exit(world, e);
+            const char *key = world_str(world, exit->key);
+            if (exit->key && world_find_item(world, key) == -1) {
+                fprintf(stderr, "Warning: Room '%s' has locked exit '%s' requiring non-existent key '%s'\n",
+                        world_str(world, world->def->rooms[i].id), world_str(world, exit->name), key);
             }
         }
     }
 
+    // Resolve condition subjects to item indices once, so evaluation during
+    // play never compares strings
+    world_compile_conditions(world);
+
     // Validate conditional description item references
-    for (int i = 0; i < world->room_count; i++) {
-        Room *room = &world->rooms[i];
+    for (int i = 0; i < world->def->room_count; i++) {
+        Room *room = &world->def->rooms[i];
+        const ConditionalDesc *conds = world_room_conditions(world->def, room);
         for (int j = 0; j < room->conditional_desc_count; j++) {
-            ConditionalDesc *cond = &room->conditional_descs[j];
+            const ConditionalDesc *cond = &conds[j];
             // Check item-based conditions have valid item IDs
-            if (cond->subject[0] != '\0') {
-                int item_idx = world_find_item(world, cond->subject);
-                if (item_idx == -1) {
+            const char *subject = world_str(world, cond->subject);
+            if (subject[0] != '\0') {
+                if (cond->item == -1) {
                     const char *cond_type = "unknown";
                     switch (cond->type) {
                         case COND_HAS_ITEM: cond_type = "has_item"; break;
@@ -575,8 +698,8 @@ bool world_load_from_file(World *world, const char *filename, LoadError *error)
                     }
                     fprintf(stderr, "Warning: Room '%s' has conditional description '%s%s=%s' "
                             "referencing non-existent item '%s'\n",
-                            room->id, cond->negate ? "!" : "", cond_type, cond->subject,
-                            cond->subject);
+                            world_str(world, room->id), cond->negate ? "!" : "", cond_type,
+                            subject, subject);
                 }
             }
         }
@@ -586,7 +709,8 @@ bool world_load_from_file(World *world, const char *filename, LoadError *error)
 }
 
 const char* world_loader_get_error(const LoadError *error) {
-    static char buffer[512];
+    // One buffer per thread, so games loading in parallel don't share it
+    static _Thread_local char buffer[512];
     if (error->line_number > 0) {
         snprintf(buffer, sizeof(buffer), "Line %d: %s", error->line_number, error->message);
     } else {
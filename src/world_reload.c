@@ -0,0 +1,300 @@
+/*
+ * Adventure Engine - World Hot Reload Implementation
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "world_reload.h"
+#include "world_journal.h"
+#include "world_route.h"
+#include "world_snapshot.h"
+
+// Helper: Compare text from two worlds' string pools
+static bool same_text(const World *a, StrRef ra, const World *b, StrRef rb) {
+    return strcmp(world_str(a, ra), world_str(b, rb)) == 0;
+}
+
+// Helper: Index of the exit named like old exit e among a new room's exits
+// (-1 if none)
+static int find_same_exit(const World *old, int e, const World *next, int room) {
+    const Exit *exit = &old->def->exits[e];
+    for (int n = next->def->exit_start[room]; n < next->def->exit_start[room + 1]; n++) {
+        if (same_text(old, exit->name, next, next->def->exits[n].name)) return n;
+    }
+    return -1;
+}
+
+// Helper: Check whether a surviving exit still leads to the same room
+// behind the same key
+static bool same_exit(const WorldDiff *diff, const World *old, int e, const World *next, int n) {
+    const Exit *a = &old->def->exits[e];
+    const Exit *b = &next->def->exits[n];
+    return diff->room_map[a->to] == b->to && same_text(old, a->key, next, b->key);
+}
+
+// Helper: Check whether a surviving room reads and connects as before
+static bool same_room(const WorldDiff *diff, const World *old, int r, const World *next, int n) {
+    const Room *a = &old->def->rooms[r];
+    const Room *b = &next->def->rooms[n];
+    if (!same_text(old, a->name, next, b->name) ||
+        !same_text(old, a->description, next, b->description) ||
+        a->conditional_desc_count != b->conditional_desc_count) {
+        return false;
+    }
+
+    const ConditionalDesc *ca = world_room_conditions(old->def, a);
+    const ConditionalDesc *cb = world_room_conditions(next->def, b);
+    for (int c = 0; c < a->conditional_desc_count; c++) {
+        if (ca[c].type != cb[c].type || ca[c].negate != cb[c].negate ||
+            !same_text(old, ca[c].subject, next, cb[c].subject) ||
+            !same_text(old, ca[c].description, next, cb[c].description)) {
+            return false;
+        }
+    }
+
+    // Same exits in the same order (exit_map is filled before rooms are compared)
+    int begin = old->def->exit_start[r];
+    int count = old->def->exit_start[r + 1] - begin;
+    if (count != next->def->exit_start[n + 1] - next->def->exit_start[n]) return false;
+    for (int e = 0; e < count; e++) {
+        int mapped = diff->exit_map[begin + e];
+        if (mapped != next->def->exit_start[n] + e || !same_exit(diff, old, begin + e, next, mapped)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Helper: Check whether an item reads and behaves as before
+static bool same_item(const World *old, int i, const World *next, int n) {
+    const Item *a = &old->def->items[i];
+    const Item *b = &next->def->items[n];
+    return a->takeable == b->takeable && a->visible == b->visible &&
+           a->use_consumable == b->use_consumable &&
+           same_text(old, a->name, next, b->name) &&
+           same_text(old, a->description, next, b->description) &&
+           same_text(old, a->use_message, next, b->use_message);
+}
+
+bool world_diff_build(WorldDiff *diff, const World *current, World *next) {
+    memset(diff, 0, sizeof(WorldDiff));
+    const WorldDef *from = current->def;
+    if (!from || !next->def) return false;
+
+    // Sessions will share the new definition, so compile it while it can
+    // still be written
+    if (next->def->conditions_dirty && world_def_writable(next->def)) {
+        world_compile_conditions(next);
+    }
+
+    const WorldDef *to = next->def;
+    diff->from = from;
+    diff->to = next;
+    // One spare entry keeps the allocations non-empty for an empty world
+    diff->room_map = malloc(((size_t)from->room_count + 1) * sizeof(int32_t));
+    diff->exit_map = malloc(((size_t)from->exit_count + 1) * sizeof(int32_t));
+    diff->item_map = malloc(((size_t)from->item_count + 1) * sizeof(int32_t));
+    diff->item_source = malloc(((size_t)to->item_count + 1) * sizeof(int32_t));
+    diff->room_changed = calloc(BITSET_WORDS((size_t)to->room_count) + 1, sizeof(uint64_t));
+    if (!diff->room_map || !diff->exit_map || !diff->item_map || !diff->item_source ||
+        !diff->room_changed) {
+        world_diff_free(diff);
+        return false;
+    }
+
+    bool same = from->room_count == to->room_count && from->exit_count == to->exit_count &&
+                from->item_count == to->item_count;
+
+    // Rooms by ID; new rooms are changed rooms
+    int rooms_kept = 0;
+    for (int r = 0; r < from->room_count; r++) {
+        diff->room_map[r] = world_find_room(next, world_str(current, from->rooms[r].id));
+        if (diff->room_map[r] >= 0) rooms_kept++;
+        if (diff->room_map[r] != r) same = false;
+    }
+    diff->rooms_removed = from->room_count - rooms_kept;
+
+    // Exits by their room and name
+    int exits_kept = 0;
+    for (int r = 0; r < from->room_count; r++) {
+        for (int e = from->exit_start[r]; e < from->exit_start[r + 1]; e++) {
+            int room = diff->room_map[r];
+            diff->exit_map[e] = room >= 0 ? find_same_exit(current, e, next, room) : -1;
+            if (diff->exit_map[e] != e) same = false;
+            if (diff->exit_map[e] < 0) continue;
+            exits_kept++;
+            if (!same_exit(diff, current, e, next, diff->exit_map[e])) diff->exits_changed++;
+        }
+    }
+    diff->exits_changed += (from->exit_count - exits_kept) + (to->exit_count - exits_kept);
+
+    for (int n = 0; n < to->room_count; n++) {
+        bitset_set(diff->room_changed, (size_t)n);
+    }
+    for (int r = 0; r < from->room_count; r++) {
+        int n = diff->room_map[r];
+        if (n >= 0 && same_room(diff, current, r, next, n)) {
+            bitset_clear(diff->room_changed, (size_t)n);
+        }
+    }
+    diff->rooms_changed = (int)bitset_count(diff->room_changed, (size_t)to->room_count);
+
+    // Items by ID
+    for (int n = 0; n < to->item_count; n++) {
+        diff->item_source[n] = -1;
+    }
+    int items_kept = 0;
+    for (int i = 0; i < from->item_count; i++) {
+        int n = world_find_item(next, world_str(current, from->items[i].id));
+        diff->item_map[i] = n;
+        if (n != i) same = false;
+        if (n < 0) continue;
+        diff->item_source[n] = i;
+        items_kept++;
+        if (!same_item(current, i, next, n)) diff->items_changed++;
+    }
+    diff->items_changed += (from->item_count - items_kept) + (to->item_count - items_kept);
+
+    diff->same_layout = same;
+    return true;
+}
+
+void world_diff_free(WorldDiff *diff) {
+    free(diff->room_map);
+    free(diff->exit_map);
+    free(diff->item_map);
+    free(diff->item_source);
+    free(diff->room_changed);
+    memset(diff, 0, sizeof(WorldDiff));
+}
+
+// Helper: Point an unchanged room's cached description at the same text in
+// the new definition (the string pools differ); false if it can't be found
+static bool remap_cached_description(World *world, const WorldDiff *diff, int room) {
+    const WorldDef *to = diff->to->def;
+    const Room *a = &diff->from->rooms[room];
+    const Room *b = &to->rooms[room];
+    StrRef cached = world->cached_description[room];
+    if (cached == a->description) {
+        world->cached_description[room] = b->description;
+        return true;
+    }
+
+    const ConditionalDesc *ca = world_room_conditions(diff->from, a);
+    const ConditionalDesc *cb = world_room_conditions(to, b);
+    for (int c = 0; c < a->conditional_desc_count; c++) {
+        if (ca[c].description == cached) {
+            world->cached_description[room] = cb[c].description;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Helper: Same layout: state stays in place, only the definition and the
+// changed rooms' cached descriptions are replaced
+static void reload_in_place(World *world, const WorldDiff *diff) {
+    int rooms = diff->from->room_count;
+    for (int r = 0; r < rooms; r++) {
+        if (!bitset_test(world->description_cached, (size_t)r)) continue;
+        if (bitset_test(diff->room_changed, (size_t)r) || !remap_cached_description(world, diff, r)) {
+            bitset_clear(world->description_cached, (size_t)r);
+        }
+    }
+
+    // Snapshots name the definition they were taken from
+    world_snapshot_detach(world);
+    WorldDef *old = world->def;
+    world->def = world_def_retain(diff->to->def);
+    world_def_release(old);
+    if (diff->exits_changed > 0) world_routes_invalidate(world->routes);
+}
+
+// Helper: Where a new item starts: carried over from its old place, or
+// where the file puts it if it is new or its room was removed
+static int item_start(const World *world, const WorldDiff *diff, int n) {
+    int old = diff->item_source[n];
+    if (old >= 0) {
+        int where = world->item_location[old].where;
+        if (where == ITEM_IN_INVENTORY || where == ITEM_NOWHERE) return where;
+        if (diff->room_map[where] >= 0) return diff->room_map[where];
+    }
+    return world_item_location(diff->to, n);
+}
+
+// Helper: Replace a session with next, a session of another definition,
+// keeping the journal and routes it points at. Indices moved, so history
+// and routes can't be kept.
+static void replace_session(World *world, World *next) {
+    WorldJournal *journal = world->journal;
+    WorldRoutes *routes = world->routes;
+    world_free(world);
+    *world = *next;
+    world->journal = journal;
+    world->routes = routes;
+    if (journal) world_journal_clear(journal);
+    world_routes_invalidate(routes);
+}
+
+bool world_reload(World *world, const WorldDiff *diff) {
+    if (!world->def || world->def != diff->from) return false;
+    if (diff->same_layout) {
+        reload_in_place(world, diff);
+        return true;
+    }
+
+    const WorldDef *from = diff->from;
+    World next;
+    if (!world_init_session(&next, diff->to->def)) return false;
+
+    int room = world->current_room >= 0 && world->current_room < from->room_count
+        ? diff->room_map[world->current_room] : -1;
+    next.current_room = room >= 0 ? room : diff->to->current_room;
+    for (int r = 0; r < from->room_count; r++) {
+        int n = diff->room_map[r];
+        if (n < 0) continue;
+        bitset_assign(next.visited, (size_t)n, bitset_test(world->visited, (size_t)r));
+        bitset_assign(next.description_shown, (size_t)n,
+                      bitset_test(world->description_shown, (size_t)r));
+    }
+    for (int e = 0; e < from->exit_count; e++) {
+        int n = diff->exit_map[e];
+        if (n >= 0 && bitset_test(world->exit_unlocked, (size_t)e)) {
+            bitset_set(next.exit_unlocked, (size_t)n);
+        }
+    }
+    for (int i = 0; i < from->item_count; i++) {
+        int n = diff->item_map[i];
+        if (n >= 0 && bitset_test(world->item_used, (size_t)i)) {
+            bitset_set(next.item_used, (size_t)n);
+        }
+    }
+
+    // Carried items first and rooms in order, walking the old lists so
+    // every location keeps its order; then whatever the file places anew
+    for (int i = world_first_item(world, ITEM_IN_INVENTORY); i != -1; i = world_next_item(world, i)) {
+        if (diff->item_map[i] >= 0) world_set_item_location(&next, diff->item_map[i], ITEM_IN_INVENTORY);
+    }
+    for (int r = 0; r < from->room_count; r++) {
+        if (diff->room_map[r] < 0) continue;
+        for (int i = world_first_item(world, r); i != -1; i = world_next_item(world, i)) {
+            if (diff->item_map[i] >= 0) world_set_item_location(&next, diff->item_map[i], diff->room_map[r]);
+        }
+    }
+    for (int n = 0; n < diff->to->def->item_count; n++) {
+        if (next.item_location[n].where == ITEM_NOWHERE) {
+            world_set_item_location(&next, n, item_start(world, diff, n));
+        }
+    }
+
+    replace_session(world, &next);
+    return true;
+}
+
+bool world_switch_definition(World *world, WorldDef *def) {
+    if (world->def == def) return true;
+    World next;
+    if (!world_init_session(&next, def)) return false;
+    replace_session(world, &next);
+    return true;
+}
@@ -0,0 +1,203 @@
+/*
+ * Adventure Engine - World Routes Implementation
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "world_route.h"
+
+// Helper: Free the reverse adjacency and every table
+static void free_storage(WorldRoutes *routes) {
+    free(routes->in_start);
+    free(routes->in_from);
+    free(routes->in_exit);
+    free(routes->queue);
+    for (int t = 0; t < ROUTE_CACHE_SLOTS; t++) {
+        free(routes->tables[t].distance);
+        free(routes->tables[t].next_exit);
+    }
+    memset(routes, 0, sizeof(WorldRoutes));
+    for (int t = 0; t < ROUTE_CACHE_SLOTS; t++) {
+        routes->tables[t].target = -1;
+    }
+}
+
+bool world_routes_init(WorldRoutes *routes, const World *world) {
+    memset(routes, 0, sizeof(WorldRoutes));
+    for (int t = 0; t < ROUTE_CACHE_SLOTS; t++) {
+        routes->tables[t].target = -1;
+    }
+
+    const WorldDef *def = world->def;
+    if (!def) return false;
+    int rooms = def->room_count;
+
+    // Transpose the exit lists: count incoming exits per room, then fill
+    // (counting sort by destination)
+    int edges = def->exit_count;
+    routes->in_start = calloc((size_t)rooms + 1, sizeof(int32_t));
+    if (!routes->in_start) return false;
+    for (int e = 0; e < edges; e++) {
+        routes->in_start[def->exits[e].to + 1]++;
+    }
+    for (int r = 0; r < rooms; r++) {
+        routes->in_start[r + 1] += routes->in_start[r];
+    }
+
+    // One spare slot keeps the allocations non-empty for an empty world
+    routes->in_from = malloc(((size_t)edges + 1) * sizeof(int32_t));
+    routes->in_exit = malloc(((size_t)edges + 1) * sizeof(int32_t));
+    routes->queue = malloc(((size_t)rooms + 1) * sizeof(int32_t));
+    if (!routes->in_from || !routes->in_exit || !routes->queue) {
+        free_storage(routes);
+        return false;
+    }
+
+    // queue doubles as the fill cursor per room
+    memcpy(routes->queue, routes->in_start, (size_t)rooms * sizeof(int32_t));
+    for (int r = 0; r < rooms; r++) {
+        for (int e = def->exit_start[r]; e < def->exit_start[r + 1]; e++) {
+            int slot = routes->queue[def->exits[e].to]++;
+            routes->in_from[slot] = r;
+            routes->in_exit[slot] = e;
+        }
+    }
+
+    routes->room_count = rooms;
+    routes->exit_count = edges;
+    return true;
+}
+
+void world_routes_free(WorldRoutes *routes) {
+    free_storage(routes);
+}
+
+void world_routes_invalidate(WorldRoutes *routes) {
+    if (!routes) return;
+    routes->room_count = -1;
+    for (int t = 0; t < ROUTE_CACHE_SLOTS; t++) {
+        routes->tables[t].target = -1;
+    }
+}
+
+// Helper: Breadth-first search backwards from the rooms already in the
+// queue, lowering distances through open exits
+static void relax(const World *world, WorldRoutes *routes, RouteTable *table,
+                  int head, int tail) {
+    while (head < tail) {
+        int room = routes->queue[head++];
+        int32_t through = table->distance[room] + 1;
+        for (int e = routes->in_start[room]; e < routes->in_start[room + 1]; e++) {
+            int from = routes->in_from[e];
+            if (through >= table->distance[from]) continue;
+            if (!world_exit_open(world, routes->in_exit[e])) continue;
+
+            // A room is queued at most once: BFS settles it at its final distance
+            table->distance[from] = through;
+            table->next_exit[from] = routes->in_exit[e];
+            routes->queue[tail++] = from;
+        }
+    }
+}
+
+// Helper: Compute the next-hop table towards target into a slot
+static bool build_table(const World *world, WorldRoutes *routes, RouteTable *table, int target) {
+    size_t rooms = (size_t)routes->room_count;
+    if (!table->distance || !table->next_exit) {
+        free(table->distance);
+        free(table->next_exit);
+        table->distance = malloc((rooms + 1) * sizeof(int32_t));
+        table->next_exit = malloc((rooms + 1) * sizeof(int32_t));
+        if (!table->distance || !table->next_exit) {
+            free(table->distance);
+            free(table->next_exit);
+            table->distance = NULL;
+            table->next_exit = NULL;
+            return false;
+        }
+    }
+
+    for (size_t r = 0; r < rooms; r++) {
+        table->distance[r] = ROUTE_UNREACHABLE;
+    }
+    table->distance[target] = 0;
+    routes->queue[0] = target;
+    relax(world, routes, table, 0, 1);
+    table->target = target;
+    return true;
+}
+
+// Helper: Room an exit leaves from (binary search of the exit offsets)
+static int exit_room(const WorldDef *def, int exit_id) {
+    int lo = 0, hi = def->room_count - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (def->exit_start[mid] <= exit_id) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+void world_routes_exit_changed(World *world, int exit_id, bool open) {
+    WorldRoutes *routes = world->routes;
+    if (!routes || exit_id < 0 || exit_id >= routes->exit_count) return;
+
+    // Losing an exit can lengthen any path through it; rebuild on demand
+    if (!open) {
+        world_routes_invalidate(routes);
+        return;
+    }
+
+    // Gaining an exit only shortens paths: start from the room it leaves
+    // and lower distances outwards, touching only rooms that improve
+    int room_id = exit_room(world->def, exit_id);
+    int to = world->def->exits[exit_id].to;
+    for (int t = 0; t < ROUTE_CACHE_SLOTS; t++) {
+        RouteTable *table = &routes->tables[t];
+        if (table->target == -1 || table->distance[to] == ROUTE_UNREACHABLE) continue;
+        if (table->distance[to] + 1 >= table->distance[room_id]) continue;
+
+        table->distance[room_id] = table->distance[to] + 1;
+        table->next_exit[room_id] = exit_id;
+        routes->queue[0] = room_id;
+        relax(world, routes, table, 0, 1);
+    }
+}
+
+int world_route_next(World *world, int from, int target, int *moves) {
+    if (moves) *moves = 0;
+    WorldRoutes *routes = world->routes;
+    const WorldDef *def = world->def;
+    if (!routes || !def) return -1;
+    if (from < 0 || from >= def->room_count || target < 0 || target >= def->room_count) return -1;
+
+    // Exits or rooms changed since the adjacency was built
+    if (routes->room_count != def->room_count || routes->exit_count != def->exit_count) {
+        world_routes_free(routes);
+        if (!world_routes_init(routes, world)) return -1;
+    }
+
+    routes->clock++;
+    RouteTable *table = NULL;
+    for (int t = 0; t < ROUTE_CACHE_SLOTS && !table; t++) {
+        if (routes->tables[t].target == target) table = &routes->tables[t];
+    }
+    if (!table) {
+        table = &routes->tables[0];
+        for (int t = 1; t < ROUTE_CACHE_SLOTS; t++) {
+            RouteTable *slot = &routes->tables[t];
+            if (table->target == -1) break;
+            if (slot->target == -1 || slot->last_used < table->last_used) table = slot;
+        }
+        if (!build_table(world, routes, table, target)) {
+            table->target = -1;
+            return -1;
+        }
+    }
+    table->last_used = routes->clock;
+
+    int32_t distance = table->distance[from];
+    if (distance == 0 || distance == ROUTE_UNREACHABLE) return -1;
+    if (moves) *moves = distance;
+    return table->next_exit[from];
+}
@@ -0,0 +1,255 @@
+/*
+ * Adventure Engine - World Snapshots Implementation
+ */
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "world_journal.h"
+#include "world_route.h"
+#include "world_snapshot.h"
+
+// Reference-counted copy of one chunk of a state region
+struct StateChunk {
+    atomic_int refcount;
+    uint32_t size;
+    _Alignas(8) unsigned char data[];
+};
+
+// Helper: Address and size in bytes of each state region
+static void state_regions(const World *world, unsigned char *data[STATE_REGION_COUNT],
+                          size_t size[STATE_REGION_COUNT]) {
+    size_t rooms = (size_t)world->def->room_count;
+    size_t items = (size_t)world->def->item_count;
+
+    data[STATE_ITEM_LOCATION] = (unsigned char *)world->item_location;
+    size[STATE_ITEM_LOCATION] = items * sizeof(ItemLocation);
+    data[STATE_ROOM_FIRST_ITEM] = (unsigned char *)world->room_first_item;
+    size[STATE_ROOM_FIRST_ITEM] = rooms * sizeof(int32_t);
+    data[STATE_VISITED] = (unsigned char *)world->visited;
+    size[STATE_VISITED] = BITSET_WORDS(rooms) * sizeof(uint64_t);
+    data[STATE_DESCRIPTION_SHOWN] = (unsigned char *)world->description_shown;
+    size[STATE_DESCRIPTION_SHOWN] = BITSET_WORDS(rooms) * sizeof(uint64_t);
+    data[STATE_EXIT_UNLOCKED] = (unsigned char *)world->exit_unlocked;
+    size[STATE_EXIT_UNLOCKED] = BITSET_WORDS(world->def->exit_count) * sizeof(uint64_t);
+    data[STATE_ITEM_USED] = (unsigned char *)world->item_used;
+    size[STATE_ITEM_USED] = BITSET_WORDS(items) * sizeof(uint64_t);
+}
+
+static StateChunk* chunk_retain(StateChunk *chunk) {
+    if (chunk) atomic_fetch_add(&chunk->refcount, 1);
+    return chunk;
+}
+
+static void chunk_release(StateChunk *chunk) {
+    if (chunk && atomic_fetch_sub(&chunk->refcount, 1) == 1) free(chunk);
+}
+
+void world_snapshot_detach(World *world) {
+    if (world->snapshot_base) {
+        for (int c = 0; c < world->chunk_start[STATE_REGION_COUNT]; c++) {
+            chunk_release(world->snapshot_base[c]);
+        }
+    }
+    free(world->snapshot_base);
+    free(world->dirty_chunks);
+    world->snapshot_base = NULL;
+    world->dirty_chunks = NULL;
+    memset(world->chunk_start, 0, sizeof(world->chunk_start));
+}
+
+// Helper: Start tracking writes, with every chunk dirty
+static bool attach(World *world) {
+    unsigned char *data[STATE_REGION_COUNT];
+    size_t size[STATE_REGION_COUNT];
+    state_regions(world, data, size);
+
+    int chunks = 0;
+    for (int r = 0; r < STATE_REGION_COUNT; r++) {
+        world->chunk_start[r] = chunks;
+        chunks += (int)((size[r] + STATE_CHUNK_BYTES - 1) / STATE_CHUNK_BYTES);
+    }
+    world->chunk_start[STATE_REGION_COUNT] = chunks;
+
+    // One spare slot keeps the allocations non-empty for an empty world
+    world->snapshot_base = calloc((size_t)chunks + 1, sizeof(StateChunk *));
+    world->dirty_chunks = malloc((BITSET_WORDS(chunks) + 1) * sizeof(uint64_t));
+    if (!world->snapshot_base || !world->dirty_chunks) {
+        world_snapshot_detach(world);
+        return false;
+    }
+    memset(world->dirty_chunks, 0xff, (BITSET_WORDS(chunks) + 1) * sizeof(uint64_t));
+    return true;
+}
+
+// Helper: Check that a snapshot was cut from this world's definition and layout
+static bool same_layout(const World *world, const WorldSnapshot *snapshot) {
+    return snapshot->def == world->def &&
+           snapshot->room_count == world->def->room_count &&
+           snapshot->exit_count == world->def->exit_count &&
+           snapshot->item_count == world->def->item_count;
+}
+
+WorldSnapshot* world_snapshot(World *world) {
+    if (!world->def) return NULL;
+    if (!world->snapshot_base && !attach(world)) return NULL;
+
+    // The snapshot shares the definition, which is read-only from then on
+    if (world->def->conditions_dirty && world_def_writable(world->def)) {
+        world_compile_conditions(world);
+    }
+
+    int chunks = world->chunk_start[STATE_REGION_COUNT];
+    WorldSnapshot *snapshot = calloc(1, sizeof(WorldSnapshot));
+    if (!snapshot) return NULL;
+    snapshot->chunks = calloc((size_t)chunks + 1, sizeof(StateChunk *));
+    if (!snapshot->chunks) {
+        free(snapshot);
+        return NULL;
+    }
+
+    unsigned char *data[STATE_REGION_COUNT];
+    size_t size[STATE_REGION_COUNT];
+    state_regions(world, data, size);
+
+    for (int r = 0; r < STATE_REGION_COUNT; r++) {
+        for (int c = world->chunk_start[r]; c < world->chunk_start[r + 1]; c++) {
+            // Unchanged chunks are shared with the previous snapshot
+            if (!bitset_test(world->dirty_chunks, (size_t)c) && world->snapshot_base[c]) {
+                snapshot->chunks[c] = chunk_retain(world->snapshot_base[c]);
+                continue;
+            }
+
+            size_t offset = (size_t)(c - world->chunk_start[r]) * STATE_CHUNK_BYTES;
+            size_t len = size[r] - offset < STATE_CHUNK_BYTES ? size[r] - offset : STATE_CHUNK_BYTES;
+            StateChunk *chunk = malloc(sizeof(StateChunk) + len);
+            if (!chunk) {
+                snapshot->chunk_count = c;
+                world_snapshot_free(snapshot);
+                return NULL;
+            }
+            atomic_init(&chunk->refcount, 1);
+            chunk->size = (uint32_t)len;
+            memcpy(chunk->data, data[r] + offset, len);
+
+            chunk_release(world->snapshot_base[c]);
+            world->snapshot_base[c] = chunk;
+            bitset_clear(world->dirty_chunks, (size_t)c);
+            snapshot->chunks[c] = chunk_retain(chunk);
+            snapshot->copied_bytes += len;
+        }
+    }
+
+    snapshot->def = world_def_retain(world->def);
+    snapshot->room_count = world->def->room_count;
+    snapshot->exit_count = world->def->exit_count;
+    snapshot->item_count = world->def->item_count;
+    snapshot->current_room = world->current_room;
+    snapshot->inventory_first = world->inventory_first;
+    snapshot->inventory_count = world->inventory_count;
+    snapshot->chunk_count = chunks;
+    return snapshot;
+}
+
+bool world_restore(World *world, const WorldSnapshot *snapshot) {
+    if (!snapshot || !same_layout(world, snapshot)) return false;
+    if (!world->snapshot_base && !attach(world)) return false;
+
+    unsigned char *data[STATE_REGION_COUNT];
+    size_t size[STATE_REGION_COUNT];
+    state_regions(world, data, size);
+
+    // Only chunks written since the last snapshot or taken from a different
+    // snapshot can differ from the target
+    for (int r = 0; r < STATE_REGION_COUNT; r++) {
+        for (int c = world->chunk_start[r]; c < world->chunk_start[r + 1]; c++) {
+            StateChunk *chunk = snapshot->chunks[c];
+            if (!bitset_test(world->dirty_chunks, (size_t)c) && world->snapshot_base[c] == chunk) {
+                continue;
+            }
+
+            size_t offset = (size_t)(c - world->chunk_start[r]) * STATE_CHUNK_BYTES;
+            memcpy(data[r] + offset, chunk->data, chunk->size);
+            chunk_release(world->snapshot_base[c]);
+            world->snapshot_base[c] = chunk_retain(chunk);
+            bitset_clear(world->dirty_chunks, (size_t)c);
+        }
+    }
+
+    world->current_room = snapshot->current_room;
+    world->inventory_first = snapshot->inventory_first;
+    world->inventory_count = snapshot->inventory_count;
+    world_invalidate_descriptions(world);
+    world_routes_invalidate(world->routes);
+
+    // Journaled changes no longer lead to the restored state
+    if (world->journal) world_journal_clear(world->journal);
+    return true;
+}
+
+bool world_fork(World *session, const WorldSnapshot *snapshot) {
+    if (!snapshot || !world_init_session(session, snapshot->def)) return false;
+
+    if (!world_restore(session, snapshot)) {
+        world_free(session);
+        return false;
+    }
+    return true;
+}
+
+bool world_snapshot_matches(const World *world, const WorldSnapshot *snapshot) {
+    if (!snapshot || !world->snapshot_base || !same_layout(world, snapshot)) return false;
+    if (world->current_room != snapshot->current_room ||
+        world->inventory_first != snapshot->inventory_first ||
+        world->inventory_count != snapshot->inventory_count) {
+        return false;
+    }
+
+    for (int c = 0; c < snapshot->chunk_count; c++) {
+        if (bitset_test(world->dirty_chunks, (size_t)c) ||
+            world->snapshot_base[c] != snapshot->chunks[c]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Helper: Fold bytes into a 64-bit FNV-1a hash
+static uint64_t hash_bytes(uint64_t hash, const void *data, size_t len) {
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+uint64_t world_state_hash(const World *world) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    if (!world->def) return hash;
+
+    int32_t scalars[] = {
+        world->def->room_count, world->def->exit_count, world->def->item_count,
+        world->current_room, world->inventory_first, world->inventory_count
+    };
+    hash = hash_bytes(hash, scalars, sizeof(scalars));
+
+    unsigned char *data[STATE_REGION_COUNT];
+    size_t size[STATE_REGION_COUNT];
+    state_regions(world, data, size);
+    for (int r = 0; r < STATE_REGION_COUNT; r++) {
+        hash = hash_bytes(hash, data[r], size[r]);
+    }
+    return hash;
+}
+
+void world_snapshot_free(WorldSnapshot *snapshot) {
+    if (!snapshot) return;
+
+    for (int c = 0; c < snapshot->chunk_count; c++) {
+        chunk_release(snapshot->chunks[c]);
+    }
+    free(snapshot->chunks);
+    world_def_release(snapshot->def);
+    free(snapshot);
+}
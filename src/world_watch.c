@@ -0,0 +1,129 @@
+/*
+ * Adventure Engine - World File Watcher Implementation
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "world_watch.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#define WORLD_NAME_SIZE 64
+#define EVENT_BUFFER_SIZE 4096
+
+struct WorldWatcher {
+    int fd;
+    char pending[WORLD_WATCH_PENDING][WORLD_NAME_SIZE]; // Names not yet reported, oldest first
+    int pending_count;
+    bool overflowed;          // Saves were missed; a rescan is owed
+};
+
+WorldWatcher* world_watcher_open(const char *dir) {
+    WorldWatcher *watcher = calloc(1, sizeof(WorldWatcher));
+    if (!watcher) return NULL;
+
+    watcher->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watcher->fd < 0) {
+        free(watcher);
+        return NULL;
+    }
+    if (inotify_add_watch(watcher->fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(watcher->fd);
+        free(watcher);
+        return NULL;
+    }
+    return watcher;
+}
+
+void world_watcher_close(WorldWatcher *watcher) {
+    if (!watcher) return;
+    close(watcher->fd);
+    free(watcher);
+}
+
+int world_watcher_fd(const WorldWatcher *watcher) {
+    return watcher->fd;
+}
+
+// Helper: Remember a saved file if it is a world not already pending
+static void add_pending(WorldWatcher *watcher, const char *file) {
+    size_t len = strlen(file);
+    if (len <= 6 || strcmp(file + len - 6, ".world") != 0) return;
+    len -= 6;
+    if (len >= WORLD_NAME_SIZE) return;
+
+    for (int p = 0; p < watcher->pending_count; p++) {
+        if (strncmp(watcher->pending[p], file, len) == 0 && watcher->pending[p][len] == '\0') {
+            return;
+        }
+    }
+    if (watcher->pending_count == WORLD_WATCH_PENDING) {
+        watcher->overflowed = true;
+        return;
+    }
+    memcpy(watcher->pending[watcher->pending_count], file, len);
+    watcher->pending[watcher->pending_count][len] = '\0';
+    watcher->pending_count++;
+}
+
+bool world_watcher_next(WorldWatcher *watcher, char *name, size_t size) {
+    // Drain every queued event first, so repeated saves collapse into one
+    _Alignas(struct inotify_event) char buffer[EVENT_BUFFER_SIZE];
+    ssize_t n;
+    while ((n = read(watcher->fd, buffer, sizeof(buffer))) > 0) {
+        for (char *p = buffer; p < buffer + n;) {
+            const struct inotify_event *event = (const struct inotify_event *)p;
+            if (event->mask & IN_Q_OVERFLOW) {
+                // The kernel dropped events: any world may have been saved
+                watcher->overflowed = true;
+            } else if (event->len > 0 && !(event->mask & IN_ISDIR)) {
+                add_pending(watcher, event->name);
+            }
+            p += sizeof(struct inotify_event) + event->len;
+        }
+    }
+
+    if (watcher->pending_count == 0) {
+        if (!watcher->overflowed) return false;
+        watcher->overflowed = false;
+        snprintf(name, size, "%s", WORLD_WATCH_RESCAN);
+        return true;
+    }
+    snprintf(name, size, "%s", watcher->pending[0]);
+    watcher->pending_count--;
+    memmove(watcher->pending[0], watcher->pending[1],
+            (size_t)watcher->pending_count * WORLD_NAME_SIZE);
+    return true;
+}
+
+#else
+
+// No inotify: hot reload is unavailable
+
+WorldWatcher* world_watcher_open(const char *dir) {
+    (void)dir;
+    return NULL;
+}
+
+void world_watcher_close(WorldWatcher *watcher) {
+    (void)watcher;
+}
+
+int world_watcher_fd(const WorldWatcher *watcher) {
+    (void)watcher;
+    return -1;
+}
+
+bool world_watcher_next(WorldWatcher *watcher, char *name, size_t size) {
+    (void)watcher;
+    (void)name;
+    (void)size;
+    return false;
+}
+
+#endif
@@ -72,6 +72,7 @@ void test_default_description(void) {
     const char *desc = world_get_room_description(&world, r);
 
     ASSERT_STR_EQ("Default description.", desc, "should return default description");
+    world_free(&world);
     PASS();
 }
 
@@ -83,19 +84,16 @@ void test_first_visit_condition(void) {
     world_init(&world);
 
     int room = world_add_room(&world, "test", "Test Room", "Default description.");
-    Room *r = &world.rooms[room];
+    Room *r = &world.def->rooms[room];
 
     // Add conditional description for first visit
-    r->conditional_descs[0].type = COND_FIRST_VISIT;
-    r->conditional_descs[0].negate = false;
-    r->conditional_descs[0].subject[0] = '\0';
-    strncpy(r->conditional_descs[0].description, "First time here!", sizeof(r->conditional_descs[0].description));
-    r->conditional_desc_count = 1;
+    world_add_conditional_desc(&world, room, COND_FIRST_VISIT, "", false,
+                               "First time here!");
 
     world.current_room = room;
 
     // Room description not shown yet - should show first_visit description
-    r->description_shown = false;
+    world_set_room_description_shown(&world, room, false);
     const char *desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("First time here!", desc, "should show first_visit description");
 
@@ -104,6 +102,7 @@ void test_first_visit_condition(void) {
     desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("Default description.", desc, "should show default after first display");
 
+    world_free(&world);
     PASS();
 }
 
@@ -115,27 +114,25 @@ void test_visited_condition(void) {
     world_init(&world);
 
     int room = world_add_room(&world, "test", "Test Room", "Default description.");
-    Room *r = &world.rooms[room];
+    Room *r = &world.def->rooms[room];
 
     // Add conditional description for return visit
-    r->conditional_descs[0].type = COND_VISITED;
-    r->conditional_descs[0].negate = false;
-    r->conditional_descs[0].subject[0] = '\0';
-    strncpy(r->conditional_descs[0].description, "Welcome back!", sizeof(r->conditional_descs[0].description));
-    r->conditional_desc_count = 1;
+    world_add_conditional_desc(&world, room, COND_VISITED, "", false,
+                               "Welcome back!");
 
     world.current_room = room;
 
     // Not visited yet - should show default
-    r->visited = false;
+    world_set_room_visited(&world, room, false);
     const char *desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("Default description.", desc, "should show default on first visit");
 
     // After visiting - should show return description
-    r->visited = true;
+    world_set_room_visited(&world, room, true);
     desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("Welcome back!", desc, "should show visited description");
 
+    world_free(&world);
     PASS();
 }
 
@@ -149,27 +146,25 @@ void test_has_item_condition(void) {
     int room = world_add_room(&world, "test", "Test Room", "A dark room.");
     int lantern = world_add_item(&world, "lantern", "brass lantern", "A lantern.", true);
 
-    Room *r = &world.rooms[room];
+    Room *r = &world.def->rooms[room];
 
     // Add conditional description for having lantern
-    r->conditional_descs[0].type = COND_HAS_ITEM;
-    r->conditional_descs[0].negate = false;
-    strncpy(r->conditional_descs[0].subject, "lantern", sizeof(r->conditional_descs[0].subject));
-    strncpy(r->conditional_descs[0].description, "The lantern illuminates the room!", sizeof(r->conditional_descs[0].description));
-    r->conditional_desc_count = 1;
+    world_add_conditional_desc(&world, room, COND_HAS_ITEM, "lantern", false,
+                               "The lantern illuminates the room!");
 
     world.current_room = room;
-    r->visited = true;
+    world_set_room_visited(&world, room, true);
 
     // Without lantern - should show default
     const char *desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("A dark room.", desc, "should show default without lantern");
 
     // With lantern in inventory
-    world.inventory[0] = lantern;
+    world_set_item_location(&world, lantern, ITEM_IN_INVENTORY);
     desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("The lantern illuminates the room!", desc, "should show has_item description");
 
+    world_free(&world);
     PASS();
 }
 
@@ -183,27 +178,25 @@ void test_negated_condition(void) {
     int room = world_add_room(&world, "test", "Test Room", "Default description.");
     int key = world_add_item(&world, "key", "rusty key", "A key.", true);
 
-    Room *r = &world.rooms[room];
+    Room *r = &world.def->rooms[room];
 
     // Add conditional description for NOT having key
-    r->conditional_descs[0].type = COND_HAS_ITEM;
-    r->conditional_descs[0].negate = true;  // Negated!
-    strncpy(r->conditional_descs[0].subject, "key", sizeof(r->conditional_descs[0].subject));
-    strncpy(r->conditional_descs[0].description, "You need to find the key.", sizeof(r->conditional_descs[0].description));
-    r->conditional_desc_count = 1;
+    world_add_conditional_desc(&world, room, COND_HAS_ITEM, "key", true,
+                               "You need to find the key.");
 
     world.current_room = room;
-    r->visited = true;
+    world_set_room_visited(&world, room, true);
 
     // Without key - negated condition should match
     const char *desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("You need to find the key.", desc, "should show !has_item description");
 
     // With key - negated condition should NOT match
-    world.inventory[0] = key;
+    world_set_item_location(&world, key, ITEM_IN_INVENTORY);
     desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("Default description.", desc, "should show default with key");
 
+    world_free(&world);
     PASS();
 }
 
@@ -217,17 +210,14 @@ void test_room_has_item_condition(void) {
     int room = world_add_room(&world, "test", "Test Room", "An empty room.");
     int coin = world_add_item(&world, "coin", "gold coin", "A coin.", true);
 
-    Room *r = &world.rooms[room];
+    Room *r = &world.def->rooms[room];
 
     // Add conditional description for coin in room
-    r->conditional_descs[0].type = COND_ROOM_HAS_ITEM;
-    r->conditional_descs[0].negate = false;
-    strncpy(r->conditional_descs[0].subject, "coin", sizeof(r->conditional_descs[0].subject));
-    strncpy(r->conditional_descs[0].description, "Something glints on the floor.", sizeof(r->conditional_descs[0].description));
-    r->conditional_desc_count = 1;
+    world_add_conditional_desc(&world, room, COND_ROOM_HAS_ITEM, "coin", false,
+                               "Something glints on the floor.");
 
     world.current_room = room;
-    r->visited = true;
+    world_set_room_visited(&world, room, true);
 
     // Without coin in room - should show default
     const char *desc = world_get_room_description(&world, r);
@@ -238,6 +228,7 @@ void test_room_has_item_condition(void) {
     desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("Something glints on the floor.", desc, "should show room_has_item description");
 
+    world_free(&world);
     PASS();
 }
 
@@ -251,28 +242,25 @@ void test_item_used_condition(void) {
     int room = world_add_room(&world, "test", "Test Room", "Normal room.");
     int scroll = world_add_item(&world, "scroll", "magic scroll", "A scroll.", true);
 
-    Room *r = &world.rooms[room];
-    Item *scroll_item = &world.items[scroll];
+    Room *r = &world.def->rooms[room];
 
     // Add conditional description for used scroll
-    r->conditional_descs[0].type = COND_ITEM_USED;
-    r->conditional_descs[0].negate = false;
-    strncpy(r->conditional_descs[0].subject, "scroll", sizeof(r->conditional_descs[0].subject));
-    strncpy(r->conditional_descs[0].description, "Arcane symbols glow on the walls.", sizeof(r->conditional_descs[0].description));
-    r->conditional_desc_count = 1;
+    world_add_conditional_desc(&world, room, COND_ITEM_USED, "scroll", false,
+                               "Arcane symbols glow on the walls.");
 
     world.current_room = room;
-    r->visited = true;
+    world_set_room_visited(&world, room, true);
 
     // Scroll not used - should show default
     const char *desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("Normal room.", desc, "should show default before scroll used");
 
     // After using scroll
-    scroll_item->used = true;
+    world_set_item_used(&world, scroll, true);
     desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("Arcane symbols glow on the walls.", desc, "should show item_used description");
 
+    world_free(&world);
     PASS();
 }
 
@@ -287,45 +275,39 @@ void test_condition_priority(void) {
     int lantern = world_add_item(&world, "lantern", "lantern", "A lantern.", true);
     int scroll = world_add_item(&world, "scroll", "scroll", "A scroll.", true);
 
-    Room *r = &world.rooms[room];
+    Room *r = &world.def->rooms[room];
 
     // Add multiple conditions
     // 1. visited (priority 1)
-    r->conditional_descs[0].type = COND_VISITED;
-    r->conditional_descs[0].negate = false;
-    strncpy(r->conditional_descs[0].description, "Visited desc.", sizeof(r->conditional_descs[0].description));
+    world_add_conditional_desc(&world, room, COND_VISITED, "", false,
+                               "Visited desc.");
 
     // 2. has_item (priority 3)
-    r->conditional_descs[1].type = COND_HAS_ITEM;
-    r->conditional_descs[1].negate = false;
-    strncpy(r->conditional_descs[1].subject, "lantern", sizeof(r->conditional_descs[1].subject));
-    strncpy(r->conditional_descs[1].description, "Has item desc.", sizeof(r->conditional_descs[1].description));
+    world_add_conditional_desc(&world, room, COND_HAS_ITEM, "lantern", false,
+                               "Has item desc.");
 
     // 3. item_used (priority 4)
-    r->conditional_descs[2].type = COND_ITEM_USED;
-    r->conditional_descs[2].negate = false;
-    strncpy(r->conditional_descs[2].subject, "scroll", sizeof(r->conditional_descs[2].subject));
-    strncpy(r->conditional_descs[2].description, "Item used desc.", sizeof(r->conditional_descs[2].description));
-
-    r->conditional_desc_count = 3;
+    world_add_conditional_desc(&world, room, COND_ITEM_USED, "scroll", false,
+                               "Item used desc.");
 
     world.current_room = room;
-    r->visited = true;
+    world_set_room_visited(&world, room, true);
 
     // Only visited matches - should show visited
     const char *desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("Visited desc.", desc, "should show visited when only visited matches");
 
     // Add lantern - has_item should win (higher priority)
-    world.inventory[0] = lantern;
+    world_set_item_location(&world, lantern, ITEM_IN_INVENTORY);
     desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("Has item desc.", desc, "should show has_item over visited");
 
     // Mark scroll as used - item_used should win (highest priority)
-    world.items[scroll].used = true;
+    world_set_item_used(&world, scroll, true);
     desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("Item used desc.", desc, "should show item_used over has_item");
 
+    world_free(&world);
     PASS();
 }
 
@@ -341,33 +323,28 @@ void test_same_priority_tiebreaking(void) {
     int torch = world_add_item(&world, "torch", "torch", "A torch.", true);
     (void)torch;  // Suppress unused warning - torch exists but player won't have it
 
-    Room *r = &world.rooms[room];
+    Room *r = &world.def->rooms[room];
 
     // Add two has_item conditions with same priority (priority 3)
     // First: has_item=lantern
-    r->conditional_descs[0].type = COND_HAS_ITEM;
-    r->conditional_descs[0].negate = false;
-    strncpy(r->conditional_descs[0].subject, "lantern", sizeof(r->conditional_descs[0].subject));
-    strncpy(r->conditional_descs[0].description, "Lantern desc (first).", sizeof(r->conditional_descs[0].description));
+    world_add_conditional_desc(&world, room, COND_HAS_ITEM, "lantern", false,
+                               "Lantern desc (first).");
 
     // Second: !has_item=torch (also priority 3, will match when player doesn't have torch)
-    r->conditional_descs[1].type = COND_HAS_ITEM;
-    r->conditional_descs[1].negate = true;
-    strncpy(r->conditional_descs[1].subject, "torch", sizeof(r->conditional_descs[1].subject));
-    strncpy(r->conditional_descs[1].description, "No torch desc (second).", sizeof(r->conditional_descs[1].description));
-
-    r->conditional_desc_count = 2;
+    world_add_conditional_desc(&world, room, COND_HAS_ITEM, "torch", true,
+                               "No torch desc (second).");
 
     world.current_room = room;
-    r->visited = true;
-    r->description_shown = true;  // Skip first_visit logic
+    world_set_room_visited(&world, room, true);
+    world_set_room_description_shown(&world, room, true);  // Skip first_visit logic
 
     // Player has lantern but not torch - both conditions match
     // First one defined (lantern) should win due to tie-breaking
-    world.inventory[0] = lantern;
+    world_set_item_location(&world, lantern, ITEM_IN_INVENTORY);
     const char *desc = world_get_room_description(&world, r);
     ASSERT_STR_EQ("Lantern desc (first).", desc, "first defined condition should win on tie");
 
+    world_free(&world);
     PASS();
 }
 
@@ -391,7 +368,7 @@ void test_load_conditional_descriptions(void) {
     int cellar_idx = world_find_room(&world, "cellar");
     ASSERT_TRUE(cellar_idx >= 0, "cellar room should exist");
 
-    Room *cellar = &world.rooms[cellar_idx];
+    Room *cellar = &world.def->rooms[cellar_idx];
 
     // Should have conditional descriptions
     ASSERT_TRUE(cellar->conditional_desc_count > 0, "cellar should have conditional descriptions");
@@ -401,20 +378,105 @@ void test_load_conditional_descriptions(void) {
     bool found_has_lantern = false;
 
     for (int i = 0; i < cellar->conditional_desc_count; i++) {
-        ConditionalDesc *cond = &cellar->conditional_descs[i];
+        ConditionalDesc *cond = &world_room_conditions(world.def, cellar)[i];
         if (cond->type == COND_FIRST_VISIT && !cond->negate) {
             found_first_visit = true;
-            ASSERT_STR_CONTAINS(cond->description, "first time", "first_visit should mention first time");
+            ASSERT_STR_CONTAINS(world_str(&world, cond->description), "first time", "first_visit should mention first time");
         }
-        if (cond->type == COND_HAS_ITEM && strcmp(cond->subject, "lantern") == 0 && !cond->negate) {
+        if (cond->type == COND_HAS_ITEM && strcmp(world_str(&world, cond->subject), "lantern") == 0 && !cond->negate) {
             found_has_lantern = true;
-            ASSERT_STR_CONTAINS(cond->description, "lantern", "has_item=lantern should mention lantern");
+            ASSERT_STR_CONTAINS(world_str(&world, cond->description), "lantern", "has_item=lantern should mention lantern");
         }
     }
 
     ASSERT_TRUE(found_first_visit, "should have first_visit condition");
     ASSERT_TRUE(found_has_lantern, "should have has_item=lantern condition");
 
+    world_free(&world);
+    PASS();
+}
+
+// Test conditions compiled to item indices (items added after conditions)
+void test_compiled_conditions(void) {
+    TEST("Compiled conditions and fixed rooms");
+
+    World world;
+    world_init(&world);
+
+    int room = world_add_room(&world, "test", "Test Room", "Default.");
+    int fixed = world_add_room(&world, "fixed", "Fixed Room", "Fixed default.");
+
+    // Condition added before its item exists
+    world_add_conditional_desc(&world, room, COND_HAS_ITEM, "lantern", false,
+                               "Lantern light.");
+    // Conditions on an item that never exists can't change
+    world_add_conditional_desc(&world, fixed, COND_HAS_ITEM, "ghost", true,
+                               "No ghost here.");
+
+    int lantern = world_add_item(&world, "lantern", "lantern", "A lantern.", true);
+    world_compile_conditions(&world);
+
+    Room *r = &world.def->rooms[room];
+    Room *f = &world.def->rooms[fixed];
+    ASSERT_TRUE(world_room_conditions(world.def, r)[0].item == lantern, "subject should resolve to lantern");
+    ASSERT_TRUE(!r->description_fixed, "room with a real item should not be fixed");
+    ASSERT_TRUE(f->description_fixed, "room with unknown items should be fixed");
+    ASSERT_STR_EQ("No ghost here.", world_get_room_description(&world, f),
+                  "fixed room should return cached description");
+
+    ASSERT_STR_EQ("Default.", world_get_room_description(&world, r), "no lantern yet");
+    world_set_item_location(&world, lantern, ITEM_IN_INVENTORY);
+    ASSERT_STR_EQ("Lantern light.", world_get_room_description(&world, r), "lantern carried");
+
+    // Bulk state changes drop every entry but the fixed room's
+    ASSERT_TRUE(world.def->item_dep_start[world.def->item_count] == 1,
+                "only the lantern condition should have a dependency entry");
+    world_state_changed(&world);
+    ASSERT_TRUE(bitset_test(world.description_cached, fixed), "fixed room cache should survive");
+    ASSERT_TRUE(!bitset_test(world.description_cached, room), "other room cache should be dropped");
+    ASSERT_STR_EQ("No ghost here.", world_get_room_description(&world, f), "fixed room after invalidate");
+
+    world_free(&world);
+    PASS();
+}
+
+// Test cached descriptions are invalidated only by their dependencies
+void test_description_cache(void) {
+    TEST("Description cache invalidation");
+
+    World world;
+    world_init(&world);
+
+    int hall = world_add_room(&world, "hall", "Hall", "Hall default.");
+    int attic = world_add_room(&world, "attic", "Attic", "Attic default.");
+    int lantern = world_add_item(&world, "lantern", "lantern", "A lantern.", true);
+    int rope = world_add_item(&world, "rope", "rope", "A rope.", true);
+
+    world_add_conditional_desc(&world, hall, COND_ROOM_HAS_ITEM, "lantern", false,
+                               "A lantern sits here.");
+    world_add_conditional_desc(&world, attic, COND_HAS_ITEM, "rope", false,
+                               "You could climb out.");
+    world_compile_conditions(&world);
+
+    Room *h = &world.def->rooms[hall];
+    Room *a = &world.def->rooms[attic];
+    const uint64_t *cached = world.description_cached;
+    ASSERT_STR_EQ("Hall default.", world_get_room_description(&world, h), "hall default");
+    ASSERT_STR_EQ("Attic default.", world_get_room_description(&world, a), "attic default");
+    ASSERT_TRUE(bitset_test(cached, hall) && bitset_test(cached, attic), "both rooms should be cached");
+
+    // Moving the lantern invalidates only the hall
+    world_place_item(&world, lantern, hall);
+    ASSERT_TRUE(!bitset_test(cached, hall), "hall cache should be dropped");
+    ASSERT_TRUE(bitset_test(cached, attic), "attic cache should survive");
+    ASSERT_STR_EQ("A lantern sits here.", world_get_room_description(&world, h), "lantern in hall");
+
+    // Taking the rope invalidates only the attic
+    world_set_item_location(&world, rope, ITEM_IN_INVENTORY);
+    ASSERT_TRUE(bitset_test(cached, hall), "hall cache should survive");
+    ASSERT_STR_EQ("You could climb out.", world_get_room_description(&world, a), "rope carried");
+
+    world_free(&world);
     PASS();
 }
 
@@ -432,6 +494,8 @@ int main(void) {
     test_item_used_condition();
     test_condition_priority();
     test_same_priority_tiebreaking();
+    test_compiled_conditions();
+    test_description_cache();
     test_load_conditional_descriptions();
 
     printf("\n=== Test Results ===\n");
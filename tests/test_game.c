@@ -0,0 +1,358 @@
+/*
+ * Test Suite for Game Commands
+ * Tests headless play through an output sink, batch mode and several
+ * games in one process
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/game.h"
+#include "../include/world.h"
+
+// Test counter
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name) \
+    printf("  Testing: %s ... ", name); \
+    fflush(stdout);
+
+#define PASS() \
+    do { \
+        printf("✓ PASS\n"); \
+        tests_passed++; \
+    } while(0)
+
+#define FAIL(msg) \
+    do { \
+        printf("✗ FAIL: %s\n", msg); \
+        tests_failed++; \
+    } while(0)
+
+#define ASSERT_TRUE(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_FALSE(cond, msg) \
+    do { \
+        if (cond) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(expected, actual, msg) \
+    do { \
+        if ((expected) != (actual)) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: %d, got: %d)", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_STR_EQ(expected, actual, msg) \
+    do { \
+        if (strcmp(expected, actual) != 0) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: '%.128s', got: '%.128s')", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+// Sink that keeps every line, newline-separated, in a fixed buffer
+typedef struct {
+    char text[4096];
+    size_t used;
+    int lines;
+} Capture;
+
+static void capture_write(void *ctx, const char *text, OutputStyle style) {
+    (void)style;
+    Capture *capture = ctx;
+    int n = snprintf(capture->text + capture->used, sizeof(capture->text) - capture->used,
+                     "%s\n", text);
+    if (n > 0 && capture->used + (size_t)n < sizeof(capture->text)) capture->used += (size_t)n;
+    capture->lines++;
+}
+
+// Helper: Two rooms with a key in the first
+static void build_world(World *world) {
+    int hall = world_add_room(world, "hall", "Hall", "A long hall.");
+    int study = world_add_room(world, "study", "Study", "Books everywhere.");
+    world_connect_rooms(world, hall, DIR_NORTH, study);
+    world_connect_rooms(world, study, DIR_SOUTH, hall);
+    int key = world_add_item(world, "key", "brass key", "A small brass key.", true);
+    world_place_item(world, key, hall);
+    world->current_room = hall;
+}
+
+// Helper: Forget captured output
+static void clear(Capture *capture) {
+    capture->used = 0;
+    capture->lines = 0;
+    capture->text[0] = '\0';
+}
+
+// Test commands write to the sink and change the world
+void test_commands(void) {
+    TEST("Commands through a sink");
+
+    Capture capture = {0};
+    OutputSink sink = { .write = capture_write, .ctx = &capture };
+    Game game;
+    game_init(&game, &sink);
+    build_world(&game.world);
+
+    game_start(&game);
+    ASSERT_TRUE(strstr(capture.text, "Hall\nA long hall.\n") != NULL, "first look");
+
+    clear(&capture);
+    ASSERT_TRUE(game_command(&game, "take brass key"), "take keeps running");
+    ASSERT_STR_EQ("You take the brass key.\n", capture.text, "take output");
+    ASSERT_TRUE(game_command(&game, "north"), "move keeps running");
+    ASSERT_EQ(1, game.world.current_room, "moved north");
+    ASSERT_TRUE(game_command(&game, "undo"), "undo keeps running");
+    ASSERT_EQ(0, game.world.current_room, "undo moved back");
+    ASSERT_TRUE(game_command(&game, ""), "empty input is ignored");
+    ASSERT_EQ(2, game.turns, "undo and empty input are not turns");
+    ASSERT_STR_EQ("unknown", game.world_name, "no world name yet");
+    ASSERT_FALSE(game_command(&game, "quit"), "quit stops");
+
+    game_free(&game);
+    PASS();
+}
+
+// Test batch mode runs a script until quit
+void test_batch(void) {
+    TEST("Batch script");
+
+    Capture capture = {0};
+    OutputSink sink = { .write = capture_write, .ctx = &capture };
+    Game game;
+    game_init(&game, &sink);
+    build_world(&game.world);
+
+    // The overlong line is cut to one command and its tail skipped
+    char script[1024];
+    int len = snprintf(script, sizeof(script), "take key\r\nn\n%0600d\nquit\nsouth\n", 0);
+    FILE *in = fmemopen(script, (size_t)len, "r");
+    ASSERT_TRUE(in != NULL, "script stream");
+
+    int turns = game_run_batch(&game, in);
+    fclose(in);
+    ASSERT_EQ(3, turns, "three turns before quit");
+    ASSERT_EQ(1, game.world.current_room, "stopped at quit");
+    ASSERT_TRUE(world_has_item(&game.world, "key"), "key taken");
+    ASSERT_TRUE(strstr(capture.text, "Thanks for playing!") != NULL, "quit message");
+
+    game_free(&game);
+    PASS();
+}
+
+// Test games in one process keep separate worlds, history and output
+void test_independent_games(void) {
+    TEST("Independent games");
+
+    Capture first_out = {0}, second_out = {0};
+    OutputSink first_sink = { .write = capture_write, .ctx = &first_out };
+    OutputSink second_sink = { .write = capture_write, .ctx = &second_out };
+    Game first, second;
+    game_init(&first, &first_sink);
+    game_init(&second, &second_sink);
+    build_world(&first.world);
+    build_world(&second.world);
+    game_start(&first);
+    game_start(&second);
+    clear(&first_out);
+    clear(&second_out);
+
+    game_command(&first, "north");
+    game_command(&second, "take key");
+    game_command(&first, "look");
+    ASSERT_EQ(1, first.world.current_room, "first game moved");
+    ASSERT_EQ(0, second.world.current_room, "second game stayed");
+    ASSERT_FALSE(world_has_item(&first.world, "key"), "first game has no key");
+    ASSERT_TRUE(world_has_item(&second.world, "key"), "second game has the key");
+    ASSERT_TRUE(strstr(first_out.text, "Study") != NULL, "first output");
+    ASSERT_STR_EQ("You take the brass key.\n", second_out.text, "second output");
+
+    // Undo only reaches the game's own history
+    game_command(&second, "undo");
+    ASSERT_FALSE(world_has_item(&second.world, "key"), "second undo");
+    ASSERT_EQ(1, first.world.current_room, "first game untouched");
+    ASSERT_EQ(2, first.turns, "first turns");
+    ASSERT_EQ(1, second.turns, "second turns");
+
+    game_free(&first);
+    game_free(&second);
+    PASS();
+}
+
+// Test a line of several commands runs them all, stopping at quit
+void test_command_chain(void) {
+    TEST("Chained commands");
+
+    Capture capture = {0};
+    OutputSink sink = { .write = capture_write, .ctx = &capture };
+    Game game;
+    game_init(&game, &sink);
+    build_world(&game.world);
+    game_start(&game);
+    clear(&capture);
+
+    ASSERT_TRUE(game_command(&game, "Take KEY, north then look"), "chain keeps running");
+    ASSERT_EQ(3, game.turns, "one turn per command");
+    ASSERT_TRUE(world_has_item(&game.world, "key"), "noun matched in any case");
+    ASSERT_EQ(1, game.world.current_room, "moved");
+    ASSERT_TRUE(strstr(capture.text, "You take the brass key.\n") == capture.text, "output in order");
+
+    // Undo takes back one command of the line
+    game_command(&game, "undo");
+    ASSERT_EQ(0, game.world.current_room, "undo takes back the move");
+    ASSERT_TRUE(world_has_item(&game.world, "key"), "earlier commands kept");
+
+    clear(&capture);
+    game_command(&game, " , then ");
+    ASSERT_STR_EQ("I don't understand that.\n", capture.text, "separators only");
+    ASSERT_FALSE(game_command(&game, "drop key, quit, north"), "quit stops the line");
+    ASSERT_EQ(0, game.world.current_room, "nothing after quit runs");
+    ASSERT_FALSE(world_has_item(&game.world, "key"), "commands before quit run");
+
+    game_free(&game);
+    PASS();
+}
+
+// Test opening a bundled world by name
+void test_open(void) {
+    TEST("Open world by name");
+
+    Game game;
+    game_init(&game, NULL);
+    LoadError error;
+    ASSERT_FALSE(game_open(&game, "../etc/passwd", &error), "unsafe name rejected");
+    ASSERT_TRUE(game.world.def != NULL, "empty world after failure");
+    ASSERT_TRUE(game_open(&game, "dark_tower", &error), "bundled world opens");
+    ASSERT_STR_EQ("dark_tower", game.world_name, "world name");
+    ASSERT_TRUE(game.world.def->room_count > 0, "rooms loaded");
+
+    game_free(&game);
+    PASS();
+}
+
+// Test the verb table finds every word, including many extra ones
+void test_verb_table(void) {
+    TEST("Verb table");
+
+    VerbTable table;
+    verb_table_init(&table);
+    ASSERT_EQ(VERB_NONE, verb_table_find(&table, "look", strlen("look")), "empty table finds nothing");
+
+    // Extra words override built-ins; later extras override earlier ones
+    enum { EXTRA = 500 };
+    static char words[EXTRA][16];
+    VerbWord extra[EXTRA + 2];
+    for (int i = 0; i < EXTRA; i++) {
+        snprintf(words[i], sizeof(words[i]), "word%d", i);
+        extra[i].word = words[i];
+        extra[i].verb = (Verb)(i % VERB_COUNT);
+    }
+    extra[EXTRA].word = "l";
+    extra[EXTRA].verb = VERB_QUIT;
+    extra[EXTRA + 1].word = "word7";
+    extra[EXTRA + 1].verb = VERB_HELP;
+    ASSERT_TRUE(verb_table_build(&table, extra, EXTRA + 2), "table builds");
+
+    for (int v = 0; v < VERB_COUNT; v++) {
+        const char *name = verb_name((Verb)v);
+        ASSERT_TRUE(name != NULL, "every verb has a name");
+        ASSERT_EQ(v, (int)verb_table_find(&table, name, strlen(name)), "canonical name found");
+    }
+    ASSERT_EQ(VERB_EXAMINE, verb_table_find(&table, "x", strlen("x")), "built-in alias");
+    ASSERT_EQ(VERB_QUIT, verb_table_find(&table, "l", strlen("l")), "extra replaces built-in");
+    ASSERT_EQ(VERB_HELP, verb_table_find(&table, "word7", strlen("word7")), "later extra wins");
+    for (int i = 0; i < EXTRA; i++) {
+        if (i == 7) continue;
+        ASSERT_EQ(i % VERB_COUNT, (int)verb_table_find(&table, words[i], strlen(words[i])), "extra word found");
+    }
+    ASSERT_EQ(VERB_NONE, verb_table_find(&table, "word500", strlen("word500")), "unknown word");
+    ASSERT_EQ(VERB_NONE, verb_table_find(&table, "", strlen("")), "empty word");
+    ASSERT_EQ(VERB_LOOK, verb_table_find(&table, "LOOK", strlen("LOOK")), "any case");
+    ASSERT_EQ(VERB_LOOK, verb_table_find(&table, "lookout", 4), "slice of a longer word");
+    ASSERT_EQ(VERB_NONE, verb_table_find(&table, "looks", 5), "longer word");
+
+    verb_table_free(&table);
+    PASS();
+}
+
+// Test world synonyms reach commands
+void test_verb_synonyms(void) {
+    TEST("World verb synonyms");
+
+    Capture capture = {0};
+    OutputSink sink = { .write = capture_write, .ctx = &capture };
+    Game game;
+    game_init(&game, &sink);
+    build_world(&game.world);
+
+    ASSERT_TRUE(world_add_verb(&game.world, "Grab", "take"), "synonym of a verb");
+    ASSERT_TRUE(world_add_verb(&game.world, "climb", "N"), "synonym of an alias");
+    ASSERT_FALSE(world_add_verb(&game.world, "grab", "juggle"), "unknown verb");
+    ASSERT_FALSE(world_add_verb(&game.world, "pick up", "take"), "two words");
+    ASSERT_EQ(VERB_TAKE, world_find_verb(&game.world, "grab", strlen("grab")), "synonym found");
+    ASSERT_EQ(VERB_NORTH, world_find_verb(&game.world, "climb", strlen("climb")), "alias target resolved");
+    ASSERT_EQ(VERB_LOOK, world_find_verb(&game.world, "l", strlen("l")), "built-ins kept");
+
+    game_start(&game);
+    clear(&capture);
+    game_command(&game, "grab key");
+    ASSERT_STR_EQ("You take the brass key.\n", capture.text, "synonym runs the verb");
+    game_command(&game, "climb");
+    ASSERT_EQ(1, game.world.current_room, "synonym moves");
+    game_free(&game);
+
+    // From a [VERBS] section
+    LoadError error;
+    game_init(&game, &sink);
+    ASSERT_TRUE(game_open(&game, "dark_tower", &error), "world opens");
+    game_start(&game);
+    clear(&capture);
+    game_command(&game, "snatch key");
+    ASSERT_TRUE(world_has_item(&game.world, "key"), "[VERBS] synonym");
+    game_free(&game);
+    PASS();
+}
+
+// Main test runner
+int main(void) {
+    printf("\n=== Game Command Test Suite ===\n\n");
+
+    test_commands();
+    test_batch();
+    test_independent_games();
+    test_command_chain();
+    test_open();
+    test_verb_table();
+    test_verb_synonyms();
+
+    printf("\n=== Test Results ===\n");
+    printf("  Passed: %d\n", tests_passed);
+    printf("  Failed: %d\n", tests_failed);
+    printf("  Total:  %d\n", tests_passed + tests_failed);
+
+    if (tests_failed == 0) {
+        printf("\n✓ All tests passed!\n\n");
+        return 0;
+    } else {
+        printf("\n✗ Some tests failed!\n\n");
+        return 1;
+    }
+}
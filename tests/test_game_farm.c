@@ -0,0 +1,257 @@
+/*
+ * Test Suite for Game Farm
+ * Tests that games run on a worker pool end where serial play ends, and
+ * that idle workers sleep
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../include/game_farm.h"
+
+// Test counter
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name) \
+    printf("  Testing: %s ... ", name); \
+    fflush(stdout);
+
+#define PASS() \
+    do { \
+        printf("✓ PASS\n"); \
+        tests_passed++; \
+    } while(0)
+
+#define FAIL(msg) \
+    do { \
+        printf("✗ FAIL: %s\n", msg); \
+        tests_failed++; \
+    } while(0)
+
+#define ASSERT_TRUE(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_FALSE(cond, msg) \
+    do { \
+        if (cond) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(expected, actual, msg) \
+    do { \
+        if ((expected) != (actual)) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: %d, got: %d)", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_STR_EQ(expected, actual, msg) \
+    do { \
+        if (strcmp(expected, actual) != 0) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: '%.128s', got: '%.128s')", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+#define GAMES 48
+#define WORKERS 4
+#define ROUNDS 200
+
+static const char *const moves[] = {
+    "take key", "north", "drop key", "south", "look", "north", "take key", "south", "undo"
+};
+#define MOVE_COUNT ((int)(sizeof(moves) / sizeof(moves[0])))
+
+// Helper: Line n of game g's script (each game starts at a different move)
+static const char* script_line(int g, int n) {
+    return moves[(g + n) % MOVE_COUNT];
+}
+
+// Helper: Two rooms with a key in the first
+static void build_world(World *world) {
+    world_init(world);
+    int hall = world_add_room(world, "hall", "Hall", "A long hall.");
+    int study = world_add_room(world, "study", "Study", "Books everywhere.");
+    world_connect_rooms(world, hall, DIR_NORTH, study);
+    world_connect_rooms(world, study, DIR_SOUTH, hall);
+    int key = world_add_item(world, "key", "brass key", "A small brass key.", true);
+    world_place_item(world, key, hall);
+    world->current_room = hall;
+}
+
+// Test every game ends in the same state as playing its script serially
+void test_matches_serial(void) {
+    TEST("Farm matches serial play");
+
+    World base;
+    build_world(&base);
+
+    Game *games = malloc(GAMES * sizeof(Game));
+    ASSERT_TRUE(games != NULL, "games allocated");
+    GameFarm *farm = game_farm_create(WORKERS, GAMES);
+    ASSERT_TRUE(farm != NULL, "farm created");
+    for (int g = 0; g < GAMES; g++) {
+        game_init(&games[g], NULL);
+        ASSERT_TRUE(game_open_shared(&games[g], &base, "test"), "game shares world");
+        game_start(&games[g]);
+        ASSERT_EQ(g, game_farm_add(farm, &games[g]), "farm ID");
+    }
+
+    // Interleave submissions across games, retrying full queues
+    for (int n = 0; n < ROUNDS; n++) {
+        for (int g = 0; g < GAMES; g++) {
+            while (!game_farm_submit(farm, g, script_line(g, n))) {}
+        }
+    }
+    game_farm_drain(farm);
+
+    long long commands = 0;
+    game_farm_stats(farm, &commands, NULL);
+    ASSERT_TRUE(commands == (long long)GAMES * ROUNDS, "every command ran");
+    game_farm_destroy(farm);
+
+    for (int g = 0; g < GAMES; g++) {
+        Game serial;
+        game_init(&serial, NULL);
+        game_open_shared(&serial, &base, "test");
+        game_start(&serial);
+        for (int n = 0; n < ROUNDS; n++) {
+            game_command(&serial, script_line(g, n));
+        }
+
+        ASSERT_EQ(serial.world.current_room, games[g].world.current_room, "same room");
+        ASSERT_EQ(serial.turns, games[g].turns, "same turns");
+        ASSERT_EQ(world_item_location(&serial.world, 0), world_item_location(&games[g].world, 0),
+                  "same key location");
+        game_free(&serial);
+        game_free(&games[g]);
+    }
+
+    free(games);
+    world_free(&base);
+    PASS();
+}
+
+// Test input after quit is dropped and further input refused
+void test_quit(void) {
+    TEST("Quit drops queued input");
+
+    World base;
+    build_world(&base);
+    Game game;
+    game_init(&game, NULL);
+    game_open_shared(&game, &base, "test");
+    game_start(&game);
+
+    GameFarm *farm = game_farm_create(2, 1);
+    ASSERT_TRUE(farm != NULL, "farm created");
+    int id = game_farm_add(farm, &game);
+    ASSERT_EQ(0, id, "farm ID");
+    ASSERT_EQ(-1, game_farm_add(farm, &game), "farm is full");
+
+    game_farm_submit(farm, id, "north");
+    game_farm_submit(farm, id, "quit");
+    game_farm_submit(farm, id, "south");
+    game_farm_drain(farm);
+
+    ASSERT_TRUE(game_farm_finished(farm, id), "game finished");
+    ASSERT_FALSE(game_farm_submit(farm, id, "look"), "input refused after quit");
+    ASSERT_EQ(1, game.world.current_room, "south never ran");
+    ASSERT_EQ(1, game.turns, "one turn");
+
+    game_farm_destroy(farm);
+    game_free(&game);
+    world_free(&base);
+    PASS();
+}
+
+// Helper: Output sink slow enough that a game's queue takes a while
+static void slow_output(void *ctx, const char *text, OutputStyle style) {
+    (void)ctx;
+    (void)text;
+    (void)style;
+    struct timespec pause = { 0, 500 * 1000 };
+    nanosleep(&pause, NULL);
+}
+
+static double seconds(clockid_t clock) {
+    struct timespec now;
+    clock_gettime(clock, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+// Test workers with nothing to run sleep while another worker works
+// through one game's long queue, instead of spinning on it
+void test_idle_workers_sleep(void) {
+    TEST("Idle workers sleep during a long queue");
+
+    World base;
+    build_world(&base);
+    OutputSink sink = { slow_output, NULL };
+    Game game;
+    game_init(&game, &sink);
+    game_open_shared(&game, &base, "test");
+    game_start(&game);
+
+    GameFarm *farm = game_farm_create(WORKERS, 1);
+    ASSERT_TRUE(farm != NULL, "farm created");
+    int id = game_farm_add(farm, &game);
+    double wall = seconds(CLOCK_MONOTONIC);
+    double cpu = seconds(CLOCK_PROCESS_CPUTIME_ID);
+    for (int n = 0; n < FARM_QUEUE_LINES; n++) {
+        ASSERT_TRUE(game_farm_submit(farm, id, "look"), "line queued");
+    }
+    game_farm_drain(farm);
+    wall = seconds(CLOCK_MONOTONIC) - wall;
+    cpu = seconds(CLOCK_PROCESS_CPUTIME_ID) - cpu;
+
+    // Spinning workers would burn WORKERS - 1 cores for the whole queue
+    char msg[128];
+    snprintf(msg, sizeof(msg), "workers busy while idle (%.0f ms CPU in %.0f ms)",
+             cpu * 1e3, wall * 1e3);
+    ASSERT_TRUE(wall > 0.05, "queue took long enough to measure");
+    ASSERT_TRUE(cpu < wall / 2, msg);
+    ASSERT_EQ(FARM_QUEUE_LINES, game.turns, "every line ran");
+
+    game_farm_destroy(farm);
+    game_free(&game);
+    world_free(&base);
+    PASS();
+}
+
+// Main test runner
+int main(void) {
+    printf("\n=== Game Farm Test Suite ===\n\n");
+
+    test_matches_serial();
+    test_quit();
+    test_idle_workers_sleep();
+
+    printf("\n=== Test Results ===\n");
+    printf("  Passed: %d\n", tests_passed);
+    printf("  Failed: %d\n", tests_failed);
+    printf("  Total:  %d\n", tests_passed + tests_failed);
+
+    if (tests_failed == 0) {
+        printf("\n✓ All tests passed!\n\n");
+        return 0;
+    } else {
+        printf("\n✗ Some tests failed!\n\n");
+        return 1;
+    }
+}
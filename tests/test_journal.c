@@ -0,0 +1,236 @@
+/*
+ * Test Suite for World Journal
+ * Tests turn-by-turn undo/redo of world mutations
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/world.h"
+#include "../include/world_journal.h"
+
+// Test counter
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name) \
+    printf("  Testing: %s ... ", name); \
+    fflush(stdout);
+
+#define PASS() \
+    do { \
+        printf("✓ PASS\n"); \
+        tests_passed++; \
+    } while(0)
+
+#define FAIL(msg) \
+    do { \
+        printf("✗ FAIL: %s\n", msg); \
+        tests_failed++; \
+    } while(0)
+
+#define ASSERT_TRUE(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_FALSE(cond, msg) \
+    do { \
+        if (cond) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(expected, actual, msg) \
+    do { \
+        if ((expected) != (actual)) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: %d, got: %d)", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_STR_EQ(expected, actual, msg) \
+    do { \
+        if (strcmp(expected, actual) != 0) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: '%.128s', got: '%.128s')", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_NOT_NULL(ptr, msg) \
+    do { \
+        if (ptr == NULL) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_NULL(ptr, msg) \
+    do { \
+        if (ptr != NULL) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+// Helper: Hall with a locked door north to a vault; key, lamp and rope in the hall
+static void build_world(World *world) {
+    world_init(world);
+    int hall = world_add_room(world, "hall", "Hall", "A hall.");
+    int vault = world_add_room(world, "vault", "Vault", "A vault.");
+    world_connect_rooms(world, hall, DIR_NORTH, vault);
+    world_connect_rooms(world, vault, DIR_SOUTH, hall);
+    world_lock_exit(world, hall, DIR_NORTH, "key");
+    world_place_item(world, world_add_item(world, "key", "key", "A key.", true), hall);
+    world_place_item(world, world_add_item(world, "lamp", "lamp", "A lamp.", true), hall);
+    world_place_item(world, world_add_item(world, "rope", "rope", "A rope.", true), hall);
+    world->current_room = hall;
+}
+
+// Test undoing a turn restores locations, list order, room and flags
+void test_undo_turn(void) {
+    TEST("Undo a turn");
+
+    World world;
+    build_world(&world);
+    WorldJournal journal;
+    ASSERT_TRUE(world_journal_init(&journal, 64), "journal init");
+    world.journal = &journal;
+
+    world_journal_begin_turn(&journal);
+    ASSERT_TRUE(world_take_item(&world, "lamp"), "take lamp");
+    ASSERT_TRUE(world_take_item(&world, "key"), "take key");
+    ASSERT_TRUE(world_move(&world, DIR_NORTH), "unlock and move north");
+    world_set_item_used(&world, 1, true);
+    ASSERT_TRUE(world_remove_from_inventory(&world, "lamp"), "consume lamp");
+
+    ASSERT_TRUE(world_journal_undo(&world), "undo should succeed");
+    ASSERT_EQ(0, world.current_room, "back in hall");
+    ASSERT_FALSE(world_exit_unlocked(&world, 0, DIR_NORTH), "door locked again");
+    ASSERT_FALSE(world_room_visited(&world, 1), "vault not visited");
+    ASSERT_FALSE(world_item_used(&world, 1), "lamp not used");
+    ASSERT_EQ(0, world.inventory_count, "inventory empty");
+
+    // Items are back in their original order
+    int order[3], count = 0;
+    for (int i = world_first_item(&world, 0); i != -1; i = world_next_item(&world, i)) {
+        if (count < 3) order[count] = i;
+        count++;
+    }
+    ASSERT_EQ(3, count, "three items in hall");
+    ASSERT_TRUE(order[0] == 0 && order[1] == 1 && order[2] == 2, "hall order restored");
+
+    ASSERT_FALSE(world_journal_undo(&world), "nothing left to undo");
+
+    world_journal_free(&journal);
+    world_free(&world);
+    PASS();
+}
+
+// Test redo replays an undone turn until a new turn is recorded
+void test_redo(void) {
+    TEST("Redo after undo");
+
+    World world;
+    build_world(&world);
+    WorldJournal journal;
+    ASSERT_TRUE(world_journal_init(&journal, 64), "journal init");
+    world.journal = &journal;
+
+    world_journal_begin_turn(&journal);
+    ASSERT_TRUE(world_take_item(&world, "key"), "take key");
+    world_journal_begin_turn(&journal);
+    ASSERT_TRUE(world_move(&world, DIR_NORTH), "move north");
+
+    ASSERT_TRUE(world_journal_undo(&world), "undo move");
+    ASSERT_TRUE(world_journal_undo(&world), "undo take");
+    ASSERT_TRUE(world_journal_redo(&world), "redo take");
+    ASSERT_TRUE(world_has_item(&world, "key"), "key carried again");
+    ASSERT_EQ(0, world.current_room, "move not redone yet");
+    ASSERT_TRUE(world_journal_redo(&world), "redo move");
+    ASSERT_EQ(1, world.current_room, "in vault again");
+    ASSERT_TRUE(world_exit_unlocked(&world, 0, DIR_NORTH), "door unlocked again");
+    ASSERT_FALSE(world_journal_redo(&world), "nothing left to redo");
+
+    // A new change after undo discards the redo history
+    ASSERT_TRUE(world_journal_undo(&world), "undo move again");
+    world_journal_begin_turn(&journal);
+    ASSERT_TRUE(world_drop_item(&world, "key"), "drop key");
+    ASSERT_FALSE(world_journal_redo(&world), "redo history dropped");
+
+    // Turns that change nothing are not recorded
+    world_journal_begin_turn(&journal);
+    ASSERT_TRUE(world_journal_undo(&world), "undo drop");
+    ASSERT_TRUE(world_has_item(&world, "key"), "key carried after undoing drop");
+
+    world_journal_free(&journal);
+    world_free(&world);
+    PASS();
+}
+
+// Test the journal keeps only recent turns in its fixed buffer
+void test_bounded(void) {
+    TEST("Journal is bounded");
+
+    World world;
+    build_world(&world);
+    world_unlock_exit(&world, 0, DIR_NORTH);
+    WorldJournal journal;
+    ASSERT_TRUE(world_journal_init(&journal, 16), "journal init");
+    world.journal = &journal;
+    JournalRecord *records = journal.records;
+
+    // Each round trip records a marker and a room change per turn
+    for (int i = 0; i < 100; i++) {
+        world_journal_begin_turn(&journal);
+        ASSERT_TRUE(world_move(&world, i % 2 == 0 ? DIR_NORTH : DIR_SOUTH), "move");
+    }
+    ASSERT_TRUE(journal.records == records, "buffer should be reused");
+    ASSERT_TRUE(journal.cursor - journal.first <= 16, "journal stays within capacity");
+
+    int undone = 0;
+    while (world_journal_undo(&world)) undone++;
+    ASSERT_TRUE(undone >= 6 && undone <= 8, "only recent turns kept");
+    ASSERT_EQ((100 - undone) % 2, world.current_room, "position matches remaining turns");
+
+    // A turn larger than the whole buffer cannot be undone
+    world_journal_begin_turn(&journal);
+    for (int i = 0; i < 20; i++) {
+        world_set_item_used(&world, i % 3, i % 2 == 0);
+    }
+    ASSERT_FALSE(world_journal_undo(&world), "oversized turn is not undoable");
+
+    world_journal_free(&journal);
+    world_free(&world);
+    PASS();
+}
+
+// Main test runner
+int main(void) {
+    printf("\n=== World Journal Test Suite ===\n\n");
+
+    test_undo_turn();
+    test_redo();
+    test_bounded();
+
+    printf("\n=== Test Results ===\n");
+    printf("  Passed: %d\n", tests_passed);
+    printf("  Failed: %d\n", tests_failed);
+    printf("  Total:  %d\n", tests_passed + tests_failed);
+
+    if (tests_failed == 0) {
+        printf("\n✓ All tests passed!\n\n");
+        return 0;
+    } else {
+        printf("\n✗ Some tests failed!\n\n");
+        return 1;
+    }
+}
@@ -26,16 +26,17 @@ void test_locked_exits_init(void) {
 
     // All locked_exits should be empty strings
     for (int i = 0; i < DIR_COUNT; i++) {
-        if (world.rooms[room_idx].locked_exits[i][0] != '\0') {
+        if (world_exit_key(&world, room_idx, (Direction)i) != NULL) {
             FAIL("locked_exits should initialize to empty");
             return;
         }
-        if (world.rooms[room_idx].exit_unlocked[i] != false) {
+        if (world_exit_unlocked(&world, room_idx, (Direction)i) != false) {
             FAIL("exit_unlocked should initialize to false");
             return;
         }
     }
 
+    world_free(&world);
     PASS();
 }
 
@@ -57,12 +58,14 @@ void test_lock_exit(void) {
     world_lock_exit(&world, room1, DIR_NORTH, "iron_key");
 
     // Verify lock was set
-    if (strcmp(world.rooms[room1].locked_exits[DIR_NORTH], "iron_key") != 0) {
+    const char *key_id = world_exit_key(&world, room1, DIR_NORTH);
+    if (!key_id || strcmp(key_id, "iron_key") != 0) {
         FAIL("locked_exits should contain key ID");
         return;
     }
 
     (void)key; // Unused variable
+    world_free(&world);
     PASS();
 }
 
@@ -102,6 +105,7 @@ void test_locked_exit_blocks_movement(void) {
         return;
     }
 
+    world_free(&world);
     PASS();
 }
 
@@ -122,7 +126,7 @@ void test_locked_exit_with_key(void) {
     world.current_room = room1;
 
     // Put key in inventory
-    world.inventory[0] = key;
+    world_set_item_location(&world, key, ITEM_IN_INVENTORY);
 
     // Try to move with key - should succeed
     char key_needed[32];
@@ -139,6 +143,7 @@ void test_locked_exit_with_key(void) {
         return;
     }
 
+    world_free(&world);
     PASS();
 }
 
@@ -158,7 +163,7 @@ void test_exit_stays_unlocked(void) {
     world_lock_exit(&world, room1, DIR_NORTH, "iron_key");
 
     world.current_room = room1;
-    world.inventory[0] = key;
+    world_set_item_location(&world, key, ITEM_IN_INVENTORY);
 
     // First move - unlocks the door
     world_move_ex(&world, DIR_NORTH, NULL, 0);
@@ -167,7 +172,7 @@ void test_exit_stays_unlocked(void) {
     world_move(&world, DIR_SOUTH);
 
     // Drop the key
-    world.inventory[0] = -1;
+    world_set_item_location(&world, key, ITEM_NOWHERE);
 
     // Try to go north again without key - should still work
     char key_needed[32];
@@ -178,6 +183,7 @@ void test_exit_stays_unlocked(void) {
         return;
     }
 
+    world_free(&world);
     PASS();
 }
 
@@ -216,6 +222,7 @@ void test_exit_is_locked(void) {
         return;
     }
 
+    world_free(&world);
     PASS();
 }
 
@@ -252,6 +259,7 @@ void test_get_required_key(void) {
         return;
     }
 
+    world_free(&world);
     PASS();
 }
 
@@ -278,12 +286,97 @@ void test_world_move_compatibility(void) {
     }
 
     // With key - should succeed
-    world.inventory[0] = key;
+    world_set_item_location(&world, key, ITEM_IN_INVENTORY);
     if (!world_move(&world, DIR_NORTH)) {
         FAIL("world_move should return true when key present");
         return;
     }
 
+    world_free(&world);
+    PASS();
+}
+
+// Test: Keys are indexed by item, including keys defined after the lock
+void test_unlock_with_key(void) {
+    TEST("Unlock exits by key");
+
+    World world;
+    world_init(&world);
+
+    int hall = world_add_room(&world, "hall", "Hall", "A hall.");
+    int vault = world_add_room(&world, "vault", "Vault", "A vault.");
+    int cellar = world_add_room(&world, "cellar", "Cellar", "A cellar.");
+
+    world_connect_rooms(&world, vault, DIR_UP, hall);
+    world_lock_exit(&world, vault, DIR_UP, "brass_key");
+    world_connect_rooms(&world, hall, DIR_NORTH, vault);
+    world_connect_rooms(&world, hall, DIR_DOWN, cellar);
+    world_lock_exit(&world, hall, DIR_NORTH, "brass_key");
+    world_lock_exit(&world, hall, DIR_DOWN, "brass_key");
+    int key = world_add_item(&world, "brass_key", "brass key", "A brass key.", true);
+
+    // Exits were renumbered by the inserts; the index follows them
+    const int32_t *exits;
+    if (world_key_exits(&world, key, &exits) != 3) {
+        FAIL("key should open three exits");
+        return;
+    }
+    if (exits[0] != world_direction_exit(&world, hall, DIR_NORTH) ||
+        exits[2] != world_direction_exit(&world, vault, DIR_UP)) {
+        FAIL("key exits should be in exit order");
+        return;
+    }
+
+    // Only the current room's doors open
+    if (world_unlock_with_key(&world, key, hall) != 2) {
+        FAIL("should unlock both hall exits");
+        return;
+    }
+    if (world_exit_is_locked(&world, DIR_NORTH) || world_exit_open(&world, exits[2])) {
+        FAIL("hall exits open, vault exit still locked");
+        return;
+    }
+    if (world_unlock_with_key(&world, key, hall) != 0) {
+        FAIL("unlocking again should do nothing");
+        return;
+    }
+    if (world_unlock_with_key(&world, key, -1) != 1 || !world_exit_open(&world, exits[2])) {
+        FAIL("every room should unlock the vault exit");
+        return;
+    }
+
+    world_free(&world);
+    PASS();
+}
+
+// Test: A lock naming no item can never be opened
+void test_unknown_key(void) {
+    TEST("Lock with unknown key");
+
+    World world;
+    world_init(&world);
+
+    int room1 = world_add_room(&world, "room1", "Room 1", "First room.");
+    int room2 = world_add_room(&world, "room2", "Room 2", "Second room.");
+    int other = world_add_item(&world, "other_key", "other key", "Some key.", true);
+
+    world_connect_rooms(&world, room1, DIR_NORTH, room2);
+    world_lock_exit(&world, room1, DIR_NORTH, "lost_key");
+    world_set_item_location(&world, other, ITEM_IN_INVENTORY);
+    world.current_room = room1;
+
+    char key_needed[32];
+    if (world_move_ex(&world, DIR_NORTH, key_needed, sizeof(key_needed)) != MOVE_LOCKED ||
+        strcmp(key_needed, "lost_key") != 0) {
+        FAIL("exit should stay locked and name its key");
+        return;
+    }
+    if (world_unlock_with_key(&world, other, room1) != 0) {
+        FAIL("other key should not unlock it");
+        return;
+    }
+
+    world_free(&world);
     PASS();
 }
 
@@ -298,6 +391,8 @@ int main(void) {
     test_exit_is_locked();
     test_get_required_key();
     test_world_move_compatibility();
+    test_unlock_with_key();
+    test_unknown_key();
 
     printf("\n=== Test Results ===\n");
     printf("  Passed: %d\n", passed);
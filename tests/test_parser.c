@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <stdbool.h>
 #include "../include/parser.h"
 
 // Test counter
@@ -29,6 +30,22 @@ static int tests_failed = 0;
         tests_failed++; \
     } while(0)
 
+#define ASSERT_TRUE(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_FALSE(cond, msg) \
+    do { \
+        if (cond) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
 #define ASSERT_STR_EQ(expected, actual, msg) \
     do { \
         if (strcmp(expected, actual) != 0) { \
@@ -223,6 +240,56 @@ void test_special_commands(void) {
     PASS();
 }
 
+// Helper: Check a token holds exactly the given text
+static bool token_eq(Token token, const char *text) {
+    return token.len == strlen(text) && strncmp(token.text, text, token.len) == 0;
+}
+
+// Test splitting a line into several commands without copying
+void test_command_chains(void) {
+    TEST("Command chains");
+
+    const char *line = "  Take Rusty key,north THEN  look around ,, then, go through the mirror";
+    const char *rest = line;
+    CommandView cmd;
+
+    ASSERT_TRUE(parse_next_command(&rest, &cmd), "first command");
+    ASSERT_TRUE(token_eq(cmd.verb, "Take"), "verb as typed");
+    ASSERT_TRUE(token_eq(cmd.noun, "Rusty key"), "multi-word noun");
+    ASSERT_TRUE(token_eq(cmd.text, "Take Rusty key"), "whole command");
+    ASSERT_TRUE(cmd.verb.text == line + 2, "verb points into the line");
+
+    ASSERT_TRUE(parse_next_command(&rest, &cmd), "comma separates");
+    ASSERT_TRUE(token_eq(cmd.verb, "north"), "second verb");
+    ASSERT_TRUE(cmd.noun.len == 0, "no noun");
+
+    ASSERT_TRUE(parse_next_command(&rest, &cmd), "then separates (any case)");
+    ASSERT_TRUE(token_eq(cmd.text, "look around"), "third command");
+
+    ASSERT_TRUE(parse_next_command(&rest, &cmd), "empty commands skipped");
+    ASSERT_TRUE(token_eq(cmd.verb, "go"), "fourth verb");
+    ASSERT_TRUE(token_eq(cmd.noun, "through the mirror"), "fourth noun");
+    ASSERT_FALSE(parse_next_command(&rest, &cmd), "end of line");
+    ASSERT_FALSE(parse_next_command(&rest, &cmd), "stays at the end");
+
+    // "then" only separates as a word of its own
+    rest = "examine thenardier's hat";
+    ASSERT_TRUE(parse_next_command(&rest, &cmd), "word starting with then");
+    ASSERT_TRUE(token_eq(cmd.noun, "thenardier's hat"), "kept in the noun");
+    ASSERT_FALSE(parse_next_command(&rest, &cmd), "one command");
+
+    rest = " , then ,";
+    ASSERT_FALSE(parse_next_command(&rest, &cmd), "separators only");
+
+    char lower[8];
+    rest = "INVENTORY please";
+    ASSERT_TRUE(parse_next_command(&rest, &cmd), "command to copy");
+    token_copy(cmd.text, lower, sizeof(lower));
+    ASSERT_STR_EQ("invento", lower, "copy lowercased and truncated");
+
+    PASS();
+}
+
 // Main test runner
 int main(void) {
     printf("\n=== Parser Test Suite ===\n\n");
@@ -235,6 +302,7 @@ int main(void) {
     test_empty_invalid_input();
     test_direction_shortcuts();
     test_special_commands();
+    test_command_chains();
 
     printf("\n=== Test Results ===\n");
     printf("  Passed: %d\n", tests_passed);
@@ -0,0 +1,282 @@
+/*
+ * Test Suite for Session Recordings
+ * Tests recording a game, seeking to any turn from the nearest keyframe
+ * and reading recordings that were never closed
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/recording.h"
+#include "../include/save_load.h"
+#include "../include/world_snapshot.h"
+
+// Test counter
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name) \
+    printf("  Testing: %s ... ", name); \
+    fflush(stdout);
+
+#define PASS() \
+    do { \
+        printf("✓ PASS\n"); \
+        tests_passed++; \
+    } while(0)
+
+#define FAIL(msg) \
+    do { \
+        printf("✗ FAIL: %s\n", msg); \
+        tests_failed++; \
+    } while(0)
+
+#define ASSERT_TRUE(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_FALSE(cond, msg) \
+    do { \
+        if (cond) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(expected, actual, msg) \
+    do { \
+        if ((expected) != (actual)) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: %d, got: %d)", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_STR_EQ(expected, actual, msg) \
+    do { \
+        if (strcmp(expected, actual) != 0) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: '%.128s', got: '%.128s')", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+
+#define RECORDING_PATH "/tmp/adventure-test-recording.rec"
+#define INTERVAL 4
+
+// A walk through the tower with undo and redo, which recordings keep as
+// state rather than rerun
+static const char *const script[] = {
+    "take key", "north", "take torch", "look", "east", "inventory", "take gem",
+    "undo", "redo", "west", "drop torch", "undo", "south", "drop key", "xyzzy",
+    "north", "east", "drop gem", "west", "take statue", "south", "redo", "look"
+};
+#define SCRIPT_LEN ((int)(sizeof(script) / sizeof(script[0])))
+
+// Helper: Start a game of dark_tower (false if the world won't load)
+static bool start_game(Game *game, Recorder *recorder) {
+    LoadError error;
+    game_init(game, NULL);
+    game->recorder = recorder;
+    if (!game_open(game, "dark_tower", &error)) return false;
+    game_start(game);
+    return true;
+}
+
+// Helper: Play the script while recording, keeping the state hash after
+// each command (hashes[0] is the start)
+static bool record_script(Recorder *recorder, uint64_t hashes[SCRIPT_LEN + 1], int commands) {
+    Game game;
+    if (!recorder_open(recorder, RECORDING_PATH, INTERVAL) || !start_game(&game, recorder)) {
+        return false;
+    }
+    hashes[0] = world_state_hash(&game.world);
+    for (int i = 0; i < commands; i++) {
+        game_command(&game, script[i]);
+        hashes[i + 1] = world_state_hash(&game.world);
+    }
+    game_free(&game);
+    return true;
+}
+
+// Test every turn of a closed recording comes back exactly
+void test_seek(void) {
+    TEST("Seek to every turn");
+
+    Recorder recorder;
+    uint64_t hashes[SCRIPT_LEN + 1];
+    ASSERT_TRUE(record_script(&recorder, hashes, SCRIPT_LEN), "record script");
+    ASSERT_TRUE(recorder_close(&recorder), "close recording");
+
+    Recording recording;
+    ASSERT_TRUE(recording_open(&recording, RECORDING_PATH), "open recording");
+    ASSERT_TRUE(recording.indexed, "index read from trailer");
+    ASSERT_STR_EQ("dark_tower", recording.world_name, "world name");
+    ASSERT_EQ(SCRIPT_LEN, recording.turns, "turns recorded");
+    // Start, every INTERVAL replayable commands, and each undo/redo
+    ASSERT_TRUE(recording.keyframe_count >= 1 + SCRIPT_LEN / INTERVAL, "keyframes written");
+
+    Game viewer;
+    ASSERT_TRUE(start_game(&viewer, NULL), "viewer game");
+
+    // Stepping forward one turn at a time
+    for (int t = 0; t <= SCRIPT_LEN; t++) {
+        ASSERT_TRUE(recording_seek(&recording, &viewer, t), "step forward");
+        if (world_state_hash(&viewer.world) != hashes[t]) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "state differs after stepping to turn %d", t);
+            FAIL(msg);
+            return;
+        }
+    }
+
+    // Jumping backwards and across keyframes
+    const int jumps[] = { 3, SCRIPT_LEN, 0, 9, 8, 12, 21, 1, 17 };
+    for (size_t j = 0; j < sizeof(jumps) / sizeof(jumps[0]); j++) {
+        ASSERT_TRUE(recording_seek(&recording, &viewer, jumps[j]), "jump");
+        if (world_state_hash(&viewer.world) != hashes[jumps[j]]) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "state differs after jumping to turn %d", jumps[j]);
+            FAIL(msg);
+            return;
+        }
+    }
+    ASSERT_FALSE(recording_seek(&recording, &viewer, SCRIPT_LEN + 1), "past the end rejected");
+
+    game_free(&viewer);
+    recording_close(&recording);
+    remove(RECORDING_PATH);
+    PASS();
+}
+
+// Test a recording still being written (or left by a crash) can be read
+// up to its last keyframe flush
+void test_unclosed(void) {
+    TEST("Read unclosed recording");
+
+    Recorder recorder;
+    uint64_t hashes[SCRIPT_LEN + 1];
+    ASSERT_TRUE(record_script(&recorder, hashes, 6), "record six commands");
+
+    // Commands 1-4 were flushed with the keyframe after them
+    Recording recording;
+    ASSERT_TRUE(recording_open(&recording, RECORDING_PATH), "open unclosed recording");
+    ASSERT_FALSE(recording.indexed, "index rebuilt by scanning");
+    ASSERT_EQ(INTERVAL, recording.turns, "turns up to the last flush");
+
+    Game viewer;
+    ASSERT_TRUE(start_game(&viewer, NULL), "viewer game");
+    ASSERT_TRUE(recording_seek(&recording, &viewer, INTERVAL), "seek to last turn");
+    ASSERT_TRUE(world_state_hash(&viewer.world) == hashes[INTERVAL], "state matches");
+
+    game_free(&viewer);
+    recording_close(&recording);
+    ASSERT_TRUE(recorder_close(&recorder), "close recording");
+    remove(RECORDING_PATH);
+    PASS();
+}
+
+// Test each command of a chained line is a turn of its own
+void test_chained_line(void) {
+    TEST("Chained line recorded per command");
+
+    Recorder recorder;
+    Game game;
+    ASSERT_TRUE(recorder_open(&recorder, RECORDING_PATH, INTERVAL), "open recorder");
+    ASSERT_TRUE(start_game(&game, &recorder), "game");
+    game_command(&game, "take key, north then undo");
+    game_free(&game);
+    ASSERT_TRUE(recorder_close(&recorder), "close recording");
+
+    // The same commands one per line
+    Game expected;
+    ASSERT_TRUE(start_game(&expected, NULL), "expected game");
+    game_command(&expected, "take key");
+    uint64_t after_take = world_state_hash(&expected.world);
+    game_command(&expected, "north");
+    game_command(&expected, "undo");
+    uint64_t after_undo = world_state_hash(&expected.world);
+
+    Recording recording;
+    Game viewer;
+    ASSERT_TRUE(recording_open(&recording, RECORDING_PATH), "open recording");
+    ASSERT_EQ(3, recording.turns, "three turns");
+    ASSERT_TRUE(start_game(&viewer, NULL), "viewer game");
+    ASSERT_TRUE(recording_seek(&recording, &viewer, 1), "seek to first command");
+    ASSERT_TRUE(world_state_hash(&viewer.world) == after_take, "state after first command");
+    ASSERT_TRUE(recording_seek(&recording, &viewer, 3), "seek to end");
+    ASSERT_TRUE(world_state_hash(&viewer.world) == after_undo, "state after undo");
+
+    game_free(&expected);
+    game_free(&viewer);
+    recording_close(&recording);
+    remove(RECORDING_PATH);
+    PASS();
+}
+
+// Test keyframe state is checked against the world it is applied to
+void test_state_codec(void) {
+    TEST("Keyframe state encoding");
+
+    Game game;
+    ASSERT_TRUE(start_game(&game, NULL), "game");
+    game_command(&game, "take key");
+    game_command(&game, "north");
+
+    unsigned char *buffer = malloc(save_state_max_size(&game.world));
+    ASSERT_TRUE(buffer != NULL, "buffer");
+    size_t size = save_state_encode(&game.world, buffer);
+    uint64_t hash = world_state_hash(&game.world);
+
+    Game other;
+    ASSERT_TRUE(start_game(&other, NULL), "second game");
+    ASSERT_FALSE(save_state_decode(&other.world, buffer, size - 1), "truncated state rejected");
+    ASSERT_TRUE(save_state_decode(&other.world, buffer, size), "state applies");
+    ASSERT_TRUE(world_state_hash(&other.world) == hash, "state comes back exactly");
+    ASSERT_TRUE(world_has_item(&other.world, "key"), "key carried");
+
+    // A world with another layout refuses it
+    Game small;
+    LoadError error;
+    game_init(&small, NULL);
+    ASSERT_TRUE(game_open(&small, "puzzle_test", &error), "other world");
+    ASSERT_FALSE(save_state_decode(&small.world, buffer, size), "other layout rejected");
+
+    free(buffer);
+    game_free(&game);
+    game_free(&other);
+    game_free(&small);
+    PASS();
+}
+
+// Main test runner
+int main(void) {
+    printf("\n=== Session Recording Test Suite ===\n\n");
+
+    test_seek();
+    test_unclosed();
+    test_chained_line();
+    test_state_codec();
+
+    printf("\n=== Test Results ===\n");
+    printf("  Passed: %d\n", tests_passed);
+    printf("  Failed: %d\n", tests_failed);
+    printf("  Total:  %d\n", tests_passed + tests_failed);
+
+    if (tests_failed == 0) {
+        printf("\n✓ All tests passed!\n\n");
+        return 0;
+    } else {
+        printf("\n✗ Some tests failed!\n\n");
+        return 1;
+    }
+}
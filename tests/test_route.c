@@ -0,0 +1,264 @@
+/*
+ * Test Suite for World Routes
+ * Tests shortest-path travel and its updates as exits open and close
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/world.h"
+#include "../include/world_journal.h"
+#include "../include/world_route.h"
+
+// Test counter
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name) \
+    printf("  Testing: %s ... ", name); \
+    fflush(stdout);
+
+#define PASS() \
+    do { \
+        printf("✓ PASS\n"); \
+        tests_passed++; \
+    } while(0)
+
+#define FAIL(msg) \
+    do { \
+        printf("✗ FAIL: %s\n", msg); \
+        tests_failed++; \
+    } while(0)
+
+#define ASSERT_TRUE(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_FALSE(cond, msg) \
+    do { \
+        if (cond) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(expected, actual, msg) \
+    do { \
+        if ((expected) != (actual)) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: %d, got: %d)", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_STR_EQ(expected, actual, msg) \
+    do { \
+        if (strcmp(expected, actual) != 0) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: '%.128s', got: '%.128s')", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_NOT_NULL(ptr, msg) \
+    do { \
+        if (ptr == NULL) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_NULL(ptr, msg) \
+    do { \
+        if (ptr != NULL) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+// Helper: Corridor a-b-c-d running east, plus a door north from a to d
+// locked with "key"; one-way drop from d down to a
+static void build_corridor(World *world) {
+    world_init(world);
+    const char *ids[] = {"a", "b", "c", "d"};
+    for (int i = 0; i < 4; i++) {
+        world_add_room(world, ids[i], ids[i], "A room.");
+    }
+    for (int i = 0; i < 3; i++) {
+        world_connect_rooms(world, i, DIR_EAST, i + 1);
+        world_connect_rooms(world, i + 1, DIR_WEST, i);
+    }
+    world_connect_rooms(world, 0, DIR_NORTH, 3);
+    world_lock_exit(world, 0, DIR_NORTH, "key");
+    world_connect_rooms(world, 3, DIR_DOWN, 0);
+}
+
+// Helper: Distance from a fresh route table (reference for cached ones)
+static int fresh_distance(World *world, int from, int target) {
+    WorldRoutes *cached = world->routes;
+    WorldRoutes fresh;
+    int moves = 0;
+    if (world_routes_init(&fresh, world)) {
+        world->routes = &fresh;
+        if (world_route_next(world, from, target, &moves) == -1 && from != target) moves = -1;
+        world_routes_free(&fresh);
+    }
+    world->routes = cached;
+    return moves;
+}
+
+// Test paths follow open exits only
+void test_shortest_path(void) {
+    TEST("Shortest path over open exits");
+
+    World world;
+    build_corridor(&world);
+    WorldRoutes routes;
+    ASSERT_TRUE(world_routes_init(&routes, &world), "routes init");
+    world.routes = &routes;
+
+    int moves = 0;
+    ASSERT_EQ(world_direction_exit(&world, 0, DIR_EAST), world_route_next(&world, 0, 3, &moves),
+              "locked door is avoided");
+    ASSERT_EQ(3, moves, "three moves along the corridor");
+    ASSERT_EQ(world_direction_exit(&world, 3, DIR_DOWN), world_route_next(&world, 3, 0, &moves),
+              "one-way drop is used");
+    ASSERT_EQ(1, moves, "one move down");
+    ASSERT_EQ(-1, world_route_next(&world, 2, 2, &moves), "already there");
+    ASSERT_EQ(0, moves, "no moves when already there");
+
+    // Walking the path reaches the target
+    world.current_room = 0;
+    int steps = 0;
+    for (int exit; (exit = world_route_next(&world, world.current_room, 3, NULL)) != -1; steps++) {
+        ASSERT_EQ(MOVE_SUCCESS, world_move_exit(&world, exit, NULL, 0), "path move succeeds");
+    }
+    ASSERT_EQ(3, world.current_room, "arrived");
+    ASSERT_EQ(3, steps, "took three steps");
+
+    world_routes_free(&routes);
+    world_free(&world);
+    PASS();
+}
+
+// Test unlocking shortens cached paths and undo restores them
+void test_unlock_updates(void) {
+    TEST("Unlocking updates cached paths");
+
+    World world;
+    build_corridor(&world);
+    WorldRoutes routes;
+    ASSERT_TRUE(world_routes_init(&routes, &world), "routes init");
+    world.routes = &routes;
+    WorldJournal journal;
+    ASSERT_TRUE(world_journal_init(&journal, 16), "journal init");
+    world.journal = &journal;
+
+    int moves = 0;
+    world_route_next(&world, 0, 3, &moves);
+    ASSERT_EQ(3, moves, "corridor before unlocking");
+
+    world_journal_begin_turn(&journal);
+    world_unlock_exit(&world, 0, DIR_NORTH);
+    ASSERT_EQ(world_direction_exit(&world, 0, DIR_NORTH), world_route_next(&world, 0, 3, &moves),
+              "door is used once open");
+    ASSERT_EQ(1, moves, "one move through the door");
+
+    ASSERT_TRUE(world_journal_undo(&world), "undo unlock");
+    ASSERT_EQ(world_direction_exit(&world, 0, DIR_EAST), world_route_next(&world, 0, 3, &moves),
+              "corridor again after undo");
+    ASSERT_EQ(3, moves, "three moves after undo");
+
+    world_journal_free(&journal);
+    world_routes_free(&routes);
+    world_free(&world);
+    PASS();
+}
+
+// Test incremental updates match fresh tables on a maze of locked doors
+void test_incremental_matches_fresh(void) {
+    TEST("Incremental updates match full rebuilds");
+
+    const int width = 16;
+    const int n = width * width;
+    World world;
+    world_init(&world);
+    char id[16];
+    for (int i = 0; i < n; i++) {
+        snprintf(id, sizeof(id), "r%d", i);
+        world_add_room(&world, id, id, "A room.");
+    }
+
+    // Grid with about a third of the exits locked
+    unsigned int seed = 7;
+    for (int i = 0; i < n; i++) {
+        int x = i % width;
+        int next[DIR_COUNT] = {
+            i >= width ? i - width : -1, i + width < n ? i + width : -1,
+            x + 1 < width ? i + 1 : -1, x > 0 ? i - 1 : -1, -1, -1
+        };
+        for (int d = 0; d < DIR_COUNT; d++) {
+            if (next[d] == -1) continue;
+            world_connect_rooms(&world, i, (Direction)d, next[d]);
+            seed = seed * 1103515245u + 12345u;
+            if ((seed >> 16) % 3 == 0) world_lock_exit(&world, i, (Direction)d, "key");
+        }
+    }
+
+    WorldRoutes routes;
+    ASSERT_TRUE(world_routes_init(&routes, &world), "routes init");
+    world.routes = &routes;
+
+    // Keep a few targets cached while doors open one at a time
+    const int targets[] = {0, n / 2, n - 1};
+    for (int step = 0; step < 200; step++) {
+        for (int t = 0; t < 3; t++) {
+            world_route_next(&world, 0, targets[t], NULL);
+        }
+        seed = seed * 1103515245u + 12345u;
+        world_unlock_exit(&world, (int)((seed >> 8) % (unsigned)n), (Direction)((seed >> 4) % 4));
+
+        for (int t = 0; t < 3; t++) {
+            for (int from = 0; from < n; from += 17) {
+                int moves = 0;
+                if (world_route_next(&world, from, targets[t], &moves) == -1 && from != targets[t]) {
+                    moves = -1;
+                }
+                ASSERT_EQ(fresh_distance(&world, from, targets[t]), moves,
+                          "cached distance matches a fresh search");
+            }
+        }
+    }
+
+    world_routes_free(&routes);
+    world_free(&world);
+    PASS();
+}
+
+// Main test runner
+int main(void) {
+    printf("\n=== World Route Test Suite ===\n\n");
+
+    test_shortest_path();
+    test_unlock_updates();
+    test_incremental_matches_fresh();
+
+    printf("\n=== Test Results ===\n");
+    printf("  Passed: %d\n", tests_passed);
+    printf("  Failed: %d\n", tests_failed);
+    printf("  Total:  %d\n", tests_passed + tests_failed);
+
+    if (tests_failed == 0) {
+        printf("\n✓ All tests passed!\n\n");
+        return 0;
+    } else {
+        printf("\n✗ Some tests failed!\n\n");
+        return 1;
+    }
+}
@@ -10,6 +10,7 @@
 #include <sys/stat.h>
 #include "../include/world.h"
 #include "../include/save_load.h"
+#include "../include/world_loader.h"
 
 // Test counter
 static int tests_passed = 0;
@@ -114,6 +115,7 @@ void test_basic_save(void) {
     // Cleanup
     unlink(save_path);
 
+    world_free(&world);
     PASS();
 }
 
@@ -128,15 +130,14 @@ void test_save_and_load(void) {
     // Take key first while in entrance (room 0) before moving
     world_take_item(&world1, "key");  // Take key from current room
     world1.current_room = 1;  // Move to hall
-    world1.rooms[0].visited = true;
-    world1.rooms[1].visited = true;
+    world_set_room_visited(&world1, 0, true);
+    world_set_room_visited(&world1, 1, true);
 
     // Save
     ASSERT_TRUE(game_save(&world1, slot, "test_world"), "save should succeed");
 
-    // Create new world and load
-    World world2;
-    world_init(&world2);
+    // Create fresh copy of the same world and load
+    World world2 = create_test_world();
     char loaded_world_name[256];
 
     ASSERT_TRUE(game_load(&world2, slot, loaded_world_name, sizeof(loaded_world_name)),
@@ -145,12 +146,13 @@ void test_save_and_load(void) {
     // Verify state
     ASSERT_EQ(world1.current_room, world2.current_room, "current room should match");
     ASSERT_STR_EQ("test_world", loaded_world_name, "world name should match");
-    ASSERT_EQ(world1.rooms[0].visited, world2.rooms[0].visited, "room 0 visited should match");
-    ASSERT_EQ(world1.rooms[1].visited, world2.rooms[1].visited, "room 1 visited should match");
+    ASSERT_EQ(world_room_visited(&world1, 0), world_room_visited(&world2, 0), "room 0 visited should match");
+    ASSERT_EQ(world_room_visited(&world1, 1), world_room_visited(&world2, 1), "room 1 visited should match");
 
     // Verify inventory
-    ASSERT_EQ(world1.inventory[0], world2.inventory[0], "inventory should match");
-    ASSERT_TRUE(world2.inventory[0] >= 0, "should have key in inventory");
+    ASSERT_EQ(world_first_item(&world1, ITEM_IN_INVENTORY),
+              world_first_item(&world2, ITEM_IN_INVENTORY), "inventory should match");
+    ASSERT_TRUE(world_first_item(&world2, ITEM_IN_INVENTORY) >= 0, "should have key in inventory");
 
     // Cleanup
     char save_path[512];
@@ -158,6 +160,32 @@ void test_save_and_load(void) {
              getenv("HOME"), slot);
     unlink(save_path);
 
+    world_free(&world1);
+    world_free(&world2);
+    PASS();
+}
+
+// Test reading the world name without applying state
+void test_read_world_name(void) {
+    TEST("Read world name from save");
+
+    World world = create_test_world();
+    const char *slot = "test_world_name";
+
+    ASSERT_TRUE(game_save(&world, slot, "dark_tower"), "save should succeed");
+
+    char world_name[64] = "";
+    ASSERT_TRUE(game_read_world_name(slot, world_name, sizeof(world_name)), "read should succeed");
+    ASSERT_STR_EQ("dark_tower", world_name, "world name should match");
+    ASSERT_FALSE(game_read_world_name("nonexistent_slot_xyz", world_name, sizeof(world_name)),
+                 "read should fail for nonexistent slot");
+
+    char save_path[512];
+    snprintf(save_path, sizeof(save_path), "%s/.adventure-saves/%s.sav",
+             getenv("HOME"), slot);
+    unlink(save_path);
+
+    world_free(&world);
     PASS();
 }
 
@@ -180,17 +208,19 @@ void test_multiple_saves(void) {
     World loaded;
     char world_name[256];
 
-    world_init(&loaded);
+    loaded = create_test_world();
     game_load(&loaded, "slot_a", world_name, sizeof(world_name));
     ASSERT_EQ(0, loaded.current_room, "slot_a current room");
     ASSERT_STR_EQ("world_a", world_name, "slot_a world name");
 
-    world_init(&loaded);
+    world_free(&loaded);
+    loaded = create_test_world();
     game_load(&loaded, "slot_b", world_name, sizeof(world_name));
     ASSERT_EQ(1, loaded.current_room, "slot_b current room");
     ASSERT_STR_EQ("world_b", world_name, "slot_b world name");
 
-    world_init(&loaded);
+    world_free(&loaded);
+    loaded = create_test_world();
     game_load(&loaded, "slot_c", world_name, sizeof(world_name));
     ASSERT_EQ(2, loaded.current_room, "slot_c current room");
     ASSERT_STR_EQ("world_c", world_name, "slot_c world name");
@@ -204,6 +234,8 @@ void test_multiple_saves(void) {
     snprintf(save_path, sizeof(save_path), "%s/.adventure-saves/slot_c.sav", getenv("HOME"));
     unlink(save_path);
 
+    world_free(&world);
+    world_free(&loaded);
     PASS();
 }
 
@@ -218,6 +250,7 @@ void test_load_nonexistent(void) {
     ASSERT_FALSE(game_load(&world, "nonexistent_slot_xyz", world_name, sizeof(world_name)),
                  "load should fail for nonexistent slot");
 
+    world_free(&world);
     PASS();
 }
 
@@ -245,6 +278,7 @@ void test_save_directory_creation(void) {
     snprintf(save_path, sizeof(save_path), "%s/test_dir_slot.sav", save_dir);
     unlink(save_path);
 
+    world_free(&world);
     PASS();
 }
 
@@ -265,18 +299,16 @@ void test_inventory_persistence(void) {
     // Save
     game_save(&world, slot, "test_world");
 
-    // Load into new world
-    World loaded;
-    world_init(&loaded);
+    // Load into fresh copy of the world
+    World loaded = create_test_world();
     char world_name[256];
     game_load(&loaded, slot, world_name, sizeof(world_name));
 
     // Verify inventory has 2 items
     int item_count = 0;
-    for (int i = 0; i < MAX_INVENTORY; i++) {
-        if (loaded.inventory[i] != -1) {
-            item_count++;
-        }
+    for (int i = world_first_item(&loaded, ITEM_IN_INVENTORY); i != -1;
+         i = world_next_item(&loaded, i)) {
+        item_count++;
     }
     ASSERT_EQ(2, item_count, "should have 2 items in inventory");
 
@@ -286,6 +318,8 @@ void test_inventory_persistence(void) {
              getenv("HOME"), slot);
     unlink(save_path);
 
+    world_free(&world);
+    world_free(&loaded);
     PASS();
 }
 
@@ -297,23 +331,22 @@ void test_visited_rooms_persistence(void) {
     const char *slot = "test_visited";
 
     // Visit rooms
-    world.rooms[0].visited = true;
-    world.rooms[1].visited = true;
-    world.rooms[2].visited = false;
+    world_set_room_visited(&world, 0, true);
+    world_set_room_visited(&world, 1, true);
+    world_set_room_visited(&world, 2, false);
 
     // Save
     game_save(&world, slot, "test_world");
 
     // Load
-    World loaded;
-    world_init(&loaded);
+    World loaded = create_test_world();
     char world_name[256];
     game_load(&loaded, slot, world_name, sizeof(world_name));
 
     // Verify visited state
-    ASSERT_TRUE(loaded.rooms[0].visited, "room 0 should be visited");
-    ASSERT_TRUE(loaded.rooms[1].visited, "room 1 should be visited");
-    ASSERT_FALSE(loaded.rooms[2].visited, "room 2 should not be visited");
+    ASSERT_TRUE(world_room_visited(&loaded, 0), "room 0 should be visited");
+    ASSERT_TRUE(world_room_visited(&loaded, 1), "room 1 should be visited");
+    ASSERT_FALSE(world_room_visited(&loaded, 2), "room 2 should not be visited");
 
     // Cleanup
     char save_path[512];
@@ -321,6 +354,197 @@ void test_visited_rooms_persistence(void) {
              getenv("HOME"), slot);
     unlink(save_path);
 
+    world_free(&world);
+    world_free(&loaded);
+    PASS();
+}
+
+// Test flag bitsets round-trip (unlocked exits, description shown, items used)
+void test_flag_bitsets_persistence(void) {
+    TEST("Flag bitsets persistence");
+
+    World world = create_test_world();
+    const char *slot = "test_flags";
+
+    world_unlock_exit(&world, 1, DIR_EAST);
+    world_set_room_description_shown(&world, 2, true);
+    world_set_item_used(&world, 1, true);
+
+    game_save(&world, slot, "test_world");
+
+    World loaded = create_test_world();
+    char world_name[256];
+    ASSERT_TRUE(game_load(&loaded, slot, world_name, sizeof(world_name)), "load should succeed");
+
+    ASSERT_TRUE(world_exit_unlocked(&loaded, 1, DIR_EAST), "hall east should be unlocked");
+    ASSERT_FALSE(world_exit_unlocked(&loaded, 1, DIR_SOUTH), "hall south should stay locked");
+    ASSERT_TRUE(world_room_description_shown(&loaded, 2), "chamber description shown");
+    ASSERT_FALSE(world_room_description_shown(&loaded, 0), "entrance description not shown");
+    ASSERT_TRUE(world_item_used(&loaded, 1), "sword should be used");
+    ASSERT_EQ(1, (int)bitset_count(loaded.item_used, (size_t)loaded.def->item_count),
+              "exactly one item should be used");
+
+    char save_path[512];
+    snprintf(save_path, sizeof(save_path), "%s/.adventure-saves/%s.sav",
+             getenv("HOME"), slot);
+    unlink(save_path);
+
+    world_free(&world);
+    world_free(&loaded);
+    PASS();
+}
+
+// Test loading a v3 save (inventory and room item lists)
+void test_load_v3_save(void) {
+    TEST("Load v3 save");
+
+    const char *slot = "test_v3_save";
+    char save_path[512];
+    snprintf(save_path, sizeof(save_path), "%s/.adventure-saves/%s.sav",
+             getenv("HOME"), slot);
+
+    // Make sure the save directory exists
+    World world = create_test_world();
+    game_save(&world, slot, "test_world");
+
+    FILE *file = fopen(save_path, "w");
+    ASSERT_TRUE(file != NULL, "should write v3 save");
+    fprintf(file, "VERSION: 3\nWORLD: test_world\n\n"
+                  "[STATE]\ncurrent_room: 1\nroom_count: 3\nitem_count: 3\n\n"
+                  "[INVENTORY]\n1\n\n"
+                  "[ROOM_ITEMS]\nROOM:0:\nROOM:1:\nROOM:2:0,2\n\n"
+                  "[VISITED]\n1\n1\n0\n\n"
+                  "[UNLOCKED_EXITS]\nROOM:1:0,0,1,0,0,0\n\n"
+                  "[ITEMS_USED]\n0\n0\n1\n");
+    fclose(file);
+
+    World loaded = create_test_world();
+    char world_name[256];
+    ASSERT_TRUE(game_load(&loaded, slot, world_name, sizeof(world_name)), "v3 save should load");
+
+    ASSERT_EQ(1, loaded.current_room, "current room should be hall");
+    ASSERT_EQ(ITEM_IN_INVENTORY, world_item_location(&loaded, 1), "sword should be carried");
+    ASSERT_EQ(2, world_item_location(&loaded, 0), "key should be in chamber");
+    ASSERT_EQ(2, world_item_location(&loaded, 2), "statue should be in chamber");
+    ASSERT_EQ(-1, world_first_item(&loaded, 0), "entrance should be empty");
+    ASSERT_TRUE(world_room_visited(&loaded, 1), "hall should be visited");
+    ASSERT_FALSE(world_room_visited(&loaded, 2), "chamber should not be visited");
+    ASSERT_TRUE(world_exit_unlocked(&loaded, 1, DIR_EAST), "hall east should be unlocked");
+    ASSERT_TRUE(world_item_used(&loaded, 2), "statue should be used");
+
+    unlink(save_path);
+    world_free(&world);
+    world_free(&loaded);
+    PASS();
+}
+
+// Test named exits and exits to rooms defined later in the file, and
+// their unlocked state across a save
+void test_named_exits_persistence(void) {
+    TEST("Named exits persistence");
+
+    const char *path = "/tmp/adventure-test-named-exits.world";
+    FILE *file = fopen(path, "w");
+    ASSERT_TRUE(file != NULL, "should write world file");
+    fprintf(file, "[WORLD]\nname: Mirrors\nstart: hall\n\n"
+                  "[ROOM:hall]\nname: Hall\ndescription: A hall.\n"
+                  "exits: n=gallery, through the mirror=mirror\n"
+                  "locked_exits: through the mirror=shard\n\n"
+                  "[ROOM:gallery]\nname: Gallery\ndescription: Paintings.\nexits: south=hall\n\n"
+                  "[ROOM:mirror]\nname: Mirror\ndescription: Behind the glass.\nexits: out=hall\n\n"
+                  "[ITEM:shard]\nname: shard\ndescription: A shard.\nlocation: gallery\n");
+    fclose(file);
+
+    World world;
+    LoadError error;
+    ASSERT_TRUE(world_load_from_file(&world, path, &error), "world should load");
+    unlink(path);
+
+    ASSERT_EQ(4, world.def->exit_count, "all exits resolved");
+    ASSERT_EQ(1, world_room_exit(&world, 0, DIR_NORTH), "forward exit to gallery");
+    int through = world_find_exit(&world, 0, "through the mirror");
+    ASSERT_TRUE(through != -1, "named exit exists");
+    ASSERT_FALSE(world_exit_open(&world, through), "named exit is locked");
+
+    const char *slot = "test_named_exits";
+    world_set_exit_unlocked(&world, through, true);
+    ASSERT_TRUE(game_save(&world, slot, "mirrors"), "save should succeed");
+
+    // A freshly built copy of the layout, as a new session would have
+    World loaded;
+    world_init(&loaded);
+    int rooms[3];
+    rooms[0] = world_add_room(&loaded, "hall", "Hall", "A hall.");
+    rooms[1] = world_add_room(&loaded, "gallery", "Gallery", "Paintings.");
+    rooms[2] = world_add_room(&loaded, "mirror", "Mirror", "Behind the glass.");
+    world_connect_rooms(&loaded, rooms[0], DIR_NORTH, rooms[1]);
+    int loaded_through = world_add_exit(&loaded, rooms[0], "through the mirror", rooms[2]);
+    world_set_exit_key(&loaded, loaded_through, "shard");
+
+    char world_name[256];
+    ASSERT_TRUE(game_load(&loaded, slot, world_name, sizeof(world_name)), "load should succeed");
+    ASSERT_TRUE(world_exit_open(&loaded, loaded_through), "named exit unlocked after load");
+
+    char save_path[512];
+    snprintf(save_path, sizeof(save_path), "%s/.adventure-saves/%s.sav",
+             getenv("HOME"), slot);
+    unlink(save_path);
+
+    world_free(&world);
+    world_free(&loaded);
+    PASS();
+}
+
+// Test .world parsing details: CRLF lines, no final newline, long text
+// kept whole, unknown sections ignored, errors with line numbers
+void test_world_file_format(void) {
+    TEST("World file format");
+
+    const char *path = "/tmp/adventure-test-format.world";
+    char long_desc[1500];
+    memset(long_desc, 'a', sizeof(long_desc) - 1);
+    long_desc[sizeof(long_desc) - 1] = '\0';
+
+    FILE *file = fopen(path, "w");
+    ASSERT_TRUE(file != NULL, "should write world file");
+    fprintf(file, "# Comment\r\n[WORLD]\r\nname: Format\r\nstart: yard\r\n\r\n"
+                  "[NOTES]\r\nanything: goes\r\n\r\n"
+                  "[ROOM:hall]\r\nname: Hall\r\ndescription: %s\r\nexits: n=yard\r\n\r\n"
+                  "[ROOM:yard]\r\n  name :  Yard  \r\ndescription: Open sky.\r\n"
+                  "exits: s=hall, over the wall=hall\r\nlocked_exits: over the wall=ladder",
+            long_desc);
+    fclose(file);
+
+    World world;
+    LoadError error;
+    ASSERT_TRUE(world_load_from_file(&world, path, &error), "world should load");
+    ASSERT_EQ(2, world.def->room_count, "two rooms");
+    ASSERT_EQ(1, world.current_room, "start room from [WORLD]");
+    ASSERT_TRUE(strcmp(world_str(&world, world.def->rooms[1].name), "Yard") == 0,
+                "keys and values trimmed");
+    ASSERT_TRUE(strlen(world_str(&world, world.def->rooms[0].description)) == strlen(long_desc),
+                "long description kept whole");
+    ASSERT_EQ(1, world_room_exit(&world, 0, DIR_NORTH), "short compass name resolved");
+    int wall = world_find_exit(&world, 1, "over the wall");
+    ASSERT_TRUE(wall != -1, "named exit on the last line's room");
+    ASSERT_TRUE(strcmp(world_str(&world, world_exit(&world, wall)->key), "ladder") == 0,
+                "lock on the unterminated last line");
+    world_free(&world);
+
+    file = fopen(path, "w");
+    ASSERT_TRUE(file != NULL, "should rewrite world file");
+    fprintf(file, "[ROOM:hall]\nname: Hall\n\n[ROOM:yard]\nname: Yard\ndescription: Sky.\n");
+    fclose(file);
+    ASSERT_FALSE(world_load_from_file(&world, path, &error), "missing description fails");
+    ASSERT_EQ(4, error.line_number, "error at the next section header");
+    ASSERT_TRUE(strstr(error.message, "'hall'") != NULL, "error names the room");
+    world_free(&world);
+    unlink(path);
+
+    ASSERT_FALSE(world_load_from_file(&world, "/tmp/adventure-no-such.world", &error),
+                 "missing file fails");
+    ASSERT_TRUE(strncmp(error.message, "Cannot open file", 16) == 0, "open error reported");
+
     PASS();
 }
 
@@ -330,11 +554,16 @@ int main(void) {
 
     test_basic_save();
     test_save_and_load();
+    test_read_world_name();
     test_multiple_saves();
     test_load_nonexistent();
     test_save_directory_creation();
     test_inventory_persistence();
     test_visited_rooms_persistence();
+    test_flag_bitsets_persistence();
+    test_load_v3_save();
+    test_named_exits_persistence();
+    test_world_file_format();
 
     printf("\n=== Test Results ===\n");
     printf("  Passed: %d\n", tests_passed);
@@ -0,0 +1,287 @@
+/*
+ * Test Suite for World Snapshots
+ * Tests copy-on-write snapshots, restore (undo) and forking sessions
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/world.h"
+#include "../include/world_snapshot.h"
+
+// Test counter
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name) \
+    printf("  Testing: %s ... ", name); \
+    fflush(stdout);
+
+#define PASS() \
+    do { \
+        printf("✓ PASS\n"); \
+        tests_passed++; \
+    } while(0)
+
+#define FAIL(msg) \
+    do { \
+        printf("✗ FAIL: %s\n", msg); \
+        tests_failed++; \
+    } while(0)
+
+#define ASSERT_TRUE(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_FALSE(cond, msg) \
+    do { \
+        if (cond) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(expected, actual, msg) \
+    do { \
+        if ((expected) != (actual)) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: %d, got: %d)", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_STR_EQ(expected, actual, msg) \
+    do { \
+        if (strcmp(expected, actual) != 0) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: '%.128s', got: '%.128s')", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_NOT_NULL(ptr, msg) \
+    do { \
+        if (ptr == NULL) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_NULL(ptr, msg) \
+    do { \
+        if (ptr != NULL) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+// Helper: Two rooms joined north/south with a locked door, a key and a lamp
+static void build_world(World *world) {
+    world_init(world);
+    int hall = world_add_room(world, "hall", "Hall", "A hall.");
+    int vault = world_add_room(world, "vault", "Vault", "A vault.");
+    world_connect_rooms(world, hall, DIR_NORTH, vault);
+    world_connect_rooms(world, vault, DIR_SOUTH, hall);
+    world_lock_exit(world, hall, DIR_NORTH, "key");
+    world_place_item(world, world_add_item(world, "key", "key", "A key.", true), hall);
+    world_place_item(world, world_add_item(world, "lamp", "lamp", "A lamp.", true), hall);
+    world->current_room = hall;
+    world_set_room_visited(world, hall, true);
+}
+
+// Test restoring a snapshot undoes takes, moves, unlocks and flags
+void test_restore(void) {
+    TEST("Restore undoes a turn");
+
+    World world;
+    build_world(&world);
+    int key = world_find_item(&world, "key");
+
+    WorldSnapshot *before = world_snapshot(&world);
+    ASSERT_NOT_NULL(before, "snapshot should succeed");
+
+    ASSERT_TRUE(world_take_item(&world, "key"), "take key");
+    ASSERT_TRUE(world_move(&world, DIR_NORTH), "move through locked door");
+    world_set_item_used(&world, key, true);
+    ASSERT_FALSE(world_snapshot_matches(&world, before), "world should have changed");
+
+    ASSERT_TRUE(world_restore(&world, before), "restore should succeed");
+    ASSERT_EQ(0, world.current_room, "back in hall");
+    ASSERT_EQ(0, world_item_location(&world, key), "key back in hall");
+    ASSERT_EQ(0, world.inventory_count, "inventory empty");
+    ASSERT_FALSE(world_exit_unlocked(&world, 0, DIR_NORTH), "door locked again");
+    ASSERT_FALSE(world_room_visited(&world, 1), "vault not visited");
+    ASSERT_FALSE(world_item_used(&world, key), "key not used");
+    ASSERT_TRUE(world_snapshot_matches(&world, before), "world should match snapshot");
+
+    // Item lists are intact after restore
+    ASSERT_EQ(key, world_first_item(&world, 0), "key first in hall");
+    ASSERT_TRUE(world_take_item(&world, "lamp"), "take lamp after restore");
+
+    world_snapshot_free(before);
+    world_free(&world);
+    PASS();
+}
+
+// Test unchanged chunks are shared between snapshots
+void test_chunk_sharing(void) {
+    TEST("Snapshots share unchanged chunks");
+
+    World world;
+    world_init(&world);
+    char id[32];
+    for (int i = 0; i < 4000; i++) {
+        snprintf(id, sizeof(id), "room_%d", i);
+        world_add_room(&world, id, "Room", "A room.");
+    }
+    for (int i = 0; i < 400; i++) {
+        snprintf(id, sizeof(id), "item_%d", i);
+        world_place_item(&world, world_add_item(&world, id, id, "An item.", true), i * 10);
+    }
+
+    WorldSnapshot *first = world_snapshot(&world);
+    ASSERT_NOT_NULL(first, "first snapshot");
+    size_t full = first->copied_bytes;
+    ASSERT_TRUE(full > 4 * STATE_CHUNK_BYTES, "first snapshot copies everything");
+
+    WorldSnapshot *same = world_snapshot(&world);
+    ASSERT_NOT_NULL(same, "second snapshot");
+    ASSERT_TRUE(same->copied_bytes == 0, "unchanged world copies nothing");
+
+    world.current_room = 3990;
+    ASSERT_TRUE(world_take_item(&world, "item_399"), "take item");
+    world_set_room_visited(&world, 3990, true);
+    WorldSnapshot *changed = world_snapshot(&world);
+    ASSERT_NOT_NULL(changed, "third snapshot");
+    ASSERT_TRUE(changed->copied_bytes > 0 && changed->copied_bytes <= 3 * STATE_CHUNK_BYTES,
+                "snapshot copies only touched chunks");
+
+    // Restoring the first snapshot copies back only what differs
+    ASSERT_TRUE(world_restore(&world, first), "restore first");
+    ASSERT_EQ(3990, world_item_location(&world, 399), "item back in its room");
+    ASSERT_FALSE(world_room_visited(&world, 3990), "visit undone");
+
+    world_snapshot_free(first);
+    world_snapshot_free(same);
+    world_snapshot_free(changed);
+    world_free(&world);
+    PASS();
+}
+
+// Test forking a session from a snapshot
+void test_fork(void) {
+    TEST("Fork session from snapshot");
+
+    World world;
+    build_world(&world);
+    ASSERT_TRUE(world_take_item(&world, "key"), "take key");
+
+    WorldSnapshot *snapshot = world_snapshot(&world);
+    ASSERT_NOT_NULL(snapshot, "snapshot should succeed");
+
+    World fork;
+    ASSERT_TRUE(world_fork(&fork, snapshot), "fork should succeed");
+    ASSERT_TRUE(fork.def == world.def, "fork shares the definition");
+    ASSERT_TRUE(world_has_item(&fork, "key"), "fork has key");
+
+    // Sessions diverge independently
+    ASSERT_TRUE(world_move(&fork, DIR_NORTH), "fork moves north");
+    ASSERT_EQ(0, world.current_room, "original stays in hall");
+    ASSERT_TRUE(world_drop_item(&world, "key"), "original drops key");
+    ASSERT_TRUE(world_has_item(&fork, "key"), "fork keeps key");
+
+    // The snapshot keeps the definition alive after both sessions end
+    world_free(&world);
+    world_free(&fork);
+    World again;
+    ASSERT_TRUE(world_fork(&again, snapshot), "fork after sessions freed");
+    ASSERT_STR_EQ("A vault.", world_str(&again, again.def->rooms[1].description), "text kept");
+
+    world_free(&again);
+    world_snapshot_free(snapshot);
+    PASS();
+}
+
+// Test snapshots are rejected by worlds with another definition
+void test_restore_other_world(void) {
+    TEST("Restore rejects another world");
+
+    World a, b;
+    build_world(&a);
+    build_world(&b);
+
+    WorldSnapshot *snapshot = world_snapshot(&a);
+    ASSERT_NOT_NULL(snapshot, "snapshot should succeed");
+    ASSERT_FALSE(world_restore(&b, snapshot), "other definition should be rejected");
+
+    // The snapshot shares the definition, so its layout cannot change
+    ASSERT_EQ(-1, world_add_room(&a, "cellar", "Cellar", "A cellar."),
+              "definition should be read-only while a snapshot holds it");
+    ASSERT_TRUE(world_restore(&a, snapshot), "own snapshot should restore");
+
+    world_snapshot_free(snapshot);
+    world_free(&a);
+    world_free(&b);
+    PASS();
+}
+
+// Test the state hash follows the state, not the history that led to it
+void test_state_hash(void) {
+    TEST("State hash");
+
+    World a, b;
+    build_world(&a);
+    build_world(&b);
+    ASSERT_TRUE(world_state_hash(&a) == world_state_hash(&b), "equal worlds hash equal");
+
+    WorldSnapshot *before = world_snapshot(&a);
+    ASSERT_NOT_NULL(before, "snapshot should succeed");
+    uint64_t start = world_state_hash(&a);
+
+    ASSERT_TRUE(world_take_item(&a, "key"), "take key");
+    uint64_t carrying = world_state_hash(&a);
+    ASSERT_TRUE(carrying != start, "take changes the hash");
+    ASSERT_TRUE(world_move(&a, DIR_NORTH), "move north");
+    ASSERT_TRUE(world_state_hash(&a) != carrying, "move changes the hash");
+
+    // The same moves in another session, and undoing them, give equal hashes
+    ASSERT_TRUE(world_take_item(&b, "key"), "take key in b");
+    ASSERT_TRUE(carrying == world_state_hash(&b), "same turn hashes equal");
+    ASSERT_TRUE(world_restore(&a, before), "restore should succeed");
+    ASSERT_TRUE(world_state_hash(&a) == start, "restore brings the hash back");
+
+    world_snapshot_free(before);
+    world_free(&a);
+    world_free(&b);
+    PASS();
+}
+
+// Main test runner
+int main(void) {
+    printf("\n=== World Snapshot Test Suite ===\n\n");
+
+    test_restore();
+    test_chunk_sharing();
+    test_fork();
+    test_restore_other_world();
+    test_state_hash();
+
+    printf("\n=== Test Results ===\n");
+    printf("  Passed: %d\n", tests_passed);
+    printf("  Failed: %d\n", tests_failed);
+    printf("  Total:  %d\n", tests_passed + tests_failed);
+
+    if (tests_failed == 0) {
+        printf("\n✓ All tests passed!\n\n");
+        return 0;
+    } else {
+        printf("\n✗ Some tests failed!\n\n");
+        return 1;
+    }
+}
@@ -47,10 +47,11 @@ void test_use_message_init(void) {
     int item_idx = world_add_item(&world, "potion", "healing potion", "A red potion.", true);
     ASSERT_TRUE(item_idx >= 0, "should create item");
 
-    Item *item = &world.items[item_idx];
-    ASSERT_EQ('\0', item->use_message[0], "use_message should be empty by default");
+    Item *item = &world.def->items[item_idx];
+    ASSERT_EQ(0, item->use_message, "use_message should be empty by default");
     ASSERT_FALSE(item->use_consumable, "use_consumable should be false by default");
 
+    world_free(&world);
     PASS();
 }
 
@@ -64,13 +65,13 @@ void test_set_use_message(void) {
     int item_idx = world_add_item(&world, "potion", "healing potion", "A red potion.", true);
     ASSERT_TRUE(item_idx >= 0, "should create item");
 
-    Item *item = &world.items[item_idx];
-    strncpy(item->use_message, "You drink the potion and feel refreshed!", sizeof(item->use_message) - 1);
-    item->use_consumable = true;
+    Item *item = &world.def->items[item_idx];
+    world_set_item_use(&world, item_idx, "You drink the potion and feel refreshed!", true);
 
-    ASSERT_STR_EQ("You drink the potion and feel refreshed!", item->use_message, "use_message should be set");
+    ASSERT_STR_EQ("You drink the potion and feel refreshed!", world_str(&world, item->use_message), "use_message should be set");
     ASSERT_TRUE(item->use_consumable, "use_consumable should be true");
 
+    world_free(&world);
     PASS();
 }
 
@@ -83,15 +84,16 @@ void test_item_is_usable(void) {
 
     // Non-usable item (empty use_message)
     int key_idx = world_add_item(&world, "key", "rusty key", "An old key.", true);
-    Item *key = &world.items[key_idx];
-    ASSERT_EQ('\0', key->use_message[0], "key should not be usable");
+    Item *key = &world.def->items[key_idx];
+    ASSERT_EQ(0, key->use_message, "key should not be usable");
 
     // Usable item
     int potion_idx = world_add_item(&world, "potion", "healing potion", "A red potion.", true);
-    Item *potion = &world.items[potion_idx];
-    strncpy(potion->use_message, "You drink the potion.", sizeof(potion->use_message) - 1);
-    ASSERT_TRUE(potion->use_message[0] != '\0', "potion should be usable");
+    Item *potion = &world.def->items[potion_idx];
+    world_set_item_use(&world, potion_idx, "You drink the potion.", false);
+    ASSERT_TRUE(potion->use_message != 0, "potion should be usable");
 
+    world_free(&world);
     PASS();
 }
 
@@ -115,6 +117,7 @@ void test_remove_from_inventory(void) {
     ASSERT_TRUE(world_remove_from_inventory(&world, "potion"), "should remove potion");
     ASSERT_FALSE(world_has_item(&world, "potion"), "should not have potion after removal");
 
+    world_free(&world);
     PASS();
 }
 
@@ -127,6 +130,7 @@ void test_remove_nonexistent_item(void) {
 
     ASSERT_FALSE(world_remove_from_inventory(&world, "nonexistent"), "should return false for non-existent item");
 
+    world_free(&world);
     PASS();
 }
 
@@ -139,18 +143,17 @@ void test_consumable_flag(void) {
 
     // Create two items: consumable and non-consumable
     int potion_idx = world_add_item(&world, "potion", "healing potion", "A red potion.", true);
-    Item *potion = &world.items[potion_idx];
-    strncpy(potion->use_message, "You drink the potion.", sizeof(potion->use_message) - 1);
-    potion->use_consumable = true;
+    Item *potion = &world.def->items[potion_idx];
+    world_set_item_use(&world, potion_idx, "You drink the potion.", true);
 
     int torch_idx = world_add_item(&world, "torch", "burning torch", "A torch.", true);
-    Item *torch = &world.items[torch_idx];
-    strncpy(torch->use_message, "The torch illuminates the area.", sizeof(torch->use_message) - 1);
-    torch->use_consumable = false;
+    Item *torch = &world.def->items[torch_idx];
+    world_set_item_use(&world, torch_idx, "The torch illuminates the area.", false);
 
     ASSERT_TRUE(potion->use_consumable, "potion should be consumable");
     ASSERT_FALSE(torch->use_consumable, "torch should not be consumable");
 
+    world_free(&world);
     PASS();
 }
 
@@ -175,8 +178,9 @@ void test_get_inventory_item(void) {
     // Now should be in inventory
     Item *item = world_get_inventory_item(&world, "potion");
     ASSERT_TRUE(item != NULL, "should find potion in inventory");
-    ASSERT_STR_EQ("potion", item->id, "item id should match");
+    ASSERT_STR_EQ("potion", world_str(&world, item->id), "item id should match");
 
+    world_free(&world);
     PASS();
 }
 
@@ -195,35 +199,33 @@ void test_multiple_usable_items(void) {
     int scroll_idx = world_add_item(&world, "scroll", "magic scroll", "A glowing scroll.", true);
     int torch_idx = world_add_item(&world, "torch", "burning torch", "A torch.", true);
 
-    Item *key = &world.items[key_idx];
-    Item *potion = &world.items[potion_idx];
-    Item *scroll = &world.items[scroll_idx];
-    Item *torch = &world.items[torch_idx];
+    Item *key = &world.def->items[key_idx];
+    Item *potion = &world.def->items[potion_idx];
+    Item *scroll = &world.def->items[scroll_idx];
+    Item *torch = &world.def->items[torch_idx];
 
     // Key: not usable
     // (default - no use_message)
 
     // Potion: usable and consumable
-    strncpy(potion->use_message, "You drink the potion.", sizeof(potion->use_message) - 1);
-    potion->use_consumable = true;
+    world_set_item_use(&world, potion_idx, "You drink the potion.", true);
 
     // Scroll: usable and consumable
-    strncpy(scroll->use_message, "You read the scroll. It crumbles to dust.", sizeof(scroll->use_message) - 1);
-    scroll->use_consumable = true;
+    world_set_item_use(&world, scroll_idx, "You read the scroll. It crumbles to dust.", true);
 
     // Torch: usable but not consumable
-    strncpy(torch->use_message, "The torch illuminates the darkness.", sizeof(torch->use_message) - 1);
-    torch->use_consumable = false;
+    world_set_item_use(&world, torch_idx, "The torch illuminates the darkness.", false);
 
     // Verify
-    ASSERT_EQ('\0', key->use_message[0], "key should not be usable");
-    ASSERT_TRUE(potion->use_message[0] != '\0', "potion should be usable");
+    ASSERT_EQ(0, key->use_message, "key should not be usable");
+    ASSERT_TRUE(potion->use_message != 0, "potion should be usable");
     ASSERT_TRUE(potion->use_consumable, "potion should be consumable");
-    ASSERT_TRUE(scroll->use_message[0] != '\0', "scroll should be usable");
+    ASSERT_TRUE(scroll->use_message != 0, "scroll should be usable");
     ASSERT_TRUE(scroll->use_consumable, "scroll should be consumable");
-    ASSERT_TRUE(torch->use_message[0] != '\0', "torch should be usable");
+    ASSERT_TRUE(torch->use_message != 0, "torch should be usable");
     ASSERT_FALSE(torch->use_consumable, "torch should not be consumable");
 
+    world_free(&world);
     PASS();
 }
 
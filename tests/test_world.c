@@ -88,15 +88,15 @@ void test_world_init(void) {
     World world;
     world_init(&world);
 
-    ASSERT_EQ(0, world.room_count, "room count should be 0");
-    ASSERT_EQ(0, world.item_count, "item count should be 0");
+    ASSERT_EQ(0, world.def->room_count, "room count should be 0");
+    ASSERT_EQ(0, world.def->item_count, "item count should be 0");
     ASSERT_EQ(0, world.current_room, "current room should be 0");
 
     // Check inventory is empty
-    for (int i = 0; i < MAX_INVENTORY; i++) {
-        ASSERT_EQ(-1, world.inventory[i], "inventory slot should be -1");
-    }
+    ASSERT_EQ(-1, world_first_item(&world, ITEM_IN_INVENTORY), "inventory should be empty");
+    ASSERT_EQ(0, world.inventory_count, "inventory count should be 0");
 
+    world_free(&world);
     PASS();
 }
 
@@ -109,17 +109,18 @@ void test_room_creation(void) {
 
     int room1 = world_add_room(&world, "entrance", "Entrance Hall", "A grand entrance hall.");
     ASSERT_EQ(0, room1, "first room should be index 0");
-    ASSERT_EQ(1, world.room_count, "room count should be 1");
+    ASSERT_EQ(1, world.def->room_count, "room count should be 1");
 
     int room2 = world_add_room(&world, "hall", "Great Hall", "A massive hall.");
     ASSERT_EQ(1, room2, "second room should be index 1");
-    ASSERT_EQ(2, world.room_count, "room count should be 2");
+    ASSERT_EQ(2, world.def->room_count, "room count should be 2");
 
     // Verify room data
-    ASSERT_STR_EQ("entrance", world.rooms[0].id, "room 0 id");
-    ASSERT_STR_EQ("Entrance Hall", world.rooms[0].name, "room 0 name");
-    ASSERT_STR_EQ("A grand entrance hall.", world.rooms[0].description, "room 0 description");
+    ASSERT_STR_EQ("entrance", world_str(&world, world.def->rooms[0].id), "room 0 id");
+    ASSERT_STR_EQ("Entrance Hall", world_str(&world, world.def->rooms[0].name), "room 0 name");
+    ASSERT_STR_EQ("A grand entrance hall.", world_str(&world, world.def->rooms[0].description), "room 0 description");
 
+    world_free(&world);
     PASS();
 }
 
@@ -132,18 +133,19 @@ void test_item_creation(void) {
 
     int item1 = world_add_item(&world, "key", "rusty key", "An old rusty key.", true);
     ASSERT_EQ(0, item1, "first item should be index 0");
-    ASSERT_EQ(1, world.item_count, "item count should be 1");
+    ASSERT_EQ(1, world.def->item_count, "item count should be 1");
 
     int item2 = world_add_item(&world, "statue", "stone statue", "A heavy stone statue.", false);
     ASSERT_EQ(1, item2, "second item should be index 1");
-    ASSERT_EQ(2, world.item_count, "item count should be 2");
+    ASSERT_EQ(2, world.def->item_count, "item count should be 2");
 
     // Verify item data
-    ASSERT_STR_EQ("key", world.items[0].id, "item 0 id");
-    ASSERT_STR_EQ("rusty key", world.items[0].name, "item 0 name");
-    ASSERT_TRUE(world.items[0].takeable, "item 0 should be takeable");
-    ASSERT_FALSE(world.items[1].takeable, "item 1 should not be takeable");
+    ASSERT_STR_EQ("key", world_str(&world, world.def->items[0].id), "item 0 id");
+    ASSERT_STR_EQ("rusty key", world_str(&world, world.def->items[0].name), "item 0 name");
+    ASSERT_TRUE(world.def->items[0].takeable, "item 0 should be takeable");
+    ASSERT_FALSE(world.def->items[1].takeable, "item 1 should not be takeable");
 
+    world_free(&world);
     PASS();
 }
 
@@ -162,11 +164,149 @@ void test_room_connections(void) {
     world_connect_rooms(&world, room2, DIR_SOUTH, room1);
 
     // Verify connections
-    ASSERT_EQ(room2, world.rooms[room1].exits[DIR_NORTH], "room1 north exit");
-    ASSERT_EQ(-1, world.rooms[room1].exits[DIR_SOUTH], "room1 south exit");
-    ASSERT_EQ(room1, world.rooms[room2].exits[DIR_SOUTH], "room2 south exit");
-    ASSERT_EQ(-1, world.rooms[room2].exits[DIR_NORTH], "room2 north exit");
+    ASSERT_EQ(room2, world_room_exit(&world, room1, DIR_NORTH), "room1 north exit");
+    ASSERT_EQ(-1, world_room_exit(&world, room1, DIR_SOUTH), "room1 south exit");
+    ASSERT_EQ(room1, world_room_exit(&world, room2, DIR_SOUTH), "room2 south exit");
+    ASSERT_EQ(-1, world_room_exit(&world, room2, DIR_NORTH), "room2 north exit");
+
+    world_free(&world);
+    PASS();
+}
+
+// Test named exits stored per room in one contiguous run
+void test_named_exits(void) {
+    TEST("Named exits");
+
+    World world;
+    world_init(&world);
 
+    int hall = world_add_room(&world, "hall", "Hall", "A hall.");
+    int mirror = world_add_room(&world, "mirror", "Mirror Room", "Behind the glass.");
+
+    // The mirror room's exits come first, then an exit inserted for the hall
+    world_add_exit(&world, mirror, "out", hall);
+    int through = world_add_exit(&world, hall, "through the mirror", mirror);
+    world_connect_rooms(&world, hall, DIR_NORTH, mirror);
+    ASSERT_EQ(3, world.def->exit_count, "three exits");
+    ASSERT_EQ(0, world_exits_begin(&world, hall), "hall exits start the list");
+    ASSERT_EQ(2, world_exits_end(&world, hall), "hall has two exits");
+    ASSERT_EQ(2, world_exits_begin(&world, mirror), "mirror exits follow");
+    ASSERT_EQ(3, world_exits_end(&world, mirror), "mirror has one exit");
+
+    // Lookup by name, direction alias and direction
+    ASSERT_EQ(through, world_find_exit(&world, hall, "Through The Mirror"), "find by name");
+    ASSERT_EQ(1, world_find_exit(&world, hall, "n"), "find by direction alias");
+    ASSERT_EQ(1, world_direction_exit(&world, hall, DIR_NORTH), "find by direction");
+    ASSERT_EQ(-1, world_find_exit(&world, mirror, "north"), "missing exit");
+    ASSERT_EQ(mirror, world_room_exit(&world, hall, DIR_NORTH), "compass exit target");
+
+    // Unlock state follows the exit when later exits shift
+    int out = world_find_exit(&world, mirror, "out");
+    world_set_exit_key(&world, out, "shard");
+    world_set_exit_unlocked(&world, out, true);
+    world_add_exit(&world, hall, "down", mirror);
+    out = world_find_exit(&world, mirror, "out");
+    ASSERT_EQ(3, out, "out moved up by one");
+    ASSERT_TRUE(world_exit_open(&world, out), "out still unlocked");
+
+    // Moving through a named exit, and only from its own room
+    world.current_room = hall;
+    ASSERT_EQ(MOVE_NO_EXIT, world_move_exit(&world, out, NULL, 0), "exit of another room");
+    ASSERT_EQ(MOVE_SUCCESS, world_move_exit(&world, through, NULL, 0), "through the mirror");
+    ASSERT_EQ(mirror, world.current_room, "arrived in the mirror room");
+
+    world_free(&world);
+    PASS();
+}
+
+// Test adding a batch of exits at once
+void test_bulk_exits(void) {
+    TEST("Bulk exits");
+
+    World world;
+    world_init(&world);
+
+    int hall = world_add_room(&world, "hall", "Hall", "A hall.");
+    int cellar = world_add_room(&world, "cellar", "Cellar", "Damp.");
+    int tower = world_add_room(&world, "tower", "Tower", "Windy.");
+
+    // An existing locked exit in the last room must keep its state
+    int up = world_add_exit(&world, tower, "down", hall);
+    world_set_exit_key(&world, up, "rope");
+    world_set_exit_unlocked(&world, up, true);
+
+    StrRef north = world_add_text(&world, "north", 5);
+    StrRef n = world_add_text(&world, "n", 1);
+    StrRef door = world_add_text(&world, "trapdoor", 8);
+    StrRef down = world_add_text(&world, "down", 4);
+    ExitSpec specs[] = {
+        { tower, north, cellar },
+        { hall, door, cellar },
+        { hall, north, tower },
+        { hall, n, cellar },       // Repeats hall's north: later target wins
+        { tower, down, cellar },   // Re-points tower's existing exit
+        { cellar, door, 99 },      // Invalid room: skipped
+    };
+    ASSERT_TRUE(world_add_exits(&world, specs, 6), "batch should be added");
+
+    ASSERT_EQ(4, world.def->exit_count, "three new exits");
+    ASSERT_EQ(2, world_exits_end(&world, hall), "hall has two exits");
+    ASSERT_EQ(0, world_find_exit(&world, hall, "trapdoor"), "hall exits keep batch order");
+    ASSERT_EQ(cellar, world_room_exit(&world, hall, DIR_NORTH), "later target wins");
+    ASSERT_EQ(world_exits_begin(&world, cellar), world_exits_end(&world, cellar),
+              "invalid exit skipped");
+    ASSERT_EQ(2, world_exits_begin(&world, tower), "tower exits moved up");
+    int moved = world_find_exit(&world, tower, "down");
+    ASSERT_EQ(2, moved, "existing exit keeps its place in the run");
+    ASSERT_EQ(cellar, world_exit(&world, moved)->to, "existing exit re-pointed");
+    ASSERT_TRUE(world_exit_open(&world, moved), "unlock state moved with the exit");
+    ASSERT_EQ(3, world_direction_exit(&world, tower, DIR_NORTH), "new exit appended to tower");
+
+    // Compass exits of the batch share one copy of their name
+    ASSERT_EQ(north, world_exit(&world, 3)->name, "name shared, not copied");
+
+    world_free(&world);
+    PASS();
+}
+
+// Test room and item lookup by ID
+void test_find_by_id(void) {
+    TEST("Find room and item by ID");
+
+    World world;
+    world_init(&world);
+
+    // Unindexed world finds nothing
+    ASSERT_EQ(-1, world_find_room(&world, "hall"), "empty world has no rooms");
+    ASSERT_EQ(-1, world_find_item(&world, "key"), "empty world has no items");
+
+    int hall = world_add_room(&world, "hall", "Hall", "A hall.");
+    int cellar = world_add_room(&world, "cellar", "Cellar", "A cellar.");
+    int dup = world_add_room(&world, "hall", "Other Hall", "A second hall.");
+    int key = world_add_item(&world, "key", "rusty key", "An old key.", true);
+    int lamp = world_add_item(&world, "lamp", "brass lamp", "A lamp.", true);
+
+    ASSERT_EQ(hall, world_find_room(&world, "hall"), "first room with duplicate ID wins");
+    ASSERT_EQ(cellar, world_find_room(&world, "cellar"), "find cellar");
+    ASSERT_TRUE(dup != hall, "duplicate room still gets its own slot");
+    ASSERT_EQ(-1, world_find_room(&world, "attic"), "missing room");
+    ASSERT_EQ(key, world_find_item(&world, "key"), "find key");
+    ASSERT_EQ(lamp, world_find_item(&world, "lamp"), "find lamp");
+    ASSERT_EQ(-1, world_find_item(&world, "hall"), "room IDs are not item IDs");
+
+    // Add enough rooms that storage and index both grow past their initial size
+    char id[32];
+    for (int i = world.def->room_count; i < 1000; i++) {
+        snprintf(id, sizeof(id), "room_%d", i);
+        ASSERT_EQ(i, world_add_room(&world, id, "Room", "A room."), "room added");
+    }
+    ASSERT_STR_EQ("cellar", world_str(&world, world.def->rooms[cellar].id), "earlier rooms survive growth");
+    for (int i = 3; i < 1000; i++) {
+        snprintf(id, sizeof(id), "room_%d", i);
+        ASSERT_EQ(i, world_find_room(&world, id), "find room after index growth");
+    }
+
+    world_free(&world);
     PASS();
 }
 
@@ -197,6 +337,7 @@ void test_navigation(void) {
     ASSERT_TRUE(world_move(&world, DIR_SOUTH), "move south should succeed");
     ASSERT_EQ(room1, world.current_room, "should be back in room1");
 
+    world_free(&world);
     PASS();
 }
 
@@ -214,9 +355,11 @@ void test_item_placement(void) {
     world_place_item(&world, item1, room1);
 
     // Verify item is in room
-    ASSERT_EQ(item1, world.rooms[room1].items[0], "item should be in room");
-    ASSERT_TRUE(world.items[item1].visible, "item should be visible");
+    ASSERT_EQ(room1, world_item_location(&world, item1), "item should be in room");
+    ASSERT_EQ(item1, world_first_item(&world, room1), "item should be listed in room");
+    ASSERT_TRUE(world.def->items[item1].visible, "item should be visible");
 
+    world_free(&world);
     PASS();
 }
 
@@ -237,7 +380,10 @@ void test_take_items(void) {
 
     // Take takeable item (should succeed)
     ASSERT_TRUE(world_take_item(&world, "key"), "take key should succeed");
-    ASSERT_EQ(item1, world.inventory[0], "key should be in inventory");
+    ASSERT_EQ(item1, world_first_item(&world, ITEM_IN_INVENTORY), "key should be in inventory");
+    ASSERT_EQ(ITEM_IN_INVENTORY, world_item_location(&world, item1), "key location should be inventory");
+    ASSERT_EQ(item2, world_first_item(&world, room1), "only statue should remain in room");
+    ASSERT_EQ(-1, world_next_item(&world, item2), "room should hold one item");
 
     // Try to take non-takeable item (should fail)
     ASSERT_FALSE(world_take_item(&world, "statue"), "take statue should fail");
@@ -245,6 +391,7 @@ void test_take_items(void) {
     // Try to take item not in room
     ASSERT_FALSE(world_take_item(&world, "sword"), "take nonexistent item should fail");
 
+    world_free(&world);
     PASS();
 }
 
@@ -259,16 +406,16 @@ void test_drop_items(void) {
     int item1 = world_add_item(&world, "key", "rusty key", "An old key.", true);
 
     world.current_room = room1;
-    world.inventory[0] = item1;
+    world_set_item_location(&world, item1, ITEM_IN_INVENTORY);
 
     // Drop item (should succeed)
     ASSERT_TRUE(world_drop_item(&world, "key"), "drop key should succeed");
-    ASSERT_EQ(-1, world.inventory[0], "inventory should be empty");
+    ASSERT_EQ(-1, world_first_item(&world, ITEM_IN_INVENTORY), "inventory should be empty");
 
     // Verify item is in room
     bool found = false;
-    for (int i = 0; i < MAX_ITEMS; i++) {
-        if (world.rooms[room1].items[i] == item1) {
+    for (int i = world_first_item(&world, room1); i != -1; i = world_next_item(&world, i)) {
+        if (i == item1) {
             found = true;
             break;
         }
@@ -278,6 +425,7 @@ void test_drop_items(void) {
     // Try to drop item not in inventory
     ASSERT_FALSE(world_drop_item(&world, "sword"), "drop nonexistent item should fail");
 
+    world_free(&world);
     PASS();
 }
 
@@ -311,8 +459,85 @@ void test_inventory_management(void) {
     // Get items from inventory
     Item *key_item = world_get_inventory_item(&world, "key");
     ASSERT_NOT_NULL(key_item, "should get key from inventory");
-    ASSERT_STR_EQ("rusty key", key_item->name, "key name should match");
+    ASSERT_STR_EQ("rusty key", world_str(&world, key_item->name), "key name should match");
 
+    world_free(&world);
+    PASS();
+}
+
+// Test item location lists (order, removal from the middle, capacity)
+void test_item_location_lists(void) {
+    TEST("Item location lists");
+
+    World world;
+    world_init(&world);
+
+    int room1 = world_add_room(&world, "room1", "Room 1", "First room.");
+    int room2 = world_add_room(&world, "room2", "Room 2", "Second room.");
+    int a = world_add_item(&world, "a", "item a", "Item A.", true);
+    int b = world_add_item(&world, "b", "item b", "Item B.", true);
+    int c = world_add_item(&world, "c", "item c", "Item C.", true);
+
+    ASSERT_EQ(ITEM_NOWHERE, world_item_location(&world, a), "new item should be nowhere");
+
+    world_place_item(&world, a, room1);
+    world_place_item(&world, b, room1);
+    world_place_item(&world, c, room1);
+
+    // Items are listed in placement order
+    ASSERT_EQ(a, world_first_item(&world, room1), "first item should be a");
+    ASSERT_EQ(b, world_next_item(&world, a), "second item should be b");
+    ASSERT_EQ(c, world_next_item(&world, b), "third item should be c");
+    ASSERT_EQ(-1, world_next_item(&world, c), "list should end after c");
+
+    // Moving the middle item keeps the rest linked
+    world_place_item(&world, b, room2);
+    ASSERT_EQ(c, world_next_item(&world, a), "a should link to c");
+    ASSERT_EQ(b, world_first_item(&world, room2), "b should be in room2");
+    ASSERT_EQ(-1, world_next_item(&world, b), "room2 should hold only b");
+
+    // Moving the head updates the room's first item
+    ASSERT_TRUE(world_set_item_location(&world, a, ITEM_IN_INVENTORY), "move a to inventory");
+    ASSERT_EQ(c, world_first_item(&world, room1), "c should now head room1");
+    ASSERT_EQ(1, world.inventory_count, "inventory should hold one item");
+    ASSERT_TRUE(world_has_item(&world, "a"), "should have a");
+
+    // Removing from inventory takes the item out of play
+    ASSERT_TRUE(world_remove_from_inventory(&world, "a"), "remove a should succeed");
+    ASSERT_EQ(ITEM_NOWHERE, world_item_location(&world, a), "a should be nowhere");
+    ASSERT_EQ(0, world.inventory_count, "inventory should be empty");
+    ASSERT_FALSE(world_set_item_location(&world, a, 99), "invalid room should be rejected");
+
+    world_free(&world);
+    PASS();
+}
+
+// Test inventory capacity limit
+void test_inventory_full(void) {
+    TEST("Inventory full");
+
+    World world;
+    world_init(&world);
+
+    int room1 = world_add_room(&world, "room1", "Room 1", "First room.");
+    world.current_room = room1;
+
+    char id[32];
+    for (int i = 0; i <= MAX_INVENTORY; i++) {
+        snprintf(id, sizeof(id), "item_%d", i);
+        int idx = world_add_item(&world, id, id, "An item.", true);
+        world_place_item(&world, idx, room1);
+    }
+
+    for (int i = 0; i < MAX_INVENTORY; i++) {
+        snprintf(id, sizeof(id), "item_%d", i);
+        ASSERT_TRUE(world_take_item(&world, id), "take should succeed until full");
+    }
+    snprintf(id, sizeof(id), "item_%d", MAX_INVENTORY);
+    ASSERT_FALSE(world_take_item(&world, id), "take should fail when inventory is full");
+    ASSERT_EQ(room1, world_item_location(&world, MAX_INVENTORY), "item should stay in room");
+
+    world_free(&world);
     PASS();
 }
 
@@ -360,14 +585,54 @@ void test_room_visited(void) {
     int room2 = world_add_room(&world, "room2", "Room 2", "Second room.");
 
     // Initially not visited
-    ASSERT_FALSE(world.rooms[room1].visited, "room1 not visited");
-    ASSERT_FALSE(world.rooms[room2].visited, "room2 not visited");
+    ASSERT_FALSE(world_room_visited(&world, room1), "room1 not visited");
+    ASSERT_FALSE(world_room_visited(&world, room2), "room2 not visited");
 
     // Mark as visited
-    world.rooms[room1].visited = true;
-    ASSERT_TRUE(world.rooms[room1].visited, "room1 visited");
-    ASSERT_FALSE(world.rooms[room2].visited, "room2 still not visited");
+    world_set_room_visited(&world, room1, true);
+    ASSERT_TRUE(world_room_visited(&world, room1), "room1 visited");
+    ASSERT_FALSE(world_room_visited(&world, room2), "room2 still not visited");
+
+    world_free(&world);
+    PASS();
+}
+
+// Test sessions sharing one definition keep separate state
+void test_shared_definition(void) {
+    TEST("Shared world definition");
+
+    World world;
+    world_init(&world);
+
+    int room1 = world_add_room(&world, "room1", "Room 1", "First room.");
+    int room2 = world_add_room(&world, "room2", "Room 2", "Second room.");
+    world_connect_rooms(&world, room1, DIR_NORTH, room2);
+    int key = world_add_item(&world, "key", "key", "A key.", true);
+    world_place_item(&world, key, room1);
+    world.current_room = room1;
 
+    World session;
+    ASSERT_TRUE(world_clone(&session, &world), "clone should succeed");
+    ASSERT_TRUE(session.def == world.def, "sessions should share the definition");
+    ASSERT_FALSE(world_def_writable(world.def), "shared definition should be read-only");
+    ASSERT_EQ(-1, world_add_room(&world, "room3", "Room 3", "Third room."),
+              "adding a room to a shared definition should fail");
+
+    // State changes stay in their own session
+    ASSERT_TRUE(world_take_item(&session, "key"), "session should take key");
+    ASSERT_TRUE(world_move(&session, DIR_NORTH), "session should move north");
+    ASSERT_EQ(room1, world_item_location(&world, key), "key should stay in original");
+    ASSERT_EQ(room1, world.current_room, "original should not move");
+    ASSERT_FALSE(world_room_visited(&world, room2), "original should not see visit");
+    ASSERT_TRUE(world_room_visited(&session, room2), "session should see visit");
+
+    // The definition outlives the session that built it
+    world_free(&world);
+    ASSERT_TRUE(world_def_writable(session.def), "last session should own the definition");
+    ASSERT_STR_EQ("Second room.", world_str(&session, session.def->rooms[room2].description),
+                  "text should survive the original");
+
+    world_free(&session);
     PASS();
 }
 
@@ -379,13 +644,19 @@ int main(void) {
     test_room_creation();
     test_item_creation();
     test_room_connections();
+    test_named_exits();
+    test_bulk_exits();
+    test_find_by_id();
     test_navigation();
     test_item_placement();
     test_take_items();
     test_drop_items();
     test_inventory_management();
+    test_item_location_lists();
+    test_inventory_full();
     test_direction_conversion();
     test_room_visited();
+    test_shared_definition();
 
     printf("\n=== Test Results ===\n");
     printf("  Passed: %d\n", tests_passed);
@@ -0,0 +1,266 @@
+/*
+ * Test Suite for the Compiled World Cache
+ * Tests that unchanged worlds come from cached images, that edits, touches
+ * and damaged images are detected, and that cache trouble never fails a load
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../include/world_cache.h"
+#include "../include/world_snapshot.h"
+
+// Test counter
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name) \
+    printf("  Testing: %s ... ", name); \
+    fflush(stdout);
+
+#define PASS() \
+    do { \
+        printf("✓ PASS\n"); \
+        tests_passed++; \
+    } while(0)
+
+#define FAIL(msg) \
+    do { \
+        printf("✗ FAIL: %s\n", msg); \
+        tests_failed++; \
+    } while(0)
+
+#define ASSERT_TRUE(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_FALSE(cond, msg) \
+    do { \
+        if (cond) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(expected, actual, msg) \
+    do { \
+        if ((expected) != (actual)) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: %d, got: %d)", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_STR_EQ(expected, actual, msg) \
+    do { \
+        if (strcmp(expected, actual) != 0) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: '%.128s', got: '%.128s')", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+static const char *SOURCE_PATH = "/tmp/adventure-test-cache.world";
+static char cache_dir[256];
+static char image_path[512];
+
+// Helper: Write the test world with the hall described as hall_desc
+static bool write_source(const char *hall_desc) {
+    FILE *file = fopen(SOURCE_PATH, "w");
+    if (!file) return false;
+    fprintf(file,
+            "[WORLD]\nname: Cache\nstart: hall\n\n"
+            "[ROOM:hall]\nname: Hall\ndescription: %s\nexits: north=yard\n\n"
+            "[ROOM:yard]\nname: Yard\ndescription: Open sky.\nexits: south=hall\n\n"
+            "[ITEM:lamp]\nname: lamp\ndescription: A lamp.\ntakeable: yes\nlocation: yard\n",
+            hall_desc);
+    fclose(file);
+    return true;
+}
+
+// Helper: Set the source file's mtime (seconds since the epoch)
+static bool set_mtime(time_t when) {
+    struct timespec times[2] = { { when, 0 }, { when, 0 } };
+    return utimensat(AT_FDCWD, SOURCE_PATH, times, 0) == 0;
+}
+
+// Helper: Load through the cache; returns how, or -1 if the load failed
+static int cache_load(World *world, const char *hall_desc) {
+    LoadError error;
+    WorldCacheResult result;
+    if (!world_cache_load(world, SOURCE_PATH, cache_dir, &error, &result)) return -1;
+    const char *desc = world_str(world, world->def->rooms[0].description);
+    if (hall_desc && strcmp(desc, hall_desc) != 0) {
+        printf("(hall: '%s') ", desc);
+        return -1;
+    }
+    return (int)result;
+}
+
+// Test the first open parses and caches, later opens map the image
+void test_miss_then_hit(void) {
+    TEST("Miss, then hit");
+
+    World world;
+    ASSERT_TRUE(write_source("A long hall.") && set_mtime(1000000), "source written");
+    ASSERT_EQ(WORLD_CACHE_MISS, cache_load(&world, "A long hall."), "first open parses");
+    ASSERT_TRUE(world.def->image == NULL, "parsed definition");
+    uint64_t parsed = world_state_hash(&world);
+    world_free(&world);
+    ASSERT_TRUE(access(image_path, F_OK) == 0, "image written to the cache");
+
+    WorldSourceStamp stamp;
+    ASSERT_TRUE(world_image_source(image_path, &stamp), "image has a stamp");
+    ASSERT_TRUE(stamp.hash != 0 && stamp.mtime_sec == 1000000, "stamp records hash and mtime");
+
+    ASSERT_EQ(WORLD_CACHE_HIT, cache_load(&world, "A long hall."), "second open hits");
+    ASSERT_TRUE(world.def->image != NULL, "mapped definition");
+    ASSERT_TRUE(world_state_hash(&world) == parsed, "same world");
+    world_free(&world);
+    PASS();
+}
+
+// Test a touched file is checked by content, then trusted again
+void test_touch(void) {
+    TEST("Touched file revalidated by hash");
+
+    World world;
+    ASSERT_TRUE(write_source("A long hall.") && set_mtime(1000000), "source written");
+    ASSERT_TRUE(cache_load(&world, NULL) >= 0, "cached");
+    world_free(&world);
+
+    ASSERT_TRUE(set_mtime(2000000), "source touched");
+    ASSERT_EQ(WORLD_CACHE_REVALIDATED, cache_load(&world, "A long hall."), "content still matches");
+    world_free(&world);
+    ASSERT_EQ(WORLD_CACHE_HIT, cache_load(&world, "A long hall."), "restamped: hit again");
+    world_free(&world);
+    PASS();
+}
+
+// Test edits are picked up, including ones that keep size and mtime
+void test_edit(void) {
+    TEST("Edited file parsed again");
+
+    World world;
+    ASSERT_TRUE(write_source("A long hall.") && set_mtime(1000000), "source written");
+    ASSERT_TRUE(cache_load(&world, NULL) >= 0, "cached");
+    world_free(&world);
+
+    ASSERT_TRUE(write_source("A wide hall.") && set_mtime(3000000), "same size, new text");
+    ASSERT_EQ(WORLD_CACHE_MISS, cache_load(&world, "A wide hall."), "hash differs: parsed");
+    world_free(&world);
+
+    ASSERT_TRUE(write_source("A very long hall.") && set_mtime(3000000), "new size, same mtime");
+    ASSERT_EQ(WORLD_CACHE_MISS, cache_load(&world, "A very long hall."), "size differs: parsed");
+    world_free(&world);
+    ASSERT_EQ(WORLD_CACHE_HIT, cache_load(&world, "A very long hall."), "new image used");
+    world_free(&world);
+    PASS();
+}
+
+// Test cache trouble falls back to parsing without failing the load
+void test_fallbacks(void) {
+    TEST("Damaged image and unusable cache");
+
+    World world;
+    LoadError error;
+    WorldCacheResult result;
+    ASSERT_TRUE(write_source("A long hall.") && set_mtime(1000000), "source written");
+    ASSERT_TRUE(cache_load(&world, NULL) >= 0, "cached");
+    world_free(&world);
+
+    struct stat st;
+    ASSERT_TRUE(stat(image_path, &st) == 0 && truncate(image_path, st.st_size / 2) == 0,
+                "image damaged");
+    ASSERT_EQ(WORLD_CACHE_MISS, cache_load(&world, "A long hall."), "damaged image replaced");
+    world_free(&world);
+    ASSERT_EQ(WORLD_CACHE_HIT, cache_load(&world, "A long hall."), "replacement used");
+    world_free(&world);
+
+    ASSERT_TRUE(world_cache_load(&world, SOURCE_PATH, NULL, &error, &result), "no cache loads");
+    ASSERT_EQ(WORLD_CACHE_UNCACHED, (int)result, "no cache: parsed");
+    world_free(&world);
+
+    // A cache "directory" below a regular file can't be created
+    char bad_dir[512];
+    snprintf(bad_dir, sizeof(bad_dir), "%s/sub", SOURCE_PATH);
+    ASSERT_TRUE(world_cache_load(&world, SOURCE_PATH, bad_dir, &error, &result), "bad cache loads");
+    ASSERT_EQ(WORLD_CACHE_UNCACHED, (int)result, "bad cache: parsed");
+    world_free(&world);
+
+    ASSERT_TRUE(write_source("") , "broken source written");
+    ASSERT_FALSE(world_cache_load(&world, SOURCE_PATH, cache_dir, &error, &result),
+                 "load errors still reported");
+    ASSERT_TRUE(strstr(error.message, "hall") != NULL, "error names the room");
+    world_free(&world);
+    ASSERT_FALSE(world_cache_load(&world, "/tmp/adventure-test-missing.world", cache_dir, &error,
+                                  &result), "missing file fails");
+    world_free(&world);
+    PASS();
+}
+
+// Test the cache directory comes from the environment
+void test_cache_dir(void) {
+    TEST("Cache directory");
+
+    char dir[512];
+    char path[512];
+    setenv(WORLD_CACHE_ENV, "/tmp/somewhere", 1);
+    ASSERT_TRUE(world_cache_dir(dir, sizeof(dir)), "explicit directory");
+    ASSERT_STR_EQ("/tmp/somewhere", dir, "explicit directory used");
+    setenv(WORLD_CACHE_ENV, "", 1);
+    ASSERT_FALSE(world_cache_dir(dir, sizeof(dir)), "empty turns caching off");
+    unsetenv(WORLD_CACHE_ENV);
+    setenv("XDG_CACHE_HOME", "/tmp/xdg", 1);
+    ASSERT_TRUE(world_cache_dir(dir, sizeof(dir)), "XDG directory");
+    ASSERT_STR_EQ("/tmp/xdg/adventure-engine", dir, "XDG directory used");
+
+    world_cache_path("/c", "worlds/dark_tower.world", dir, sizeof(dir));
+    world_cache_path("/c", "/elsewhere/dark_tower.world", path, sizeof(path));
+    ASSERT_TRUE(strncmp(dir, "/c/dark_tower-", 14) == 0, "named after the world");
+    ASSERT_TRUE(strcmp(dir, path) != 0, "same name elsewhere gets its own image");
+    PASS();
+}
+
+int main(void) {
+    printf("\n=== Compiled World Cache Test Suite ===\n\n");
+
+    snprintf(cache_dir, sizeof(cache_dir), "/tmp/adventure-test-cache-%d/worlds", (int)getpid());
+    world_cache_path(cache_dir, SOURCE_PATH, image_path, sizeof(image_path));
+
+    test_miss_then_hit();
+    test_touch();
+    test_edit();
+    test_fallbacks();
+    test_cache_dir();
+
+    unlink(image_path);
+    rmdir(cache_dir);
+    *strrchr(cache_dir, '/') = '\0';
+    rmdir(cache_dir);
+    unlink(SOURCE_PATH);
+
+    printf("\n=== Test Results ===\n");
+    printf("  Passed: %d\n", tests_passed);
+    printf("  Failed: %d\n", tests_failed);
+    printf("  Total:  %d\n", tests_passed + tests_failed);
+
+    if (tests_failed == 0) {
+        printf("\n✓ All tests passed!\n\n");
+        return 0;
+    } else {
+        printf("\n✗ Some tests failed!\n\n");
+        return 1;
+    }
+}
@@ -0,0 +1,341 @@
+/*
+ * Test Suite for Compiled World Images
+ * Tests that a .worldc image (or linked-in tables) opens as the same world
+ * as its source, stays read-only, and that damaged or foreign images are
+ * rejected
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../include/game.h"
+#include "../include/world.h"
+#include "../include/world_cache.h"
+#include "../include/world_image.h"
+#include "../include/world_snapshot.h"
+
+// Test counter
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name) \
+    printf("  Testing: %s ... ", name); \
+    fflush(stdout);
+
+#define PASS() \
+    do { \
+        printf("✓ PASS\n"); \
+        tests_passed++; \
+    } while(0)
+
+#define FAIL(msg) \
+    do { \
+        printf("✗ FAIL: %s\n", msg); \
+        tests_failed++; \
+    } while(0)
+
+#define ASSERT_TRUE(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_FALSE(cond, msg) \
+    do { \
+        if (cond) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(expected, actual, msg) \
+    do { \
+        if ((expected) != (actual)) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: %d, got: %d)", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_STR_EQ(expected, actual, msg) \
+    do { \
+        if (strcmp(expected, actual) != 0) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: '%.128s', got: '%.128s')", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+static const char *SOURCE_PATH = "/tmp/adventure-test-image.world";
+static const char *IMAGE_PATH = "/tmp/adventure-test-image.worldc";
+
+// Helper: A world using every kind of definition data: named and locked
+// exits, conditional descriptions, usable items, verbs and a start room
+// that isn't the first
+static bool write_source(void) {
+    FILE *file = fopen(SOURCE_PATH, "w");
+    if (!file) return false;
+    fprintf(file,
+            "[WORLD]\nname: Image\nstart: yard\n\n"
+            "[VERBS]\ntake: grab, snatch\n\n"
+            "[ROOM:hall]\nname: Hall\ndescription: A long hall.\n"
+            "description_if(has_item=lamp): The lamp lights the hall.\n"
+            "exits: south=yard, through the mirror=attic\nlocked_exits: through the mirror=key\n\n"
+            "[ROOM:yard]\nname: Yard\ndescription: Open sky.\n"
+            "description_if(first_visit): You step into the light.\nexits: north=hall\n\n"
+            "[ROOM:attic]\nname: Attic\ndescription: Dusty rafters.\nexits: down=hall\n\n"
+            "[ITEM:key]\nname: silver key\ndescription: A silver key.\ntakeable: yes\nlocation: yard\n\n"
+            "[ITEM:lamp]\nname: oil lamp\ndescription: An oil lamp.\ntakeable: yes\nlocation: yard\n"
+            "use_message: The lamp flares.\nuse_consumable: no\n\n"
+            "[ITEM:statue]\nname: statue\ndescription: A heavy statue.\ntakeable: no\nlocation: hall\n");
+    fclose(file);
+    return true;
+}
+
+// Helper: Compile the test world's source to its image
+static bool compile_source(void) {
+    World world;
+    LoadError error;
+    if (!write_source() || !world_load_from_file(&world, SOURCE_PATH, &error)) return false;
+    bool written = world_image_write(&world, IMAGE_PATH, NULL, &error);
+    world_free(&world);
+    return written;
+}
+
+// Test an image holds the same definition and starting state as its source
+void test_round_trip(void) {
+    TEST("Image matches its source");
+
+    ASSERT_TRUE(compile_source(), "image written");
+    World source;
+    World image;
+    LoadError error;
+    ASSERT_TRUE(world_load_from_file(&source, SOURCE_PATH, &error), "source loads");
+    ASSERT_TRUE(world_image_load(&image, IMAGE_PATH, &error), "image loads");
+    world_compile_conditions(&source);
+
+    ASSERT_TRUE(image.def->image != NULL, "definition is mapped");
+    ASSERT_EQ(source.def->room_count, image.def->room_count, "room count");
+    ASSERT_EQ(source.def->exit_count, image.def->exit_count, "exit count");
+    ASSERT_EQ(source.def->item_count, image.def->item_count, "item count");
+    ASSERT_EQ(source.current_room, image.current_room, "start room");
+    ASSERT_TRUE(world_room_visited(&image, image.current_room), "start room visited");
+    for (int r = 0; r < source.def->room_count; r++) {
+        ASSERT_STR_EQ(world_str(&source, source.def->rooms[r].id),
+                      world_str(&image, image.def->rooms[r].id), "room id");
+        ASSERT_EQ(r, world_find_room(&image, world_str(&source, source.def->rooms[r].id)),
+                  "room found by id");
+        ASSERT_EQ(world_exits_end(&source, r) - world_exits_begin(&source, r),
+                  world_exits_end(&image, r) - world_exits_begin(&image, r), "exits per room");
+        ASSERT_EQ(source.def->rooms[r].conditional_desc_count,
+                  image.def->rooms[r].conditional_desc_count, "conditions per room");
+    }
+    for (int i = 0; i < source.def->item_count; i++) {
+        ASSERT_EQ(i, world_find_item(&image, world_str(&source, source.def->items[i].id)),
+                  "item found by id");
+        ASSERT_EQ(world_item_location(&source, i), world_item_location(&image, i),
+                  "item placement");
+    }
+    ASSERT_EQ(-1, world_find_room(&image, "cellar"), "unknown room");
+
+    int hall = world_find_room(&image, "hall");
+    int mirror = world_find_exit(&image, hall, "through the mirror");
+    ASSERT_TRUE(mirror != -1, "named exit");
+    ASSERT_STR_EQ("key", world_str(&image, world_exit(&image, mirror)->key), "exit lock");
+    const int32_t *exits;
+    ASSERT_EQ(1, world_key_exits(&image, world_find_item(&image, "key"), &exits), "key's exits");
+    ASSERT_EQ(mirror, exits[0], "key opens the mirror");
+
+    ConditionalDesc *conditions = world_room_conditions(image.def, &image.def->rooms[hall]);
+    ASSERT_TRUE(conditions != NULL, "hall conditions");
+    ASSERT_STR_EQ("The lamp lights the hall.", world_str(&image, conditions[0].description),
+                  "condition text");
+    ASSERT_EQ(world_find_item(&image, "lamp"), conditions[0].item, "compiled condition item");
+    ASSERT_EQ(VERB_TAKE, verb_table_find(&image.def->verbs, "snatch", strlen("snatch")),
+              "world verb");
+    ASSERT_EQ(VERB_LOOK, verb_table_find(&image.def->verbs, "look", strlen("look")),
+              "built-in verb");
+    ASSERT_TRUE(world_state_hash(&source) == world_state_hash(&image), "same starting state");
+
+    world_free(&source);
+    world_free(&image);
+    PASS();
+}
+
+// Test an image's definition can't be changed but its sessions can
+void test_read_only(void) {
+    TEST("Image is read-only and clonable");
+
+    World world;
+    LoadError error;
+    ASSERT_TRUE(compile_source(), "image written");
+    ASSERT_TRUE(world_image_load(&world, IMAGE_PATH, &error), "image loads");
+    ASSERT_FALSE(world_def_writable(world.def), "definition not writable");
+    ASSERT_EQ(-1, world_add_room(&world, "cellar", "Cellar", "Dark."), "room not added");
+
+    World clone;
+    ASSERT_TRUE(world_clone(&clone, &world), "clone shares the image");
+    ASSERT_TRUE(clone.def == world.def, "same definition");
+    ASSERT_TRUE(world_take_item(&clone, "lamp"), "clone plays");
+    ASSERT_TRUE(world_has_item(&clone, "lamp"), "clone has lamp");
+    ASSERT_FALSE(world_has_item(&world, "lamp"), "original unchanged");
+    world_free(&world);
+    ASSERT_STR_EQ("oil lamp", world_str(&clone, clone.def->items[world_find_item(&clone, "lamp")].name),
+                  "image kept while a clone uses it");
+    world_free(&clone);
+    PASS();
+}
+
+// Test playing the image ends in the same state as playing the source
+void test_play(void) {
+    TEST("Image plays like its source");
+
+    ASSERT_TRUE(compile_source(), "image written");
+    const char *commands[] = {
+        "take lamp", "north", "look", "through the mirror", "south", "grab key",
+        "north", "through the mirror", "down", "drop lamp", "use lamp"
+    };
+    uint64_t hashes[2];
+    const char *paths[2] = { SOURCE_PATH, IMAGE_PATH };
+    for (int g = 0; g < 2; g++) {
+        Game game;
+        LoadError error;
+        game_init(&game, NULL);
+        ASSERT_TRUE(game_open_file(&game, paths[g], "image", &error), "game opens");
+        ASSERT_EQ(g == 1, game.world.def->image != NULL, "image chosen by extension");
+        game_start(&game);
+        for (size_t c = 0; c < sizeof(commands) / sizeof(commands[0]); c++) {
+            game_command(&game, commands[c]);
+        }
+        ASSERT_EQ(world_find_room(&game.world, "hall"), game.world.current_room,
+                  "back in the hall");
+        ASSERT_EQ(game.world.current_room, world_item_location(&game.world, world_find_item(&game.world, "lamp")),
+                  "lamp dropped there");
+        hashes[g] = world_state_hash(&game.world);
+        game_free(&game);
+    }
+    ASSERT_TRUE(hashes[0] == hashes[1], "same final state");
+    PASS();
+}
+
+// Test a session over flattened tables (what world-embed links in) plays
+// like the world they came from
+void test_tables(void) {
+    TEST("Session over world tables");
+
+    World source;
+    LoadError error;
+    WorldTables tables;
+    ASSERT_TRUE(write_source(), "source written");
+    ASSERT_TRUE(world_load_from_file(&source, SOURCE_PATH, &error), "source loads");
+    ASSERT_TRUE(world_tables_build(&source, &tables, &error), "tables built");
+    ASSERT_EQ(2, tables.condition_count, "conditions packed");
+    ASSERT_EQ(source.current_room, tables.start_room, "start room");
+
+    World world;
+    ASSERT_TRUE(world_tables_open(&world, &tables, &error), "tables open");
+    ASSERT_TRUE(world.def->image == &tables && world.def->image_size == 0, "tables used in place");
+    ASSERT_FALSE(world_def_writable(world.def), "definition not writable");
+    ASSERT_TRUE(world_state_hash(&source) == world_state_hash(&world), "same starting state");
+
+    World clone;
+    ASSERT_TRUE(world_clone(&clone, &world), "clone shares the tables");
+    ASSERT_TRUE(world_take_item(&source, "lamp") && world_take_item(&clone, "lamp"), "both play");
+    ASSERT_TRUE(world_move(&source, DIR_NORTH) && world_move(&clone, DIR_NORTH), "both move");
+    ASSERT_STR_EQ(world_get_room_description(&source, &source.def->rooms[source.current_room]),
+                  world_get_room_description(&clone, &clone.def->rooms[clone.current_room]),
+                  "same conditional description");
+    ASSERT_TRUE(world_state_hash(&source) == world_state_hash(&clone), "same state after play");
+
+    world_free(&world);
+    world_free(&clone);
+    world_tables_free(&tables);
+    world_free(&source);
+    PASS();
+}
+
+// Helper: Overwrite bytes of the image at offset
+static bool patch_image(long offset, const void *bytes, size_t size) {
+    FILE *file = fopen(IMAGE_PATH, "r+b");
+    if (!file) return false;
+    bool ok = fseek(file, offset, SEEK_SET) == 0 && fwrite(bytes, 1, size, file) == size;
+    fclose(file);
+    return ok;
+}
+
+// Test images that aren't from this build are refused with a reason
+void test_rejected(void) {
+    TEST("Bad images rejected");
+
+    World world;
+    LoadError error;
+    ASSERT_FALSE(world_image_load(&world, "/tmp/adventure-test-missing.worldc", &error),
+                 "missing file fails");
+    ASSERT_TRUE(strstr(error.message, "Cannot open") != NULL, "missing file reported");
+    world_free(&world);
+
+    ASSERT_TRUE(write_source(), "source written");
+    ASSERT_FALSE(world_image_load(&world, SOURCE_PATH, &error), "source is not an image");
+    ASSERT_TRUE(strstr(error.message, "Not a compiled world image") != NULL, "wrong kind reported");
+    world_free(&world);
+
+    ASSERT_TRUE(compile_source(), "image written");
+    const char magic[] = "XXWORLDC";
+    ASSERT_TRUE(patch_image(0, magic, 8), "magic patched");
+    ASSERT_FALSE(world_image_load(&world, IMAGE_PATH, &error), "bad magic fails");
+    world_free(&world);
+
+    ASSERT_TRUE(compile_source(), "image rewritten");
+    uint32_t version = WORLD_IMAGE_VERSION + 1;
+    ASSERT_TRUE(patch_image(8, &version, sizeof(version)), "version patched");
+    ASSERT_FALSE(world_image_load(&world, IMAGE_PATH, &error), "other version fails");
+    ASSERT_TRUE(strstr(error.message, "version") != NULL, "version reported");
+    world_free(&world);
+
+    ASSERT_TRUE(compile_source(), "image rewritten");
+    FILE *file = fopen(IMAGE_PATH, "rb");
+    ASSERT_TRUE(file != NULL, "image readable");
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    ASSERT_TRUE(truncate(IMAGE_PATH, size - 1) == 0, "image truncated");
+    ASSERT_FALSE(world_image_load(&world, IMAGE_PATH, &error), "truncated image fails");
+    ASSERT_TRUE(strstr(error.message, "truncated") != NULL, "truncation reported");
+    ASSERT_TRUE(world.def != NULL && world.def->room_count == 0, "empty world after failure");
+    world_free(&world);
+
+    unlink(SOURCE_PATH);
+    unlink(IMAGE_PATH);
+    PASS();
+}
+
+int main(void) {
+    printf("\n=== Compiled World Image Test Suite ===\n\n");
+    setenv(WORLD_CACHE_ENV, "", 1);  // Games here parse their .world files
+
+    test_round_trip();
+    test_read_only();
+    test_play();
+    test_tables();
+    test_rejected();
+
+    printf("\n=== Test Results ===\n");
+    printf("  Passed: %d\n", tests_passed);
+    printf("  Failed: %d\n", tests_failed);
+    printf("  Total:  %d\n", tests_passed + tests_failed);
+
+    if (tests_failed == 0) {
+        printf("\n✓ All tests passed!\n\n");
+        return 0;
+    } else {
+        printf("\n✗ Some tests failed!\n\n");
+        return 1;
+    }
+}
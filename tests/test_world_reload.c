@@ -0,0 +1,601 @@
+/*
+ * Test Suite for World Hot Reload
+ * Tests that sessions moved onto an edited world keep the player's room,
+ * inventory and flags, that only changed rooms are touched, that saved
+ * world files are reported by the watcher, and that recordings seek across
+ * a reload
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../include/game_farm.h"
+#include "../include/recording.h"
+#include "../include/world_reload.h"
+#include "../include/world_snapshot.h"
+#include "../include/world_watch.h"
+
+// Test counter
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name) \
+    printf("  Testing: %s ... ", name); \
+    fflush(stdout);
+
+#define PASS() \
+    do { \
+        printf("✓ PASS\n"); \
+        tests_passed++; \
+    } while(0)
+
+#define FAIL(msg) \
+    do { \
+        printf("✗ FAIL: %s\n", msg); \
+        tests_failed++; \
+    } while(0)
+
+#define ASSERT_TRUE(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_FALSE(cond, msg) \
+    do { \
+        if (cond) { \
+            FAIL(msg); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(expected, actual, msg) \
+    do { \
+        if ((expected) != (actual)) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: %d, got: %d)", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+#define ASSERT_STR_EQ(expected, actual, msg) \
+    do { \
+        if (strcmp(expected, actual) != 0) { \
+            char err[512]; \
+            snprintf(err, sizeof(err), "%s (expected: '%.128s', got: '%.128s')", msg, expected, actual); \
+            FAIL(err); \
+            return; \
+        } \
+    } while(0)
+
+// What an author might change between two saves of a world
+typedef struct {
+    const char *yard_desc;    // Yard's description
+    bool cellar;              // Add a cellar below the hall, with a coin in it
+    bool drop_rope;           // Remove the rope
+    bool drop_yard;           // Remove the yard (and the lamp's room with it)
+} Edit;
+
+// Helper: Hall, yard (locked behind the key) and attic, with a key,
+// a lamp and a rope; the hall reads differently while the key is there
+static void build_world(World *world, const Edit *edit) {
+    world_init(world);
+    int hall = world_add_room(world, "hall", "Hall", "A long hall.");
+    world_add_conditional_desc(world, hall, COND_ROOM_HAS_ITEM, "key", false,
+                               "A long hall. A key glints on the floor.");
+    int yard = edit->drop_yard ? -1 : world_add_room(world, "yard", "Yard", edit->yard_desc);
+    int attic = world_add_room(world, "attic", "Attic", "Dusty rafters.");
+    int cellar = edit->cellar ? world_add_room(world, "cellar", "Cellar", "Damp stone.") : -1;
+
+    world_connect_rooms(world, hall, DIR_UP, attic);
+    world_connect_rooms(world, attic, DIR_DOWN, hall);
+    if (yard >= 0) {
+        world_connect_rooms(world, hall, DIR_NORTH, yard);
+        world_connect_rooms(world, yard, DIR_SOUTH, hall);
+        world_set_exit_key(world, world_direction_exit(world, hall, DIR_NORTH), "key");
+    }
+    if (cellar >= 0) {
+        world_connect_rooms(world, hall, DIR_DOWN, cellar);
+        world_connect_rooms(world, cellar, DIR_UP, hall);
+    }
+
+    int key = world_add_item(world, "key", "brass key", "A small brass key.", true);
+    world_place_item(world, key, hall);
+    int lamp = world_add_item(world, "lamp", "lamp", "An oil lamp.", true);
+    world_place_item(world, lamp, yard >= 0 ? yard : attic);
+    if (!edit->drop_rope) {
+        int rope = world_add_item(world, "rope", "rope", "A coil of rope.", true);
+        world_place_item(world, rope, attic);
+    }
+    if (cellar >= 0) {
+        int coin = world_add_item(world, "coin", "coin", "A gold coin.", true);
+        world_place_item(world, coin, cellar);
+    }
+    world->current_room = hall;
+    world_compile_conditions(world);
+}
+
+// Helper: Description of a room, by ID
+static const char* describe(World *world, const char *room_id) {
+    int room = world_find_room(world, room_id);
+    return room >= 0 ? world_get_room_description(world, &world->def->rooms[room]) : "";
+}
+
+// Helper: Take the key, unlock and go north, take the lamp
+static bool play(World *world) {
+    return world_take_item(world, "key") &&
+           world_unlock_with_key(world, world_find_item(world, "key"), -1) == 1 &&
+           world_move(world, DIR_NORTH) && world_take_item(world, "lamp");
+}
+
+// Test a text-only edit keeps the session's state arrays and history
+void test_text_edit(void) {
+    TEST("Text edit reloads in place");
+
+    Edit v1 = { "Open sky.", false, false, false };
+    Edit v2 = { "Open sky, wet with rain.", false, false, false };
+    World world, next;
+    WorldJournal journal;
+    build_world(&world, &v1);
+    ASSERT_TRUE(world_journal_init(&journal, 64), "journal");
+    world.journal = &journal;
+    world_journal_begin_turn(&journal);
+    ASSERT_TRUE(play(&world), "played to the yard");
+    describe(&world, "hall");
+    describe(&world, "attic");
+    ASSERT_STR_EQ("Open sky.", describe(&world, "yard"), "old yard");
+
+    build_world(&next, &v2);
+    WorldDiff diff;
+    ASSERT_TRUE(world_diff_build(&diff, &world, &next), "diff built");
+    ASSERT_TRUE(diff.same_layout, "same layout");
+    ASSERT_EQ(1, diff.rooms_changed, "one room changed");
+    ASSERT_EQ(0, diff.items_changed, "no items changed");
+    ASSERT_EQ(0, diff.exits_changed, "no exits changed");
+
+    uint64_t *visited = world.visited;
+    ItemLocation *locations = world.item_location;
+    ASSERT_TRUE(world_reload(&world, &diff), "reloaded");
+    ASSERT_FALSE(world_reload(&world, &diff), "second reload refused: already moved");
+    ASSERT_TRUE(world.def == next.def, "on the new definition");
+    ASSERT_TRUE(world.visited == visited && world.item_location == locations, "state kept in place");
+
+    // Unchanged rooms keep their cached description; the yard is redone
+    int hall = world_find_room(&world, "hall");
+    int yard = world_find_room(&world, "yard");
+    ASSERT_TRUE(bitset_test(world.description_cached, (size_t)hall), "hall cache kept");
+    ASSERT_FALSE(bitset_test(world.description_cached, (size_t)yard), "yard cache dropped");
+    ASSERT_STR_EQ("A long hall.", describe(&world, "hall"), "hall text from new pool");
+    ASSERT_STR_EQ("Open sky, wet with rain.", describe(&world, "yard"), "new yard");
+
+    ASSERT_EQ(yard, world.current_room, "still in the yard");
+    ASSERT_TRUE(world_has_item(&world, "key") && world_has_item(&world, "lamp"), "still carrying");
+    ASSERT_TRUE(world_exit_open(&world, world_direction_exit(&world, hall, DIR_NORTH)),
+                "door still unlocked");
+    ASSERT_TRUE(world_journal_undo(&world), "undo history kept");
+    ASSERT_EQ(hall, world.current_room, "undo goes back to the hall");
+    ASSERT_FALSE(world_has_item(&world, "key"), "undo puts the key back");
+
+    world_diff_free(&diff);
+    world_free(&next);
+    world.journal = NULL;
+    world_journal_free(&journal);
+    world_free(&world);
+    PASS();
+}
+
+// Test added and removed rooms, exits and items carry state over by ID
+void test_layout_edit(void) {
+    TEST("Layout edit carries state by ID");
+
+    Edit v1 = { "Open sky.", false, false, false };
+    Edit v2 = { "Open sky.", true, true, false };
+    World world, next;
+    WorldJournal journal;
+    build_world(&world, &v1);
+    ASSERT_TRUE(world_journal_init(&journal, 64), "journal");
+    world.journal = &journal;
+    ASSERT_TRUE(play(&world), "played to the yard");
+    ASSERT_TRUE(world_drop_item(&world, "key"), "key left in the yard");
+    world_set_item_used(&world, world_find_item(&world, "lamp"), true);
+    world_set_room_visited(&world, world_find_room(&world, "attic"), true);
+
+    build_world(&next, &v2);
+    WorldDiff diff;
+    ASSERT_TRUE(world_diff_build(&diff, &world, &next), "diff built");
+    ASSERT_FALSE(diff.same_layout, "layout changed");
+    ASSERT_EQ(2, diff.rooms_changed, "cellar added, hall gained an exit");
+    ASSERT_EQ(0, diff.rooms_removed, "no rooms removed");
+    ASSERT_EQ(2, diff.items_changed, "rope removed, coin added");
+    ASSERT_EQ(2, diff.exits_changed, "two exits added");
+    ASSERT_TRUE(world_reload(&world, &diff), "reloaded");
+    ASSERT_FALSE(world_journal_undo(&world), "history cleared: indices moved");
+
+    int hall = world_find_room(&world, "hall");
+    int yard = world_find_room(&world, "yard");
+    ASSERT_EQ(yard, world.current_room, "still in the yard");
+    ASSERT_TRUE(world_room_visited(&world, yard), "visits kept");
+    ASSERT_TRUE(world_room_visited(&world, world_find_room(&world, "attic")), "attic visit kept");
+    ASSERT_FALSE(world_room_visited(&world, hall), "unvisited stays unvisited");
+    ASSERT_FALSE(world_room_visited(&world, world_find_room(&world, "cellar")), "cellar unvisited");
+    ASSERT_TRUE(world_has_item(&world, "lamp"), "lamp still carried");
+    ASSERT_EQ(1, world.inventory_count, "nothing else carried");
+    ASSERT_TRUE(world_item_used(&world, world_find_item(&world, "lamp")), "lamp still used");
+    ASSERT_EQ(yard, world_item_location(&world, world_find_item(&world, "key")), "key still in yard");
+    ASSERT_EQ(world_find_room(&world, "cellar"),
+              world_item_location(&world, world_find_item(&world, "coin")), "coin where the file puts it");
+    ASSERT_EQ(-1, world_find_item(&world, "rope"), "rope gone");
+    ASSERT_TRUE(world_exit_open(&world, world_direction_exit(&world, hall, DIR_NORTH)),
+                "door still unlocked");
+    ASSERT_STR_EQ("A long hall.", describe(&world, "hall"), "hall without its key");
+    ASSERT_TRUE(world_move(&world, DIR_SOUTH) && world_move(&world, DIR_DOWN), "new exit works");
+
+    world_diff_free(&diff);
+    world_free(&next);
+    world.journal = NULL;
+    world_journal_free(&journal);
+    world_free(&world);
+    PASS();
+}
+
+// Test a player and items in a removed room go where the file now says
+void test_removed_room(void) {
+    TEST("Removed room");
+
+    Edit v1 = { "Open sky.", false, false, false };
+    Edit v2 = { "Open sky.", false, false, true };
+    World world, next;
+    build_world(&world, &v1);
+    ASSERT_TRUE(world_take_item(&world, "key") &&
+                world_unlock_with_key(&world, world_find_item(&world, "key"), -1) == 1 &&
+                world_move(&world, DIR_NORTH), "in the yard, lamp left there");
+
+    build_world(&next, &v2);
+    WorldDiff diff;
+    ASSERT_TRUE(world_diff_build(&diff, &world, &next), "diff built");
+    ASSERT_EQ(1, diff.rooms_removed, "yard removed");
+    ASSERT_TRUE(world_reload(&world, &diff), "reloaded");
+    ASSERT_EQ(next.current_room, world.current_room, "back at the start");
+    ASSERT_TRUE(world_has_item(&world, "key"), "key still carried");
+    ASSERT_EQ(world_find_room(&world, "attic"),
+              world_item_location(&world, world_find_item(&world, "lamp")), "lamp moved by the file");
+
+    world_diff_free(&diff);
+    world_free(&next);
+    world_free(&world);
+    PASS();
+}
+
+// Test sessions sharing a definition move with one diff and release it
+void test_shared(void) {
+    TEST("Shared sessions");
+
+    Edit v1 = { "Open sky.", false, false, false };
+    Edit v2 = { "Grey sky.", false, false, false };
+    World base, a, b, next;
+    build_world(&base, &v1);
+    ASSERT_TRUE(world_clone(&a, &base) && world_clone(&b, &base), "sessions cloned");
+    ASSERT_TRUE(world_take_item(&b, "key"), "b took the key");
+    WorldDef *old = base.def;
+    world_free(&base);
+    ASSERT_EQ(2, atomic_load(&old->refcount), "two sessions on the old definition");
+
+    build_world(&next, &v2);
+    WorldDiff diff;
+    ASSERT_TRUE(world_diff_build(&diff, &a, &next), "diff built");
+    ASSERT_TRUE(world_reload(&a, &diff) && world_reload(&b, &diff), "both reloaded");
+    ASSERT_EQ(3, atomic_load(&next.def->refcount), "both on the new definition");
+    ASSERT_FALSE(world_def_writable(next.def), "new definition read-only");
+    ASSERT_FALSE(world_has_item(&a, "key"), "a's state kept");
+    ASSERT_TRUE(world_has_item(&b, "key"), "b's state kept");
+
+    world_diff_free(&diff);
+    world_free(&next);
+    world_free(&a);
+    world_free(&b);
+    PASS();
+}
+
+static char watch_dir[256];
+
+// Helper: Write a file in the watched directory
+static bool write_file(const char *name, const char *text) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", watch_dir, name);
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+    fputs(text, file);
+    return fclose(file) == 0;
+}
+
+// Helper: Remove a file from the watched directory
+static void remove_file(const char *name) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", watch_dir, name);
+    unlink(path);
+}
+
+// Test saves and renames into place are reported once per world
+void test_watcher(void) {
+    TEST("Watcher reports saved worlds");
+
+    WorldWatcher *watcher = world_watcher_open(watch_dir);
+#ifndef __linux__
+    ASSERT_TRUE(watcher == NULL, "no inotify: no watcher");
+    PASS();
+    return;
+#endif
+    ASSERT_TRUE(watcher != NULL, "watching");
+    ASSERT_TRUE(world_watcher_fd(watcher) >= 0, "pollable");
+    char name[64];
+    ASSERT_FALSE(world_watcher_next(watcher, name, sizeof(name)), "nothing yet");
+
+    ASSERT_TRUE(write_file("cave.world", "[WORLD]\n") && write_file("cave.world", "[WORLD]\n") &&
+                write_file("notes.txt", "todo\n"), "files written");
+    ASSERT_TRUE(world_watcher_next(watcher, name, sizeof(name)), "save seen");
+    ASSERT_STR_EQ("cave", name, "world named");
+    ASSERT_FALSE(world_watcher_next(watcher, name, sizeof(name)), "two saves reported once");
+
+    // Editors that save through a temporary file
+    char from[512], to[512];
+    ASSERT_TRUE(write_file(".tower.world.swp", "[WORLD]\n"), "temporary written");
+    snprintf(from, sizeof(from), "%s/.tower.world.swp", watch_dir);
+    snprintf(to, sizeof(to), "%s/tower.world", watch_dir);
+    ASSERT_TRUE(rename(from, to) == 0, "renamed into place");
+    ASSERT_TRUE(world_watcher_next(watcher, name, sizeof(name)), "rename seen");
+    ASSERT_STR_EQ("tower", name, "renamed world named");
+    ASSERT_FALSE(world_watcher_next(watcher, name, sizeof(name)), "nothing else");
+
+    world_watcher_close(watcher);
+    remove_file("cave.world");
+    remove_file("tower.world");
+    remove_file("notes.txt");
+    PASS();
+}
+
+// Test saves beyond what the watcher can hold ask for a rescan, and the
+// rescan finds a changed file by its stamp
+void test_watcher_overflow(void) {
+    TEST("Watcher asks for a rescan after missed saves");
+
+    WorldWatcher *watcher = world_watcher_open(watch_dir);
+#ifndef __linux__
+    ASSERT_TRUE(watcher == NULL, "no inotify: no watcher");
+    PASS();
+    return;
+#endif
+    ASSERT_TRUE(watcher != NULL, "watching");
+
+    enum { SAVED = WORLD_WATCH_PENDING + 6 };
+    char file[64];
+    for (int w = 0; w < SAVED; w++) {
+        snprintf(file, sizeof(file), "world%02d.world", w);
+        ASSERT_TRUE(write_file(file, "[WORLD]\n"), "world saved");
+    }
+
+    char name[64];
+    int named = 0;
+    bool rescan = false;
+    while (world_watcher_next(watcher, name, sizeof(name))) {
+        ASSERT_FALSE(rescan, "rescan reported last");
+        if (strcmp(name, WORLD_WATCH_RESCAN) == 0) {
+            rescan = true;
+        } else {
+            named++;
+        }
+    }
+    ASSERT_EQ(WORLD_WATCH_PENDING, named, "names kept");
+    ASSERT_TRUE(rescan, "rescan reported");
+
+    // Reported once; later saves are named again
+    ASSERT_TRUE(write_file("world00.world", "[WORLD]\n"), "world saved again");
+    ASSERT_TRUE(world_watcher_next(watcher, name, sizeof(name)), "save seen");
+    ASSERT_STR_EQ("world00", name, "world named");
+    ASSERT_FALSE(world_watcher_next(watcher, name, sizeof(name)), "no second rescan");
+
+    // What a rescan compares: a zeroed stamp differs, the same file doesn't
+    WorldSourceStamp stamp = {0};
+    ASSERT_TRUE(game_world_changed("dark_tower", &stamp), "first look counts as changed");
+    ASSERT_FALSE(game_world_changed("dark_tower", &stamp), "unchanged file");
+    stamp.mtime_nsec++;
+    ASSERT_TRUE(game_world_changed("dark_tower", &stamp), "other version");
+    ASSERT_FALSE(game_world_changed("no_such_world", &stamp), "missing file");
+
+    world_watcher_close(watcher);
+    for (int w = 0; w < SAVED; w++) {
+        snprintf(file, sizeof(file), "world%02d.world", w);
+        remove_file(file);
+    }
+    PASS();
+}
+
+// Test a farm moves its games between commands
+void test_farm(void) {
+    TEST("Farm reload");
+
+    Edit v1 = { "Open sky.", false, false, false };
+    Edit v2 = { "Open sky, wet with rain.", true, false, false };
+    World base, next, other;
+    build_world(&base, &v1);
+    build_world(&other, &v1);
+
+    Game games[3];
+    GameFarm *farm = game_farm_create(2, 3);
+    ASSERT_TRUE(farm != NULL, "farm created");
+    for (int g = 0; g < 3; g++) {
+        game_init(&games[g], NULL);
+        ASSERT_TRUE(game_open_shared(&games[g], g < 2 ? &base : &other, g < 2 ? "cave" : "tower"),
+                    "game opened");
+        game_start(&games[g]);
+        game_farm_add(farm, &games[g]);
+    }
+    for (int g = 0; g < 3; g++) {
+        game_farm_submit(farm, g, "take key");
+        game_farm_submit(farm, g, "north");
+    }
+    game_farm_drain(farm);
+
+    build_world(&next, &v2);
+    ASSERT_EQ(2, game_farm_reload(farm, "cave", &next), "cave games moved");
+    ASSERT_EQ(0, game_farm_reload(farm, "cave", &next), "already moved");
+    for (int g = 0; g < 3; g++) {
+        game_farm_submit(farm, g, "look");
+    }
+    game_farm_drain(farm);
+
+    for (int g = 0; g < 2; g++) {
+        ASSERT_TRUE(games[g].world.def == next.def, "moved to the new definition");
+        ASSERT_TRUE(world_has_item(&games[g].world, "key"), "key still carried");
+        ASSERT_STR_EQ("Open sky, wet with rain.", describe(&games[g].world, "yard"), "new yard");
+        ASSERT_EQ(3, games[g].turns, "turns kept");
+    }
+    ASSERT_TRUE(games[2].world.def == other.def, "other world's game untouched");
+
+    game_farm_destroy(farm);
+    for (int g = 0; g < 3; g++) {
+        game_free(&games[g]);
+    }
+    world_free(&base);
+    world_free(&other);
+    world_free(&next);
+    PASS();
+}
+
+// Test a recording made through a layout-changing reload seeks to turns
+// on both sides, even from a viewer opened on the new version
+void test_recording(void) {
+    TEST("Recording across a layout reload");
+
+    // Two commands each side are undo/redo, kept as state in the recording
+    static const char *const before[] = { "take key", "up", "take rope", "undo", "redo" };
+    static const char *const after[] = { "down", "down", "take coin", "undo", "up", "look" };
+    enum { BEFORE = 5, AFTER = 6, TURNS = BEFORE + AFTER };
+
+    Edit v1 = { "Open sky.", false, false, false };
+    Edit v2 = { "Open sky.", true, true, false };
+    World base, next, viewed;
+    build_world(&base, &v1);
+    build_world(&next, &v2);
+    build_world(&viewed, &v2);
+
+    char path[300];
+    snprintf(path, sizeof(path), "%s/cave.rec", watch_dir);
+    Recorder recorder;
+    Game game;
+    ASSERT_TRUE(recorder_open(&recorder, path, 4), "recorder opened");
+    game_init(&game, NULL);
+    game.recorder = &recorder;
+    ASSERT_TRUE(game_open_shared(&game, &base, "cave"), "game opened");
+    game_start(&game);
+
+    // hashes[t] is the state after t commands; the reload comes after BEFORE
+    uint64_t hashes[TURNS + 1];
+    hashes[0] = world_state_hash(&game.world);
+    for (int t = 0; t < BEFORE; t++) {
+        game_command(&game, before[t]);
+        hashes[t + 1] = world_state_hash(&game.world);
+    }
+    WorldDiff diff;
+    ASSERT_TRUE(world_diff_build(&diff, &game.world, &next), "diff built");
+    ASSERT_FALSE(diff.same_layout, "layout changed");
+    ASSERT_TRUE(game_reload(&game, &diff), "game reloaded");
+    world_diff_free(&diff);
+    hashes[BEFORE] = world_state_hash(&game.world);
+    for (int t = 0; t < AFTER; t++) {
+        game_command(&game, after[t]);
+        hashes[BEFORE + t + 1] = world_state_hash(&game.world);
+    }
+    int cellar = world_find_room(&game.world, "cellar");
+    ASSERT_TRUE(cellar >= 0 && bitset_test(game.world.visited, (size_t)cellar), "played in the new cellar");
+    ASSERT_TRUE(hashes[BEFORE + 3] != hashes[BEFORE + 2], "coin taken");
+    game_free(&game);
+    ASSERT_TRUE(recorder_close(&recorder), "recorder closed");
+
+    Recording recording;
+    ASSERT_TRUE(recording_open(&recording, path), "recording opened");
+    ASSERT_EQ(TURNS, recording.turns, "turns recorded");
+    ASSERT_EQ(2, recording.world_count, "start and reloaded definitions stored");
+
+    Game viewer;
+    game_init(&viewer, NULL);
+    ASSERT_TRUE(game_open_shared(&viewer, &viewed, "cave"), "viewer opened");
+    game_start(&viewer);
+    for (int t = 0; t <= TURNS; t++) {
+        ASSERT_TRUE(recording_seek(&recording, &viewer, t), "step forward");
+        ASSERT_TRUE(world_state_hash(&viewer.world) == hashes[t], "state after stepping");
+    }
+    ASSERT_TRUE(recording_seek(&recording, &viewer, 2), "seek back before the reload");
+    ASSERT_TRUE(world_state_hash(&viewer.world) == hashes[2], "state before the reload");
+    ASSERT_EQ(3, viewer.world.def->room_count, "viewer on the old layout");
+    ASSERT_TRUE(recording_seek(&recording, &viewer, TURNS), "seek past the reload");
+    ASSERT_TRUE(world_state_hash(&viewer.world) == hashes[TURNS], "state after the reload");
+    ASSERT_EQ(4, viewer.world.def->room_count, "viewer on the new layout");
+    ASSERT_TRUE(recording_seek(&recording, &viewer, 0), "seek to the start");
+    ASSERT_TRUE(world_state_hash(&viewer.world) == hashes[0], "starting state");
+
+    game_free(&viewer);
+    recording_close(&recording);
+
+    // Without a trailer the definitions are found by scanning
+    FILE *file = fopen(path, "r+b");
+    ASSERT_TRUE(file != NULL, "reopen recording");
+    fseek(file, -4, SEEK_END);
+    fputs("XXXX", file);
+    fclose(file);
+    ASSERT_TRUE(recording_open(&recording, path), "unclosed recording opened");
+    ASSERT_FALSE(recording.indexed, "index rebuilt");
+    ASSERT_EQ(2, recording.world_count, "definitions found by the scan");
+    game_init(&viewer, NULL);
+    ASSERT_TRUE(game_open_shared(&viewer, &viewed, "cave"), "viewer reopened");
+    game_start(&viewer);
+    ASSERT_TRUE(recording_seek(&recording, &viewer, 1), "seek before the reload");
+    ASSERT_TRUE(world_state_hash(&viewer.world) == hashes[1], "state before the reload (scanned)");
+    ASSERT_TRUE(recording_seek(&recording, &viewer, TURNS - 1), "seek after the reload");
+    ASSERT_TRUE(world_state_hash(&viewer.world) == hashes[TURNS - 1], "state after the reload (scanned)");
+
+    game_free(&viewer);
+    recording_close(&recording);
+    unlink(path);
+    world_free(&base);
+    world_free(&next);
+    world_free(&viewed);
+    PASS();
+}
+
+int main(void) {
+    printf("\n=== World Hot Reload Test Suite ===\n\n");
+
+    snprintf(watch_dir, sizeof(watch_dir), "/tmp/adventure-test-reload-%d", (int)getpid());
+    mkdir(watch_dir, 0700);
+
+    test_text_edit();
+    test_layout_edit();
+    test_removed_room();
+    test_shared();
+    test_watcher();
+    test_watcher_overflow();
+    test_farm();
+    test_recording();
+
+    rmdir(watch_dir);
+
+    printf("\n=== Test Results ===\n");
+    printf("  Passed: %d\n", tests_passed);
+    printf("  Failed: %d\n", tests_failed);
+    printf("  Total:  %d\n", tests_passed + tests_failed);
+
+    if (tests_failed == 0) {
+        printf("\n✓ All tests passed!\n\n");
+        return 0;
+    } else {
+        printf("\n✗ Some tests failed!\n\n");
+        return 1;
+    }
+}